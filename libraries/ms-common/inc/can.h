@@ -12,10 +12,14 @@
 #include <stdint.h>
 #include "can_ack.h"
 #include "can_fifo.h"
+#include "can_filter.h"
 #include "can_hw.h"
+#include "can_queue.h"
 #include "can_rx.h"
+#include "can_stats.h"
 #include "fsm.h"
 #include "gpio.h"
+#include "soft_timer.h"
 
 #define CAN_NUM_RX_HANDLERS 10
 
@@ -28,15 +32,30 @@ typedef struct CanSettings {
   EventId tx_event;
   EventId fault_event;
   bool loopback;
+  // Optional table of CAN_MSG_MAX_IDS entries, such as can_msg_schema_get(). If set, data
+  // messages that are undefined or don't match their DLC and source device are dropped.
+  const CanMsgSchema *msg_schema;
 } CanSettings;
 
 typedef struct CanStorage {
   Fsm fsm;
-  volatile CanFifo tx_fifo;
-  volatile CanFifo rx_fifo;
+  CanQueue tx_queue;
+  // Set while a TX event is waiting to be processed, so bursts only raise one event
+  volatile bool tx_pending;
+  CanRxRing rx_ring;
+  // When the message in each RX ring slot was received
+  uint32_t rx_times_us[CAN_FIFO_SIZE];
+  CanStats stats;
+  CanMessageId stats_msg_id;
+  SoftTimerId stats_timer;
   CanAckRequests ack_requests;
   CanRxHandlers rx_handlers;
   CanRxHandler rx_handler_storage[CAN_NUM_RX_HANDLERS];
+  // Every message ID passed to can_add_filter() and the filters currently installed for them
+  CanMessageId filter_ids[CAN_MSG_MAX_IDS];
+  size_t num_filter_ids;
+  CanFilterPlan filter_plan;
+  const CanMsgSchema *msg_schema;
   EventId rx_event;
   EventId tx_event;
   EventId fault_event;
@@ -46,9 +65,13 @@ typedef struct CanStorage {
 // Initializes the specified CAN configuration.
 StatusCode can_init(CanStorage *storage, const CanSettings *settings);
 
-// Adds a hardware filter for the specified message ID.
+// Adds the specified message ID to the hardware filters. All messages are accepted until the first
+// filter is added. Filters may let through some other message IDs once the filter banks run out.
 StatusCode can_add_filter(CanMessageId msg_id);
 
+// Returns the filters currently installed, including how many message IDs pass them.
+StatusCode can_get_filter_plan(CanFilterPlan *plan);
+
 // Registers a default RX handler for messages without specific RX handlers.
 StatusCode can_register_rx_default_handler(CanRxHandlerCb handler, void *context);
 
@@ -58,5 +81,13 @@ StatusCode can_register_rx_handler(CanMessageId msg_id, CanRxHandlerCb handler,
 // Attempts to transmit the CAN message as soon as possible.
 StatusCode can_transmit(const CanMessage *msg, const CanAckRequest *ack_request);
 
+// Returns bus load, latency, drop, TX queue and per-message ID stats since CAN was initialized.
+StatusCode can_get_stats(CanStats *stats);
+
+// Periodically transmits a CAN stats summary as |msg_id| - see can_stats.h for the layout.
+// Replaces any broadcast that was already running. can_init() starts it automatically when built
+// with CAN_STATS_MSG_ID=, every CAN_STATS_PERIOD_MS.
+StatusCode can_start_stats_broadcast(CanMessageId msg_id, uint32_t period_ms);
+
 // Processes the registered events. This must be called for the CAN network layer to work.
 bool can_process_event(const Event *e);
@@ -8,8 +8,13 @@
 // a) We receive an ACK over CAN
 // b) The timer expires and we timeout the ACK
 //
-// If the ACK has timed out or we've received the expected number of ACKs, we remove the ACK request
-// from the list. We use an object pool and an array of pointers to do so efficiently.
+// If the ACK has timed out or we've received the expected number of ACKs, we remove the request.
+// Requests come from an object pool. Pending requests are linked into a FIFO per message ID, and
+// each ACK timer maps back to its request, so matching, timeouts and removal don't need to search.
+//
+// Round-trip times (request to ACK) are tracked per critical message ID in a histogram. Bucket 0
+// counts ACKs within CAN_ACK_RTT_BASE_US, each bucket after that doubles the limit, and the last
+// bucket counts anything slower.
 #include <assert.h>
 #include <limits.h>
 #include "can_msg.h"
@@ -22,6 +27,9 @@
 #define CAN_ACK_TIMEOUT_MS 25
 #define CAN_ACK_MAX_REQUESTS 10
 
+#define CAN_ACK_RTT_BASE_US 250
+#define CAN_ACK_RTT_NUM_BUCKETS 8
+
 // Converts devices IDs to their bitset form. Populate ACK request bitsets using this.
 // Example: ack_request.expected_bitset = CAN_ACK_EXPECTED_DEVICES(CAN_DEVICE_A, CAN_DEVICE_D)
 #define CAN_ACK_EXPECTED_DEVICES(...)                       \
@@ -61,8 +69,13 @@ typedef struct CanAckPendingReq {
   void *context;
   uint32_t expected_bitset;
   uint32_t response_bitset;
+  // When the request was made, for round-trip times
+  uint32_t sent_us;
   SoftTimerId timer;
   CanMessageId msg_id;
+  // Neighbouring requests for the same message ID, oldest first
+  uint8_t prev;
+  uint8_t next;
 } CanAckPendingReq;
 static_assert(SIZEOF_FIELD(CanAckPendingReq, expected_bitset) * CHAR_BIT >= CAN_MSG_MAX_DEVICES,
               "CAN pending ACK expected bitset field not large enough to fit all CAN devices!");
@@ -70,10 +83,24 @@ static_assert(SIZEOF_FIELD(CanAckPendingReq, expected_bitset) ==
                   SIZEOF_FIELD(CanAckPendingReq, response_bitset),
               "CAN pending ACK expected bitset size not equal to response bitset size");
 
+static_assert(CAN_ACK_MAX_REQUESTS < UINT8_MAX, "CAN ACK request indices must fit in a uint8_t");
+
+typedef struct CanAckRttHistogram {
+  uint16_t buckets[CAN_ACK_RTT_NUM_BUCKETS];
+  uint16_t timeouts;
+  uint32_t max_us;
+} CanAckRttHistogram;
+
 typedef struct CanAckRequests {
   ObjectPool pool;
   CanAckPendingReq request_nodes[CAN_ACK_MAX_REQUESTS];
-  CanAckPendingReq *active_requests[CAN_ACK_MAX_REQUESTS];
+  // Oldest and newest pending request for each message ID
+  uint8_t id_head[CAN_MSG_MAX_IDS];
+  uint8_t id_tail[CAN_MSG_MAX_IDS];
+  // Pending request for each ACK timeout timer
+  uint8_t timer_requests[SOFT_TIMER_MAX_TIMERS];
+  // Only critical messages are ACKed
+  CanAckRttHistogram rtt[CAN_MSG_NUM_CRITICAL_IDS];
   size_t num_requests;
 } CanAckRequests;
 
@@ -85,3 +112,7 @@ StatusCode can_ack_add_request(CanAckRequests *requests, CanMessageId msg_id,
 
 // Handle a received ACK, firing the callback associated with the received message
 StatusCode can_ack_handle_msg(CanAckRequests *requests, const CanMessage *msg);
+
+// Copies the round-trip time histogram for a critical message ID.
+StatusCode can_ack_get_rtt_histogram(const CanAckRequests *requests, CanMessageId msg_id,
+                                     CanAckRttHistogram *histogram);
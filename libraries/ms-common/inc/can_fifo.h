@@ -2,6 +2,7 @@
 // Specific instance of FIFO for CAN
 #include "can_msg.h"
 #include "fifo.h"
+#include "spsc_ring.h"
 
 #define CAN_FIFO_SIZE 32
 
@@ -19,3 +20,7 @@ typedef struct CanFifo {
 #define can_fifo_pop(can_fifo, dest) fifo_pop(&(can_fifo)->fifo, (dest))
 
 #define can_fifo_size(can_fifo) fifo_size(&(can_fifo)->fifo)
+
+// RX only has one producer (the CAN RX ISR) and one consumer (the main loop), so it doesn't need
+// critical sections. TX is prioritized by CAN ID instead (see can_queue).
+SPSC_RING_DEFINE(CanRxRing, can_rx_ring, CanMessage, CAN_FIFO_SIZE)
@@ -0,0 +1,36 @@
+#pragma once
+// CAN filter planner
+// Computes the hardware filters for a set of subscribed message IDs.
+//
+// Each filter is a mask/ID pair over the 6-bit message ID, so it accepts a power-of-two sized group
+// of IDs. The planner starts with one exact filter per ID and greedily merges the pair of filters
+// that lets through the fewest unsubscribed IDs until the plan fits in the filter banks. Merges that
+// don't let anything extra through are always made. Source ID and message type are never filtered.
+//
+// Filters are packed two per bank using bxCAN's 16-bit mask mode. List mode isn't useful here since
+// it can only match full IDs, including the source ID.
+#include <stddef.h>
+#include <stdint.h>
+#include "can_hw.h"
+#include "can_msg.h"
+#include "status.h"
+
+#define CAN_FILTER_PER_BANK 2
+#define CAN_FILTER_MAX_FILTERS (CAN_HW_NUM_FILTER_BANKS * CAN_FILTER_PER_BANK)
+
+typedef struct CanFilterPlan {
+  CanHwFilter filters[CAN_FILTER_MAX_FILTERS];
+  size_t num_filters;
+  size_t num_banks;
+  // Message IDs that were subscribed to, and how many IDs actually pass the filters
+  size_t num_subscribed;
+  size_t num_accepted;
+} CanFilterPlan;
+
+// Plans filters that accept every ID in |msg_ids| and fit in |max_banks| filter banks.
+// Duplicate IDs are allowed.
+StatusCode can_filter_plan(const CanMessageId *msg_ids, size_t num_ids, size_t max_banks,
+                           CanFilterPlan *plan);
+
+// Returns the percentage of unsubscribed message IDs that pass the filters anyway.
+uint8_t can_filter_false_accept_rate(const CanFilterPlan *plan);
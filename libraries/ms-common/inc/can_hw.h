@@ -34,6 +34,16 @@ typedef enum {
   NUM_CAN_HW_BITRATES
 } CanHwBitrate;
 
+// bxCAN filter banks. Standard ID filters are packed in 16-bit scale, so each bank holds either
+// four exact IDs or two mask/ID pairs. Extended ID filters take a whole bank.
+#define CAN_HW_NUM_FILTER_BANKS 14
+
+typedef struct CanHwFilter {
+  uint32_t mask;
+  uint32_t filter;
+  bool extended;
+} CanHwFilter;
+
 typedef struct CanHwSettings {
   GpioAddress tx;
   GpioAddress rx;
@@ -49,8 +59,14 @@ StatusCode can_hw_register_callback(CanHwEvent event, CanHwEventHandlerCb callba
 
 StatusCode can_hw_add_filter(uint32_t mask, uint32_t filter, bool extended);
 
+// Replaces every filter with |filters|. Accepts all messages if |num_filters| is 0.
+StatusCode can_hw_set_filters(const CanHwFilter *filters, size_t num_filters);
+
 CanHwBusStatus can_hw_bus_status(void);
 
+// Reads the transmit and receive error counters
+void can_hw_get_error_counters(uint8_t *tx_errors, uint8_t *rx_errors);
+
 StatusCode can_hw_transmit(uint32_t id, bool extended, const uint8_t *data, size_t len);
 
 // Must be called within the RX handler, returns whether a message was processed
@@ -11,7 +11,8 @@
 #define CAN_MSG_MAX_IDS (1 << 6)
 
 // TODO(ELEC-202): determine which messages are considered "critical"
-#define CAN_MSG_IS_CRITICAL(msg) ((msg)->msg_id < 14)
+#define CAN_MSG_NUM_CRITICAL_IDS 14
+#define CAN_MSG_IS_CRITICAL(msg) ((msg)->msg_id < CAN_MSG_NUM_CRITICAL_IDS)
 
 #define CAN_MSG_SET_RAW_ID(can_msg, can_id) \
   do {                                      \
@@ -29,18 +30,33 @@ typedef enum {
 
 typedef uint16_t CanMessageId;
 
+// Only needs word alignment, which keeps CanMessage at 12 bytes instead of padding it out to 16
+typedef uint64_t CanMessageData __attribute__((aligned(4)));
+
 typedef struct CanMessage {
-  uint16_t source_id;
-  CanMessageId msg_id;
   union {
-    uint64_t data;
+    CanMessageData data;
     uint32_t data_u32[2];
     uint16_t data_u16[4];
     uint8_t data_u8[8];
   };
-  CanMsgType type;
-  size_t dlc;
+  CanMessageId msg_id;
+  uint8_t source_id;
+  // CanMsgType
+  uint8_t type : 4;
+  uint8_t dlc : 4;
 } CanMessage;
+_Static_assert(sizeof(CanMessage) <= 12, "CanMessage should be packed into 12 bytes");
+
+// Expected layout of a message ID, indexed by message ID. See can_msg_schema.h in ms-helper.
+#define CAN_MSG_SCHEMA_NO_SLOT (UINT8_MAX)
+
+typedef struct CanMsgSchema {
+  uint8_t dlc;
+  uint8_t source_id;
+  // Dense index of the message among the defined messages, or CAN_MSG_SCHEMA_NO_SLOT if undefined
+  uint8_t slot;
+} CanMsgSchema;
 
 typedef union CanId {
   uint16_t raw;
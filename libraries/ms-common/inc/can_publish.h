@@ -0,0 +1,45 @@
+#pragma once
+// Publish-on-change layer over can_transmit()
+// Requires CAN and soft timers to be initialized.
+//
+// Each publisher caches the last message it sent. A new message is only transmitted if a field
+// has moved by more than the deadband, the message ID or DLC changed, or nothing has been sent for
+// the maximum silence interval. Otherwise it's dropped and counted as suppressed, so periodic
+// senders with steady values stop loading the bus while real changes go out immediately.
+//
+// The silence interval is only checked when can_publish() is called, so periodic senders should
+// publish at least that often. Fields are compared as unsigned integers, so a signed value crossing
+// zero is always treated as a change.
+#include <stdbool.h>
+#include <stdint.h>
+#include "can_msg.h"
+#include "status.h"
+
+typedef struct CanPublishSettings {
+  // Width of each field in bytes: 1, 2, 4 or 8
+  uint8_t field_size;
+  // A field must differ from the last sent value by more than this to be sent early
+  uint32_t deadband;
+  // Resend the last value at least this often, even if nothing has changed
+  uint32_t max_silence_ms;
+} CanPublishSettings;
+
+typedef struct CanPublishStorage {
+  CanPublishSettings settings;
+  CanMessage last_msg;
+  uint64_t last_sent_us;
+  // Set once a message has been sent, so the first message always goes out
+  bool sent;
+  uint32_t num_sent;
+  uint32_t num_suppressed;
+} CanPublishStorage;
+
+StatusCode can_publish_init(CanPublishStorage *storage, const CanPublishSettings *settings);
+
+// Transmits |msg| without an ACK request if it has changed enough or the interval has elapsed.
+// Suppressed messages return STATUS_CODE_OK. If the transmit fails, the cache is left alone so the
+// next call tries again.
+StatusCode can_publish(CanPublishStorage *storage, const CanMessage *msg);
+
+// Forgets the last sent message, so the next call to can_publish() always transmits.
+void can_publish_invalidate(CanPublishStorage *storage);
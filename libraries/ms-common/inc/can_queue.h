@@ -1,21 +1,34 @@
 #pragma once
+// CAN TX queue
+//
+// Messages are ordered by their 11-bit CAN ID, the same way the bus arbitrates between them, so a
+// critical message never waits behind a burst of telemetry. Messages with the same ID stay in
+// FIFO order. The last few slots are reserved for critical messages so a telemetry burst can't
+// fill the queue and lock them out.
 #include "can_msg.h"
 #include "pqueue_backed.h"
 
 #define CAN_QUEUE_SIZE 10
+#define CAN_QUEUE_CRITICAL_RESERVED 2
+
+// Entries remember when they were queued so we can track how long they wait for a mailbox
+typedef struct CanTxEntry {
+  CanMessage msg;
+  uint32_t queued_us;
+} CanTxEntry;
 
 typedef struct CanQueue {
   PQueueBacked pqueue;
   PQueueNode queue_nodes[CAN_QUEUE_SIZE + 1];
-  CanMessage msg_nodes[CAN_QUEUE_SIZE];
+  CanTxEntry msg_nodes[CAN_QUEUE_SIZE];
 } CanQueue;
 
 StatusCode can_queue_init(CanQueue *can_queue);
 
-StatusCode can_queue_push(CanQueue *can_queue, const CanMessage *msg);
+StatusCode can_queue_push(CanQueue *can_queue, const CanTxEntry *entry);
 
-StatusCode can_queue_pop(CanQueue *can_queue, CanMessage *msg);
+StatusCode can_queue_pop(CanQueue *can_queue, CanTxEntry *entry);
 
-StatusCode can_queue_peek(CanQueue *can_queue, CanMessage *msg);
+StatusCode can_queue_peek(CanQueue *can_queue, CanTxEntry *entry);
 
 size_t can_queue_size(CanQueue *can_queue);
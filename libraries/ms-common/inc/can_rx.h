@@ -1,6 +1,9 @@
 #pragma once
 // CAN RX handlers
 // Provides an interface for registering and finding callbacks based on CAN message IDs.
+//
+// Message IDs are only 6 bits, so handlers are found through a table indexed by message ID
+// rather than by searching. Any other IDs fall back to a linear search.
 #include <stdint.h>
 #include "can_ack.h"
 #include "can_msg.h"
@@ -21,8 +24,13 @@ typedef struct CanRxHandlers {
   CanRxHandler *default_handler;
   size_t max_handlers;
   size_t num_handlers;
+  // Index + 1 of the handler for each message ID, 0 if there isn't one
+  uint8_t lookup[CAN_MSG_MAX_IDS];
+  // Optional - lookups per message ID
+  uint32_t *hits;
 } CanRxHandlers;
 
+// |num_handlers| must be less than 256.
 StatusCode can_rx_init(CanRxHandlers *rx_handlers, CanRxHandler *handler_storage,
                        size_t num_handlers);
 
@@ -32,4 +40,9 @@ StatusCode can_rx_register_default_handler(CanRxHandlers *rx_handlers, CanRxHand
 StatusCode can_rx_register_handler(CanRxHandlers *rx_handlers, CanMessageId msg_id,
                                    CanRxHandlerCb handler, void *context);
 
+// Returns the handler for a received message, or the default handler if it has none.
 CanRxHandler *can_rx_get_handler(CanRxHandlers *rx_handlers, CanMessageId msg_id);
+
+// Counts every lookup by message ID in |hits|, which must have CAN_MSG_MAX_IDS entries. The counts
+// are cleared. Pass NULL to stop counting.
+StatusCode can_rx_set_hit_counts(CanRxHandlers *rx_handlers, uint32_t *hits);
@@ -0,0 +1,83 @@
+#pragma once
+// CAN bus statistics
+// Fixed-size counters for the CAN network layer, each updated in O(1) per frame.
+//
+// Bus load is estimated from the frames this node sends and the frames that pass its filters,
+// using worst-case bit stuffing, so it's an upper bound on what this node sees rather than a
+// measurement of the whole bus. Each 100ms window is folded into a moving average.
+//
+// Recording TX and RX frames is safe from the main loop while a summary is packed from an
+// interrupt, such as a soft timer.
+//
+// Summary message layout (8 bytes):
+//   data_u8[0]: Bus load (%)
+//   data_u8[1]: TX queue drops since the last summary (saturates at 255)
+//   data_u8[2]: RX ring drops since the last summary (saturates at 255)
+//   data_u8[3]: Bus errors since the last summary (saturates at 255)
+//   data_u16[2]: Longest TX latency since the last summary (us, saturates at 65535)
+//   data_u16[3]: Longest RX latency since the last summary (us, saturates at 65535)
+#include <stddef.h>
+#include <stdint.h>
+#include "can_hw.h"
+#include "can_msg.h"
+
+#define CAN_STATS_WINDOW_MS 100
+
+typedef struct CanStatsLatency {
+  uint32_t count;
+  uint64_t total_us;
+  uint32_t max_us;
+  // Longest since the last summary
+  uint32_t window_max_us;
+} CanStatsLatency;
+
+typedef struct CanStats {
+  // Frames per message ID, including ACKs. These wrap, so use the difference between two reads.
+  uint32_t tx_frames[CAN_MSG_MAX_IDS];
+  uint32_t rx_frames[CAN_MSG_MAX_IDS];
+  // can_transmit() to being handed to a mailbox - the count is the number of messages transmitted
+  CanStatsLatency tx_latency;
+  // Received in the CAN ISR to the RX handler running
+  CanStatsLatency rx_latency;
+  // Messages rejected because the TX queue or RX ring was full
+  uint32_t tx_dropped;
+  uint32_t rx_dropped;
+  uint32_t bus_errors;
+  // Data messages dropped for not matching the message schema
+  uint32_t rx_invalid;
+  // Messages waiting for a mailbox and the most there have been at once. The current depth is
+  // filled in by can_get_stats().
+  size_t tx_queue_depth;
+  size_t tx_queue_high_water;
+  // Number of times the TX queue was serviced - each pass fills as many mailboxes as it can
+  uint32_t tx_service_passes;
+  // Hardware transmit and receive error counters, filled in by can_get_stats()
+  uint8_t tx_error_count;
+  uint8_t rx_error_count;
+  // Moving average of bus load in 0.1% steps
+  uint16_t bus_load_permille;
+
+  uint16_t bits_per_ms;
+  uint32_t window_start_us;
+  uint32_t window_bits;
+  // Drop and error counts when the last summary was packed
+  uint32_t summary_tx_dropped;
+  uint32_t summary_rx_dropped;
+  uint32_t summary_bus_errors;
+} CanStats;
+
+void can_stats_init(CanStats *stats, CanHwBitrate bitrate, uint32_t now_us);
+
+// Records a frame handed to a mailbox. |queued_us| is when it was passed to can_transmit().
+void can_stats_record_tx(CanStats *stats, const CanMessage *msg, uint32_t queued_us,
+                         uint32_t now_us);
+
+// Records a frame about to be handled. |received_us| is when the CAN ISR received it.
+void can_stats_record_rx(CanStats *stats, const CanMessage *msg, uint32_t received_us,
+                         uint32_t now_us);
+
+// Returns the bus load in %, folding in any windows that have finished since the last frame
+uint8_t can_stats_bus_load(CanStats *stats, uint32_t now_us);
+
+// Packs a summary into |msg|'s data and starts a new summary period. The message ID is left alone.
+void can_stats_pack_summary(CanStats *stats, uint32_t now_us, CanMessage *msg);
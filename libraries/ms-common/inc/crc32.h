@@ -5,10 +5,32 @@
 // Cyclic redundancy check - error detecting code commonly used as a quick hash function.
 // Note that this is designed to be used to verify data integrity, and should not be used to
 // protect against intentional alteration of data.
+//
+// Data can be hashed in one call with crc32_arr(), or streamed in pieces of any size:
+//   Crc32 crc;
+//   crc32_start(&crc);
+//   crc32_update(&crc, segment_a, len_a);
+//   crc32_update(&crc, segment_b, len_b);
+//   uint32_t result = crc32_final(&crc);
+// Streams are independent, so several can be in progress at once.
+//
+// On x86, this uses slice-by-8 tables. On STM32F0xx, this uses the CRC peripheral, so
+// crc32_init() must be called first.
 #include <stddef.h>
 #include <stdint.h>
 #include "status.h"
 
+typedef struct Crc32 {
+  // Running CRC before the final inversion
+  uint32_t state;
+} Crc32;
+
 StatusCode crc32_init(void);
 
 uint32_t crc32_arr(const uint8_t *buffer, size_t buffer_len);
+
+void crc32_start(Crc32 *crc);
+
+void crc32_update(Crc32 *crc, const uint8_t *buffer, size_t buffer_len);
+
+uint32_t crc32_final(const Crc32 *crc);
@@ -4,8 +4,10 @@
 // Uses an array of FIFOs to prioritize events of lower priority. Only one global instance exists.
 //
 // Implementation:
-// - Event Queue consists of five FIFOs each of which correspond to a priority.
-// - Raised events are put into the corresponding FIFO.
+// - Event Queue consists of five ring buffers each of which correspond to a priority.
+// - Raised events are put into the corresponding ring buffer.
+// - A bitmask tracks which priorities have events, so the highest priority non-empty queue is
+//   found with a single count-trailing-zeros rather than a scan.
 // - A processed event will come from the highest priority queue that has elements.
 //
 // For legacy purposes and simplicity for smaller projects |event_raise()| allows events to be
@@ -13,12 +15,20 @@
 // will preempt most ms-common and ms-helper functionality as well as any board behavior.
 // Additionally, low priority message will effectively become best effort as many events may be
 // raised.
+//
+// High-rate events that only report the latest state can be made coalescable with
+// |event_queue_add_coalesce_group()|. Raising an event from a group while another event from the
+// same group is still queued at that priority replaces the queued event in place, so the queue
+// depth is bounded by the number of distinct groups rather than by the rate they are raised at.
+#include <stddef.h>
 #include <stdint.h>
 
 #include "objpool.h"
 #include "status.h"
 
 #define EVENT_QUEUE_SIZE 20
+#define EVENT_QUEUE_MAX_COALESCE_GROUPS 8
+#define EVENT_QUEUE_MAX_COALESCABLE_IDS 16
 typedef uint16_t EventId;
 
 typedef enum {
@@ -35,7 +45,16 @@ typedef struct Event {
   uint16_t data;
 } Event;
 
-// Initializes the event queue.
+typedef struct EventQueueStats {
+  // Most events that have been queued at once
+  uint16_t high_water_mark;
+  // Events that were dropped because the queue was full
+  uint32_t dropped;
+  // Events that replaced a queued event from the same coalesce group
+  uint32_t coalesced;
+} EventQueueStats;
+
+// Initializes the event queue. Also clears the stats and coalesce groups.
 void event_queue_init(void);
 
 // Raises an event in the global event queue at the default priority.
@@ -48,3 +67,17 @@ StatusCode event_raise_priority(EventPriority priority, EventId id, uint16_t dat
 // Returns the next event to be processed.
 // Note that events are processed by priority.
 StatusCode event_process(Event *e);
+
+// Pops up to |max_events| events into |events| in a single critical section and returns how many
+// were popped. Events only come from the highest priority that has any, so a higher priority event
+// raised while the batch is being handled waits for at most the rest of the batch.
+size_t event_process_batch(Event *events, size_t max_events);
+
+// Makes |ids| a coalesce group: a newly raised event from the group replaces one that is still
+// queued at the same priority, keeping its place in the queue. Use a group with a single ID for
+// periodic updates, or several IDs for mutually exclusive states where only the latest matters.
+// Must be called after |event_queue_init()|.
+StatusCode event_queue_add_coalesce_group(const EventId *ids, size_t num_ids);
+
+// Returns the stats for a priority since the event queue was initialized.
+StatusCode event_queue_get_stats(EventPriority priority, EventQueueStats *stats);
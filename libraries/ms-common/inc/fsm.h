@@ -25,12 +25,25 @@
 // }
 //
 // Use fsm_state_init to set a state's output function (called whenever transitioned to).
+//
+// fsm_init() builds a transition table sorted by event ID for every state reachable from the
+// default state, so processing an event is a binary search rather than a walk through every
+// transition. Tables are stored in a shared pool of FSM_MAX_TRANSITIONS entries, sized at build
+// time with FSM_MAX_TRANSITIONS=. A state's table is only built once, so initializing an FSM again
+// doesn't use more of the pool. States that don't fit fall back to checking their transitions in
+// order - this is logged and counted in fsm_get_pool_stats() so the pool can be resized. States
+// shared by FSMs whose transitions differ (i.e. event IDs taken from the FSM context) also fall
+// back to checking their transitions in order. Building with FSM=func skips the tables entirely.
+//
+// Transitions with the same event ID are still checked in the order they were added.
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include "event_queue.h"
 #include "fsm_impl.h"
+#include "status.h"
 
 // Forward-declares the state for use.
 #define FSM_DECLARE_STATE(state) _FSM_DECLARE_STATE(state)
@@ -45,28 +58,82 @@
 // Initializes an FSM state with an output function.
 #define fsm_state_init(state, output_func) _fsm_state_init(state, output_func)
 
+// Total transitions across all FSM tables - set through the build system
+#ifndef FSM_MAX_TRANSITIONS
+#define FSM_MAX_TRANSITIONS 128
+#endif
+
 struct Fsm;
+struct State;
+struct FsmTransitionBuilder;
 typedef void (*FsmStateOutput)(struct Fsm *fsm, const Event *e, void *context);
-typedef void (*FsmStateTransition)(struct Fsm *fsm, const Event *e, bool *transitioned);
+typedef void (*FsmStateTransition)(struct Fsm *fsm, const Event *e,
+                                   struct FsmTransitionBuilder *builder);
 typedef bool (*FsmStateTransitionGuard)(const struct Fsm *fsm, const Event *e, void *context);
 
+typedef struct FsmTransition {
+  EventId event_id;
+  FsmStateTransitionGuard guard;
+  struct State *state;
+} FsmTransition;
+
+typedef void (*FsmTransitionVisitFn)(const FsmTransition *transition, void *context);
+
 typedef struct State {
   const char *name;
   FsmStateOutput output;
   FsmStateTransition table;
+  // Sorted by event ID. NULL if the table hasn't been built.
+  const FsmTransition *transitions;
+  uint16_t num_transitions;
+  bool built;
+  // Used to walk the states reachable from a state
+  uint16_t traversal;
+  struct State *next;
 } FsmState;
 
+typedef struct FsmPoolStats {
+  // Transitions stored in the pool
+  size_t in_use;
+  // States whose tables didn't fit in the pool
+  uint32_t overflows;
+} FsmPoolStats;
+
 typedef struct Fsm {
   const char *name;
+  FsmState *default_state;
   FsmState *last_state;
   FsmState *current_state;
   void *context;
 } Fsm;
 
-// Initializes the FSM.
-void fsm_init(Fsm *fsm, const char *name, FsmState *default_state, void *context);
+// Passed to transition functions - either collects the transitions or dispatches an event.
+typedef struct FsmTransitionBuilder {
+  // Collects transitions if set
+  FsmTransitionVisitFn visit;
+  void *context;
+
+  Fsm *fsm;
+  const Event *e;
+  bool transitioned;
+} FsmTransitionBuilder;
+
+// Initializes the FSM and builds the transition tables for all states reachable from the default
+// state. States whose tables don't fit in the pool check their transitions in order instead.
+StatusCode fsm_init(Fsm *fsm, const char *name, FsmState *default_state, void *context);
+
+// Returns the transition pool's usage across all FSMs.
+StatusCode fsm_get_pool_stats(FsmPoolStats *stats);
 
 // Returns whether a transition occurred in the FSM.
 bool fsm_process_event(Fsm *fsm, const Event *e);
 
-bool fsm_guard_true(Fsm *fsm, const Event *e, void *context);
+// Calls |visit| with every transition of every state reachable from the FSM's default state.
+// Must not be called from an interrupt.
+void fsm_for_each_transition(Fsm *fsm, FsmTransitionVisitFn visit, void *context);
+
+bool fsm_guard_true(const Fsm *fsm, const Event *e, void *context);
+
+// Used by the transition table macros - returns whether the FSM transitioned.
+bool _fsm_add_transition(FsmTransitionBuilder *builder, EventId event_id,
+                         FsmStateTransitionGuard guard, FsmState *state);
@@ -3,7 +3,13 @@
 //
 // This implementation attempts to simplify the creation of a transition table by declaring it
 // as a function. We use macros to hide that function, proving an interface to declare simple
-// transition tables. If needed, we could add simple guards quite easily.
+// transition tables.
+//
+// The function is normally only run by |fsm_init()|, which collects each state's transitions into
+// a table sorted by event ID that is binary searched when processing events. |e| is NULL while
+// collecting, so transition tables may depend on |fsm| (i.e. its context) but not on the event.
+// If a table can't be built, the function is run on every event instead, checking each transition
+// in order.
 
 // Forward-declares the state's transition function (prv_fsm_[state])
 // and declares a FsmState object populated with its name and transition function
@@ -12,27 +18,17 @@
   static FsmState state = { .name = #state, .table = prv_fsm_##state }
 
 // This is used for both forward-declaration and the actual function declaration
-// Since we're implementing the transition table as a function, we can't rely on a return value
-// so we pass in a pointer to be modified on transitions.
+// The builder either collects the transitions or dispatches the event to them.
 #define _FSM_STATE_TRANSITION(state) \
-  static void prv_fsm_##state(Fsm *fsm, const Event *e, bool *transitioned)
+  static void prv_fsm_##state(Fsm *fsm, const Event *e, FsmTransitionBuilder *_fsm_builder)
 
 // Represents a transition through a conditional. This should only be used in transition functions.
-// This keeps track of states and signals that a transition has occurred through the pointer.
-// We then call the new state's output function if it exists.
-#define _FSM_ADD_GUARDED_TRANSITION(event_id, guard, state)   \
-  do {                                                        \
-    if (e->id == event_id && (guard)(fsm, e, fsm->context)) { \
-      fsm->last_state = fsm->current_state;                   \
-      fsm->current_state = &state;                            \
-      *transitioned = true;                                   \
-                                                              \
-      if (fsm->current_state->output != NULL) {               \
-        fsm->current_state->output(fsm, e, fsm->context);     \
-      }                                                       \
-                                                              \
-      return;                                                 \
-    }                                                         \
+// When dispatching, we stop at the first transition taken.
+#define _FSM_ADD_GUARDED_TRANSITION(event_id, guard, state)                 \
+  do {                                                                      \
+    if (_fsm_add_transition(_fsm_builder, (event_id), (guard), &(state))) { \
+      return;                                                               \
+    }                                                                       \
   } while (0)
 
 // Unguarded transitions just always return true for the guard.
@@ -6,3 +6,11 @@
 // For testing soft_timer.h:
 // TEST ONLY FUNCTION TO SET TIMER COUNTER FOR SOFT TIMERS UNSAFE TO CALL OUTSIDE A TEST.
 void _test_soft_timer_set_counter(uint32_t counter_value);
+
+// For benchmarks:
+// Returns the current time in microseconds from a monotonic wall clock. Unlike soft timer time,
+// this keeps counting when x86 soft timers run in virtual time (X86_INTERRUPT=sched).
+uint64_t _test_benchmark_get_time(void);
+
+// Returns the wall-clock time elapsed since |start_us| in microseconds, saturated to UINT32_MAX.
+uint32_t _test_benchmark_elapsed_us(uint64_t start_us);
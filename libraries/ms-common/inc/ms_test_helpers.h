@@ -8,14 +8,14 @@
 #include "fsm.h"
 #include "status.h"
 #include "unity.h"
+#include "wait.h"
 
 // Awaits an event and populates |e| with that event.
-#define MS_TEST_HELPER_AWAIT_EVENT(e)     \
-  ({                                      \
-    StatusCode status = NUM_STATUS_CODES; \
-    do {                                  \
-      status = event_process(&(e));       \
-    } while (status != STATUS_CODE_OK);   \
+#define MS_TEST_HELPER_AWAIT_EVENT(e)               \
+  ({                                                \
+    while (event_process(&(e)) != STATUS_CODE_OK) { \
+      wait();                                       \
+    }                                               \
   })
 
 // The following require CAN to be initialized.
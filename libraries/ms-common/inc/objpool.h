@@ -3,6 +3,15 @@
 //
 // Manages a pre-allocated array of objects. We use this instead of a heap so we don't need to deal
 // with memory fragmentation.
+//
+// Free nodes are tracked in a two-level bitmap: a summary word with a bit per bitmap word that
+// may have free nodes, then a bit per node. Getting a node is two count-trailing-zeros.
+// Nodes are reset (zeroed, then passed to the init function) when they are handed out, not when
+// they are freed.
+//
+// Where the CPU has a 64-bit compare-and-swap (i.e. x86), the bitmaps are updated with atomics
+// instead of critical sections and pools can hold thousands of nodes. Otherwise (i.e. the
+// Cortex-M0) they are protected by critical sections.
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
@@ -10,18 +19,41 @@
 #include "misc.h"
 #include "status.h"
 
-#define OBJPOOL_MAX_NODES 64
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_8)
+#define OBJPOOL_LOCK_FREE
+#define OBJPOOL_MAX_NODES 4096
+#define OBJPOOL_WORD_BITS 64
+typedef uint64_t ObjpoolWord;
+#else
+#define OBJPOOL_MAX_NODES 128
+#define OBJPOOL_WORD_BITS 32
+typedef uint32_t ObjpoolWord;
+#endif
+
+#define OBJPOOL_NUM_WORDS (OBJPOOL_MAX_NODES / OBJPOOL_WORD_BITS)
 
 // Function to initialize nodes with
 typedef void (*ObjpoolNodeInitFn)(void *node, void *context);
 
+typedef struct ObjpoolStats {
+  size_t in_use;
+  // Most nodes in use at once
+  size_t peak_in_use;
+  // Gets that failed because the pool was empty
+  uint32_t failures;
+} ObjpoolStats;
+
 typedef struct ObjectPool {
   void *nodes;
   void *context;
   ObjpoolNodeInitFn init_node;
   size_t num_nodes;
   size_t node_size;
-  uint64_t free_bitset;
+  // Bit w is set if free_bitset[w] may have free nodes
+  ObjpoolWord free_summary;
+  // Bit n of word w is set if node (w * OBJPOOL_WORD_BITS + n) is free
+  ObjpoolWord free_bitset[OBJPOOL_NUM_WORDS];
+  ObjpoolStats stats;
 } ObjectPool;
 
 // Initializes an object pool given a local array (i.e. not a pointer)
@@ -30,11 +62,15 @@ typedef struct ObjectPool {
                        (context))
 
 // Initializes an object pool. The specified context is provided for node initialization.
+// All nodes are zeroed.
 StatusCode objpool_init_verbose(ObjectPool *pool, void *nodes, size_t node_size, size_t num_nodes,
                                 ObjpoolNodeInitFn init_node, void *context);
 
 // Returns the pointer to an object from the pool.
 void *objpool_get_node(ObjectPool *pool);
 
-// Releases the specified node
+// Releases the specified node. The node is left as is until it is handed out again.
 StatusCode objpool_free_node(ObjectPool *pool, void *node);
+
+// Returns the pool's allocation stats since it was initialized.
+StatusCode objpool_get_stats(const ObjectPool *pool, ObjpoolStats *stats);
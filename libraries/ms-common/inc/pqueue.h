@@ -1,5 +1,6 @@
 #pragma once
 // Generic minimum priority queue
+// Nodes with equal priorities are popped in the order they were pushed.
 #include <stdint.h>
 #include <stdlib.h>
 
@@ -7,6 +8,8 @@
 
 typedef struct PQueueNode {
   void *data;
+  // Push order - breaks ties between equal priorities
+  uint32_t seq;
   uint16_t prio;
 } PQueueNode;
 
@@ -14,6 +17,7 @@ typedef struct PQueue {
   PQueueNode *nodes;
   size_t max_nodes;
   size_t size;
+  uint32_t next_seq;
 } PQueue;
 
 // Initialize and clear the priority queue.
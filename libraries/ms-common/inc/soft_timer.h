@@ -1,6 +1,9 @@
 #pragma once
 // Software-based timers backed by single hardware timer
 // Requires interrupts to be initialized.
+//
+// Timers are kept in either a sorted linked list (default) or a hierarchical timing wheel. This is
+// selected at build time with the SOFT_TIMER make variable - see soft_timer_queue.h.
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -33,6 +36,18 @@ StatusCode soft_timer_start(uint32_t duration_us, SoftTimerCallback callback, vo
 #define soft_timer_start_seconds(duration_s, callback, context, timer_id) \
   soft_timer_start((duration_s)*1000000, (callback), (context), (timer_id))
 
+// Adds a periodic software timer. The callback is run every period_us microseconds, starting one
+// period from now, until the timer is cancelled. Each deadline is scheduled relative to the last
+// deadline rather than when the callback ran, so the timer does not drift. If the callback is
+// delayed by more than a period, the missed deadlines are skipped and counted as overruns. The
+// timer_id remains valid until the timer is cancelled.
+StatusCode soft_timer_start_periodic(uint32_t period_us, SoftTimerCallback callback, void *context,
+                                     SoftTimerId *timer_id);
+
+// Starts a periodic software timer in milliseconds. Max period is still UINT32_MAX us.
+#define soft_timer_start_periodic_millis(period_ms, callback, context, timer_id) \
+  soft_timer_start_periodic((period_ms)*1000, (callback), (context), (timer_id))
+
 // Cancels the soft timer specified by id. Returns true if successful.
 bool soft_timer_cancel(SoftTimerId timer_id);
 
@@ -43,3 +58,11 @@ bool soft_timer_inuse(void);
 // in use. Note that since timer ids are re-used this could return false values once the timer has
 // expired or if it is cancelled.
 uint32_t soft_timer_remaining_time(SoftTimerId timer_id);
+
+// Returns the number of deadlines a periodic timer has skipped because its callback could not be
+// run in time. Returns 0 if the timer is not in use.
+uint32_t soft_timer_get_overruns(SoftTimerId timer_id);
+
+// Returns the time in microseconds since soft timers were initialized. This is the time base that
+// timers run off of, so it can be used to timestamp or measure short intervals.
+uint64_t soft_timer_get_time(void);
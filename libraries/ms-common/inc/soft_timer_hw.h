@@ -0,0 +1,23 @@
+#pragma once
+// Hardware abstraction layer for soft timers
+// This is an internal module and should not be used.
+//
+// Provides a free-running microsecond time base and a single alarm. All times are absolute and
+// relative to initialization.
+#include <stdint.h>
+
+typedef void (*SoftTimerHwCallback)(void);
+
+// Initializes the time base and resets it to 0. The callback is run in an interrupt context
+// whenever the alarm expires.
+void soft_timer_hw_init(SoftTimerHwCallback callback);
+
+// Returns the time since initialization in microseconds.
+uint64_t soft_timer_hw_get_time(void);
+
+// Sets the alarm to expire at the specified time. If the time has already passed, the alarm will
+// expire as soon as possible. The alarm may expire early, so the callback should check the time.
+void soft_timer_hw_set_alarm(uint64_t time_us);
+
+// Disables the alarm until it is set again.
+void soft_timer_hw_disable_alarm(void);
@@ -0,0 +1,113 @@
+#pragma once
+// Soft timer queues
+// This is an internal module and should not be used.
+//
+// Soft timers are kept in one of two interchangeable queues, selected at build time through the
+// SOFT_TIMER make variable (see ms-common/rules.mk):
+// * list: Doubly linked list sorted in order of expiry. O(1) cancel and expire, but O(n)
+//         insertion since we need to walk the list to find where the timer belongs.
+// * wheel: Hierarchical timing wheel. O(1) insertion, cancel and expire.
+//
+// The wheel is the default. test_soft_timer_queue benchmarks both - the wheel's cost per expiry
+// stays flat as timers are added, while the list's grows with every timer it has to walk past.
+//
+// Both queues operate on an external array of nodes and refer to them by index. The owner of the
+// array sets a node's expiry before inserting it. Times are absolute and in microseconds.
+//
+// The timing wheel consists of SOFT_TIMER_WHEEL_NUM_LEVELS levels, each with
+// SOFT_TIMER_WHEEL_NUM_SLOTS slots. Level n covers bits [n * SLOT_BITS, (n + 1) * SLOT_BITS) of
+// the expiry time. A node is placed in the level of the most significant bit that differs between
+// its expiry and the wheel's current time, in the slot given by its expiry's digit for that level.
+// Thus, every node in a level shares its upper digits with the current time and lands in a slot
+// after the current one, so the earliest slot of the lowest occupied level always holds the next
+// node to expire. The wheel caches that node's expiry and jumps straight to it - all lower levels
+// are empty, so its slot is the only one passed. The nodes of a passed slot are redistributed into
+// lower levels until they expire. Each node moves at most once per level, so the cost is amortized
+// O(1), and the wheel never needs to be serviced between expiries.
+//
+// Nodes that cross a boundary of the top level (i.e. differ above the bits covered by the wheel)
+// are kept in an overflow list that is redistributed when the wheel reaches that boundary.
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SOFT_TIMER_NODE_INVALID UINT16_MAX
+
+// 32 slots per level lets us use a single 32-bit occupancy bitmask per level.
+#define SOFT_TIMER_WHEEL_SLOT_BITS 5
+#define SOFT_TIMER_WHEEL_NUM_SLOTS (1 << SOFT_TIMER_WHEEL_SLOT_BITS)
+// Enough levels to cover 2^35 us so any 32-bit duration overflows at most once.
+#define SOFT_TIMER_WHEEL_NUM_LEVELS 7
+
+typedef struct SoftTimerNode {
+  uint64_t expiry_us;
+  uint16_t next;
+  uint16_t prev;
+  // Used by the wheel to locate the list the node is in
+  uint8_t level;
+  uint8_t slot;
+} SoftTimerNode;
+
+typedef struct SoftTimerList {
+  SoftTimerNode *nodes;
+  uint16_t head;
+} SoftTimerList;
+
+typedef struct SoftTimerWheel {
+  SoftTimerNode *nodes;
+  uint64_t time_us;
+  uint32_t occupied[SOFT_TIMER_WHEEL_NUM_LEVELS];
+  uint16_t slots[SOFT_TIMER_WHEEL_NUM_LEVELS][SOFT_TIMER_WHEEL_NUM_SLOTS];
+  uint16_t overflow;
+  // Earliest expiry of any node in a slot or the overflow list, or UINT64_MAX if there are none
+  uint64_t next_expiry_us;
+  uint16_t expired_head;
+  uint16_t expired_tail;
+} SoftTimerWheel;
+
+// Initializes an empty list.
+void soft_timer_list_init(SoftTimerList *list, SoftTimerNode *nodes, uint64_t now_us);
+
+// Inserts the node in order of expiry.
+void soft_timer_list_insert(SoftTimerList *list, uint16_t node_id, uint64_t now_us);
+
+// Removes a node currently in the list.
+void soft_timer_list_remove(SoftTimerList *list, uint16_t node_id);
+
+// Returns the expiry of the head of the list if the list is not empty.
+bool soft_timer_list_next_event(const SoftTimerList *list, uint64_t *time_us);
+
+// Removes and returns the next node that has expired by |now_us|, or SOFT_TIMER_NODE_INVALID.
+uint16_t soft_timer_list_pop_expired(SoftTimerList *list, uint64_t now_us);
+
+// Initializes an empty wheel starting at |now_us|.
+void soft_timer_wheel_init(SoftTimerWheel *wheel, SoftTimerNode *nodes, uint64_t now_us);
+
+// Schedules the node. |now_us| is used to bring the wheel up to date first.
+void soft_timer_wheel_insert(SoftTimerWheel *wheel, uint16_t node_id, uint64_t now_us);
+
+// Removes a node currently in the wheel.
+void soft_timer_wheel_remove(SoftTimerWheel *wheel, uint16_t node_id);
+
+// Returns the earliest expiry of the nodes in the wheel if it is not empty.
+bool soft_timer_wheel_next_event(const SoftTimerWheel *wheel, uint64_t *time_us);
+
+// Advances the wheel to |now_us|, then removes and returns the next node that has expired, or
+// SOFT_TIMER_NODE_INVALID. Expired nodes are returned in order of expiry.
+uint16_t soft_timer_wheel_pop_expired(SoftTimerWheel *wheel, uint64_t now_us);
+
+// Selects the backend used by soft_timer.c.
+#if defined(SOFT_TIMER_BACKEND_LIST)
+typedef SoftTimerList SoftTimerQueue;
+#define soft_timer_queue_init soft_timer_list_init
+#define soft_timer_queue_insert soft_timer_list_insert
+#define soft_timer_queue_remove soft_timer_list_remove
+#define soft_timer_queue_next_event soft_timer_list_next_event
+#define soft_timer_queue_pop_expired soft_timer_list_pop_expired
+#else
+typedef SoftTimerWheel SoftTimerQueue;
+#define soft_timer_queue_init soft_timer_wheel_init
+#define soft_timer_queue_insert soft_timer_wheel_insert
+#define soft_timer_queue_remove soft_timer_wheel_remove
+#define soft_timer_queue_next_event soft_timer_wheel_next_event
+#define soft_timer_queue_pop_expired soft_timer_wheel_pop_expired
+#endif
@@ -0,0 +1,124 @@
+#pragma once
+// Single-producer, single-consumer ring buffer
+//
+// A lock-free alternative to Fifo for handing data from one ISR to the main loop (or vice versa).
+// Exactly one context may push and exactly one context may pop, so no critical sections are
+// needed. Anything with multiple producers, such as the event queue, must keep using Fifo.
+//
+// Rings are generated per element type, so copies are fixed size and indexing is a mask:
+//   SPSC_RING_DEFINE(CanRxRing, can_rx_ring, CanMessage, 32)
+// defines the CanRxRing type and can_rx_ring_{init,push,pop,peek,pop_arr,size}().
+// The capacity must be a power of two.
+//
+// Elements can also be used in place: the producer fills the slot from claim() and publishes it
+// with commit(), and the consumer reads the slot from peek_ptr() and releases it with pop().
+//
+// |head| is only written by the consumer and |tail| by the producer. Both are free-running, so the
+// ring holds |tail - head| elements. Each side publishes its index with a release store after
+// touching the element and reads the other side's index with an acquire load. These are plain
+// aligned word loads and stores with barriers, which is all the Cortex-M0 can do atomically.
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "status.h"
+
+#define SPSC_RING_DEFINE(type, prefix, elem_type, capacity)                            \
+  _Static_assert((capacity) > 0 && ((capacity) & ((capacity)-1)) == 0,                 \
+                 #type " capacity must be a power of two");                            \
+                                                                                       \
+  typedef struct type {                                                                \
+    uint32_t head;                                                                     \
+    uint32_t tail;                                                                     \
+    elem_type elems[(capacity)]; /* NOLINT(runtime/arrays) */                          \
+  } type;                                                                              \
+                                                                                       \
+  static inline void prefix##_init(type *ring) {                                       \
+    memset(ring, 0, sizeof(*ring));                                                    \
+  }                                                                                    \
+                                                                                       \
+  static inline size_t prefix##_size(type *ring) {                                     \
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);                    \
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);                    \
+    return (size_t)(tail - head);                                                      \
+  }                                                                                    \
+                                                                                       \
+  /* Producer only */                                                                  \
+  static inline StatusCode prefix##_push(type *ring, const elem_type *elem) {          \
+    uint32_t tail = ring->tail;                                                        \
+    if (tail - __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) == (capacity)) {         \
+      return status_code(STATUS_CODE_RESOURCE_EXHAUSTED);                              \
+    }                                                                                  \
+                                                                                       \
+    ring->elems[tail & ((capacity)-1)] = *elem;                                        \
+    __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);                         \
+    return STATUS_CODE_OK;                                                             \
+  }                                                                                    \
+                                                                                       \
+  /* Producer only - returns the next slot to fill, or NULL if full */                  \
+  static inline elem_type *prefix##_claim(type *ring) {                                \
+    uint32_t tail = ring->tail;                                                        \
+    if (tail - __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) == (capacity)) {         \
+      return NULL;                                                                     \
+    }                                                                                  \
+    return &ring->elems[tail & ((capacity)-1)];                                        \
+  }                                                                                    \
+                                                                                       \
+  /* Producer only - publishes the slot returned by claim() */                         \
+  static inline void prefix##_commit(type *ring) {                                     \
+    __atomic_store_n(&ring->tail, ring->tail + 1, __ATOMIC_RELEASE);                   \
+  }                                                                                    \
+                                                                                       \
+  /* Consumer only - returns the oldest element in place, or NULL if empty */          \
+  static inline elem_type *prefix##_peek_ptr(type *ring) {                             \
+    uint32_t head = ring->head;                                                        \
+    if (__atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) == head) {                      \
+      return NULL;                                                                     \
+    }                                                                                  \
+    return &ring->elems[head & ((capacity)-1)];                                        \
+  }                                                                                    \
+                                                                                       \
+  /* Consumer only - |elem| may be NULL to discard */                                  \
+  static inline StatusCode prefix##_peek(type *ring, elem_type *elem) {                \
+    uint32_t head = ring->head;                                                        \
+    if (__atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) == head) {                      \
+      return status_code(STATUS_CODE_RESOURCE_EXHAUSTED);                              \
+    }                                                                                  \
+                                                                                       \
+    if (elem != NULL) {                                                                \
+      *elem = ring->elems[head & ((capacity)-1)];                                      \
+    }                                                                                  \
+    return STATUS_CODE_OK;                                                             \
+  }                                                                                    \
+                                                                                       \
+  /* Consumer only - |elem| may be NULL to discard */                                  \
+  static inline StatusCode prefix##_pop(type *ring, elem_type *elem) {                 \
+    uint32_t head = ring->head;                                                        \
+    if (__atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) == head) {                      \
+      return status_code(STATUS_CODE_RESOURCE_EXHAUSTED);                              \
+    }                                                                                  \
+                                                                                       \
+    if (elem != NULL) {                                                                \
+      *elem = ring->elems[head & ((capacity)-1)];                                      \
+    }                                                                                  \
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);                         \
+    return STATUS_CODE_OK;                                                             \
+  }                                                                                    \
+                                                                                       \
+  /* Consumer only - pops |len| elements or nothing. |dest| may be NULL to discard */  \
+  static inline StatusCode prefix##_pop_arr(type *ring, elem_type *dest, size_t len) { \
+    uint32_t head = ring->head;                                                        \
+    if ((size_t)(__atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) - head) < len) {       \
+      return status_code(STATUS_CODE_RESOURCE_EXHAUSTED);                              \
+    }                                                                                  \
+                                                                                       \
+    if (dest != NULL) {                                                                \
+      size_t start = head & ((capacity)-1);                                            \
+      size_t first = ((capacity)-start < len) ? (capacity)-start : len;                \
+      memcpy(dest, &ring->elems[start], first * sizeof(elem_type));                    \
+      memcpy(dest + first, &ring->elems[0], (len - first) * sizeof(elem_type));        \
+    }                                                                                  \
+    __atomic_store_n(&ring->head, head + (uint32_t)len, __ATOMIC_RELEASE);             \
+    return STATUS_CODE_OK;                                                             \
+  }
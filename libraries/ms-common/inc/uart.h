@@ -6,11 +6,15 @@
 #include <stdint.h>
 #include "fifo.h"
 #include "gpio.h"
+#include "spsc_ring.h"
 #include "status.h"
 #include "uart_mcu.h"
 
 #define UART_MAX_BUFFER_LEN 512
 
+// RX is only touched from the UART ISR
+SPSC_RING_DEFINE(UartRxRing, uart_rx_ring, uint8_t, UART_MAX_BUFFER_LEN)
+
 typedef void (*UartRxHandler)(const uint8_t *rx_arr, size_t len, void *context);
 
 typedef struct {
@@ -19,8 +23,7 @@ typedef struct {
 
   volatile Fifo tx_fifo;
   volatile uint8_t tx_buf[UART_MAX_BUFFER_LEN];
-  volatile Fifo rx_fifo;
-  volatile uint8_t rx_buf[UART_MAX_BUFFER_LEN];
+  UartRxRing rx_ring;
 
   uint8_t rx_line_buf[UART_MAX_BUFFER_LEN + 1];
   char delimiter;
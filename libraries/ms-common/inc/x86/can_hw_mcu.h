@@ -0,0 +1,50 @@
+#pragma once
+// x86-only CAN HW extensions
+//
+// x86 supports several CAN interfaces at once, each with its own threads, TX queue and filters.
+// The can_hw_*() API uses the default instance, which is bound to the interface named by
+// MIDSUN_X86_CAN_INTERFACE (vcan0 if unset). Other interfaces are opened by name with
+// can_hw_open(), so one process can sit on several buses. With X86_INTERRUPT=sched, each instance
+// is a separate in-process virtual bus.
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "can_hw.h"
+#include "status.h"
+
+#define CAN_HW_MAX_INSTANCES 4
+
+typedef struct CanHwInstance CanHwInstance;
+
+// Opens |interface|, or reinitializes it if it's already open. NULL selects the default instance.
+StatusCode can_hw_open(CanHwInstance **instance, const char *interface,
+                       const CanHwSettings *settings);
+
+StatusCode can_hw_instance_register_callback(CanHwInstance *instance, CanHwEvent event,
+                                             CanHwEventHandlerCb callback, void *context);
+
+StatusCode can_hw_instance_add_filter(CanHwInstance *instance, uint32_t mask, uint32_t filter,
+                                      bool extended);
+
+StatusCode can_hw_instance_set_filters(CanHwInstance *instance, const CanHwFilter *filters,
+                                       size_t num_filters);
+
+CanHwBusStatus can_hw_instance_bus_status(CanHwInstance *instance);
+
+void can_hw_instance_get_error_counters(CanHwInstance *instance, uint8_t *tx_errors,
+                                        uint8_t *rx_errors);
+
+StatusCode can_hw_instance_transmit(CanHwInstance *instance, uint32_t id, bool extended,
+                                    const uint8_t *data, size_t len);
+
+// Must be called within the instance's RX handler, returns whether a message was processed
+bool can_hw_instance_receive(CanHwInstance *instance, uint32_t *id, bool *extended, uint64_t *data,
+                             size_t *len);
+
+// Returns when the frame last returned by can_hw_instance_receive() was received, in ns.
+// SocketCAN uses kernel RX timestamps (CLOCK_REALTIME) and the virtual bus uses virtual time.
+uint64_t can_hw_instance_get_rx_timestamp_ns(CanHwInstance *instance);
+
+// can_hw_instance_get_rx_timestamp_ns() for the default instance
+uint64_t can_hw_get_rx_timestamp_ns(void);
@@ -7,6 +7,57 @@
 
 $(T)_DEPS := $(PLATFORM_LIB) libcore
 
+# Soft timer queue - see soft_timer_queue.h
+SOFT_TIMER ?= wheel
+VALID_SOFT_TIMERS := wheel list
+ifeq (,$(filter $(VALID_SOFT_TIMERS),$(SOFT_TIMER)))
+  $(error Invalid soft timer queue. Expected: $(VALID_SOFT_TIMERS))
+endif
+
+ifeq (list,$(SOFT_TIMER))
+$(T)_CFLAGS += -DSOFT_TIMER_BACKEND_LIST
+endif
+
+# FSM dispatch - see fsm.h
+FSM ?= table
+VALID_FSMS := table func
+ifeq (,$(filter $(VALID_FSMS),$(FSM)))
+  $(error Invalid FSM dispatch. Expected: $(VALID_FSMS))
+endif
+
+ifeq (func,$(FSM))
+$(T)_CFLAGS += -DFSM_BACKEND_FUNC
+endif
+
+# Transitions shared by all FSM tables - raise if fsm_init() runs out
+FSM_MAX_TRANSITIONS ?= 128
+$(T)_CFLAGS += -DFSM_MAX_TRANSITIONS=$(FSM_MAX_TRANSITIONS)
+
+# CAN stats summary broadcast - disabled unless a message ID is given, see can.h
+CAN_STATS_PERIOD_MS ?= 1000
+ifneq (,$(CAN_STATS_MSG_ID))
+$(T)_CFLAGS += -DCAN_STATS_MSG_ID=$(CAN_STATS_MSG_ID) -DCAN_STATS_PERIOD_MS=$(CAN_STATS_PERIOD_MS)
+endif
+
+ifneq (sched,$(X86_INTERRUPT))
+$(T)_EXCLUDE_TESTS := virtual_time
+endif
+
+$(T)_test_can_publish_MOCKS := can_transmit
+
+# Multiple CAN interfaces are only supported on x86 - see can_hw_mcu.h
+ifneq (x86,$(PLATFORM))
+$(T)_EXCLUDE_TESTS += can_hw_instance
+endif
+
 ifeq (x86,$(PLATFORM))
-$(T)_EXCLUDE_TESTS := adc pwm pwm_input
+$(T)_EXCLUDE_TESTS += adc pwm pwm_input
+
+# The scheduler runs in virtual time, so CAN uses an in-process bus instead of SocketCAN
+$(T)_SRC := $(wildcard $($(T)_SRC_ROOT)/*.c) $(wildcard $($(T)_SRC_ROOT)/$(PLATFORM)/*.c)
+ifeq (sched,$(X86_INTERRUPT))
+$(T)_SRC := $(filter-out %/x86/can_hw.c,$($(T)_SRC))
+else
+$(T)_SRC := $(filter-out %/x86/can_hw_virtual.c,$($(T)_SRC))
+endif
 endif
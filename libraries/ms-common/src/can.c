@@ -1,18 +1,25 @@
 // Basically, this module glues all the components of CAN together.
 //
 // It hooks into the CAN HW callbacks:
-// - TX ready: Used to re-raise potentially discarded TX events. We assume that if there are
-//             elements in the TX FIFO, we have a backlog that has resulted in discarded events.
+// - TX ready: A mailbox has freed up. If there are still messages in the TX queue and no TX event
+//             is pending, we raise one. Each TX event fills as many mailboxes as possible
+//             (can_fsm), so bursts only cost a single event.
 // - Message RX: When the message RX callback runs, we just push the message into a queue and
 //               raise an event. When that event is processed in the main loop
 //               (can_fsm_process_event), we find the associated callback and run it.
 //               In the case of an ACK, we update the associated pending ACK request.
 // - Bus error: In case of a bus error, we set a timer and wait to see if the bus has recovered
 //              after the timeout. If it's still down, we raise an event.
+//
+// Each hook also feeds can_stats, along with can_fsm as frames are sent and handled.
+//
+// Filters are replanned from every subscribed message ID whenever one is added (can_filter), so
+// related IDs share hardware filters instead of running out of filter banks.
 #include "can.h"
 #include <string.h>
 #include "can_fsm.h"
 #include "can_hw.h"
+#include "critical_section.h"
 #include "log.h"
 #include "soft_timer.h"
 
@@ -21,14 +28,20 @@
 // Attempts to transmit the specified message using the HW TX, overwriting the source device.
 StatusCode prv_transmit(const CanMessage *msg);
 
+// Raises a TX event if there isn't one pending already
+static void prv_raise_tx(CanStorage *can_storage);
+
 // Handler for CAN HW TX ready events
-// Re-raises potentially discarded TX events
+// Raises a TX event if there's a backlog
 void prv_tx_handler(void *context);
 
 // Handler for CAN HW messaged RX events
 // Dumps received messages to the RX queue and raises an event for the messages to be processed.
 void prv_rx_handler(void *context);
 
+// Stats broadcast timer callback
+static void prv_stats_broadcast(SoftTimerId timer_id, void *context);
+
 // Bus error timer callback
 // Checks if the bus has recovered, raising the fault event if still off
 void prv_bus_error_timeout_handler(SoftTimerId timer_id, void *context);
@@ -49,12 +62,15 @@ StatusCode can_init(CanStorage *storage, const CanSettings *settings) {
   storage->tx_event = settings->tx_event;
   storage->fault_event = settings->fault_event;
   storage->device_id = settings->device_id;
+  storage->msg_schema = settings->msg_schema;
 
   s_can_storage = storage;
 
   status_ok_or_return(can_fsm_init(&s_can_storage->fsm, s_can_storage));
-  status_ok_or_return(can_fifo_init(&s_can_storage->tx_fifo));
-  status_ok_or_return(can_fifo_init(&s_can_storage->rx_fifo));
+  status_ok_or_return(can_queue_init(&s_can_storage->tx_queue));
+  can_rx_ring_init(&s_can_storage->rx_ring);
+  can_stats_init(&s_can_storage->stats, settings->bitrate, (uint32_t)soft_timer_get_time());
+  s_can_storage->stats_timer = SOFT_TIMER_INVALID_TIMER;
   status_ok_or_return(can_ack_init(&s_can_storage->ack_requests));
   status_ok_or_return(can_rx_init(&s_can_storage->rx_handlers, s_can_storage->rx_handler_storage,
                                   SIZEOF_ARRAY(s_can_storage->rx_handler_storage)));
@@ -71,6 +87,10 @@ StatusCode can_init(CanStorage *storage, const CanSettings *settings) {
   can_hw_register_callback(CAN_HW_EVENT_MSG_RX, prv_rx_handler, s_can_storage);
   can_hw_register_callback(CAN_HW_EVENT_BUS_ERROR, prv_bus_error_handler, s_can_storage);
 
+#ifdef CAN_STATS_MSG_ID
+  status_ok_or_return(can_start_stats_broadcast(CAN_STATS_MSG_ID, CAN_STATS_PERIOD_MS));
+#endif
+
   return STATUS_CODE_OK;
 }
 
@@ -81,11 +101,30 @@ StatusCode can_add_filter(CanMessageId msg_id) {
     return status_msg(STATUS_CODE_INVALID_ARGS, "CAN: Invalid message ID");
   }
 
-  CanId can_id = { .msg_id = msg_id };
-  CanId mask = { 0 };
-  mask.msg_id = ~mask.msg_id;
+  for (size_t i = 0; i < s_can_storage->num_filter_ids; i++) {
+    if (s_can_storage->filter_ids[i] == msg_id) {
+      return STATUS_CODE_OK;
+    }
+  }
+  s_can_storage->filter_ids[s_can_storage->num_filter_ids++] = msg_id;
+
+  CanFilterPlan *plan = &s_can_storage->filter_plan;
+  status_ok_or_return(can_filter_plan(s_can_storage->filter_ids, s_can_storage->num_filter_ids,
+                                      CAN_HW_NUM_FILTER_BANKS, plan));
 
-  return can_hw_add_filter(can_id.raw, mask.raw, false);
+  return can_hw_set_filters(plan->filters, plan->num_filters);
+}
+
+StatusCode can_get_filter_plan(CanFilterPlan *plan) {
+  if (s_can_storage == NULL) {
+    return status_code(STATUS_CODE_UNINITIALIZED);
+  } else if (plan == NULL) {
+    return status_code(STATUS_CODE_INVALID_ARGS);
+  }
+
+  *plan = s_can_storage->filter_plan;
+
+  return STATUS_CODE_OK;
 }
 
 StatusCode can_register_rx_default_handler(CanRxHandlerCb handler, void *context) {
@@ -120,11 +159,62 @@ StatusCode can_transmit(const CanMessage *msg, const CanAckRequest *ack_request)
     status_ok_or_return(ret);
   }
 
+  CanTxEntry entry = {
+    .msg = *msg,                                   //
+    .queued_us = (uint32_t)soft_timer_get_time(),  //
+  };
+  // We transmit from both the main loop and interrupts, so update the stats atomically
+  bool disabled = critical_section_start();
+  StatusCode ret = can_queue_push(&s_can_storage->tx_queue, &entry);
+  if (ret != STATUS_CODE_OK) {
+    s_can_storage->stats.tx_dropped++;
+  } else {
+    size_t depth = can_queue_size(&s_can_storage->tx_queue);
+    if (depth > s_can_storage->stats.tx_queue_high_water) {
+      s_can_storage->stats.tx_queue_high_water = depth;
+    }
+  }
+  critical_section_end(disabled);
+
+  if (ret != STATUS_CODE_OK) {
+    return status_msg(STATUS_CODE_RESOURCE_EXHAUSTED, "CAN: TX queue full");
+  }
+
   // Basically, the idea is that all the TX and RX should be happening in the main event loop.
   // We raise an event just to ensure that the CAN TX is postponed until the main event loop.
-  event_raise(s_can_storage->tx_event, 1);
+  // The message must be queued first - the TX handler clears the flag before draining the queue.
+  prv_raise_tx(s_can_storage);
 
-  return can_fifo_push(&s_can_storage->tx_fifo, msg);
+  return STATUS_CODE_OK;
+}
+
+StatusCode can_get_stats(CanStats *stats) {
+  if (s_can_storage == NULL) {
+    return status_code(STATUS_CODE_UNINITIALIZED);
+  } else if (stats == NULL) {
+    return status_code(STATUS_CODE_INVALID_ARGS);
+  }
+
+  // Bring the bus load up to date in case the bus has been quiet
+  can_stats_bus_load(&s_can_storage->stats, (uint32_t)soft_timer_get_time());
+  *stats = s_can_storage->stats;
+  stats->tx_queue_depth = can_queue_size(&s_can_storage->tx_queue);
+  can_hw_get_error_counters(&stats->tx_error_count, &stats->rx_error_count);
+
+  return STATUS_CODE_OK;
+}
+
+StatusCode can_start_stats_broadcast(CanMessageId msg_id, uint32_t period_ms) {
+  if (s_can_storage == NULL) {
+    return status_code(STATUS_CODE_UNINITIALIZED);
+  } else if (msg_id >= CAN_MSG_MAX_IDS) {
+    return status_msg(STATUS_CODE_INVALID_ARGS, "CAN: Invalid message ID");
+  }
+
+  soft_timer_cancel(s_can_storage->stats_timer);
+  s_can_storage->stats_msg_id = msg_id;
+  return soft_timer_start_periodic_millis(period_ms, prv_stats_broadcast, s_can_storage,
+                                          &s_can_storage->stats_timer);
 }
 
 bool can_process_event(const Event *e) {
@@ -136,40 +226,61 @@ bool can_process_event(const Event *e) {
   return fsm_process_event(&s_can_storage->fsm, e);
 }
 
+static void prv_raise_tx(CanStorage *can_storage) {
+  // Racing with the TX ready interrupt can raise an extra event, which just finds an empty queue
+  if (!can_storage->tx_pending) {
+    can_storage->tx_pending = true;
+    if (event_raise(can_storage->tx_event, 1) != STATUS_CODE_OK) {
+      // Let the next transmit or TX ready interrupt try again
+      can_storage->tx_pending = false;
+    }
+  }
+}
+
 void prv_tx_handler(void *context) {
   CanStorage *can_storage = context;
-  CanMessage tx_msg;
 
-  // If we failed to TX some messages or aren't transmitting fast enough, those events
-  // were discarded. Raise a TX event to trigger a transmit attempt.
-  // We only raise one event since TX ready interrupts are 1-to-1.
-  if (can_fifo_size(&can_storage->tx_fifo) > 0) {
-    event_raise(can_storage->tx_event, 0);
+  // The last pass ran out of mailboxes - now that one is free, service the backlog.
+  if (can_queue_size(&can_storage->tx_queue) > 0) {
+    prv_raise_tx(can_storage);
   }
 }
 
 // The RX ISR will fire once for each received message
 // Each event will result in one message's processing.
+// Messages are received straight into the RX ring, so they're never copied.
 void prv_rx_handler(void *context) {
   CanStorage *can_storage = context;
   uint32_t rx_id = 0;
-  CanMessage rx_msg = { 0 };
-  size_t counter = 0;
-
+  size_t dlc = 0;
   bool extended = false;
-  while (can_hw_receive(&rx_id, &extended, &rx_msg.data, &rx_msg.dlc)) {
-    if (extended) {
-      // We don't handle extended messages in the network layer
-      continue;
+  CanMessage overflow_msg = { 0 };
+  uint32_t now_us = (uint32_t)soft_timer_get_time();
+
+  while (true) {
+    // If the ring is full, we still read the message out so the hardware doesn't stall
+    CanMessage *rx_msg = can_rx_ring_claim(&can_storage->rx_ring);
+    bool overflow = (rx_msg == NULL);
+    if (overflow) {
+      rx_msg = &overflow_msg;
     }
-    CAN_MSG_SET_RAW_ID(&rx_msg, rx_id);
 
-    StatusCode result = can_fifo_push(&can_storage->rx_fifo, &rx_msg);
-    // TODO(ELEC-251): add error handling for FSMs
-    if (result != STATUS_CODE_OK) {
+    if (!can_hw_receive(&rx_id, &extended, &rx_msg->data, &dlc)) {
       return;
     }
 
+    if (overflow) {
+      can_storage->stats.rx_dropped++;
+      continue;
+    } else if (extended) {
+      // We don't handle extended messages in the network layer - reuse the slot
+      continue;
+    }
+    CAN_MSG_SET_RAW_ID(rx_msg, rx_id);
+    rx_msg->dlc = (uint8_t)dlc;
+    can_storage->rx_times_us[rx_msg - can_storage->rx_ring.elems] = now_us;
+
+    can_rx_ring_commit(&can_storage->rx_ring);
     event_raise(can_storage->rx_event, 1);
   }
 }
@@ -185,8 +296,18 @@ void prv_bus_error_timeout_handler(SoftTimerId timer_id, void *context) {
   }
 }
 
+static void prv_stats_broadcast(SoftTimerId timer_id, void *context) {
+  CanStorage *can_storage = context;
+  CanMessage msg = { .msg_id = can_storage->stats_msg_id };
+
+  can_stats_pack_summary(&can_storage->stats, (uint32_t)soft_timer_get_time(), &msg);
+  // A full TX queue is already counted as a drop
+  can_transmit(&msg, NULL);
+}
+
 void prv_bus_error_handler(void *context) {
   CanStorage *can_storage = context;
+  can_storage->stats.bus_errors++;
 
   soft_timer_start_millis(CAN_BUS_OFF_RECOVERY_TIME_MS, prv_bus_error_timeout_handler, can_storage,
                           NULL);
@@ -1,16 +1,72 @@
-// Uses an object pool to track the storage for ack requests, but the actual requests are handled
-// through an array of request pointers to minimize copying
-// ACK requests currently ordered as they were created
+// Uses an object pool to track the storage for ack requests. Pending requests are kept in a doubly
+// linked FIFO per message ID (by pool index), ordered as they were created.
 #include "can_ack.h"
 #include <string.h>
 
-static StatusCode prv_update_req(CanAckRequests *requests, CanMessageId msg_id,
-                                 SoftTimerId timer_id, CanAckStatus status, uint16_t device);
+#define CAN_ACK_INVALID_INDEX UINT8_MAX
+
+static StatusCode prv_update_req(CanAckRequests *requests, uint8_t index, CanAckStatus status,
+                                 uint16_t device);
 
 static void prv_timeout_cb(SoftTimerId timer_id, void *context);
 
+static void prv_link(CanAckRequests *requests, uint8_t index) {
+  CanAckPendingReq *req = &requests->request_nodes[index];
+  uint8_t tail = requests->id_tail[req->msg_id];
+
+  req->prev = tail;
+  req->next = CAN_ACK_INVALID_INDEX;
+  if (tail == CAN_ACK_INVALID_INDEX) {
+    requests->id_head[req->msg_id] = index;
+  } else {
+    requests->request_nodes[tail].next = index;
+  }
+  requests->id_tail[req->msg_id] = index;
+}
+
+static void prv_unlink(CanAckRequests *requests, uint8_t index) {
+  CanAckPendingReq *req = &requests->request_nodes[index];
+
+  if (req->prev == CAN_ACK_INVALID_INDEX) {
+    requests->id_head[req->msg_id] = req->next;
+  } else {
+    requests->request_nodes[req->prev].next = req->next;
+  }
+
+  if (req->next == CAN_ACK_INVALID_INDEX) {
+    requests->id_tail[req->msg_id] = req->prev;
+  } else {
+    requests->request_nodes[req->next].prev = req->prev;
+  }
+}
+
+static void prv_record_rtt(CanAckRequests *requests, const CanAckPendingReq *req) {
+  if (req->msg_id >= CAN_MSG_NUM_CRITICAL_IDS) {
+    return;
+  }
+
+  CanAckRttHistogram *histogram = &requests->rtt[req->msg_id];
+  uint32_t rtt_us = (uint32_t)soft_timer_get_time() - req->sent_us;
+  if (rtt_us > histogram->max_us) {
+    histogram->max_us = rtt_us;
+  }
+
+  // Bucket n (n > 0) holds [BASE << (n - 1), BASE << n)
+  uint32_t scaled = rtt_us / CAN_ACK_RTT_BASE_US;
+  size_t bucket = (scaled == 0) ? 0 : (size_t)(32 - __builtin_clz(scaled));
+  if (bucket >= CAN_ACK_RTT_NUM_BUCKETS) {
+    bucket = CAN_ACK_RTT_NUM_BUCKETS - 1;
+  }
+  if (histogram->buckets[bucket] < UINT16_MAX) {
+    histogram->buckets[bucket]++;
+  }
+}
+
 StatusCode can_ack_init(CanAckRequests *requests) {
   memset(requests, 0, sizeof(*requests));
+  memset(requests->id_head, CAN_ACK_INVALID_INDEX, sizeof(requests->id_head));
+  memset(requests->id_tail, CAN_ACK_INVALID_INDEX, sizeof(requests->id_tail));
+  memset(requests->timer_requests, CAN_ACK_INVALID_INDEX, sizeof(requests->timer_requests));
 
   requests->num_requests = 0;
 
@@ -19,7 +75,7 @@ StatusCode can_ack_init(CanAckRequests *requests) {
 
 StatusCode can_ack_add_request(CanAckRequests *requests, CanMessageId msg_id,
                                const CanAckRequest *ack_request) {
-  if (ack_request == NULL || ack_request->expected_bitset == 0) {
+  if (ack_request == NULL || ack_request->expected_bitset == 0 || msg_id >= CAN_MSG_MAX_IDS) {
     return status_code(STATUS_CODE_INVALID_ARGS);
   }
 
@@ -33,6 +89,7 @@ StatusCode can_ack_add_request(CanAckRequests *requests, CanMessageId msg_id,
   pending_ack->expected_bitset = ack_request->expected_bitset;
   pending_ack->callback = ack_request->callback;
   pending_ack->context = ack_request->context;
+  pending_ack->sent_us = (uint32_t)soft_timer_get_time();
   StatusCode ret =
       soft_timer_start_millis(CAN_ACK_TIMEOUT_MS, prv_timeout_cb, requests, &pending_ack->timer);
 
@@ -41,46 +98,54 @@ StatusCode can_ack_add_request(CanAckRequests *requests, CanMessageId msg_id,
     return ret;
   }
 
-  requests->active_requests[requests->num_requests++] = pending_ack;
+  uint8_t index = (uint8_t)(pending_ack - requests->request_nodes);
+  requests->timer_requests[pending_ack->timer] = index;
+  prv_link(requests, index);
+  requests->num_requests++;
 
   return STATUS_CODE_OK;
 }
 
 StatusCode can_ack_handle_msg(CanAckRequests *requests, const CanMessage *msg) {
-  return prv_update_req(requests, msg->msg_id, SOFT_TIMER_INVALID_TIMER, msg->data, msg->source_id);
-}
+  if (msg->msg_id >= CAN_MSG_MAX_IDS) {
+    return status_code(STATUS_CODE_UNKNOWN);
+  }
 
-static StatusCode prv_update_req(CanAckRequests *requests, CanMessageId msg_id,
-                                 SoftTimerId timer_id, CanAckStatus status, uint16_t device) {
-  CanAckPendingReq *found_request = NULL;
-  size_t index = 0;
-
-  // Requests should be in the order that they were made, and there's a higher
-  // chance that requests made first will be serviced first. In the case where we're
-  // searching for a message ID, we'd like to pick the ACK request closest to expiry,
-  // which should be the first one we encounter because we keep them in the order they were made.
-
-  // Essentially checks if an ACK has been received from the device already and
-  // * The message ID matches given an invalid timer
-  // * The timer ID matches given an invalid message ID
-  // * Both message and timer match given valid values for both
-  for (index = 0; index < requests->num_requests; index++) {
-    CanAckPendingReq *req = requests->active_requests[index];
-    if (((req->msg_id == msg_id && timer_id == SOFT_TIMER_INVALID_TIMER) ||
-         (req->timer == timer_id && msg_id == CAN_MSG_INVALID_ID) ||
-         (req->msg_id == msg_id && req->timer == timer_id)) &&
-        (device == CAN_MSG_INVALID_DEVICE ||
-         ((req->response_bitset & ((uint32_t)1 << device)) == 0 &&
-          (req->expected_bitset & ((uint32_t)1 << device)) != 0))) {
-      found_request = req;
-      break;
+  // Requests are in the order that they were made, and there's a higher chance that requests made
+  // first will be serviced first. We'd like to pick the ACK request closest to expiry that is still
+  // waiting on this device, which should be the first one we encounter.
+  if (msg->source_id >= CAN_MSG_MAX_DEVICES) {
+    return status_code(STATUS_CODE_UNKNOWN);
+  }
+
+  uint32_t device_bit = (uint32_t)1 << msg->source_id;
+  uint8_t index = requests->id_head[msg->msg_id];
+  while (index != CAN_ACK_INVALID_INDEX) {
+    const CanAckPendingReq *req = &requests->request_nodes[index];
+    if ((req->response_bitset & device_bit) == 0 && (req->expected_bitset & device_bit) != 0) {
+      return prv_update_req(requests, index, msg->data, msg->source_id);
     }
+    index = req->next;
   }
 
-  if (found_request == NULL) {
-    return status_code(STATUS_CODE_UNKNOWN);
+  return status_code(STATUS_CODE_UNKNOWN);
+}
+
+StatusCode can_ack_get_rtt_histogram(const CanAckRequests *requests, CanMessageId msg_id,
+                                     CanAckRttHistogram *histogram) {
+  if (msg_id >= CAN_MSG_NUM_CRITICAL_IDS || histogram == NULL) {
+    return status_code(STATUS_CODE_INVALID_ARGS);
   }
 
+  *histogram = requests->rtt[msg_id];
+
+  return STATUS_CODE_OK;
+}
+
+static StatusCode prv_update_req(CanAckRequests *requests, uint8_t index, CanAckStatus status,
+                                 uint16_t device) {
+  CanAckPendingReq *found_request = &requests->request_nodes[index];
+
   // We use a bitset to keep track of which devices we've received an ACK for this message from
   if (device != CAN_MSG_INVALID_DEVICE) {
     found_request->response_bitset |= ((uint32_t)1 << device);
@@ -103,22 +168,31 @@ static StatusCode prv_update_req(CanAckRequests *requests, CanMessageId msg_id,
     }
   }
 
+  if (status == CAN_ACK_STATUS_TIMEOUT) {
+    if (found_request->msg_id < CAN_MSG_NUM_CRITICAL_IDS &&
+        requests->rtt[found_request->msg_id].timeouts < UINT16_MAX) {
+      requests->rtt[found_request->msg_id].timeouts++;
+    }
+  } else if (device != CAN_MSG_INVALID_DEVICE &&
+             (found_request->response_bitset & ((uint32_t)1 << device))) {
+    prv_record_rtt(requests, found_request);
+  }
+
   // The response bitset should only ever be set by devices in the expected bitset, so we don't
   // need to mask the value here.
   if (found_request->response_bitset == found_request->expected_bitset ||
       status == CAN_ACK_STATUS_TIMEOUT) {
-    soft_timer_cancel(found_request->timer);
+    // On timeout, the timer has already expired
+    if (status != CAN_ACK_STATUS_TIMEOUT) {
+      soft_timer_cancel(found_request->timer);
+    }
+    requests->timer_requests[found_request->timer] = CAN_ACK_INVALID_INDEX;
+    prv_unlink(requests, index);
+
     StatusCode ret = objpool_free_node(&requests->pool, found_request);
     status_ok_or_return(ret);
 
     requests->num_requests--;
-    if (index != requests->num_requests) {
-      // Shift all requests to the left by 1
-      memmove(&requests->active_requests[index], &requests->active_requests[index + 1],
-              sizeof(requests->active_requests[0]) * (requests->num_requests - index));
-    }
-
-    requests->active_requests[requests->num_requests] = NULL;
   }
 
   return STATUS_CODE_OK;
@@ -127,6 +201,11 @@ static StatusCode prv_update_req(CanAckRequests *requests, CanMessageId msg_id,
 static void prv_timeout_cb(SoftTimerId timer_id, void *context) {
   CanAckRequests *requests = context;
 
-  prv_update_req(requests, CAN_MSG_INVALID_ID, timer_id, CAN_ACK_STATUS_TIMEOUT,
+  if (timer_id >= SOFT_TIMER_MAX_TIMERS ||
+      requests->timer_requests[timer_id] == CAN_ACK_INVALID_INDEX) {
+    return;
+  }
+
+  prv_update_req(requests, requests->timer_requests[timer_id], CAN_ACK_STATUS_TIMEOUT,
                  CAN_MSG_INVALID_DEVICE);
 }
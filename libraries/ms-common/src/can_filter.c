@@ -0,0 +1,147 @@
+#include "can_filter.h"
+#include <string.h>
+
+#define CAN_FILTER_ID_BITS 6
+#define CAN_FILTER_ID_MASK ((1 << CAN_FILTER_ID_BITS) - 1)
+
+_Static_assert(CAN_MSG_MAX_IDS == 64, "Message ID sets must fit in a uint64_t");
+
+// Filters are compared as sets of message IDs, where bit i is set if message ID i is in the set.
+// Entry b is the set of IDs with bit b set.
+static const uint64_t s_id_bit_sets[CAN_FILTER_ID_BITS] = {
+  0xAAAAAAAAAAAAAAAA, 0xCCCCCCCCCCCCCCCC, 0xF0F0F0F0F0F0F0F0,
+  0xFF00FF00FF00FF00, 0xFFFF0000FFFF0000, 0xFFFFFFFF00000000,
+};
+
+// Accepts message IDs where (id & mask) == value
+typedef struct CanFilterGroup {
+  uint8_t mask;
+  uint8_t value;
+} CanFilterGroup;
+
+static uint64_t prv_group_ids(CanFilterGroup group) {
+  uint64_t ids = UINT64_MAX;
+
+  for (size_t bit = 0; bit < CAN_FILTER_ID_BITS; bit++) {
+    if (group.mask & (1 << bit)) {
+      ids &= (group.value & (1 << bit)) ? s_id_bit_sets[bit] : ~s_id_bit_sets[bit];
+    }
+  }
+
+  return ids;
+}
+
+// Smallest group that contains both groups - any bit they disagree on becomes "don't care"
+static CanFilterGroup prv_merge(CanFilterGroup a, CanFilterGroup b) {
+  uint8_t mask = a.mask & b.mask & (uint8_t)~(a.value ^ b.value);
+
+  return (CanFilterGroup){
+    .mask = mask,             //
+    .value = a.value & mask,  //
+  };
+}
+
+// Replaces groups[index] with |merged| and drops every other group it covers
+static size_t prv_apply_merge(CanFilterGroup *groups, size_t num_groups, size_t index,
+                              CanFilterGroup merged) {
+  uint64_t merged_ids = prv_group_ids(merged);
+  size_t num_kept = 0;
+
+  groups[index] = merged;
+  for (size_t i = 0; i < num_groups; i++) {
+    if (i != index && (prv_group_ids(groups[i]) & ~merged_ids) == 0) {
+      continue;
+    }
+    groups[num_kept++] = groups[i];
+  }
+
+  return num_kept;
+}
+
+StatusCode can_filter_plan(const CanMessageId *msg_ids, size_t num_ids, size_t max_banks,
+                           CanFilterPlan *plan) {
+  if ((msg_ids == NULL && num_ids > 0) || plan == NULL || max_banks == 0 ||
+      max_banks > CAN_HW_NUM_FILTER_BANKS) {
+    return status_code(STATUS_CODE_INVALID_ARGS);
+  }
+
+  CanFilterGroup groups[CAN_MSG_MAX_IDS];
+  size_t num_groups = 0;
+  uint64_t subscribed = 0;
+
+  for (size_t i = 0; i < num_ids; i++) {
+    if (msg_ids[i] >= CAN_MSG_MAX_IDS) {
+      return status_msg(STATUS_CODE_INVALID_ARGS, "CAN filter: Invalid message ID");
+    } else if (subscribed & (1ull << msg_ids[i])) {
+      continue;
+    }
+
+    subscribed |= 1ull << msg_ids[i];
+    groups[num_groups++] = (CanFilterGroup){
+      .mask = CAN_FILTER_ID_MASK,    //
+      .value = (uint8_t)msg_ids[i],  //
+    };
+  }
+
+  // Everything that currently passes the filters
+  uint64_t accepted = subscribed;
+  size_t max_filters = max_banks * CAN_FILTER_PER_BANK;
+
+  while (num_groups > 1) {
+    size_t best_index = 0;
+    CanFilterGroup best_merge = { 0 };
+    int best_cost = CAN_MSG_MAX_IDS + 1;
+    int best_size = 0;
+
+    // Find the merge that lets through the fewest new IDs, preferring smaller groups on ties
+    for (size_t a = 0; a < num_groups; a++) {
+      for (size_t b = a + 1; b < num_groups; b++) {
+        CanFilterGroup merged = prv_merge(groups[a], groups[b]);
+        uint64_t merged_ids = prv_group_ids(merged);
+        int cost = __builtin_popcountll(merged_ids & ~accepted);
+        int size = __builtin_popcountll(merged_ids);
+
+        if (cost < best_cost || (cost == best_cost && size < best_size)) {
+          best_index = a;
+          best_merge = merged;
+          best_cost = cost;
+          best_size = size;
+        }
+      }
+    }
+
+    if (best_cost > 0 && num_groups <= max_filters) {
+      break;
+    }
+
+    num_groups = prv_apply_merge(groups, num_groups, best_index, best_merge);
+    accepted |= prv_group_ids(best_merge);
+  }
+
+  memset(plan, 0, sizeof(*plan));
+  for (size_t i = 0; i < num_groups; i++) {
+    CanId mask = { .msg_id = groups[i].mask };
+    CanId filter = { .msg_id = groups[i].value };
+
+    plan->filters[i] = (CanHwFilter){
+      .mask = mask.raw,      //
+      .filter = filter.raw,  //
+      .extended = false,     //
+    };
+  }
+  plan->num_filters = num_groups;
+  plan->num_banks = (num_groups + CAN_FILTER_PER_BANK - 1) / CAN_FILTER_PER_BANK;
+  plan->num_subscribed = (size_t)__builtin_popcountll(subscribed);
+  plan->num_accepted = (size_t)__builtin_popcountll(accepted);
+
+  return STATUS_CODE_OK;
+}
+
+uint8_t can_filter_false_accept_rate(const CanFilterPlan *plan) {
+  size_t num_unsubscribed = CAN_MSG_MAX_IDS - plan->num_subscribed;
+  if (num_unsubscribed == 0) {
+    return 0;
+  }
+
+  return (uint8_t)((plan->num_accepted - plan->num_subscribed) * 100 / num_unsubscribed);
+}
@@ -2,6 +2,8 @@
 #include "can.h"
 #include "can_hw.h"
 #include "can_rx.h"
+#include "critical_section.h"
+#include "soft_timer.h"
 
 FSM_DECLARE_STATE(can_rx_fsm_handle);
 FSM_DECLARE_STATE(can_tx_fsm_handle);
@@ -42,59 +44,92 @@ static StatusCode prv_handle_data_msg(CanStorage *can_storage, const CanMessage
   return ret;
 }
 
+// Without a schema, every data message is passed on
+static bool prv_is_valid_data_msg(const CanMsgSchema *msg_schema, const CanMessage *msg) {
+  if (msg_schema == NULL) {
+    return true;
+  }
+
+  // Received message IDs come from a 6-bit field, so they're always in the table
+  const CanMsgSchema *schema = &msg_schema[msg->msg_id];
+  return schema->slot != CAN_MSG_SCHEMA_NO_SLOT && schema->dlc == msg->dlc &&
+         schema->source_id == msg->source_id;
+}
+
 static void prv_handle_rx(Fsm *fsm, const Event *e, void *context) {
   CanStorage *can_storage = context;
-  CanMessage rx_msg = { 0 };
 
-  StatusCode result = can_fifo_pop(&can_storage->rx_fifo, &rx_msg);
-  if (result != STATUS_CODE_OK) {
+  // Handlers run on the message in the ring, so it's only released once they're done
+  const CanMessage *rx_msg = can_rx_ring_peek_ptr(&can_storage->rx_ring);
+  if (rx_msg == NULL) {
     // We had a mismatch between number of events and number of messages, so return silently
     // Alternatively, we could use the data value of the event.
     return;
   }
 
+  uint32_t received_us = can_storage->rx_times_us[rx_msg - can_storage->rx_ring.elems];
+  can_stats_record_rx(&can_storage->stats, rx_msg, received_us, (uint32_t)soft_timer_get_time());
+
   // We currently ignore failures to handle the message.
-  // If needed, we could push it back to the queue.
-  switch (rx_msg.type) {
+  switch (rx_msg->type) {
     case CAN_MSG_TYPE_ACK:
-      result = can_ack_handle_msg(&can_storage->ack_requests, &rx_msg);
+      can_ack_handle_msg(&can_storage->ack_requests, rx_msg);
 
       break;
     case CAN_MSG_TYPE_DATA:
-      result = prv_handle_data_msg(can_storage, &rx_msg);
+      if (!prv_is_valid_data_msg(can_storage->msg_schema, rx_msg)) {
+        can_storage->stats.rx_invalid++;
+        break;
+      }
+      prv_handle_data_msg(can_storage, rx_msg);
 
       break;
     default:
+      // error
       status_msg(STATUS_CODE_UNREACHABLE, "CAN RX: Invalid type");
 
-      return;
-      // error
       break;
   }
+
+  can_rx_ring_pop(&can_storage->rx_ring, NULL);
 }
 
-// We assume that TX events are always 1-to-1.
-// We expect the TX complete interrupt to raise any discarded events.
+// Fills as many mailboxes as the hardware will take. If messages are left over, the TX ready
+// interrupt raises another TX event once a mailbox frees up.
 static void prv_handle_tx(Fsm *fsm, const Event *e, void *context) {
   CanStorage *can_storage = context;
-  CanMessage tx_msg = { 0 };
+  CanTxEntry entry = { 0 };
+
+  // Clear the flag before draining so anything queued from here on raises a new event
+  can_storage->tx_pending = false;
+  can_storage->stats.tx_service_passes++;
+
+  uint32_t now_us = (uint32_t)soft_timer_get_time();
+  while (true) {
+    // A higher priority message could be queued from an interrupt between the peek and the pop,
+    // so hold off interrupts until we know which message made it into a mailbox.
+    bool disabled = critical_section_start();
+    if (can_queue_peek(&can_storage->tx_queue, &entry) != STATUS_CODE_OK) {
+      critical_section_end(disabled);
+      break;
+    }
 
-  StatusCode result = can_fifo_peek(&can_storage->tx_fifo, &tx_msg);
-  if (result != STATUS_CODE_OK) {
-    // Mismatch
-    return;
-  }
+    CanId msg_id = {
+      .source_id = can_storage->device_id,  //
+      .type = entry.msg.type,               //
+      .msg_id = entry.msg.msg_id,           //
+    };
 
-  CanId msg_id = {
-    .source_id = can_storage->device_id,  //
-    .type = tx_msg.type,                  //
-    .msg_id = tx_msg.msg_id,              //
-  };
+    // If added to mailbox, pop message from the TX queue
+    if (can_hw_transmit(msg_id.raw, false, entry.msg.data_u8, entry.msg.dlc) != STATUS_CODE_OK) {
+      // Out of mailboxes
+      critical_section_end(disabled);
+      break;
+    }
+    can_queue_pop(&can_storage->tx_queue, NULL);
+    critical_section_end(disabled);
 
-  // If added to mailbox, pop message from the TX queue
-  StatusCode ret = can_hw_transmit(msg_id.raw, false, tx_msg.data_u8, tx_msg.dlc);
-  if (ret == STATUS_CODE_OK) {
-    can_fifo_pop(&can_storage->tx_fifo, NULL);
+    can_stats_record_tx(&can_storage->stats, &entry.msg, entry.queued_us, now_us);
   }
 }
 
@@ -103,7 +138,7 @@ StatusCode can_fsm_init(Fsm *fsm, CanStorage *can_storage) {
     return status_code(STATUS_CODE_INVALID_ARGS);
   }
 
-  fsm_init(fsm, "can_fsm", &can_rx_fsm_handle, can_storage);
+  status_ok_or_return(fsm_init(fsm, "can_fsm", &can_rx_fsm_handle, can_storage));
   fsm_state_init(can_rx_fsm_handle, prv_handle_rx);
   fsm_state_init(can_tx_fsm_handle, prv_handle_tx);
 
@@ -0,0 +1,85 @@
+#include "can_publish.h"
+#include <string.h>
+#include "can.h"
+#include "soft_timer.h"
+
+// Returns the field at |index| of |size| bytes, zero-extended
+static uint64_t prv_get_field(const CanMessage *msg, uint8_t size, size_t index) {
+  switch (size) {
+    case 1:
+      return msg->data_u8[index];
+    case 2:
+      return msg->data_u16[index];
+    case 4:
+      return msg->data_u32[index];
+    default:
+      return msg->data;
+  }
+}
+
+static bool prv_has_changed(const CanPublishStorage *storage, const CanMessage *msg) {
+  const CanMessage *last_msg = &storage->last_msg;
+  if (msg->msg_id != last_msg->msg_id || msg->dlc != last_msg->dlc ||
+      msg->type != last_msg->type) {
+    return true;
+  }
+
+  uint8_t size = storage->settings.field_size;
+  size_t num_fields = (msg->dlc + size - 1u) / size;
+  for (size_t i = 0; i < num_fields; i++) {
+    uint64_t value = prv_get_field(msg, size, i);
+    uint64_t last_value = prv_get_field(last_msg, size, i);
+
+    // Only compare the bytes of a partial field at the end that are within the DLC
+    size_t num_bytes = msg->dlc - i * size;
+    if (num_bytes < size) {
+      uint64_t mask = (1ull << (8 * num_bytes)) - 1;
+      value &= mask;
+      last_value &= mask;
+    }
+    uint64_t delta = (value > last_value) ? value - last_value : last_value - value;
+
+    if (delta > storage->settings.deadband) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+StatusCode can_publish_init(CanPublishStorage *storage, const CanPublishSettings *settings) {
+  if (storage == NULL || settings == NULL) {
+    return status_code(STATUS_CODE_INVALID_ARGS);
+  } else if (settings->field_size != 1 && settings->field_size != 2 &&
+             settings->field_size != 4 && settings->field_size != 8) {
+    return status_msg(STATUS_CODE_INVALID_ARGS, "CAN publish: Invalid field size");
+  }
+
+  memset(storage, 0, sizeof(*storage));
+  storage->settings = *settings;
+
+  return STATUS_CODE_OK;
+}
+
+StatusCode can_publish(CanPublishStorage *storage, const CanMessage *msg) {
+  uint64_t now_us = soft_timer_get_time();
+
+  if (storage->sent && !prv_has_changed(storage, msg) &&
+      now_us - storage->last_sent_us < (uint64_t)storage->settings.max_silence_ms * 1000) {
+    storage->num_suppressed++;
+    return STATUS_CODE_OK;
+  }
+
+  status_ok_or_return(can_transmit(msg, NULL));
+
+  storage->last_msg = *msg;
+  storage->last_sent_us = now_us;
+  storage->sent = true;
+  storage->num_sent++;
+
+  return STATUS_CODE_OK;
+}
+
+void can_publish_invalidate(CanPublishStorage *storage) {
+  storage->sent = false;
+}
@@ -0,0 +1,43 @@
+#include "can_queue.h"
+#include "critical_section.h"
+
+StatusCode can_queue_init(CanQueue *can_queue) {
+  return pqueue_backed_init(&can_queue->pqueue, can_queue->queue_nodes, can_queue->msg_nodes);
+}
+
+StatusCode can_queue_push(CanQueue *can_queue, const CanTxEntry *entry) {
+  // Every message we send has our source ID, so only the message ID and type matter
+  CanId can_id = {
+    .type = entry->msg.type,      //
+    .msg_id = entry->msg.msg_id,  //
+  };
+
+  // Messages are pushed from interrupts too - the reserve check must hold until we push
+  bool disabled = critical_section_start();
+  if (!CAN_MSG_IS_CRITICAL(&entry->msg) &&
+      pqueue_backed_size(&can_queue->pqueue) >= CAN_QUEUE_SIZE - CAN_QUEUE_CRITICAL_RESERVED) {
+    critical_section_end(disabled);
+    return status_code(STATUS_CODE_RESOURCE_EXHAUSTED);
+  }
+
+  StatusCode ret = pqueue_backed_push(&can_queue->pqueue, entry, can_id.raw);
+  critical_section_end(disabled);
+
+  return ret;
+}
+
+StatusCode can_queue_pop(CanQueue *can_queue, CanTxEntry *entry) {
+  bool disabled = critical_section_start();
+  StatusCode ret = pqueue_backed_pop(&can_queue->pqueue, entry);
+  critical_section_end(disabled);
+
+  return ret;
+}
+
+StatusCode can_queue_peek(CanQueue *can_queue, CanTxEntry *entry) {
+  return pqueue_backed_peek(&can_queue->pqueue, entry);
+}
+
+size_t can_queue_size(CanQueue *can_queue) {
+  return pqueue_backed_size(&can_queue->pqueue);
+}
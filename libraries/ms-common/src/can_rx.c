@@ -1,16 +1,28 @@
 #include "can_rx.h"
-#include <stdlib.h>
 #include <string.h>
 
-static int prv_handler_comp(const void *a, const void *b) {
-  const CanRxHandler *x = a;
-  const CanRxHandler *y = b;
+// Returns the handler registered for the ID, ignoring the default handler
+static CanRxHandler *prv_find_handler(CanRxHandlers *rx_handlers, CanMessageId msg_id) {
+  if (msg_id < CAN_MSG_MAX_IDS) {
+    uint8_t index = rx_handlers->lookup[msg_id];
+    return (index != 0) ? &rx_handlers->storage[index - 1] : NULL;
+  }
+
+  for (size_t i = 0; i < rx_handlers->num_handlers; i++) {
+    if (rx_handlers->storage[i].msg_id == msg_id) {
+      return &rx_handlers->storage[i];
+    }
+  }
 
-  return x->msg_id - y->msg_id;
+  return NULL;
 }
 
 StatusCode can_rx_init(CanRxHandlers *rx_handlers, CanRxHandler *handler_storage,
                        size_t num_handlers) {
+  if (num_handlers > UINT8_MAX) {
+    return status_msg(STATUS_CODE_INVALID_ARGS, "CAN RX: Too many handlers");
+  }
+
   memset(rx_handlers, 0, sizeof(*rx_handlers));
   memset(handler_storage, 0, sizeof(*handler_storage) * num_handlers);
 
@@ -26,7 +38,7 @@ StatusCode can_rx_register_default_handler(CanRxHandlers *rx_handlers, CanRxHand
   StatusCode ret = can_rx_register_handler(rx_handlers, CAN_MSG_INVALID_ID, handler, context);
 
   if (ret == STATUS_CODE_OK) {
-    rx_handlers->default_handler = can_rx_get_handler(rx_handlers, CAN_MSG_INVALID_ID);
+    rx_handlers->default_handler = prv_find_handler(rx_handlers, CAN_MSG_INVALID_ID);
   }
 
   return ret;
@@ -36,7 +48,7 @@ StatusCode can_rx_register_handler(CanRxHandlers *rx_handlers, CanMessageId msg_
                                    CanRxHandlerCb handler, void *context) {
   if (rx_handlers->num_handlers == rx_handlers->max_handlers) {
     return status_msg(STATUS_CODE_RESOURCE_EXHAUSTED, "CAN RX handlers full");
-  } else if (can_rx_get_handler(rx_handlers, msg_id) != NULL) {
+  } else if (prv_find_handler(rx_handlers, msg_id) != NULL) {
     return status_msg(STATUS_CODE_RESOURCE_EXHAUSTED, "CAN RX handler already registered");
   }
 
@@ -46,18 +58,19 @@ StatusCode can_rx_register_handler(CanRxHandlers *rx_handlers, CanMessageId msg_
     .context = context,
   };
 
-  qsort(rx_handlers->storage, rx_handlers->num_handlers, sizeof(*rx_handlers->storage),
-        prv_handler_comp);
+  if (msg_id < CAN_MSG_MAX_IDS) {
+    rx_handlers->lookup[msg_id] = (uint8_t)rx_handlers->num_handlers;
+  }
 
   return STATUS_CODE_OK;
 }
 
 CanRxHandler *can_rx_get_handler(CanRxHandlers *rx_handlers, CanMessageId msg_id) {
-  const CanRxHandler key = {
-    .msg_id = msg_id,
-  };
-  CanRxHandler *handler = bsearch(&key, rx_handlers->storage, rx_handlers->num_handlers,
-                                  sizeof(*rx_handlers->storage), prv_handler_comp);
+  if (rx_handlers->hits != NULL && msg_id < CAN_MSG_MAX_IDS) {
+    rx_handlers->hits[msg_id]++;
+  }
+
+  CanRxHandler *handler = prv_find_handler(rx_handlers, msg_id);
 
   if (handler == NULL && rx_handlers->default_handler != NULL) {
     return rx_handlers->default_handler;
@@ -65,3 +78,12 @@ CanRxHandler *can_rx_get_handler(CanRxHandlers *rx_handlers, CanMessageId msg_id
 
   return handler;
 }
+
+StatusCode can_rx_set_hit_counts(CanRxHandlers *rx_handlers, uint32_t *hits) {
+  if (hits != NULL) {
+    memset(hits, 0, sizeof(*hits) * CAN_MSG_MAX_IDS);
+  }
+  rx_handlers->hits = hits;
+
+  return STATUS_CODE_OK;
+}
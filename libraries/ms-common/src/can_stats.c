@@ -0,0 +1,131 @@
+#include "can_stats.h"
+#include <string.h>
+#include "critical_section.h"
+
+#define CAN_STATS_WINDOW_US (CAN_STATS_WINDOW_MS * 1000)
+// After this many idle windows, the moving average has decayed to nothing
+#define CAN_STATS_MAX_IDLE_WINDOWS 16
+// Standard data frame without stuffing: SOF, ID, RTR, IDE, r0, DLC, CRC, delimiters, ACK, EOF, IFS
+#define CAN_STATS_FRAME_BITS 47
+// Stuff bits can be inserted from the SOF to the end of the CRC
+#define CAN_STATS_STUFFED_BITS 34
+
+static const uint16_t s_bits_per_ms[NUM_CAN_HW_BITRATES] = {
+  [CAN_HW_BITRATE_125KBPS] = 125,
+  [CAN_HW_BITRATE_250KBPS] = 250,
+  [CAN_HW_BITRATE_500KBPS] = 500,
+  [CAN_HW_BITRATE_1000KBPS] = 1000,
+};
+
+// Worst case - a stuff bit after every 4 bits
+static uint32_t prv_frame_bits(uint8_t dlc) {
+  uint32_t data_bits = 8u * dlc;
+  return CAN_STATS_FRAME_BITS + data_bits + (CAN_STATS_STUFFED_BITS + data_bits - 1) / 4;
+}
+
+// Folds any finished windows into the moving average
+static void prv_roll_window(CanStats *stats, uint32_t now_us) {
+  uint32_t num_windows = (now_us - stats->window_start_us) / CAN_STATS_WINDOW_US;
+  if (num_windows == 0) {
+    return;
+  }
+
+  uint32_t window_permille =
+      stats->window_bits * 1000 / ((uint32_t)stats->bits_per_ms * CAN_STATS_WINDOW_MS);
+  if (window_permille > 1000) {
+    window_permille = 1000;
+  }
+
+  if (num_windows > CAN_STATS_MAX_IDLE_WINDOWS) {
+    stats->bus_load_permille = 0;
+  } else {
+    uint32_t load = ((uint32_t)stats->bus_load_permille * 3 + window_permille) / 4;
+    // The rest of the windows didn't see any frames
+    for (uint32_t i = 1; i < num_windows; i++) {
+      load = load * 3 / 4;
+    }
+    stats->bus_load_permille = (uint16_t)load;
+  }
+
+  stats->window_start_us += num_windows * CAN_STATS_WINDOW_US;
+  stats->window_bits = 0;
+}
+
+static void prv_record_latency(CanStatsLatency *latency, uint32_t latency_us) {
+  latency->count++;
+  latency->total_us += latency_us;
+  if (latency_us > latency->max_us) {
+    latency->max_us = latency_us;
+  }
+  if (latency_us > latency->window_max_us) {
+    latency->window_max_us = latency_us;
+  }
+}
+
+static void prv_record_frame(CanStats *stats, const CanMessage *msg, uint32_t now_us) {
+  // Packing a summary from an interrupt also rolls the window
+  bool disabled = critical_section_start();
+  prv_roll_window(stats, now_us);
+  stats->window_bits += prv_frame_bits(msg->dlc);
+  critical_section_end(disabled);
+}
+
+static uint8_t prv_saturate_u8(uint32_t value) {
+  return (value > UINT8_MAX) ? UINT8_MAX : (uint8_t)value;
+}
+
+static uint16_t prv_saturate_u16(uint32_t value) {
+  return (value > UINT16_MAX) ? UINT16_MAX : (uint16_t)value;
+}
+
+void can_stats_init(CanStats *stats, CanHwBitrate bitrate, uint32_t now_us) {
+  memset(stats, 0, sizeof(*stats));
+  stats->bits_per_ms = s_bits_per_ms[bitrate];
+  stats->window_start_us = now_us;
+}
+
+void can_stats_record_tx(CanStats *stats, const CanMessage *msg, uint32_t queued_us,
+                         uint32_t now_us) {
+  stats->tx_frames[msg->msg_id]++;
+  prv_record_latency(&stats->tx_latency, now_us - queued_us);
+  prv_record_frame(stats, msg, now_us);
+}
+
+void can_stats_record_rx(CanStats *stats, const CanMessage *msg, uint32_t received_us,
+                         uint32_t now_us) {
+  stats->rx_frames[msg->msg_id]++;
+  prv_record_latency(&stats->rx_latency, now_us - received_us);
+  prv_record_frame(stats, msg, now_us);
+}
+
+uint8_t can_stats_bus_load(CanStats *stats, uint32_t now_us) {
+  bool disabled = critical_section_start();
+  prv_roll_window(stats, now_us);
+  critical_section_end(disabled);
+
+  return (uint8_t)((stats->bus_load_permille + 5) / 10);
+}
+
+void can_stats_pack_summary(CanStats *stats, uint32_t now_us, CanMessage *msg) {
+  // The window maxima are reset here, so a latency recorded in between must not be lost
+  bool disabled = critical_section_start();
+  uint32_t tx_dropped = stats->tx_dropped;
+  uint32_t rx_dropped = stats->rx_dropped;
+  uint32_t bus_errors = stats->bus_errors;
+
+  msg->type = CAN_MSG_TYPE_DATA;
+  msg->dlc = 8;
+  msg->data_u8[0] = can_stats_bus_load(stats, now_us);
+  msg->data_u8[1] = prv_saturate_u8(tx_dropped - stats->summary_tx_dropped);
+  msg->data_u8[2] = prv_saturate_u8(rx_dropped - stats->summary_rx_dropped);
+  msg->data_u8[3] = prv_saturate_u8(bus_errors - stats->summary_bus_errors);
+  msg->data_u16[2] = prv_saturate_u16(stats->tx_latency.window_max_us);
+  msg->data_u16[3] = prv_saturate_u16(stats->rx_latency.window_max_us);
+
+  stats->summary_tx_dropped = tx_dropped;
+  stats->summary_rx_dropped = rx_dropped;
+  stats->summary_bus_errors = bus_errors;
+  stats->tx_latency.window_max_us = 0;
+  stats->rx_latency.window_max_us = 0;
+  critical_section_end(disabled);
+}
@@ -1,42 +1,216 @@
-// This is just a wrapper for a backed priority queue.
+// A ring buffer per priority with a bitmask of which ones are non-empty.
 // Currently, there is only one global event queue.
 #include <stdbool.h>
 #include <string.h>
 
+#include "critical_section.h"
 #include "event_queue.h"
-#include "fifo.h"
 #include "status.h"
 
+#define EVENT_QUEUE_NO_GROUP 0xFF
+
+typedef struct EventQueueLevel {
+  Event events[EVENT_QUEUE_SIZE];
+  // Coalesce group of each queued event
+  uint8_t groups[EVENT_QUEUE_SIZE];
+  size_t head;
+  size_t num_events;
+} EventQueueLevel;
+
+typedef struct EventQueueCoalesceId {
+  EventId id;
+  uint8_t group;
+} EventQueueCoalesceId;
+
+// Where the group's queued event is, if any
+typedef struct EventQueueCoalesceGroup {
+  bool queued;
+  uint8_t priority;
+  uint8_t slot;
+} EventQueueCoalesceGroup;
+
 typedef struct EventQueue {
-  Fifo fifos[NUM_EVENT_PRIORITIES];
-  Event event_nodes[NUM_EVENT_PRIORITIES][EVENT_QUEUE_SIZE];
+  EventQueueLevel levels[NUM_EVENT_PRIORITIES];
+  EventQueueStats stats[NUM_EVENT_PRIORITIES];
+  // Bit n is set if priority n has events
+  uint32_t occupied;
+
+  EventQueueCoalesceId coalesce_ids[EVENT_QUEUE_MAX_COALESCABLE_IDS];
+  size_t num_coalesce_ids;
+  EventQueueCoalesceGroup coalesce_groups[EVENT_QUEUE_MAX_COALESCE_GROUPS];
+  size_t num_coalesce_groups;
+  // Bit (id % 32) is set if any coalescable ID maps to it, so most raises skip the lookup
+  uint32_t coalesce_filter;
 } EventQueue;
 
+_Static_assert(NUM_EVENT_PRIORITIES <= 32, "Event priorities must fit in the occupancy bitmask");
+_Static_assert(EVENT_QUEUE_SIZE <= UINT8_MAX, "Event queue slots must fit in a uint8_t");
+_Static_assert(EVENT_QUEUE_MAX_COALESCE_GROUPS < EVENT_QUEUE_NO_GROUP, "Too many coalesce groups");
+
 static EventQueue s_queue;
 
-void event_queue_init(void) {
-  for (size_t i = 0; i < NUM_EVENT_PRIORITIES; i++) {
-    fifo_init(&s_queue.fifos[i], s_queue.event_nodes[i]);
+static uint8_t prv_find_group(EventId id) {
+  if ((s_queue.coalesce_filter & (1u << (id % 32))) == 0) {
+    return EVENT_QUEUE_NO_GROUP;
   }
+
+  for (size_t i = 0; i < s_queue.num_coalesce_ids; i++) {
+    if (s_queue.coalesce_ids[i].id == id) {
+      return s_queue.coalesce_ids[i].group;
+    }
+  }
+
+  return EVENT_QUEUE_NO_GROUP;
+}
+
+// Must be called within a critical section with at least one priority occupied
+static size_t prv_pop(Event *events, size_t max_events) {
+  size_t priority = (size_t)__builtin_ctz(s_queue.occupied);
+  EventQueueLevel *level = &s_queue.levels[priority];
+
+  size_t num_events = (level->num_events < max_events) ? level->num_events : max_events;
+  for (size_t i = 0; i < num_events; i++) {
+    events[i] = level->events[level->head];
+
+    uint8_t group = level->groups[level->head];
+    if (group != EVENT_QUEUE_NO_GROUP) {
+      EventQueueCoalesceGroup *coalesce = &s_queue.coalesce_groups[group];
+      if (coalesce->priority == priority && coalesce->slot == level->head) {
+        coalesce->queued = false;
+      }
+    }
+
+    level->head = (level->head + 1 == EVENT_QUEUE_SIZE) ? 0 : level->head + 1;
+  }
+
+  level->num_events -= num_events;
+  if (level->num_events == 0) {
+    s_queue.occupied &= ~(1u << priority);
+  }
+
+  return num_events;
+}
+
+void event_queue_init(void) {
+  memset(&s_queue, 0, sizeof(s_queue));
 }
 
 StatusCode event_raise_priority(EventPriority priority, EventId id, uint16_t data) {
   if (priority >= NUM_EVENT_PRIORITIES) {
     return status_code(STATUS_CODE_INVALID_ARGS);
   }
+
   Event e = {
     .id = id,      //
     .data = data,  //
   };
 
-  return fifo_push(&s_queue.fifos[priority], &e);
+  bool disabled = critical_section_start();
+  EventQueueLevel *level = &s_queue.levels[priority];
+  EventQueueStats *stats = &s_queue.stats[priority];
+
+  uint8_t group = prv_find_group(id);
+  EventQueueCoalesceGroup *coalesce = NULL;
+  if (group != EVENT_QUEUE_NO_GROUP) {
+    coalesce = &s_queue.coalesce_groups[group];
+    if (coalesce->queued && coalesce->priority == priority) {
+      level->events[coalesce->slot] = e;
+      stats->coalesced++;
+      critical_section_end(disabled);
+      return STATUS_CODE_OK;
+    }
+  }
+
+  if (level->num_events == EVENT_QUEUE_SIZE) {
+    stats->dropped++;
+    critical_section_end(disabled);
+    return status_code(STATUS_CODE_RESOURCE_EXHAUSTED);
+  }
+
+  size_t tail = level->head + level->num_events;
+  if (tail >= EVENT_QUEUE_SIZE) {
+    tail -= EVENT_QUEUE_SIZE;
+  }
+  level->events[tail] = e;
+  level->groups[tail] = group;
+  if (coalesce != NULL) {
+    // Any event from the group queued at another priority is left alone
+    *coalesce = (EventQueueCoalesceGroup){
+      .queued = true,                 //
+      .priority = (uint8_t)priority,  //
+      .slot = (uint8_t)tail,          //
+    };
+  }
+
+  level->num_events++;
+  if (level->num_events > stats->high_water_mark) {
+    stats->high_water_mark = (uint16_t)level->num_events;
+  }
+  s_queue.occupied |= 1u << priority;
+  critical_section_end(disabled);
+
+  return STATUS_CODE_OK;
 }
 
 StatusCode event_process(Event *e) {
-  for (size_t i = 0; i < NUM_EVENT_PRIORITIES; i++) {
-    if (s_queue.fifos[i].num_elems > 0) {
-      return fifo_pop(&s_queue.fifos[i], e);
+  bool disabled = critical_section_start();
+  size_t num_events = (s_queue.occupied != 0) ? prv_pop(e, 1) : 0;
+  critical_section_end(disabled);
+
+  if (num_events == 0) {
+    return status_code(STATUS_CODE_EMPTY);
+  }
+  return STATUS_CODE_OK;
+}
+
+size_t event_process_batch(Event *events, size_t max_events) {
+  if (events == NULL || max_events == 0) {
+    return 0;
+  }
+
+  bool disabled = critical_section_start();
+  size_t num_events = (s_queue.occupied != 0) ? prv_pop(events, max_events) : 0;
+  critical_section_end(disabled);
+
+  return num_events;
+}
+
+StatusCode event_queue_add_coalesce_group(const EventId *ids, size_t num_ids) {
+  if (ids == NULL || num_ids == 0) {
+    return status_code(STATUS_CODE_INVALID_ARGS);
+  } else if (s_queue.num_coalesce_groups >= EVENT_QUEUE_MAX_COALESCE_GROUPS ||
+             s_queue.num_coalesce_ids + num_ids > EVENT_QUEUE_MAX_COALESCABLE_IDS) {
+    return status_code(STATUS_CODE_RESOURCE_EXHAUSTED);
+  }
+
+  for (size_t i = 0; i < num_ids; i++) {
+    if (prv_find_group(ids[i]) != EVENT_QUEUE_NO_GROUP) {
+      return status_msg(STATUS_CODE_INVALID_ARGS, "Event is already in a coalesce group");
     }
   }
-  return status_code(STATUS_CODE_EMPTY);
+
+  bool disabled = critical_section_start();
+  uint8_t group = (uint8_t)s_queue.num_coalesce_groups++;
+  for (size_t i = 0; i < num_ids; i++) {
+    s_queue.coalesce_ids[s_queue.num_coalesce_ids++] = (EventQueueCoalesceId){
+      .id = ids[i],    //
+      .group = group,  //
+    };
+    s_queue.coalesce_filter |= 1u << (ids[i] % 32);
+  }
+  critical_section_end(disabled);
+
+  return STATUS_CODE_OK;
+}
+
+StatusCode event_queue_get_stats(EventPriority priority, EventQueueStats *stats) {
+  if (priority >= NUM_EVENT_PRIORITIES || stats == NULL) {
+    return status_code(STATUS_CODE_INVALID_ARGS);
+  }
+
+  bool disabled = critical_section_start();
+  *stats = s_queue.stats[priority];
+  critical_section_end(disabled);
+
+  return STATUS_CODE_OK;
 }
@@ -1,19 +1,252 @@
 #include "fsm.h"
 
-void fsm_init(Fsm *fsm, const char *name, FsmState *default_state, void *context) {
+#include <stddef.h>
+
+#include "log.h"
+
+typedef struct FsmTraversal {
+  FsmState *tail;
+  uint16_t id;
+  FsmTransitionVisitFn visit;
+  void *context;
+} FsmTraversal;
+
+#ifndef FSM_BACKEND_FUNC
+typedef struct FsmTableBuilder {
+  const FsmState *state;
+  size_t start;
+  size_t num_matched;
+  bool overflow;
+} FsmTableBuilder;
+
+static FsmTransition s_transitions[FSM_MAX_TRANSITIONS];
+static size_t s_num_transitions;
+#endif
+static FsmPoolStats s_pool_stats;
+static uint16_t s_traversal_id;
+
+static void prv_transition(Fsm *fsm, FsmState *state, const Event *e) {
+  fsm->last_state = fsm->current_state;
+  fsm->current_state = state;
+
+  if (fsm->current_state->output != NULL) {
+    fsm->current_state->output(fsm, e, fsm->context);
+  }
+}
+
+// Returns the index of the first transition with an event ID >= |event_id|
+static size_t prv_find_transition(const FsmState *state, EventId event_id) {
+  size_t low = 0;
+  size_t high = state->num_transitions;
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    if (state->transitions[mid].event_id < event_id) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+
+  return low;
+}
+
+static void prv_collect(Fsm *fsm, FsmState *state, FsmTransitionVisitFn visit, void *context) {
+  FsmTransitionBuilder builder = {
+    .visit = visit,      //
+    .context = context,  //
+    .fsm = fsm,          //
+  };
+  state->table(fsm, NULL, &builder);
+}
+
+#ifndef FSM_BACKEND_FUNC
+static void prv_append_transition(const FsmTransition *transition, void *context) {
+  FsmTableBuilder *table = context;
+  if (s_num_transitions >= FSM_MAX_TRANSITIONS) {
+    table->overflow = true;
+    return;
+  }
+
+  // Insertion sort, keeping transitions with the same event ID in the order they were added
+  size_t i = s_num_transitions++;
+  while (i > table->start && s_transitions[i - 1].event_id > transition->event_id) {
+    s_transitions[i] = s_transitions[i - 1];
+    i--;
+  }
+  s_transitions[i] = *transition;
+}
+
+// States that don't fit in the pool check their transitions in order
+static void prv_build_table(Fsm *fsm, FsmState *state) {
+  state->built = true;
+
+  FsmTableBuilder table = { .start = s_num_transitions };
+  prv_collect(fsm, state, prv_append_transition, &table);
+
+  if (table.overflow) {
+    s_num_transitions = table.start;
+    s_pool_stats.overflows++;
+    LOG_WARN("FSM: Ran out of transitions for %s - checking transitions in order\n", state->name);
+    return;
+  }
+
+  state->transitions = &s_transitions[table.start];
+  state->num_transitions = (uint16_t)(s_num_transitions - table.start);
+  s_pool_stats.in_use = s_num_transitions;
+}
+
+static void prv_match_transition(const FsmTransition *transition, void *context) {
+  FsmTableBuilder *table = context;
+  const FsmState *state = table->state;
+
+  for (size_t i = prv_find_transition(state, transition->event_id);
+       i < state->num_transitions && state->transitions[i].event_id == transition->event_id; i++) {
+    if (state->transitions[i].guard == transition->guard &&
+        state->transitions[i].state == transition->state) {
+      table->num_matched++;
+      return;
+    }
+  }
+
+  table->overflow = true;
+}
+
+// States can be shared between FSMs, but the table was built from the first one
+static void prv_check_table(Fsm *fsm, FsmState *state) {
+  FsmTableBuilder table = { .state = state };
+  prv_collect(fsm, state, prv_match_transition, &table);
+
+  if (table.overflow || table.num_matched != state->num_transitions) {
+    LOG_DEBUG("FSM: %s differs between FSMs - checking transitions in order\n", state->name);
+    // Reclaim the table if nothing was built after it
+    if (state->transitions + state->num_transitions == &s_transitions[s_num_transitions]) {
+      s_num_transitions -= state->num_transitions;
+      s_pool_stats.in_use = s_num_transitions;
+    }
+    state->transitions = NULL;
+    state->num_transitions = 0;
+  }
+}
+#endif
+
+static void prv_visit_transition(const FsmTransition *transition, void *context) {
+  FsmTraversal *traversal = context;
+  FsmState *state = transition->state;
+
+  if (state->traversal != traversal->id) {
+    state->traversal = traversal->id;
+    state->next = NULL;
+    traversal->tail->next = state;
+    traversal->tail = state;
+  }
+
+  if (traversal->visit != NULL) {
+    traversal->visit(transition, traversal->context);
+  }
+}
+
+// Walks every state reachable from |start| breadth-first, queueing states through |next|.
+static void prv_traverse(Fsm *fsm, FsmState *start, bool build, FsmTransitionVisitFn visit,
+                         void *context) {
+  FsmTraversal traversal = {
+    .tail = start,           //
+    .id = ++s_traversal_id,  //
+    .visit = visit,          //
+    .context = context,      //
+  };
+  start->traversal = traversal.id;
+  start->next = NULL;
+
+  for (FsmState *state = start; state != NULL; state = state->next) {
+#ifndef FSM_BACKEND_FUNC
+    if (build && !state->built) {
+      prv_build_table(fsm, state);
+    } else if (build && state->transitions != NULL) {
+      prv_check_table(fsm, state);
+    }
+#endif
+
+    if (state->transitions != NULL) {
+      for (size_t i = 0; i < state->num_transitions; i++) {
+        prv_visit_transition(&state->transitions[i], &traversal);
+      }
+    } else {
+      prv_collect(fsm, state, prv_visit_transition, &traversal);
+    }
+  }
+}
+
+StatusCode fsm_init(Fsm *fsm, const char *name, FsmState *default_state, void *context) {
   fsm->name = name;
   fsm->context = context;
+  fsm->default_state = default_state;
   fsm->current_state = default_state;
+
+#ifndef FSM_BACKEND_FUNC
+  prv_traverse(fsm, default_state, true, NULL, NULL);
+#endif
+
+  return STATUS_CODE_OK;
+}
+
+StatusCode fsm_get_pool_stats(FsmPoolStats *stats) {
+  if (stats == NULL) {
+    return status_code(STATUS_CODE_INVALID_ARGS);
+  }
+
+  *stats = s_pool_stats;
+  return STATUS_CODE_OK;
 }
 
 bool fsm_process_event(Fsm *fsm, const Event *e) {
-  bool transitioned = false;
+  const FsmState *state = fsm->current_state;
+
+  if (state->transitions == NULL) {
+    FsmTransitionBuilder builder = {
+      .fsm = fsm,  //
+      .e = e,      //
+    };
+    state->table(fsm, e, &builder);
+    return builder.transitioned;
+  }
+
+  for (size_t i = prv_find_transition(state, e->id);
+       i < state->num_transitions && state->transitions[i].event_id == e->id; i++) {
+    const FsmTransition *transition = &state->transitions[i];
+    if (transition->guard(fsm, e, fsm->context)) {
+      prv_transition(fsm, transition->state, e);
+      return true;
+    }
+  }
 
-  fsm->current_state->table(fsm, e, &transitioned);
+  return false;
+}
+
+void fsm_for_each_transition(Fsm *fsm, FsmTransitionVisitFn visit, void *context) {
+  prv_traverse(fsm, fsm->default_state, false, visit, context);
+}
 
-  return transitioned;
+bool fsm_guard_true(const Fsm *fsm, const Event *e, void *context) {
+  return true;
 }
 
-bool fsm_guard_true(Fsm *fsm, const Event *e, void *context) {
+bool _fsm_add_transition(FsmTransitionBuilder *builder, EventId event_id,
+                         FsmStateTransitionGuard guard, FsmState *state) {
+  if (builder->visit != NULL) {
+    FsmTransition transition = {
+      .event_id = event_id,  //
+      .guard = guard,        //
+      .state = state,        //
+    };
+    builder->visit(&transition, builder->context);
+    return false;
+  }
+
+  if (builder->e->id != event_id || !guard(builder->fsm, builder->e, builder->fsm->context)) {
+    return false;
+  }
+
+  prv_transition(builder->fsm, state, builder->e);
+  builder->transitioned = true;
   return true;
 }
@@ -1,4 +1,4 @@
-// We use a bitset to represent free nodes
+// We use a two-level bitmap to represent free nodes
 #include <stdbool.h>
 #include <string.h>
 
@@ -6,6 +6,8 @@
 #include "objpool.h"
 #include "status.h"
 
+_Static_assert(OBJPOOL_NUM_WORDS <= OBJPOOL_WORD_BITS, "Objpool summary word is too small");
+
 #define OBJPOOL_GET(pool, index) \
   ((void *)((uint8_t *)(pool)->nodes + ((index) * (pool)->node_size)))
 
@@ -18,6 +20,126 @@
 #define OBJPOOL_GET_INDEX(pool, node) \
   ((size_t)((uint8_t *)(node) - (uint8_t *)(pool)->nodes) / (pool->node_size))
 
+#define OBJPOOL_BIT(n) ((ObjpoolWord)1 << (n))
+
+#if OBJPOOL_WORD_BITS == 64
+#define OBJPOOL_CTZ(word) ((size_t)__builtin_ctzll(word))
+#else
+#define OBJPOOL_CTZ(word) ((size_t)__builtin_ctz(word))
+#endif
+
+#ifdef OBJPOOL_LOCK_FREE
+// Takes the lowest free node in the word. Clearing the summary bit can race with a free
+// refilling the word, so the summary is only a hint and the caller falls back to a full scan.
+static bool prv_try_take(ObjectPool *pool, size_t word, size_t *index) {
+  ObjpoolWord bits = __atomic_load_n(&pool->free_bitset[word], __ATOMIC_ACQUIRE);
+  while (bits != 0) {
+    ObjpoolWord remaining = bits & (bits - 1);
+    if (__atomic_compare_exchange_n(&pool->free_bitset[word], &bits, remaining, true,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+      if (remaining == 0) {
+        __atomic_fetch_and(&pool->free_summary, ~OBJPOOL_BIT(word), __ATOMIC_RELEASE);
+      }
+      *index = word * OBJPOOL_WORD_BITS + OBJPOOL_CTZ(bits);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static bool prv_take(ObjectPool *pool, size_t *index) {
+  ObjpoolWord summary = __atomic_load_n(&pool->free_summary, __ATOMIC_ACQUIRE);
+  while (summary != 0) {
+    if (prv_try_take(pool, OBJPOOL_CTZ(summary), index)) {
+      return true;
+    }
+    summary &= summary - 1;
+  }
+
+  for (size_t word = 0; word < OBJPOOL_NUM_WORDS; word++) {
+    if (prv_try_take(pool, word, index)) {
+      return true;
+    }
+  }
+
+  __atomic_fetch_add(&pool->stats.failures, 1, __ATOMIC_RELAXED);
+  return false;
+}
+
+static bool prv_release(ObjectPool *pool, size_t index) {
+  size_t word = index / OBJPOOL_WORD_BITS;
+  ObjpoolWord bit = OBJPOOL_BIT(index % OBJPOOL_WORD_BITS);
+  if (__atomic_fetch_or(&pool->free_bitset[word], bit, __ATOMIC_ACQ_REL) & bit) {
+    // Already free
+    return false;
+  }
+  __atomic_fetch_or(&pool->free_summary, OBJPOOL_BIT(word), __ATOMIC_RELEASE);
+  __atomic_fetch_sub(&pool->stats.in_use, 1, __ATOMIC_RELAXED);
+
+  return true;
+}
+
+static void prv_update_in_use(ObjectPool *pool) {
+  size_t in_use = __atomic_add_fetch(&pool->stats.in_use, 1, __ATOMIC_RELAXED);
+  size_t peak = __atomic_load_n(&pool->stats.peak_in_use, __ATOMIC_RELAXED);
+  while (in_use > peak && !__atomic_compare_exchange_n(&pool->stats.peak_in_use, &peak, in_use,
+                                                       true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+  }
+}
+#else
+static bool prv_take(ObjectPool *pool, size_t *index) {
+  bool disabled = critical_section_start();
+
+  if (pool->free_summary == 0) {
+    pool->stats.failures++;
+    critical_section_end(disabled);
+    return false;
+  }
+
+  size_t word = OBJPOOL_CTZ(pool->free_summary);
+  size_t bit = OBJPOOL_CTZ(pool->free_bitset[word]);
+  pool->free_bitset[word] &= ~OBJPOOL_BIT(bit);
+  if (pool->free_bitset[word] == 0) {
+    pool->free_summary &= ~OBJPOOL_BIT(word);
+  }
+
+  critical_section_end(disabled);
+
+  *index = word * OBJPOOL_WORD_BITS + bit;
+  return true;
+}
+
+static bool prv_release(ObjectPool *pool, size_t index) {
+  size_t word = index / OBJPOOL_WORD_BITS;
+  ObjpoolWord bit = OBJPOOL_BIT(index % OBJPOOL_WORD_BITS);
+  bool disabled = critical_section_start();
+
+  if (pool->free_bitset[word] & bit) {
+    critical_section_end(disabled);
+    return false;
+  }
+  pool->free_bitset[word] |= bit;
+  pool->free_summary |= OBJPOOL_BIT(word);
+  pool->stats.in_use--;
+
+  critical_section_end(disabled);
+
+  return true;
+}
+
+static void prv_update_in_use(ObjectPool *pool) {
+  bool disabled = critical_section_start();
+
+  pool->stats.in_use++;
+  if (pool->stats.in_use > pool->stats.peak_in_use) {
+    pool->stats.peak_in_use = pool->stats.in_use;
+  }
+
+  critical_section_end(disabled);
+}
+#endif
+
 StatusCode objpool_init_verbose(ObjectPool *pool, void *nodes, size_t node_size, size_t num_nodes,
                                 ObjpoolNodeInitFn init_node, void *context) {
   if (num_nodes > OBJPOOL_MAX_NODES) {
@@ -32,46 +154,55 @@ StatusCode objpool_init_verbose(ObjectPool *pool, void *nodes, size_t node_size,
   pool->node_size = node_size;
   pool->init_node = init_node;
 
-  for (size_t i = 0; i < num_nodes; i++) {
-    void *node = OBJPOOL_GET(pool, i);
-    objpool_free_node(pool, node);
+  // Nodes are only initialized when they're handed out, but unused nodes should still read as zero
+  memset(nodes, 0, num_nodes * node_size);
+
+  for (size_t word = 0; word * OBJPOOL_WORD_BITS < num_nodes; word++) {
+    size_t remaining = num_nodes - word * OBJPOOL_WORD_BITS;
+    pool->free_bitset[word] =
+        (remaining >= OBJPOOL_WORD_BITS) ? ~(ObjpoolWord)0 : OBJPOOL_BIT(remaining) - 1;
+    pool->free_summary |= OBJPOOL_BIT(word);
   }
 
   return STATUS_CODE_OK;
 }
 
 void *objpool_get_node(ObjectPool *pool) {
-  bool disabled = critical_section_start();
-
-  // Find first set bit - returns 0 if no bits are set, 1-indexed
-  size_t index = (size_t)__builtin_ffsll((int32_t)pool->free_bitset);
-  if (index == 0) {
-    critical_section_end(disabled);
+  size_t index = 0;
+  if (!prv_take(pool, &index)) {
     return NULL;
   }
+  prv_update_in_use(pool);
 
-  pool->free_bitset &= ~((uint64_t)1 << (index - 1));
-
-  critical_section_end(disabled);
+  // The node is ours now, so it can be reset without blocking other users of the pool
+  void *node = OBJPOOL_GET(pool, index);
+  memset(node, 0, pool->node_size);
+  if (pool->init_node != NULL) {
+    pool->init_node(node, pool->context);
+  }
 
-  return OBJPOOL_GET(pool, index - 1);
+  return node;
 }
 
 StatusCode objpool_free_node(ObjectPool *pool, void *node) {
-  bool disabled = critical_section_start();
-
   if (node == NULL || OBJPOOL_NODE_INVALID(pool, node)) {
-    critical_section_end(disabled);
     return status_code(STATUS_CODE_INVALID_ARGS);
   }
 
-  memset(node, 0, pool->node_size);
-  if (pool->init_node != NULL) {
-    pool->init_node(node, pool->context);
+  if (!prv_release(pool, OBJPOOL_GET_INDEX(pool, node))) {
+    return status_msg(STATUS_CODE_INVALID_ARGS, "Objpool: double free");
   }
 
-  pool->free_bitset |= ((uint64_t)1 << OBJPOOL_GET_INDEX(pool, node));
+  return STATUS_CODE_OK;
+}
+
+StatusCode objpool_get_stats(const ObjectPool *pool, ObjpoolStats *stats) {
+  if (stats == NULL) {
+    return status_code(STATUS_CODE_INVALID_ARGS);
+  }
 
+  bool disabled = critical_section_start();
+  *stats = pool->stats;
   critical_section_end(disabled);
 
   return STATUS_CODE_OK;
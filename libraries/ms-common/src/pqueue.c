@@ -7,6 +7,13 @@
 #include "pqueue.h"
 #include "status.h"
 
+// Sequence numbers wrap, so they're compared by their difference. This holds as long as a node
+// leaves the queue within 2^31 pushes of entering it - a low priority node that stays queued
+// while higher priority nodes are pushed and popped still counts those pushes, which is why
+// the sequence is 32 bits.
+#define PQUEUE_NODE_LESS(a, b) \
+  ((a).prio < (b).prio || ((a).prio == (b).prio && (int32_t)((a).seq - (b).seq) < 0))
+
 void pqueue_init(PQueue *queue, PQueueNode *nodes, size_t num_nodes) {
   bool disabled = critical_section_start();
   memset(queue, 0, sizeof(*queue));
@@ -26,15 +33,20 @@ StatusCode pqueue_push(PQueue *queue, void *data, uint16_t prio) {
     return status_code(STATUS_CODE_RESOURCE_EXHAUSTED);
   }
 
+  PQueueNode node = {
+    .data = data,              //
+    .prio = prio,              //
+    .seq = queue->next_seq++,  //
+  };
+
   // Begin at new leaf, bubble up
   size_t i = ++queue->size;
-  while (i != 1 && queue->nodes[i / 2].prio > prio) {
+  while (i != 1 && PQUEUE_NODE_LESS(node, queue->nodes[i / 2])) {
     queue->nodes[i] = queue->nodes[i / 2];
     i /= 2;
   }
 
-  queue->nodes[i].prio = prio;
-  queue->nodes[i].data = data;
+  queue->nodes[i] = node;
 
   critical_section_end(disabled);
 
@@ -57,11 +69,11 @@ void *pqueue_pop(PQueue *queue) {
   size_t i = 1, child = 2;
   while (child <= queue->size) {
     // Set child to min(left, right)
-    if (child < queue->size && queue->nodes[child].prio > queue->nodes[child + 1].prio) {
+    if (child < queue->size && PQUEUE_NODE_LESS(queue->nodes[child + 1], queue->nodes[child])) {
       child++;
     }
 
-    if (queue->nodes[last_elem].prio <= queue->nodes[child].prio) {
+    if (!PQUEUE_NODE_LESS(queue->nodes[child], queue->nodes[last_elem])) {
       break;
     }
 
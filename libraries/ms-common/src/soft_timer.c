@@ -0,0 +1,208 @@
+// Timers are kept in a queue ordered by expiry (see soft_timer_queue.h) and the hardware alarm is
+// always set to the queue's next event. Expired timers are freed before their callbacks run, so a
+// callback may immediately restart its timer.
+//
+// Periodic timers are instead put back in the queue at their next deadline before their callbacks
+// run. Deadlines are always a whole number of periods from the first, so callback latency doesn't
+// accumulate as drift.
+#include "soft_timer.h"
+
+#include <stddef.h>
+
+#include "critical_section.h"
+#include "misc.h"
+#include "objpool.h"
+#include "soft_timer_hw.h"
+#include "soft_timer_queue.h"
+
+typedef struct SoftTimer {
+  SoftTimerCallback callback;
+  void *context;
+  // 0 if the timer is not periodic
+  uint32_t period_us;
+  uint32_t overruns;
+  bool inuse;
+} SoftTimer;
+
+static SoftTimer s_storage[SOFT_TIMER_MAX_TIMERS];
+static SoftTimerNode s_nodes[SOFT_TIMER_MAX_TIMERS];
+static SoftTimerQueue s_queue;
+static ObjectPool s_pool;
+static volatile uint16_t s_active_timers = 0;
+
+#define SOFT_TIMER_GET_ID(timer) ((SoftTimerId)((timer)-s_storage))
+
+// Must be called from a critical section
+static void prv_update_alarm(void) {
+  uint64_t next_event_us = 0;
+  if (soft_timer_queue_next_event(&s_queue, &next_event_us)) {
+    soft_timer_hw_set_alarm(next_event_us);
+  } else {
+    soft_timer_hw_disable_alarm();
+  }
+}
+
+// Moves a periodic timer to its next deadline. If we've already missed it, we skip ahead to the
+// next deadline in the future rather than trying to catch up, counting the skipped periods.
+// Must be called from a critical section
+static void prv_reschedule(uint16_t node_id, uint64_t now_us) {
+  SoftTimer *timer = &s_storage[node_id];
+  SoftTimerNode *node = &s_nodes[node_id];
+
+  node->expiry_us += timer->period_us;
+  if (node->expiry_us <= now_us) {
+    uint64_t missed = (now_us - node->expiry_us) / timer->period_us + 1;
+    node->expiry_us += missed * timer->period_us;
+    timer->overruns = (uint32_t)MIN(timer->overruns + missed, UINT32_MAX);
+  }
+
+  soft_timer_queue_insert(&s_queue, node_id, now_us);
+}
+
+static StatusCode prv_start(uint32_t duration_us, uint32_t period_us, SoftTimerCallback callback,
+                            void *context, SoftTimerId *timer_id) {
+  if (duration_us < SOFT_TIMER_MIN_TIME_US) {
+    return status_msg(STATUS_CODE_INVALID_ARGS, "Soft timer too short!");
+  }
+
+  SoftTimer *timer = objpool_get_node(&s_pool);
+  if (timer == NULL) {
+    return status_msg(STATUS_CODE_RESOURCE_EXHAUSTED, "Out of software timers.");
+  }
+
+  SoftTimerId id = SOFT_TIMER_GET_ID(timer);
+  timer->callback = callback;
+  timer->context = context;
+  timer->period_us = period_us;
+  timer->overruns = 0;
+  timer->inuse = true;
+
+  if (timer_id != NULL) {
+    *timer_id = id;
+  }
+
+  bool disabled = critical_section_start();
+  uint64_t now_us = soft_timer_hw_get_time();
+  s_nodes[id].expiry_us = now_us + duration_us;
+
+  uint64_t prev_event_us = 0;
+  bool had_event = soft_timer_queue_next_event(&s_queue, &prev_event_us);
+  soft_timer_queue_insert(&s_queue, id, now_us);
+  s_active_timers++;
+
+  // Only touch the alarm if this timer is now the next thing to happen
+  uint64_t next_event_us = 0;
+  soft_timer_queue_next_event(&s_queue, &next_event_us);
+  if (!had_event || next_event_us != prev_event_us) {
+    soft_timer_hw_set_alarm(next_event_us);
+  }
+  critical_section_end(disabled);
+
+  return STATUS_CODE_OK;
+}
+
+static void prv_alarm_handler(void) {
+  bool disabled = critical_section_start();
+
+  uint64_t now_us = soft_timer_hw_get_time();
+  uint16_t node_id = SOFT_TIMER_NODE_INVALID;
+  while ((node_id = soft_timer_queue_pop_expired(&s_queue, now_us)) != SOFT_TIMER_NODE_INVALID) {
+    SoftTimer *timer = &s_storage[node_id];
+    SoftTimerCallback callback = timer->callback;
+    void *context = timer->context;
+
+    if (timer->period_us != 0) {
+      prv_reschedule(node_id, now_us);
+    } else {
+      s_active_timers--;
+      // Nodes are only reset when they're handed out again
+      timer->inuse = false;
+      objpool_free_node(&s_pool, timer);
+    }
+
+    // Run the callback outside of the critical section so other interrupts are serviced
+    critical_section_end(disabled);
+    callback(node_id, context);
+    disabled = critical_section_start();
+
+    now_us = soft_timer_hw_get_time();
+  }
+
+  prv_update_alarm();
+  critical_section_end(disabled);
+}
+
+void soft_timer_init(void) {
+  soft_timer_hw_init(prv_alarm_handler);
+
+  objpool_init(&s_pool, s_storage, NULL, NULL);
+  soft_timer_queue_init(&s_queue, s_nodes, soft_timer_hw_get_time());
+  s_active_timers = 0;
+
+  soft_timer_hw_disable_alarm();
+}
+
+StatusCode soft_timer_start(uint32_t duration_us, SoftTimerCallback callback, void *context,
+                            SoftTimerId *timer_id) {
+  return prv_start(duration_us, 0, callback, context, timer_id);
+}
+
+StatusCode soft_timer_start_periodic(uint32_t period_us, SoftTimerCallback callback, void *context,
+                                     SoftTimerId *timer_id) {
+  return prv_start(period_us, period_us, callback, context, timer_id);
+}
+
+bool soft_timer_cancel(SoftTimerId timer_id) {
+  if (timer_id >= SOFT_TIMER_MAX_TIMERS) {
+    return false;
+  }
+
+  bool disabled = critical_section_start();
+  if (!s_storage[timer_id].inuse) {
+    critical_section_end(disabled);
+    return false;
+  }
+
+  soft_timer_queue_remove(&s_queue, timer_id);
+  s_active_timers--;
+  s_storage[timer_id].inuse = false;
+  objpool_free_node(&s_pool, &s_storage[timer_id]);
+
+  // Leave the alarm alone - at worst it fires early and is reset to the next event
+  critical_section_end(disabled);
+  return true;
+}
+
+bool soft_timer_inuse(void) {
+  return s_active_timers > 0;
+}
+
+uint32_t soft_timer_remaining_time(SoftTimerId timer_id) {
+  if (timer_id >= SOFT_TIMER_MAX_TIMERS) {
+    return 0;
+  }
+
+  bool disabled = critical_section_start();
+  uint32_t remaining_us = 0;
+  if (s_storage[timer_id].inuse) {
+    uint64_t now_us = soft_timer_hw_get_time();
+    if (s_nodes[timer_id].expiry_us > now_us) {
+      remaining_us = (uint32_t)MIN(s_nodes[timer_id].expiry_us - now_us, UINT32_MAX);
+    }
+  }
+  critical_section_end(disabled);
+
+  return remaining_us;
+}
+
+uint32_t soft_timer_get_overruns(SoftTimerId timer_id) {
+  if (timer_id >= SOFT_TIMER_MAX_TIMERS || !s_storage[timer_id].inuse) {
+    return 0;
+  }
+
+  return s_storage[timer_id].overruns;
+}
+
+uint64_t soft_timer_get_time(void) {
+  return soft_timer_hw_get_time();
+}
@@ -0,0 +1,68 @@
+#include "soft_timer_queue.h"
+
+void soft_timer_list_init(SoftTimerList *list, SoftTimerNode *nodes, uint64_t now_us) {
+  list->nodes = nodes;
+  list->head = SOFT_TIMER_NODE_INVALID;
+}
+
+void soft_timer_list_insert(SoftTimerList *list, uint16_t node_id, uint64_t now_us) {
+  SoftTimerNode *node = &list->nodes[node_id];
+  uint16_t prev_id = SOFT_TIMER_NODE_INVALID;
+  uint16_t next_id = list->head;
+
+  // Find the first node that expires at or after this one
+  while (next_id != SOFT_TIMER_NODE_INVALID &&
+         list->nodes[next_id].expiry_us < node->expiry_us) {
+    prev_id = next_id;
+    next_id = list->nodes[next_id].next;
+  }
+
+  node->prev = prev_id;
+  node->next = next_id;
+
+  if (next_id != SOFT_TIMER_NODE_INVALID) {
+    list->nodes[next_id].prev = node_id;
+  }
+
+  if (prev_id != SOFT_TIMER_NODE_INVALID) {
+    list->nodes[prev_id].next = node_id;
+  } else {
+    list->head = node_id;
+  }
+}
+
+void soft_timer_list_remove(SoftTimerList *list, uint16_t node_id) {
+  SoftTimerNode *node = &list->nodes[node_id];
+
+  if (node->prev != SOFT_TIMER_NODE_INVALID) {
+    list->nodes[node->prev].next = node->next;
+  } else {
+    list->head = node->next;
+  }
+
+  if (node->next != SOFT_TIMER_NODE_INVALID) {
+    list->nodes[node->next].prev = node->prev;
+  }
+
+  node->next = SOFT_TIMER_NODE_INVALID;
+  node->prev = SOFT_TIMER_NODE_INVALID;
+}
+
+bool soft_timer_list_next_event(const SoftTimerList *list, uint64_t *time_us) {
+  if (list->head == SOFT_TIMER_NODE_INVALID) {
+    return false;
+  }
+
+  *time_us = list->nodes[list->head].expiry_us;
+  return true;
+}
+
+uint16_t soft_timer_list_pop_expired(SoftTimerList *list, uint64_t now_us) {
+  uint16_t node_id = list->head;
+  if (node_id == SOFT_TIMER_NODE_INVALID || list->nodes[node_id].expiry_us > now_us) {
+    return SOFT_TIMER_NODE_INVALID;
+  }
+
+  soft_timer_list_remove(list, node_id);
+  return node_id;
+}
@@ -0,0 +1,308 @@
+#include <stddef.h>
+
+#include "misc.h"
+#include "soft_timer_queue.h"
+
+// Special values of SoftTimerNode.level for nodes that aren't in a slot
+#define SOFT_TIMER_WHEEL_LEVEL_OVERFLOW SOFT_TIMER_WHEEL_NUM_LEVELS
+#define SOFT_TIMER_WHEEL_LEVEL_EXPIRED (SOFT_TIMER_WHEEL_NUM_LEVELS + 1)
+
+#define SOFT_TIMER_WHEEL_SLOT_MASK (SOFT_TIMER_WHEEL_NUM_SLOTS - 1)
+// Number of time bits covered by the wheel
+#define SOFT_TIMER_WHEEL_BITS (SOFT_TIMER_WHEEL_NUM_LEVELS * SOFT_TIMER_WHEEL_SLOT_BITS)
+
+_Static_assert(SOFT_TIMER_WHEEL_NUM_SLOTS <= 32, "Slot occupancy must fit in a uint32_t");
+
+static uint16_t *prv_list_head(SoftTimerWheel *wheel, uint8_t level, uint8_t slot) {
+  if (level == SOFT_TIMER_WHEEL_LEVEL_OVERFLOW) {
+    return &wheel->overflow;
+  } else if (level == SOFT_TIMER_WHEEL_LEVEL_EXPIRED) {
+    return &wheel->expired_head;
+  }
+
+  return &wheel->slots[level][slot];
+}
+
+// Returns a mask of slots [0, slot]
+static uint32_t prv_slots_up_to(uint32_t slot) {
+  return UINT32_MAX >> (31 - slot);
+}
+
+static void prv_push_front(SoftTimerWheel *wheel, uint16_t node_id, uint8_t level, uint8_t slot) {
+  SoftTimerNode *node = &wheel->nodes[node_id];
+  uint16_t *head = prv_list_head(wheel, level, slot);
+
+  node->level = level;
+  node->slot = slot;
+  node->prev = SOFT_TIMER_NODE_INVALID;
+  node->next = *head;
+  if (*head != SOFT_TIMER_NODE_INVALID) {
+    wheel->nodes[*head].prev = node_id;
+  }
+  *head = node_id;
+}
+
+// Expired nodes are kept in FIFO order so they're popped in the order they expired.
+static void prv_push_expired(SoftTimerWheel *wheel, uint16_t node_id) {
+  SoftTimerNode *node = &wheel->nodes[node_id];
+
+  node->level = SOFT_TIMER_WHEEL_LEVEL_EXPIRED;
+  node->slot = 0;
+  node->next = SOFT_TIMER_NODE_INVALID;
+  node->prev = wheel->expired_tail;
+  if (wheel->expired_tail != SOFT_TIMER_NODE_INVALID) {
+    wheel->nodes[wheel->expired_tail].next = node_id;
+  } else {
+    wheel->expired_head = node_id;
+  }
+  wheel->expired_tail = node_id;
+}
+
+// Places the node relative to the wheel's current time.
+static void prv_place(SoftTimerWheel *wheel, uint16_t node_id) {
+  uint64_t expiry_us = wheel->nodes[node_id].expiry_us;
+
+  if (expiry_us <= wheel->time_us) {
+    prv_push_expired(wheel, node_id);
+    return;
+  }
+
+  wheel->next_expiry_us = MIN(wheel->next_expiry_us, expiry_us);
+
+  uint64_t diff = expiry_us ^ wheel->time_us;
+  if ((diff >> SOFT_TIMER_WHEEL_BITS) != 0) {
+    prv_push_front(wheel, node_id, SOFT_TIMER_WHEEL_LEVEL_OVERFLOW, 0);
+    return;
+  }
+
+  uint8_t level = (uint8_t)((63 - __builtin_clzll(diff)) / SOFT_TIMER_WHEEL_SLOT_BITS);
+  uint8_t slot =
+      (uint8_t)((expiry_us >> (level * SOFT_TIMER_WHEEL_SLOT_BITS)) & SOFT_TIMER_WHEEL_SLOT_MASK);
+
+  prv_push_front(wheel, node_id, level, slot);
+  wheel->occupied[level] |= 1u << slot;
+}
+
+// Returns the earliest expiry in a list of nodes.
+static uint64_t prv_min_expiry(const SoftTimerWheel *wheel, uint16_t node_id) {
+  uint64_t min_us = UINT64_MAX;
+  while (node_id != SOFT_TIMER_NODE_INVALID) {
+    min_us = MIN(min_us, wheel->nodes[node_id].expiry_us);
+    node_id = wheel->nodes[node_id].next;
+  }
+
+  return min_us;
+}
+
+// Returns the earliest expiry of any node that hasn't expired yet, or UINT64_MAX if there are
+// none. Every node in a lower level expires before any node in a higher one, and slots within a
+// level are in order, so only the first slot of the lowest occupied level needs to be searched.
+static uint64_t prv_find_next_expiry(const SoftTimerWheel *wheel) {
+  for (size_t level = 0; level < SOFT_TIMER_WHEEL_NUM_LEVELS; level++) {
+    if (wheel->occupied[level] != 0) {
+      uint32_t slot = (uint32_t)__builtin_ctz(wheel->occupied[level]);
+      if (level == 0) {
+        // Level 0 slots are a single microsecond wide
+        return (wheel->time_us & ~(uint64_t)SOFT_TIMER_WHEEL_SLOT_MASK) | slot;
+      }
+      return prv_min_expiry(wheel, wheel->slots[level][slot]);
+    }
+  }
+
+  return prv_min_expiry(wheel, wheel->overflow);
+}
+
+// Moves the wheel to |time_us|, redistributing the nodes of every slot that was passed.
+static void prv_advance(SoftTimerWheel *wheel, uint64_t time_us) {
+  // Nodes to redistribute - only |next| is used while they're in this list
+  uint16_t pending = SOFT_TIMER_NODE_INVALID;
+
+  for (size_t level = 0; level < SOFT_TIMER_WHEEL_NUM_LEVELS; level++) {
+    unsigned int shift = (unsigned int)level * SOFT_TIMER_WHEEL_SLOT_BITS;
+    uint64_t old_digits = wheel->time_us >> shift;
+    uint64_t new_digits = time_us >> shift;
+    if (old_digits == new_digits) {
+      // Higher levels can't have changed either
+      break;
+    }
+
+    uint32_t passed = prv_slots_up_to(SOFT_TIMER_WHEEL_SLOT_MASK);
+    if ((old_digits >> SOFT_TIMER_WHEEL_SLOT_BITS) == (new_digits >> SOFT_TIMER_WHEEL_SLOT_BITS)) {
+      // Still in the same rotation - only slots (old, new] were passed
+      passed = prv_slots_up_to((uint32_t)(new_digits & SOFT_TIMER_WHEEL_SLOT_MASK)) &
+               ~prv_slots_up_to((uint32_t)(old_digits & SOFT_TIMER_WHEEL_SLOT_MASK));
+    }
+    passed &= wheel->occupied[level];
+    wheel->occupied[level] &= ~passed;
+
+    while (passed != 0) {
+      uint32_t slot = (uint32_t)__builtin_ctz(passed);
+      passed &= passed - 1;
+
+      uint16_t node_id = wheel->slots[level][slot];
+      wheel->slots[level][slot] = SOFT_TIMER_NODE_INVALID;
+      while (node_id != SOFT_TIMER_NODE_INVALID) {
+        uint16_t next_id = wheel->nodes[node_id].next;
+        wheel->nodes[node_id].next = pending;
+        pending = node_id;
+        node_id = next_id;
+      }
+    }
+  }
+
+  if ((wheel->time_us >> SOFT_TIMER_WHEEL_BITS) != (time_us >> SOFT_TIMER_WHEEL_BITS)) {
+    uint16_t node_id = wheel->overflow;
+    wheel->overflow = SOFT_TIMER_NODE_INVALID;
+    while (node_id != SOFT_TIMER_NODE_INVALID) {
+      uint16_t next_id = wheel->nodes[node_id].next;
+      wheel->nodes[node_id].next = pending;
+      pending = node_id;
+      node_id = next_id;
+    }
+  }
+
+  wheel->time_us = time_us;
+
+  while (pending != SOFT_TIMER_NODE_INVALID) {
+    uint16_t next_id = wheel->nodes[pending].next;
+    prv_place(wheel, pending);
+    pending = next_id;
+  }
+
+  // Every node left is still pending if the earliest one is
+  if (wheel->next_expiry_us <= time_us) {
+    wheel->next_expiry_us = prv_find_next_expiry(wheel);
+  }
+}
+
+// Moves the wheel to the earliest expiry. Every level below the one that node is in is empty, so
+// that node's slot is the only one passed and we can skip straight to it.
+static void prv_advance_to_next_expiry(SoftTimerWheel *wheel) {
+  uint64_t time_us = wheel->next_expiry_us;
+  uint64_t diff = time_us ^ wheel->time_us;
+  if ((diff >> SOFT_TIMER_WHEEL_BITS) != 0) {
+    // The node is in the overflow list
+    prv_advance(wheel, time_us);
+    return;
+  }
+
+  uint8_t level = (uint8_t)((63 - __builtin_clzll(diff)) / SOFT_TIMER_WHEEL_SLOT_BITS);
+  uint8_t slot =
+      (uint8_t)((time_us >> (level * SOFT_TIMER_WHEEL_SLOT_BITS)) & SOFT_TIMER_WHEEL_SLOT_MASK);
+
+  uint16_t node_id = wheel->slots[level][slot];
+  wheel->slots[level][slot] = SOFT_TIMER_NODE_INVALID;
+  wheel->occupied[level] &= ~(1u << slot);
+  wheel->time_us = time_us;
+
+  while (node_id != SOFT_TIMER_NODE_INVALID) {
+    uint16_t next_id = wheel->nodes[node_id].next;
+    prv_place(wheel, node_id);
+    node_id = next_id;
+  }
+
+  wheel->next_expiry_us = prv_find_next_expiry(wheel);
+}
+
+// Jumps to each expiry up to |now_us| in turn so nodes expire in order. Nothing happens between
+// expiries, so the wheel never stops at a slot just to redistribute it.
+static void prv_update(SoftTimerWheel *wheel, uint64_t now_us) {
+  if (now_us <= wheel->time_us) {
+    // Nodes in the wheel always expire after the current time, so there's nothing to do
+    return;
+  }
+
+  while (wheel->next_expiry_us <= now_us) {
+    prv_advance_to_next_expiry(wheel);
+  }
+
+  // Nothing else is due by now, so this just moves the wheel forward. Keeping the wheel close to
+  // the actual time places new nodes in the lowest possible level.
+  if (now_us > wheel->time_us) {
+    prv_advance(wheel, now_us);
+  }
+}
+
+void soft_timer_wheel_init(SoftTimerWheel *wheel, SoftTimerNode *nodes, uint64_t now_us) {
+  wheel->nodes = nodes;
+  wheel->time_us = now_us;
+
+  for (size_t level = 0; level < SOFT_TIMER_WHEEL_NUM_LEVELS; level++) {
+    wheel->occupied[level] = 0;
+    for (size_t slot = 0; slot < SOFT_TIMER_WHEEL_NUM_SLOTS; slot++) {
+      wheel->slots[level][slot] = SOFT_TIMER_NODE_INVALID;
+    }
+  }
+
+  wheel->overflow = SOFT_TIMER_NODE_INVALID;
+  wheel->next_expiry_us = UINT64_MAX;
+  wheel->expired_head = SOFT_TIMER_NODE_INVALID;
+  wheel->expired_tail = SOFT_TIMER_NODE_INVALID;
+}
+
+void soft_timer_wheel_insert(SoftTimerWheel *wheel, uint16_t node_id, uint64_t now_us) {
+  prv_update(wheel, now_us);
+  prv_place(wheel, node_id);
+}
+
+void soft_timer_wheel_remove(SoftTimerWheel *wheel, uint16_t node_id) {
+  SoftTimerNode *node = &wheel->nodes[node_id];
+
+  if (node->prev != SOFT_TIMER_NODE_INVALID) {
+    wheel->nodes[node->prev].next = node->next;
+  } else {
+    *prv_list_head(wheel, node->level, node->slot) = node->next;
+  }
+
+  if (node->next != SOFT_TIMER_NODE_INVALID) {
+    wheel->nodes[node->next].prev = node->prev;
+  } else if (node->level == SOFT_TIMER_WHEEL_LEVEL_EXPIRED) {
+    wheel->expired_tail = node->prev;
+  }
+
+  if (node->level < SOFT_TIMER_WHEEL_NUM_LEVELS &&
+      wheel->slots[node->level][node->slot] == SOFT_TIMER_NODE_INVALID) {
+    wheel->occupied[node->level] &= ~(1u << node->slot);
+  }
+
+  node->next = SOFT_TIMER_NODE_INVALID;
+  node->prev = SOFT_TIMER_NODE_INVALID;
+
+  if (node->level != SOFT_TIMER_WHEEL_LEVEL_EXPIRED && node->expiry_us == wheel->next_expiry_us) {
+    wheel->next_expiry_us = prv_find_next_expiry(wheel);
+  }
+}
+
+bool soft_timer_wheel_next_event(const SoftTimerWheel *wheel, uint64_t *time_us) {
+  if (wheel->expired_head != SOFT_TIMER_NODE_INVALID) {
+    *time_us = wheel->time_us;
+    return true;
+  }
+
+  if (wheel->next_expiry_us == UINT64_MAX) {
+    return false;
+  }
+
+  *time_us = wheel->next_expiry_us;
+  return true;
+}
+
+uint16_t soft_timer_wheel_pop_expired(SoftTimerWheel *wheel, uint64_t now_us) {
+  prv_update(wheel, now_us);
+
+  uint16_t node_id = wheel->expired_head;
+  if (node_id == SOFT_TIMER_NODE_INVALID) {
+    return SOFT_TIMER_NODE_INVALID;
+  }
+
+  SoftTimerNode *node = &wheel->nodes[node_id];
+  wheel->expired_head = node->next;
+  if (node->next != SOFT_TIMER_NODE_INVALID) {
+    wheel->nodes[node->next].prev = SOFT_TIMER_NODE_INVALID;
+  } else {
+    wheel->expired_tail = SOFT_TIMER_NODE_INVALID;
+  }
+
+  node->next = SOFT_TIMER_NODE_INVALID;
+  return node_id;
+}
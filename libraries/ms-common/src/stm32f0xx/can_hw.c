@@ -5,7 +5,9 @@
 #include "stm32f0xx.h"
 
 #define CAN_HW_BASE CAN
-#define CAN_HW_NUM_FILTER_BANKS 14
+#define CAN_HW_STANDARD_MASK 0x7FF
+// 16-bit scale filters hold 4 values per bank: two mask/ID pairs or four IDs
+#define CAN_HW_FILTER_16BIT_VALUES 4
 
 typedef struct CanHwTiming {
   uint16_t prescaler;
@@ -29,6 +31,7 @@ static CanHwTiming s_timing[NUM_CAN_HW_BITRATES] = {  // For 48MHz clock
   [CAN_HW_BITRATE_1000KBPS] = { .prescaler = 3, .bs1 = 12, .bs2 = 1 }
 };
 static CanHwEventHandler s_handlers[NUM_CAN_HW_EVENTS];
+// Filter banks in use
 static uint8_t s_num_filters;
 
 static void prv_add_filter(uint8_t filter_num, uint32_t mask, uint32_t filter) {
@@ -47,6 +50,44 @@ static void prv_add_filter(uint8_t filter_num, uint32_t mask, uint32_t filter) {
   CAN_FilterInit(&filter_cfg);
 }
 
+// Standard ID only. |values| are ID, mask, ID, mask in mask mode or four IDs in list mode.
+static void prv_add_filter_16bit(uint8_t filter_num, uint8_t mode, const uint16_t *values) {
+  CAN_FilterInitTypeDef filter_cfg = {
+    .CAN_FilterNumber = filter_num,
+    .CAN_FilterMode = mode,
+    .CAN_FilterScale = CAN_FilterScale_16bit,
+    .CAN_FilterIdLow = values[0],
+    .CAN_FilterMaskIdLow = values[1],
+    .CAN_FilterIdHigh = values[2],
+    .CAN_FilterMaskIdHigh = values[3],
+    .CAN_FilterFIFOAssignment = (filter_num % 2),
+    .CAN_FilterActivation = ENABLE,
+  };
+
+  CAN_FilterInit(&filter_cfg);
+}
+
+static void prv_disable_filter(uint8_t filter_num) {
+  CAN_FilterInitTypeDef filter_cfg = {
+    .CAN_FilterNumber = filter_num,
+    .CAN_FilterActivation = DISABLE,
+  };
+
+  CAN_FilterInit(&filter_cfg);
+}
+
+static void prv_add_mask_filter(uint8_t filter_num, uint32_t mask, uint32_t filter,
+                                bool extended) {
+  // 32-bit Filter - Identifer Mask
+  // STID[10:3] | STID[2:0] EXID[17:13] | EXID[12:5] | EXID[4:0] [IDE] [RTR] 0
+  size_t offset = extended ? 3 : 21;
+  // We always set the IDE bit for the mask so we distinguish between standard and extended
+  uint32_t mask_val = (mask << offset) | (1 << 2);
+  uint32_t filter_val = (filter << offset) | ((uint32_t)extended << 2);
+
+  prv_add_filter(filter_num, mask_val, filter_val);
+}
+
 StatusCode can_hw_init(const CanHwSettings *settings) {
   memset(s_handlers, 0, sizeof(s_handlers));
   s_num_filters = 0;
@@ -106,18 +147,92 @@ StatusCode can_hw_add_filter(uint32_t mask, uint32_t filter, bool extended) {
     return status_msg(STATUS_CODE_RESOURCE_EXHAUSTED, "CAN HW: Ran out of filter banks.");
   }
 
-  // 32-bit Filter - Identifer Mask
-  // STID[10:3] | STID[2:0] EXID[17:13] | EXID[12:5] | EXID[4:0] [IDE] [RTR] 0
-  size_t offset = extended ? 3 : 21;
-  // We always set the IDE bit for the mask so we distinguish between standard and extended
-  uint32_t mask_val = (mask << offset) | (1 << 2);
-  uint32_t filter_val = (filter << offset) | ((uint32_t)extended << 2);
-
-  prv_add_filter(s_num_filters, mask_val, filter_val);
+  prv_add_mask_filter(s_num_filters, mask, filter, extended);
   s_num_filters++;
   return STATUS_CODE_OK;
 }
 
+StatusCode can_hw_set_filters(const CanHwFilter *filters, size_t num_filters) {
+  if (filters == NULL && num_filters > 0) {
+    return status_code(STATUS_CODE_INVALID_ARGS);
+  }
+
+  // Standard ID filters are packed in 16-bit scale - exact IDs in list mode, the rest in mask mode
+  size_t num_exact = 0;
+  size_t num_masked = 0;
+  size_t num_extended = 0;
+  for (size_t i = 0; i < num_filters; i++) {
+    if (filters[i].extended) {
+      num_extended++;
+    } else if ((filters[i].mask & CAN_HW_STANDARD_MASK) == CAN_HW_STANDARD_MASK) {
+      num_exact++;
+    } else {
+      num_masked++;
+    }
+  }
+
+  size_t num_banks = num_extended + (num_masked + 1) / 2 + (num_exact + 3) / 4;
+  if (num_banks > CAN_HW_NUM_FILTER_BANKS) {
+    return status_msg(STATUS_CODE_RESOURCE_EXHAUSTED, "CAN HW: Ran out of filter banks.");
+  }
+
+  // 16-bit Filter
+  // STID[10:3] | STID[2:0] RTR IDE EXID[17:15]
+  uint16_t exact[CAN_HW_FILTER_16BIT_VALUES] = { 0 };
+  uint16_t masked[CAN_HW_FILTER_16BIT_VALUES] = { 0 };
+  size_t exact_index = 0;
+  size_t masked_index = 0;
+  uint8_t filter_num = 0;
+
+  for (size_t i = 0; i < num_filters; i++) {
+    const CanHwFilter *filter = &filters[i];
+    uint16_t filter_val = (uint16_t)((filter->filter & CAN_HW_STANDARD_MASK) << 5);
+
+    if (filter->extended) {
+      prv_add_mask_filter(filter_num++, filter->mask, filter->filter, true);
+    } else if ((filter->mask & CAN_HW_STANDARD_MASK) == CAN_HW_STANDARD_MASK) {
+      exact[exact_index++] = filter_val;
+      if (exact_index == CAN_HW_FILTER_16BIT_VALUES) {
+        prv_add_filter_16bit(filter_num++, CAN_FilterMode_IdList, exact);
+        exact_index = 0;
+      }
+    } else {
+      // Always match IDE so extended IDs are rejected
+      masked[masked_index++] = filter_val;
+      masked[masked_index++] = (uint16_t)(((filter->mask & CAN_HW_STANDARD_MASK) << 5) | (1 << 3));
+      if (masked_index == CAN_HW_FILTER_16BIT_VALUES) {
+        prv_add_filter_16bit(filter_num++, CAN_FilterMode_IdMask, masked);
+        masked_index = 0;
+      }
+    }
+  }
+
+  // Fill partial banks by repeating their last ID or mask/ID pair
+  if (exact_index > 0) {
+    for (size_t i = exact_index; i < CAN_HW_FILTER_16BIT_VALUES; i++) {
+      exact[i] = exact[exact_index - 1];
+    }
+    prv_add_filter_16bit(filter_num++, CAN_FilterMode_IdList, exact);
+  }
+  if (masked_index > 0) {
+    masked[2] = masked[0];
+    masked[3] = masked[1];
+    prv_add_filter_16bit(filter_num++, CAN_FilterMode_IdMask, masked);
+  }
+
+  for (uint8_t i = filter_num; i < s_num_filters; i++) {
+    prv_disable_filter(i);
+  }
+
+  if (filter_num == 0) {
+    // Allow all messages, but overwrite it on the next filter
+    prv_add_filter(0, 0, 0);
+  }
+  s_num_filters = filter_num;
+
+  return STATUS_CODE_OK;
+}
+
 CanHwBusStatus can_hw_bus_status(void) {
   if (CAN_GetFlagStatus(CAN_HW_BASE, CAN_FLAG_BOF) == SET) {
     return CAN_HW_BUS_STATUS_OFF;
@@ -129,6 +244,11 @@ CanHwBusStatus can_hw_bus_status(void) {
   return CAN_HW_BUS_STATUS_OK;
 }
 
+void can_hw_get_error_counters(uint8_t *tx_errors, uint8_t *rx_errors) {
+  *tx_errors = CAN_GetLSBTransmitErrorCounter(CAN_HW_BASE);
+  *rx_errors = CAN_GetReceiveErrorCounter(CAN_HW_BASE);
+}
+
 StatusCode can_hw_transmit(uint32_t id, bool extended, const uint8_t *data, size_t len) {
   // We can set both since the used ID is determined by tx_msg.IDE
   CanTxMsg tx_msg = {
@@ -1,7 +1,17 @@
 #include "crc32.h"
+#include <string.h>
 #include "log.h"
 #include "stm32f0xx.h"
 
+// The peripheral holds the CRC bit-reversed, so streams are resumed by loading the reversed state
+// into the initial value register. The M0 has no RBIT instruction.
+static uint32_t prv_reverse_bits(uint32_t value) {
+  value = ((value >> 1) & 0x55555555) | ((value & 0x55555555) << 1);
+  value = ((value >> 2) & 0x33333333) | ((value & 0x33333333) << 2);
+  value = ((value >> 4) & 0x0F0F0F0F) | ((value & 0x0F0F0F0F) << 4);
+  return __REV(value);
+}
+
 StatusCode crc32_init(void) {
   RCC_AHBPeriphClockCmd(RCC_AHBPeriph_CRC, ENABLE);
   CRC_ReverseInputDataSelect(CRC_ReverseInputData_32bits);
@@ -10,20 +20,49 @@ StatusCode crc32_init(void) {
   return STATUS_CODE_OK;
 }
 
-uint32_t crc32_arr(const uint8_t *buffer, size_t buffer_len) {
+void crc32_start(Crc32 *crc) {
+  crc->state = 0xFFFFFFFF;
+}
+
+void crc32_update(Crc32 *crc, const uint8_t *buffer, size_t buffer_len) {
+  CRC_SetInitRegister(prv_reverse_bits(crc->state));
   CRC_ResetDR();
 
   // The CRC32 peripheral consumes words (u32) by default - split into u32 and remaining bytes
   // so we can process the remaining bytes separately
   size_t num_u32 = buffer_len / sizeof(uint32_t);
   size_t remaining_bytes = buffer_len % sizeof(uint32_t);
-  uint32_t crc = CRC_CalcBlockCRC((const uint32_t *)buffer, num_u32);
+  uint32_t state = CRC->DR;
+
+  if (((uintptr_t)buffer % sizeof(uint32_t)) == 0) {
+    if (num_u32 > 0) {
+      state = CRC_CalcBlockCRC((uint32_t *)buffer, num_u32);
+    }
+  } else {
+    // The M0 faults on unaligned word loads, so assemble each word first
+    for (size_t i = 0; i < num_u32; i++) {
+      uint32_t word = 0;
+      memcpy(&word, buffer + i * sizeof(uint32_t), sizeof(word));
+      state = CRC_CalcCRC(word);
+    }
+  }
 
   // Consume remaining bytes that did not take up a whole word
   const uint8_t *data = buffer + (num_u32 * sizeof(uint32_t));
   for (size_t i = 0; i < remaining_bytes; i++) {
-    crc = CRC_CalcCRC8bits(data[i]);
+    state = CRC_CalcCRC8bits(data[i]);
   }
 
-  return ~crc;
+  crc->state = state;
+}
+
+uint32_t crc32_final(const Crc32 *crc) {
+  return ~crc->state;
+}
+
+uint32_t crc32_arr(const uint8_t *buffer, size_t buffer_len) {
+  Crc32 crc;
+  crc32_start(&crc);
+  crc32_update(&crc, buffer, buffer_len);
+  return crc32_final(&crc);
 }
@@ -2,9 +2,20 @@
 
 #include <stdint.h>
 
+#include "misc.h"
+#include "soft_timer.h"
 #include "stm32f0xx_tim.h"
 
 void _test_soft_timer_set_counter(uint32_t counter_value) {
   TIM_SetCounter(TIM2, counter_value);
   return;
 }
+
+// Soft timers always run in real time on hardware
+uint64_t _test_benchmark_get_time(void) {
+  return soft_timer_get_time();
+}
+
+uint32_t _test_benchmark_elapsed_us(uint64_t start_us) {
+  return (uint32_t)MIN(_test_benchmark_get_time() - start_us, UINT32_MAX);
+}
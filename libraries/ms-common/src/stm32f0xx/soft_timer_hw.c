@@ -0,0 +1,95 @@
+// TIM2 is a 32-bit timer running at 1 MHz. We extend it to 64 bits by counting rollovers and use
+// the CC1 compare for the alarm. A compare only looks at the lower 32 bits, so an alarm more than
+// a rollover away fires early - the soft timer core handles this by checking the time.
+#include "soft_timer_hw.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "critical_section.h"
+#include "interrupt.h"
+#include "misc.h"
+#include "soft_timer.h"
+#include "stm32f0xx.h"
+
+static SoftTimerHwCallback s_callback = NULL;
+static volatile uint32_t s_rollover_count = 0;
+
+void soft_timer_hw_init(SoftTimerHwCallback callback) {
+  s_callback = callback;
+  s_rollover_count = 0;
+
+  RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM2, ENABLE);
+
+  TIM_Cmd(TIM2, DISABLE);
+  TIM_ITConfig(TIM2, TIM_IT_CC1, DISABLE);
+  TIM_ITConfig(TIM2, TIM_IT_Update, DISABLE);
+
+  RCC_ClocksTypeDef clocks;
+  RCC_GetClocksFreq(&clocks);
+
+  TIM_TimeBaseInitTypeDef timer_init = {
+    .TIM_Prescaler = (clocks.PCLK_Frequency / 1000000) - 1,  // 1 Mhz
+    .TIM_CounterMode = TIM_CounterMode_Up,
+    .TIM_Period = UINT32_MAX,
+    .TIM_ClockDivision = TIM_CKD_DIV1,
+  };
+  TIM_TimeBaseInit(TIM2, &timer_init);
+
+  // Make sure the compare flag won't trigger from setting the counter
+  TIM_ClearITPendingBit(TIM2, TIM_IT_CC1);
+  TIM_SetCounter(TIM2, 0);
+
+  // Update on overflows only. Clear any pending overflows.
+  TIM_UpdateRequestConfig(TIM2, TIM_UpdateSource_Regular);
+  TIM_ClearITPendingBit(TIM2, TIM_IT_Update);
+
+  stm32f0xx_interrupt_nvic_enable(TIM2_IRQn, INTERRUPT_PRIORITY_NORMAL);
+
+  TIM_Cmd(TIM2, ENABLE);
+
+  TIM_ITConfig(TIM2, TIM_IT_Update, ENABLE);
+}
+
+uint64_t soft_timer_hw_get_time(void) {
+  bool disabled = critical_section_start();
+  uint32_t rollover_count = s_rollover_count;
+  uint32_t counter = TIM_GetCounter(TIM2);
+  if (TIM_GetFlagStatus(TIM2, TIM_FLAG_Update) == SET) {
+    // We rolled over but haven't serviced the interrupt yet - the counter may have been read
+    // before or after the rollover, so read it again now that we know it's after.
+    counter = TIM_GetCounter(TIM2);
+    rollover_count++;
+  }
+  critical_section_end(disabled);
+
+  return ((uint64_t)rollover_count << 32) | counter;
+}
+
+void soft_timer_hw_set_alarm(uint64_t time_us) {
+  // We enforce a minimum interval between interrupts so we don't miss the compare.
+  uint64_t min_time_us = soft_timer_hw_get_time() + SOFT_TIMER_MIN_TIME_US;
+
+  TIM_SetCompare1(TIM2, (uint32_t)MAX(time_us, min_time_us));
+  TIM_ClearITPendingBit(TIM2, TIM_IT_CC1);
+  TIM_ITConfig(TIM2, TIM_IT_CC1, ENABLE);
+}
+
+void soft_timer_hw_disable_alarm(void) {
+  TIM_ITConfig(TIM2, TIM_IT_CC1, DISABLE);
+}
+
+void TIM2_IRQHandler(void) {
+  if (TIM_GetITStatus(TIM2, TIM_IT_CC1) == SET) {
+    TIM_ClearITPendingBit(TIM2, TIM_IT_CC1);
+    s_callback();
+  }
+
+  if (TIM_GetITStatus(TIM2, TIM_IT_Update) == SET) {
+    // The count and flag must change together so the time can't jump while reading it
+    bool disabled = critical_section_start();
+    s_rollover_count++;
+    TIM_ClearITPendingBit(TIM2, TIM_IT_Update);
+    critical_section_end(disabled);
+  }
+}
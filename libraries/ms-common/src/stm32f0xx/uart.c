@@ -55,7 +55,7 @@ StatusCode uart_init(UartPort uart, UartSettings *settings, UartStorage *storage
   s_port[uart].storage->context = settings->context;
   s_port[uart].storage->delimiter = '\n';
   fifo_init(&s_port[uart].storage->tx_fifo, s_port[uart].storage->tx_buf);
-  fifo_init(&s_port[uart].storage->rx_fifo, s_port[uart].storage->rx_buf);
+  uart_rx_ring_init(&s_port[uart].storage->rx_ring);
 
   GpioSettings gpio_settings = {
     .alt_function = settings->alt_fn,  //
@@ -123,12 +123,12 @@ static void prv_rx_push(UartPort uart) {
   UartStorage *storage = s_port[uart].storage;
 
   uint8_t rx_data = USART_ReceiveData(s_port[uart].base);
-  fifo_push(&storage->rx_fifo, &rx_data);
+  uart_rx_ring_push(&storage->rx_ring, &rx_data);
 
-  size_t num_bytes = fifo_size(&storage->rx_fifo);
+  size_t num_bytes = uart_rx_ring_size(&storage->rx_ring);
   if (rx_data == storage->delimiter || num_bytes == UART_MAX_BUFFER_LEN) {
     storage->rx_line_buf[num_bytes] = '\0';
-    fifo_pop_arr(&storage->rx_fifo, storage->rx_line_buf, num_bytes);
+    uart_rx_ring_pop_arr(&storage->rx_ring, storage->rx_line_buf, num_bytes);
 
     if (storage->rx_handler != NULL) {
       storage->rx_handler(storage->rx_line_buf, num_bytes, storage->context);
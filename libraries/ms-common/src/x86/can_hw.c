@@ -1,56 +1,100 @@
+// SocketCAN implementation
+//
+// Each instance is bound to one SocketCAN interface and has its own RX and TX threads, which block
+// in epoll on their own fd and the instance's exit eventfd. Frames are moved in batches of up to
+// CAN_HW_BATCH_SIZE: the RX thread reads everything available with recvmmsg() and raises one RX
+// event per batch, and the TX thread drains the TX ring with sendmmsg() and raises one TX ready
+// event per batch.
+//
+// TX is paced by a token bucket holding up to a batch of frames and refilled at one frame per frame
+// time, so bursts go out together while the average rate still matches the configured bitrate.
+// The TX queue depth defaults to the old fifo length and can be raised with the
+// MIDSUN_X86_CAN_TX_QUEUE_LEN environment variable.
 #include "can_hw.h"
 
+#include <errno.h>
 #include <fcntl.h>
 #include <linux/can.h>
 #include <linux/can/raw.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
 #include <net/if.h>
-#include <poll.h>
 #include <pthread.h>
-#include <semaphore.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <time.h>
 #include <unistd.h>
 
-#include "fifo.h"
+#include "can_hw_mcu.h"
 #include "interrupt_def.h"
 #include "log.h"
+#include "spsc_ring.h"
 #include "x86_interrupt.h"
 
-#define CAN_HW_DEV_INTERFACE "vcan0"
-#define CAN_HW_MAX_FILTERS 14
-#define CAN_HW_TX_FIFO_LEN 8
-// Check for thread exit once every 10ms
-#define CAN_HW_THREAD_EXIT_PERIOD_US 10000
+#define CAN_HW_DEFAULT_INTERFACE "vcan0"
+#define CAN_HW_INTERFACE_ENV "MIDSUN_X86_CAN_INTERFACE"
+// As many standard ID filters as bxCAN can hold
+#define CAN_HW_MAX_FILTERS (CAN_HW_NUM_FILTER_BANKS * 2)
+// Max frames per recvmmsg()/sendmmsg() - also the token bucket capacity
+#define CAN_HW_BATCH_SIZE 32
+#define CAN_HW_TX_RING_SIZE 256
+#define CAN_HW_TX_QUEUE_LEN_DEFAULT 8
+#define CAN_HW_TX_QUEUE_LEN_ENV "MIDSUN_X86_CAN_TX_QUEUE_LEN"
+
+#define CAN_HW_NS_PER_US 1000ull
+#define CAN_HW_NS_PER_S 1000000000ull
+
+// can_hw_transmit() is the only producer and the TX thread is the only consumer
+SPSC_RING_DEFINE(CanHwTxRing, can_hw_tx_ring, struct can_frame, CAN_HW_TX_RING_SIZE)
 
 typedef struct CanHwEventHandler {
   CanHwEventHandlerCb callback;
   void *context;
 } CanHwEventHandler;
 
-typedef struct CanHwSocketData {
+// Only touched by the RX thread, which runs the RX handler
+typedef struct CanHwRxBatch {
+  struct can_frame frames[CAN_HW_BATCH_SIZE];
+  uint64_t timestamps_ns[CAN_HW_BATCH_SIZE];
+  size_t count;
+  size_t index;
+  uint64_t last_timestamp_ns;
+} CanHwRxBatch;
+
+struct CanHwInstance {
+  char interface[IFNAMSIZ];
   int can_fd;
-  struct can_frame rx_frame;
-  Fifo tx_fifo;
-  struct can_frame tx_frames[CAN_HW_TX_FIFO_LEN];
+  // Written once to stop both threads
+  int exit_fd;
+  // Written by can_hw_transmit() to wake the TX thread
+  int tx_fd;
+  int rx_epoll_fd;
+  int tx_epoll_fd;
+  pthread_t rx_pthread_id;
+  pthread_t tx_pthread_id;
+  // Holds init until both threads are running
+  pthread_barrier_t start_barrier;
+  // Everything from here on is reset on init
+  bool threads_started;
+  bool running;
+  CanHwRxBatch rx;
+  CanHwTxRing tx_ring;
+  size_t tx_queue_len;
   struct can_filter filters[CAN_HW_MAX_FILTERS];
   size_t num_filters;
   CanHwEventHandler handlers[NUM_CAN_HW_EVENTS];
-  uint32_t delay_us;
-} CanHwSocketData;
-
-static pthread_t s_rx_pthread_id;
-static pthread_t s_tx_pthread_id;
-static pthread_barrier_t s_barrier;
-// Producer/Consumer semaphore
-static sem_t s_tx_sem;
+  uint64_t frame_ns;
+};
 
-// Locked if the TX/RX threads should be alive, unlocked on exit
-static pthread_mutex_t s_keep_alive = PTHREAD_MUTEX_INITIALIZER;
-
-static CanHwSocketData s_socket_data = { .can_fd = -1 };
+static CanHwInstance s_instances[CAN_HW_MAX_INSTANCES];
+static size_t s_num_instances = 0;
+static CanHwInstance *s_default = NULL;
 
 static uint32_t prv_get_delay(CanHwBitrate bitrate) {
   const uint32_t delay_us[NUM_CAN_HW_BITRATES] = {
@@ -63,152 +107,373 @@ static uint32_t prv_get_delay(CanHwBitrate bitrate) {
   return delay_us[bitrate];
 }
 
-static void *prv_rx_thread(void *arg) {
-  x86_interrupt_pthread_init();
-  LOG_DEBUG("CAN HW RX thread started\n");
+static size_t prv_get_tx_queue_len(void) {
+  const char *env = getenv(CAN_HW_TX_QUEUE_LEN_ENV);
+  if (env == NULL) {
+    return CAN_HW_TX_QUEUE_LEN_DEFAULT;
+  }
+
+  char *end = NULL;
+  uint64_t len = strtoull(env, &end, 0);
+  if (*end != '\0' || len == 0 || len > CAN_HW_TX_RING_SIZE) {
+    LOG_WARN("CAN HW: Invalid %s \"%s\" (1 - %d), using %d\n", CAN_HW_TX_QUEUE_LEN_ENV, env,
+             CAN_HW_TX_RING_SIZE, CAN_HW_TX_QUEUE_LEN_DEFAULT);
+    return CAN_HW_TX_QUEUE_LEN_DEFAULT;
+  }
 
-  pthread_barrier_wait(&s_barrier);
+  return (size_t)len;
+}
 
-  struct timeval timeout = { .tv_usec = CAN_HW_THREAD_EXIT_PERIOD_US };
+static uint64_t prv_get_time_ns(clockid_t clock) {
+  struct timespec ts = { 0 };
+  clock_gettime(clock, &ts);
+  return (uint64_t)ts.tv_sec * CAN_HW_NS_PER_S + (uint64_t)ts.tv_nsec;
+}
 
-  // Mutex is unlocked when the thread should exit
-  while (pthread_mutex_trylock(&s_keep_alive) != 0) {
-    // Select timeout is used to poll every now and then
-    fd_set input_fds;
-    FD_ZERO(&input_fds);
-    FD_SET(s_socket_data.can_fd, &input_fds);
+static void prv_sleep_until_ns(uint64_t deadline_ns) {
+  struct timespec ts = {
+    .tv_sec = (time_t)(deadline_ns / CAN_HW_NS_PER_S),    //
+    .tv_nsec = (int64_t)(deadline_ns % CAN_HW_NS_PER_S),  //
+  };
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+  }
+}
 
-    select(s_socket_data.can_fd + 1, &input_fds, NULL, NULL, &timeout);
+static void prv_handle_event(CanHwInstance *instance, CanHwEvent event) {
+  if (instance->handlers[event].callback != NULL) {
+    instance->handlers[event].callback(instance->handlers[event].context);
+  }
+}
 
-    if (FD_ISSET(s_socket_data.can_fd, &input_fds)) {
-      int bytes =
-          read(s_socket_data.can_fd, &s_socket_data.rx_frame, sizeof(s_socket_data.rx_frame));
+static bool prv_is_running(CanHwInstance *instance) {
+  return __atomic_load_n(&instance->running, __ATOMIC_ACQUIRE);
+}
 
-      if (s_socket_data.handlers[CAN_HW_EVENT_MSG_RX].callback != NULL) {
-        s_socket_data.handlers[CAN_HW_EVENT_MSG_RX].callback(
-            s_socket_data.handlers[CAN_HW_EVENT_TX_READY].context);
-      }
+static StatusCode prv_create_epoll(CanHwInstance *instance, int fd, int *epoll_fd) {
+  *epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  if (*epoll_fd == -1) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "CAN HW: Failed to create epoll");
+  }
 
-      // Limit how often we can receive messages to simulate bus speed
-      usleep(s_socket_data.delay_us);
+  int fds[] = { fd, instance->exit_fd };
+  for (size_t i = 0; i < sizeof(fds) / sizeof(fds[0]); i++) {
+    struct epoll_event event = { .events = EPOLLIN, .data.fd = fds[i] };
+    if (epoll_ctl(*epoll_fd, EPOLL_CTL_ADD, fds[i], &event) == -1) {
+      return status_msg(STATUS_CODE_INTERNAL_ERROR, "CAN HW: Failed to add fd to epoll");
     }
   }
 
-  pthread_mutex_unlock(&s_keep_alive);
+  return STATUS_CODE_OK;
+}
 
-  return NULL;
+// Blocks until the thread's fd is readable. Returns false once the threads should exit.
+static bool prv_wait(CanHwInstance *instance, int epoll_fd) {
+  struct epoll_event event = { 0 };
+  while (prv_is_running(instance)) {
+    int ret = epoll_wait(epoll_fd, &event, 1, -1);
+    if (ret == 1) {
+      return event.data.fd != instance->exit_fd;
+    } else if (ret == -1 && errno != EINTR) {
+      LOG_CRITICAL("CAN HW: epoll_wait failed on %s (%d)\n", instance->interface, errno);
+      return false;
+    }
+  }
+
+  return false;
 }
 
-static void *prv_tx_thread(void *arg) {
+// Pulls the software RX timestamp out of the control messages
+static uint64_t prv_get_rx_timestamp(struct msghdr *hdr, uint64_t fallback_ns) {
+  for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(hdr); cmsg != NULL; cmsg = CMSG_NXTHDR(hdr, cmsg)) {
+    if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPING) {
+      struct scm_timestamping timestamps;
+      memcpy(&timestamps, CMSG_DATA(cmsg), sizeof(timestamps));
+      // Software timestamps are in the first slot
+      const struct timespec *ts = &timestamps.ts[0];
+      if (ts->tv_sec != 0 || ts->tv_nsec != 0) {
+        return (uint64_t)ts->tv_sec * CAN_HW_NS_PER_S + (uint64_t)ts->tv_nsec;
+      }
+    }
+  }
+
+  return fallback_ns;
+}
+
+static void *prv_rx_thread(void *arg) {
+  CanHwInstance *instance = arg;
   x86_interrupt_pthread_init();
-  LOG_DEBUG("CAN HW TX thread started\n");
-  struct can_frame frame = { 0 };
+  LOG_DEBUG("CAN HW RX thread started on %s\n", instance->interface);
+
+  CanHwRxBatch *rx = &instance->rx;
+  struct mmsghdr msgs[CAN_HW_BATCH_SIZE];
+  struct iovec iovs[CAN_HW_BATCH_SIZE];
+  char control[CAN_HW_BATCH_SIZE][CMSG_SPACE(sizeof(struct scm_timestamping))];
+
+  pthread_barrier_wait(&instance->start_barrier);
+
+  while (prv_wait(instance, instance->rx_epoll_fd)) {
+    // recvmmsg() overwrites the control lengths, so the headers are rebuilt each time
+    for (size_t i = 0; i < CAN_HW_BATCH_SIZE; i++) {
+      iovs[i] = (struct iovec){ .iov_base = &rx->frames[i], .iov_len = sizeof(rx->frames[i]) };
+      msgs[i] = (struct mmsghdr){ 0 };
+      msgs[i].msg_hdr.msg_iov = &iovs[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+      msgs[i].msg_hdr.msg_control = control[i];
+      msgs[i].msg_hdr.msg_controllen = sizeof(control[i]);
+    }
+
+    int received = recvmmsg(instance->can_fd, msgs, CAN_HW_BATCH_SIZE, MSG_DONTWAIT, NULL);
+    if (received <= 0) {
+      continue;
+    }
 
-  pthread_barrier_wait(&s_barrier);
+    uint64_t fallback_ns = prv_get_time_ns(CLOCK_REALTIME);
+    for (size_t i = 0; i < (size_t)received; i++) {
+      rx->timestamps_ns[i] = prv_get_rx_timestamp(&msgs[i].msg_hdr, fallback_ns);
+    }
 
-  // Mutex is unlocked when the thread should exit
-  while (pthread_mutex_trylock(&s_keep_alive) != 0) {
-    // Wait until the producer has created an item
-    sem_wait(&s_tx_sem);
-    fifo_pop(&s_socket_data.tx_fifo, &frame);
-    int bytes = write(s_socket_data.can_fd, &frame, sizeof(frame));
+    rx->index = 0;
+    rx->count = (size_t)received;
+    prv_handle_event(instance, CAN_HW_EVENT_MSG_RX);
 
-    // Delay to simulate bus speed
-    usleep(s_socket_data.delay_us);
+    // The RX handler should drain the batch - anything left over is dropped
+    if (rx->index < rx->count) {
+      LOG_WARN("CAN HW: Dropped %zu RX frames on %s\n", rx->count - rx->index,
+               instance->interface);
+    }
+    rx->count = 0;
+  }
 
-    if (s_socket_data.handlers[CAN_HW_EVENT_TX_READY].callback != NULL) {
-      s_socket_data.handlers[CAN_HW_EVENT_TX_READY].callback(
-          s_socket_data.handlers[CAN_HW_EVENT_TX_READY].context);
+  return NULL;
+}
+
+// Sends the first |num_frames| messages, waiting for room in the socket's queue if needed
+static void prv_tx_send(CanHwInstance *instance, struct mmsghdr *msgs, size_t num_frames) {
+  size_t sent = 0;
+  while (sent < num_frames && prv_is_running(instance)) {
+    int ret = sendmmsg(instance->can_fd, &msgs[sent], (unsigned int)(num_frames - sent), 0);
+    if (ret > 0) {
+      sent += (size_t)ret;
+    } else if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS) {
+      // Give the interface a frame time to drain
+      prv_sleep_until_ns(prv_get_time_ns(CLOCK_MONOTONIC) + instance->frame_ns);
+    } else if (errno != EINTR) {
+      LOG_WARN("CAN HW: TX failed on %s (%d), dropping %zu frames\n", instance->interface, errno,
+               num_frames - sent);
+      return;
     }
   }
+}
+
+static void *prv_tx_thread(void *arg) {
+  CanHwInstance *instance = arg;
+  x86_interrupt_pthread_init();
+  LOG_DEBUG("CAN HW TX thread started on %s\n", instance->interface);
+
+  struct can_frame frames[CAN_HW_BATCH_SIZE];
+  struct mmsghdr msgs[CAN_HW_BATCH_SIZE];
+  struct iovec iovs[CAN_HW_BATCH_SIZE];
+  for (size_t i = 0; i < CAN_HW_BATCH_SIZE; i++) {
+    iovs[i] = (struct iovec){ .iov_base = &frames[i], .iov_len = sizeof(frames[i]) };
+    msgs[i] = (struct mmsghdr){ .msg_hdr = { .msg_iov = &iovs[i], .msg_iovlen = 1 } };
+  }
 
-  pthread_mutex_unlock(&s_keep_alive);
+  // Token bucket - starts full. |refill_ns| is when the last whole token was added.
+  uint64_t frame_ns = instance->frame_ns;
+  size_t tokens = CAN_HW_BATCH_SIZE;
+  uint64_t refill_ns = prv_get_time_ns(CLOCK_MONOTONIC);
+
+  pthread_barrier_wait(&instance->start_barrier);
+
+  while (prv_wait(instance, instance->tx_epoll_fd)) {
+    // Clear the eventfd - the ring is drained regardless of how many kicks there were
+    uint64_t kicks = 0;
+    ssize_t ret = read(instance->tx_fd, &kicks, sizeof(kicks));
+    (void)ret;
+
+    size_t queued = 0;
+    while (prv_is_running(instance) && (queued = can_hw_tx_ring_size(&instance->tx_ring)) > 0) {
+      uint64_t now_ns = prv_get_time_ns(CLOCK_MONOTONIC);
+      uint64_t earned = (now_ns - refill_ns) / frame_ns;
+      tokens += (size_t)earned;
+      refill_ns += earned * frame_ns;
+      if (tokens >= CAN_HW_BATCH_SIZE) {
+        tokens = CAN_HW_BATCH_SIZE;
+        refill_ns = now_ns;
+      } else if (tokens == 0) {
+        prv_sleep_until_ns(refill_ns + frame_ns);
+        continue;
+      }
+
+      size_t batch = (queued < tokens) ? queued : tokens;
+      can_hw_tx_ring_pop_arr(&instance->tx_ring, frames, batch);
+      tokens -= batch;
+
+      prv_tx_send(instance, msgs, batch);
+      prv_handle_event(instance, CAN_HW_EVENT_TX_READY);
+    }
+  }
 
   return NULL;
 }
 
-StatusCode can_hw_init(const CanHwSettings *settings) {
-  if (s_socket_data.can_fd != -1) {
-    LOG_DEBUG("Exiting CAN HW\n");
+static void prv_close(int *fd) {
+  if (*fd != -1) {
+    close(*fd);
+    *fd = -1;
+  }
+}
 
-    // Request threads to exit
-    close(s_socket_data.can_fd);
+static void prv_deinit(CanHwInstance *instance) {
+  if (instance->threads_started) {
+    LOG_DEBUG("Exiting CAN HW on %s\n", instance->interface);
 
-    pthread_mutex_unlock(&s_keep_alive);
+    __atomic_store_n(&instance->running, false, __ATOMIC_RELEASE);
+    uint64_t exit = 1;
+    ssize_t ret = write(instance->exit_fd, &exit, sizeof(exit));
+    (void)ret;
 
-    pthread_join(s_rx_pthread_id, NULL);
+    pthread_join(instance->rx_pthread_id, NULL);
+    pthread_join(instance->tx_pthread_id, NULL);
+  }
 
-    // Allow the TX thread to continue
-    sem_post(&s_tx_sem);
+  prv_close(&instance->rx_epoll_fd);
+  prv_close(&instance->tx_epoll_fd);
+  prv_close(&instance->tx_fd);
+  prv_close(&instance->exit_fd);
+  prv_close(&instance->can_fd);
+}
 
-    sem_destroy(&s_tx_sem);
-    pthread_join(s_tx_pthread_id, NULL);
+// Returns the instance bound to |interface|, claiming a new one if there isn't one yet
+static CanHwInstance *prv_get_instance(const char *interface) {
+  for (size_t i = 0; i < s_num_instances; i++) {
+    if (strncmp(s_instances[i].interface, interface, sizeof(s_instances[i].interface)) == 0) {
+      return &s_instances[i];
+    }
   }
 
-  pthread_mutex_init(&s_keep_alive, NULL);
-  // Init semaphore to thread-shared and locked
-  sem_init(&s_tx_sem, 0, 0);
+  if (s_num_instances >= CAN_HW_MAX_INSTANCES) {
+    return NULL;
+  }
 
-  pthread_mutex_lock(&s_keep_alive);
+  CanHwInstance *instance = &s_instances[s_num_instances++];
+  snprintf(instance->interface, sizeof(instance->interface), "%s", interface);
+  instance->can_fd = -1;
+  instance->exit_fd = -1;
+  instance->tx_fd = -1;
+  instance->rx_epoll_fd = -1;
+  instance->tx_epoll_fd = -1;
 
-  memset(&s_socket_data, 0, sizeof(s_socket_data));
-  s_socket_data.delay_us = prv_get_delay(settings->bitrate);
-  fifo_init(&s_socket_data.tx_fifo, s_socket_data.tx_frames);
+  return instance;
+}
+
+static StatusCode prv_init(CanHwInstance *instance, const CanHwSettings *settings) {
+  instance->frame_ns = prv_get_delay(settings->bitrate) * CAN_HW_NS_PER_US;
+  instance->tx_queue_len = prv_get_tx_queue_len();
+  can_hw_tx_ring_init(&instance->tx_ring);
+
+  instance->exit_fd = eventfd(0, EFD_CLOEXEC);
+  instance->tx_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (instance->exit_fd == -1 || instance->tx_fd == -1) {
+    LOG_CRITICAL("CAN HW: Failed to create eventfds\n");
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "CAN HW: Failed to create eventfds");
+  }
 
-  s_socket_data.can_fd = socket(PF_CAN, SOCK_RAW, CAN_RAW);
-  if (s_socket_data.can_fd == -1) {
+  instance->can_fd = socket(PF_CAN, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, CAN_RAW);
+  if (instance->can_fd == -1) {
     LOG_CRITICAL("CAN HW: Failed to open SocketCAN socket\n");
     return status_msg(STATUS_CODE_INTERNAL_ERROR, "CAN HW: Failed to open socket");
   }
 
   // Loopback - expects to receive its own messages
   int loopback = settings->loopback;
-  if (setsockopt(s_socket_data.can_fd, SOL_CAN_RAW, CAN_RAW_RECV_OWN_MSGS, &loopback,
+  if (setsockopt(instance->can_fd, SOL_CAN_RAW, CAN_RAW_RECV_OWN_MSGS, &loopback,
                  sizeof(loopback)) < 0) {
     LOG_CRITICAL("CAN HW: Failed to set loopback mode on socket\n");
     return status_msg(STATUS_CODE_INTERNAL_ERROR, "CAN HW: Failed to set loopback mode on socket");
   }
 
+  // Kernel RX timestamps - falls back to the time the batch was read
+  int timestamping = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+  if (setsockopt(instance->can_fd, SOL_SOCKET, SO_TIMESTAMPING, &timestamping,
+                 sizeof(timestamping)) < 0) {
+    LOG_WARN("CAN HW: RX timestamping unavailable\n");
+  }
+
   struct ifreq ifr = { 0 };
-  snprintf(ifr.ifr_name, sizeof(ifr.ifr_name), "%s", CAN_HW_DEV_INTERFACE);
-  if (ioctl(s_socket_data.can_fd, SIOCGIFINDEX, &ifr) < 0) {
-    LOG_CRITICAL("CAN HW: Device %s not found\n", CAN_HW_DEV_INTERFACE);
+  snprintf(ifr.ifr_name, sizeof(ifr.ifr_name), "%s", instance->interface);
+  if (ioctl(instance->can_fd, SIOCGIFINDEX, &ifr) < 0) {
+    LOG_CRITICAL("CAN HW: Device %s not found\n", instance->interface);
     return status_msg(STATUS_CODE_INTERNAL_ERROR, "CAN HW: Device not found");
   }
 
-  // Set non-blocking
-  fcntl(s_socket_data.can_fd, F_SETFL, O_NONBLOCK);
-
   struct sockaddr_can addr = {
     .can_family = AF_CAN,
     .can_ifindex = ifr.ifr_ifindex,
   };
-  if (bind(s_socket_data.can_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+  if (bind(instance->can_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
     LOG_CRITICAL("CAN HW: Failed to bind socket\n");
     return status_msg(STATUS_CODE_INTERNAL_ERROR, "CAN HW: Failed to bind socket");
   }
 
-  LOG_DEBUG("CAN HW initialized on %s\n", CAN_HW_DEV_INTERFACE);
+  status_ok_or_return(prv_create_epoll(instance, instance->can_fd, &instance->rx_epoll_fd));
+  status_ok_or_return(prv_create_epoll(instance, instance->tx_fd, &instance->tx_epoll_fd));
+
+  LOG_DEBUG("CAN HW initialized on %s (TX queue %zu)\n", instance->interface,
+            instance->tx_queue_len);
+
+  instance->running = true;
 
   // 3 threads total: main, TX, RX
-  pthread_barrier_init(&s_barrier, NULL, 3);
+  pthread_barrier_init(&instance->start_barrier, NULL, 3);
 
-  pthread_create(&s_rx_pthread_id, NULL, prv_rx_thread, NULL);
-  pthread_create(&s_tx_pthread_id, NULL, prv_tx_thread, NULL);
+  pthread_create(&instance->rx_pthread_id, NULL, prv_rx_thread, instance);
+  pthread_create(&instance->tx_pthread_id, NULL, prv_tx_thread, instance);
+  instance->threads_started = true;
 
-  pthread_barrier_wait(&s_barrier);
-  pthread_barrier_destroy(&s_barrier);
+  pthread_barrier_wait(&instance->start_barrier);
+  pthread_barrier_destroy(&instance->start_barrier);
 
   return STATUS_CODE_OK;
 }
 
-// Registers a callback for the given event
-StatusCode can_hw_register_callback(CanHwEvent event, CanHwEventHandlerCb callback, void *context) {
-  if (event >= NUM_CAN_HW_EVENTS) {
+StatusCode can_hw_open(CanHwInstance **instance, const char *interface,
+                       const CanHwSettings *settings) {
+  if (interface == NULL) {
+    interface = getenv(CAN_HW_INTERFACE_ENV);
+    if (interface == NULL) {
+      interface = CAN_HW_DEFAULT_INTERFACE;
+    }
+  }
+
+  if (strlen(interface) >= IFNAMSIZ) {
+    return status_msg(STATUS_CODE_INVALID_ARGS, "CAN HW: Interface name too long");
+  }
+
+  CanHwInstance *inst = prv_get_instance(interface);
+  if (inst == NULL) {
+    return status_msg(STATUS_CODE_RESOURCE_EXHAUSTED, "CAN HW: Ran out of instances");
+  }
+  *instance = inst;
+
+  prv_deinit(inst);
+  size_t reset_offset = offsetof(CanHwInstance, threads_started);
+  memset((uint8_t *)inst + reset_offset, 0, sizeof(*inst) - reset_offset);
+
+  return prv_init(inst, settings);
+}
+
+StatusCode can_hw_init(const CanHwSettings *settings) {
+  return can_hw_open(&s_default, NULL, settings);
+}
+
+StatusCode can_hw_instance_register_callback(CanHwInstance *instance, CanHwEvent event,
+                                             CanHwEventHandlerCb callback, void *context) {
+  if (instance == NULL || event >= NUM_CAN_HW_EVENTS) {
     return status_code(STATUS_CODE_INVALID_ARGS);
   }
 
-  s_socket_data.handlers[event] = (CanHwEventHandler){
+  instance->handlers[event] = (CanHwEventHandler){
     .callback = callback,  //
     .context = context,    //
   };
@@ -216,59 +481,159 @@ StatusCode can_hw_register_callback(CanHwEvent event, CanHwEventHandlerCb callba
   return STATUS_CODE_OK;
 }
 
-StatusCode can_hw_add_filter(uint32_t mask, uint32_t filter, bool extended) {
-  if (s_socket_data.num_filters >= CAN_HW_MAX_FILTERS) {
-    return status_msg(STATUS_CODE_RESOURCE_EXHAUSTED, "CAN HW: Ran out of filters.");
-  }
+// Registers a callback for the given event
+StatusCode can_hw_register_callback(CanHwEvent event, CanHwEventHandlerCb callback, void *context) {
+  return can_hw_instance_register_callback(s_default, event, callback, context);
+}
+
+static void prv_set_filter(struct can_filter *raw_filter, const CanHwFilter *filter) {
+  uint32_t reg_mask = filter->extended ? CAN_EFF_MASK : CAN_SFF_MASK;
+  uint32_t ide = filter->extended ? CAN_EFF_FLAG : 0;
 
-  uint32_t reg_mask = extended ? CAN_EFF_MASK : CAN_SFF_MASK;
-  uint32_t ide = extended ? CAN_EFF_FLAG : 0;
-  s_socket_data.filters[s_socket_data.num_filters].can_id = (filter & reg_mask) | ide;
-  s_socket_data.filters[s_socket_data.num_filters].can_mask = (mask & reg_mask) | CAN_EFF_FLAG;
-  s_socket_data.num_filters++;
+  raw_filter->can_id = (filter->filter & reg_mask) | ide;
+  raw_filter->can_mask = (filter->mask & reg_mask) | CAN_EFF_FLAG;
+}
+
+// Installs the whole filter list with one call
+static StatusCode prv_apply_filters(CanHwInstance *instance) {
+  // An empty list would drop everything
+  struct can_filter accept_all = { 0 };
+  const struct can_filter *filters = instance->filters;
+  size_t num_filters = instance->num_filters;
+  if (num_filters == 0) {
+    filters = &accept_all;
+    num_filters = 1;
+  }
 
-  if (setsockopt(s_socket_data.can_fd, SOL_CAN_RAW, CAN_RAW_FILTER, s_socket_data.filters,
-                 sizeof(s_socket_data.filters[0]) * s_socket_data.num_filters) < 0) {
+  if (setsockopt(instance->can_fd, SOL_CAN_RAW, CAN_RAW_FILTER, filters,
+                 sizeof(filters[0]) * num_filters) < 0) {
     return status_msg(STATUS_CODE_INTERNAL_ERROR, "CAN HW: Failed to set raw filters");
   }
 
   return STATUS_CODE_OK;
 }
 
-CanHwBusStatus can_hw_bus_status(void) {
+StatusCode can_hw_instance_add_filter(CanHwInstance *instance, uint32_t mask, uint32_t filter,
+                                      bool extended) {
+  if (instance == NULL) {
+    return status_code(STATUS_CODE_INVALID_ARGS);
+  } else if (instance->num_filters >= CAN_HW_MAX_FILTERS) {
+    return status_msg(STATUS_CODE_RESOURCE_EXHAUSTED, "CAN HW: Ran out of filters.");
+  }
+
+  CanHwFilter hw_filter = {
+    .mask = mask,          //
+    .filter = filter,      //
+    .extended = extended,  //
+  };
+  prv_set_filter(&instance->filters[instance->num_filters], &hw_filter);
+  instance->num_filters++;
+
+  return prv_apply_filters(instance);
+}
+
+StatusCode can_hw_add_filter(uint32_t mask, uint32_t filter, bool extended) {
+  return can_hw_instance_add_filter(s_default, mask, filter, extended);
+}
+
+StatusCode can_hw_instance_set_filters(CanHwInstance *instance, const CanHwFilter *filters,
+                                       size_t num_filters) {
+  if (instance == NULL || (filters == NULL && num_filters > 0)) {
+    return status_code(STATUS_CODE_INVALID_ARGS);
+  } else if (num_filters > CAN_HW_MAX_FILTERS) {
+    return status_msg(STATUS_CODE_RESOURCE_EXHAUSTED, "CAN HW: Ran out of filters.");
+  }
+
+  for (size_t i = 0; i < num_filters; i++) {
+    prv_set_filter(&instance->filters[i], &filters[i]);
+  }
+  instance->num_filters = num_filters;
+
+  return prv_apply_filters(instance);
+}
+
+StatusCode can_hw_set_filters(const CanHwFilter *filters, size_t num_filters) {
+  return can_hw_instance_set_filters(s_default, filters, num_filters);
+}
+
+CanHwBusStatus can_hw_instance_bus_status(CanHwInstance *instance) {
   return CAN_HW_BUS_STATUS_OK;
 }
 
-StatusCode can_hw_transmit(uint32_t id, bool extended, const uint8_t *data, size_t len) {
-  uint32_t mask = extended ? CAN_EFF_MASK : CAN_SFF_MASK;
-  uint32_t extended_bit = extended ? CAN_EFF_FLAG : 0;
-  struct can_frame frame = { .can_id = (id & mask) | extended_bit, .can_dlc = len };
-  memcpy(&frame.data, data, len);
+CanHwBusStatus can_hw_bus_status(void) {
+  return can_hw_instance_bus_status(s_default);
+}
+
+// SocketCAN only reports error counters through netlink, so they always read 0
+void can_hw_instance_get_error_counters(CanHwInstance *instance, uint8_t *tx_errors,
+                                        uint8_t *rx_errors) {
+  *tx_errors = 0;
+  *rx_errors = 0;
+}
+
+void can_hw_get_error_counters(uint8_t *tx_errors, uint8_t *rx_errors) {
+  can_hw_instance_get_error_counters(s_default, tx_errors, rx_errors);
+}
+
+StatusCode can_hw_instance_transmit(CanHwInstance *instance, uint32_t id, bool extended,
+                                    const uint8_t *data, size_t len) {
+  if (instance == NULL || len > CAN_MAX_DLEN) {
+    return status_code(STATUS_CODE_INVALID_ARGS);
+  }
 
-  StatusCode ret = fifo_push(&s_socket_data.tx_fifo, &frame);
-  if (ret != STATUS_CODE_OK) {
-    // Fifo is full
+  if (can_hw_tx_ring_size(&instance->tx_ring) >= instance->tx_queue_len) {
+    // Queue is full
     return status_msg(STATUS_CODE_RESOURCE_EXHAUSTED, "CAN HW TX failed");
   }
-  // Unblock TX thread
-  sem_post(&s_tx_sem);
+
+  // Can't fail since the queue length is at most the ring size
+  struct can_frame *frame = can_hw_tx_ring_claim(&instance->tx_ring);
+  uint32_t mask = extended ? CAN_EFF_MASK : CAN_SFF_MASK;
+  uint32_t extended_bit = extended ? CAN_EFF_FLAG : 0;
+  *frame = (struct can_frame){ .can_id = (id & mask) | extended_bit, .can_dlc = (uint8_t)len };
+  memcpy(&frame->data, data, len);
+  can_hw_tx_ring_commit(&instance->tx_ring);
+
+  // Wake the TX thread
+  uint64_t kick = 1;
+  ssize_t ret = write(instance->tx_fd, &kick, sizeof(kick));
+  (void)ret;
 
   return STATUS_CODE_OK;
 }
 
-// Must be called within the RX handler, returns whether a message was processed
-bool can_hw_receive(uint32_t *id, bool *extended, uint64_t *data, size_t *len) {
-  if (s_socket_data.rx_frame.can_id == 0) {
-    // Assumes that we'll never transmit something with a CAN ID of all 0s
+StatusCode can_hw_transmit(uint32_t id, bool extended, const uint8_t *data, size_t len) {
+  return can_hw_instance_transmit(s_default, id, extended, data, len);
+}
+
+bool can_hw_instance_receive(CanHwInstance *instance, uint32_t *id, bool *extended, uint64_t *data,
+                             size_t *len) {
+  if (instance == NULL || instance->rx.index >= instance->rx.count) {
     return false;
   }
 
-  *extended = !!(s_socket_data.rx_frame.can_id & CAN_EFF_FLAG);
+  CanHwRxBatch *rx = &instance->rx;
+  const struct can_frame *frame = &rx->frames[rx->index];
+  *extended = !!(frame->can_id & CAN_EFF_FLAG);
   uint32_t mask = *extended ? CAN_EFF_MASK : CAN_SFF_MASK;
-  *id = s_socket_data.rx_frame.can_id & mask;
-  memcpy(data, s_socket_data.rx_frame.data, sizeof(*data));
-  *len = s_socket_data.rx_frame.can_dlc;
+  *id = frame->can_id & mask;
+  memcpy(data, frame->data, sizeof(*data));
+  *len = frame->can_dlc;
+  rx->last_timestamp_ns = rx->timestamps_ns[rx->index];
 
-  memset(&s_socket_data.rx_frame, 0, sizeof(s_socket_data.rx_frame));
+  rx->index++;
   return true;
 }
+
+// Must be called within the RX handler, returns whether a message was processed
+bool can_hw_receive(uint32_t *id, bool *extended, uint64_t *data, size_t *len) {
+  return can_hw_instance_receive(s_default, id, extended, data, len);
+}
+
+uint64_t can_hw_instance_get_rx_timestamp_ns(CanHwInstance *instance) {
+  return (instance == NULL) ? 0 : instance->rx.last_timestamp_ns;
+}
+
+uint64_t can_hw_get_rx_timestamp_ns(void) {
+  return can_hw_instance_get_rx_timestamp_ns(s_default);
+}
@@ -0,0 +1,334 @@
+// Virtual CAN bus - only built with X86_INTERRUPT=sched in place of the SocketCAN implementation.
+//
+// Frames are transmitted one at a time in virtual time, taking one frame time at the configured
+// bitrate. Since virtual time can't be shared with other processes, the bus only has this node on
+// it: frames are received back if loopback is enabled and they pass the filters, and are otherwise
+// dropped. TX and RX events are raised from a scheduled interrupt, like the CAN ISR.
+//
+// Each instance is a separate bus, named after the SocketCAN interface it stands in for.
+#include "can_hw.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "can_hw_mcu.h"
+#include "fifo.h"
+#include "interrupt_def.h"
+#include "log.h"
+#include "x86_interrupt.h"
+
+#define CAN_HW_DEFAULT_INTERFACE "vcan0"
+#define CAN_HW_INTERFACE_ENV "MIDSUN_X86_CAN_INTERFACE"
+#define CAN_HW_INTERFACE_LEN 16
+// As many standard ID filters as bxCAN can hold
+#define CAN_HW_MAX_FILTERS (CAN_HW_NUM_FILTER_BANKS * 2)
+#define CAN_HW_TX_FIFO_LEN 8
+#define CAN_HW_RX_FIFO_LEN 8
+
+#define CAN_HW_STANDARD_MASK 0x7FF
+#define CAN_HW_EXTENDED_MASK 0x1FFFFFFF
+
+typedef struct CanHwFrame {
+  uint32_t id;
+  bool extended;
+  uint8_t dlc;
+  uint64_t data;
+  uint64_t timestamp_ns;
+} CanHwFrame;
+
+typedef struct CanHwEventHandler {
+  CanHwEventHandlerCb callback;
+  void *context;
+} CanHwEventHandler;
+
+struct CanHwInstance {
+  char interface[CAN_HW_INTERFACE_LEN];
+  Fifo tx_fifo;
+  CanHwFrame tx_frames[CAN_HW_TX_FIFO_LEN];
+  Fifo rx_fifo;
+  CanHwFrame rx_frames[CAN_HW_RX_FIFO_LEN];
+  CanHwFilter filters[CAN_HW_MAX_FILTERS];
+  size_t num_filters;
+  CanHwEventHandler handlers[NUM_CAN_HW_EVENTS];
+  uint32_t delay_us;
+  bool loopback;
+  // Whether a frame is on the bus
+  bool tx_active;
+  uint8_t interrupt_id;
+  uint64_t last_rx_timestamp_ns;
+};
+
+static CanHwInstance s_instances[CAN_HW_MAX_INSTANCES];
+static size_t s_num_instances = 0;
+static CanHwInstance *s_default = NULL;
+
+static uint32_t prv_get_delay(CanHwBitrate bitrate) {
+  const uint32_t delay_us[NUM_CAN_HW_BITRATES] = {
+    1000,  // 125 kbps
+    500,   // 250 kbps
+    250,   // 500 kbps
+    125,   // 1 mbps
+  };
+
+  return delay_us[bitrate];
+}
+
+static void prv_handle_event(CanHwInstance *bus, CanHwEvent event) {
+  if (bus->handlers[event].callback != NULL) {
+    bus->handlers[event].callback(bus->handlers[event].context);
+  }
+}
+
+static bool prv_passes_filters(CanHwInstance *bus, const CanHwFrame *frame) {
+  if (bus->num_filters == 0) {
+    return true;
+  }
+
+  for (size_t i = 0; i < bus->num_filters; i++) {
+    const CanHwFilter *filter = &bus->filters[i];
+    if (filter->extended == frame->extended &&
+        (frame->id & filter->mask) == (filter->filter & filter->mask)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// Puts the next frame on the bus, if there is one
+static void prv_start_tx(CanHwInstance *bus) {
+  bus->tx_active = (fifo_size(&bus->tx_fifo) > 0);
+  if (bus->tx_active) {
+    x86_interrupt_schedule(bus->interrupt_id, x86_interrupt_get_time() + bus->delay_us);
+  }
+}
+
+// Runs once the frame at the head of the TX fifo has been on the bus for a frame time
+static void prv_tx_complete_handler(uint8_t interrupt_id) {
+  CanHwInstance *bus = NULL;
+  for (size_t i = 0; i < s_num_instances; i++) {
+    if (s_instances[i].interrupt_id == interrupt_id) {
+      bus = &s_instances[i];
+    }
+  }
+
+  CanHwFrame frame = { 0 };
+  if (bus == NULL || fifo_pop(&bus->tx_fifo, &frame) != STATUS_CODE_OK) {
+    if (bus != NULL) {
+      bus->tx_active = false;
+    }
+    return;
+  }
+
+  if (bus->loopback && prv_passes_filters(bus, &frame)) {
+    frame.timestamp_ns = x86_interrupt_get_time() * 1000;
+    if (fifo_push(&bus->rx_fifo, &frame) == STATUS_CODE_OK) {
+      prv_handle_event(bus, CAN_HW_EVENT_MSG_RX);
+    } else {
+      LOG_WARN("CAN HW: RX overflow on %s, dropping 0x%x\n", bus->interface, frame.id);
+    }
+  }
+
+  prv_start_tx(bus);
+  prv_handle_event(bus, CAN_HW_EVENT_TX_READY);
+}
+
+// Returns the bus named |interface|, claiming a new one if there isn't one yet
+static CanHwInstance *prv_get_instance(const char *interface) {
+  for (size_t i = 0; i < s_num_instances; i++) {
+    if (strncmp(s_instances[i].interface, interface, sizeof(s_instances[i].interface)) == 0) {
+      return &s_instances[i];
+    }
+  }
+
+  if (s_num_instances >= CAN_HW_MAX_INSTANCES) {
+    return NULL;
+  }
+
+  return &s_instances[s_num_instances++];
+}
+
+StatusCode can_hw_open(CanHwInstance **instance, const char *interface,
+                       const CanHwSettings *settings) {
+  if (interface == NULL) {
+    interface = getenv(CAN_HW_INTERFACE_ENV);
+    if (interface == NULL) {
+      interface = CAN_HW_DEFAULT_INTERFACE;
+    }
+  }
+
+  if (strlen(interface) >= CAN_HW_INTERFACE_LEN) {
+    return status_msg(STATUS_CODE_INVALID_ARGS, "CAN HW: Interface name too long");
+  }
+
+  CanHwInstance *bus = prv_get_instance(interface);
+  if (bus == NULL) {
+    return status_msg(STATUS_CODE_RESOURCE_EXHAUSTED, "CAN HW: Ran out of instances");
+  }
+  *instance = bus;
+
+  memset(bus, 0, sizeof(*bus));
+  snprintf(bus->interface, sizeof(bus->interface), "%s", interface);
+  bus->delay_us = prv_get_delay(settings->bitrate);
+  bus->loopback = settings->loopback;
+  fifo_init(&bus->tx_fifo, bus->tx_frames);
+  fifo_init(&bus->rx_fifo, bus->rx_frames);
+
+  uint8_t handler_id = 0;
+  status_ok_or_return(x86_interrupt_register_handler(prv_tx_complete_handler, &handler_id));
+  InterruptSettings it_settings = {
+    .type = INTERRUPT_TYPE_INTERRUPT,       //
+    .priority = INTERRUPT_PRIORITY_NORMAL,  //
+  };
+  status_ok_or_return(
+      x86_interrupt_register_interrupt(handler_id, &it_settings, &bus->interrupt_id));
+
+  LOG_DEBUG("CAN HW initialized on virtual bus %s\n", bus->interface);
+
+  return STATUS_CODE_OK;
+}
+
+StatusCode can_hw_init(const CanHwSettings *settings) {
+  return can_hw_open(&s_default, NULL, settings);
+}
+
+StatusCode can_hw_instance_register_callback(CanHwInstance *instance, CanHwEvent event,
+                                             CanHwEventHandlerCb callback, void *context) {
+  if (instance == NULL || event >= NUM_CAN_HW_EVENTS) {
+    return status_code(STATUS_CODE_INVALID_ARGS);
+  }
+
+  instance->handlers[event] = (CanHwEventHandler){
+    .callback = callback,  //
+    .context = context,    //
+  };
+
+  return STATUS_CODE_OK;
+}
+
+StatusCode can_hw_register_callback(CanHwEvent event, CanHwEventHandlerCb callback, void *context) {
+  return can_hw_instance_register_callback(s_default, event, callback, context);
+}
+
+StatusCode can_hw_instance_add_filter(CanHwInstance *instance, uint32_t mask, uint32_t filter,
+                                      bool extended) {
+  if (instance == NULL) {
+    return status_code(STATUS_CODE_INVALID_ARGS);
+  } else if (instance->num_filters >= CAN_HW_MAX_FILTERS) {
+    return status_msg(STATUS_CODE_RESOURCE_EXHAUSTED, "CAN HW: Ran out of filters.");
+  }
+
+  uint32_t reg_mask = extended ? CAN_HW_EXTENDED_MASK : CAN_HW_STANDARD_MASK;
+  instance->filters[instance->num_filters] = (CanHwFilter){
+    .mask = mask & reg_mask,      //
+    .filter = filter & reg_mask,  //
+    .extended = extended,         //
+  };
+  instance->num_filters++;
+
+  return STATUS_CODE_OK;
+}
+
+StatusCode can_hw_add_filter(uint32_t mask, uint32_t filter, bool extended) {
+  return can_hw_instance_add_filter(s_default, mask, filter, extended);
+}
+
+StatusCode can_hw_instance_set_filters(CanHwInstance *instance, const CanHwFilter *filters,
+                                       size_t num_filters) {
+  if (instance == NULL || (filters == NULL && num_filters > 0)) {
+    return status_code(STATUS_CODE_INVALID_ARGS);
+  } else if (num_filters > CAN_HW_MAX_FILTERS) {
+    return status_msg(STATUS_CODE_RESOURCE_EXHAUSTED, "CAN HW: Ran out of filters.");
+  }
+
+  instance->num_filters = 0;
+  for (size_t i = 0; i < num_filters; i++) {
+    status_ok_or_return(can_hw_instance_add_filter(instance, filters[i].mask, filters[i].filter,
+                                                   filters[i].extended));
+  }
+
+  return STATUS_CODE_OK;
+}
+
+StatusCode can_hw_set_filters(const CanHwFilter *filters, size_t num_filters) {
+  return can_hw_instance_set_filters(s_default, filters, num_filters);
+}
+
+CanHwBusStatus can_hw_instance_bus_status(CanHwInstance *instance) {
+  return CAN_HW_BUS_STATUS_OK;
+}
+
+CanHwBusStatus can_hw_bus_status(void) {
+  return can_hw_instance_bus_status(s_default);
+}
+
+// The virtual bus never has errors
+void can_hw_instance_get_error_counters(CanHwInstance *instance, uint8_t *tx_errors,
+                                        uint8_t *rx_errors) {
+  *tx_errors = 0;
+  *rx_errors = 0;
+}
+
+void can_hw_get_error_counters(uint8_t *tx_errors, uint8_t *rx_errors) {
+  can_hw_instance_get_error_counters(s_default, tx_errors, rx_errors);
+}
+
+StatusCode can_hw_instance_transmit(CanHwInstance *instance, uint32_t id, bool extended,
+                                    const uint8_t *data, size_t len) {
+  if (instance == NULL || len > sizeof(uint64_t)) {
+    return status_code(STATUS_CODE_INVALID_ARGS);
+  }
+
+  CanHwFrame frame = {
+    .id = id & (extended ? CAN_HW_EXTENDED_MASK : CAN_HW_STANDARD_MASK),  //
+    .extended = extended,                                                //
+    .dlc = (uint8_t)len,                                                 //
+  };
+  memcpy(&frame.data, data, len);
+
+  StatusCode ret = fifo_push(&instance->tx_fifo, &frame);
+  if (ret != STATUS_CODE_OK) {
+    // Fifo is full
+    return status_msg(STATUS_CODE_RESOURCE_EXHAUSTED, "CAN HW TX failed");
+  }
+
+  if (!instance->tx_active) {
+    prv_start_tx(instance);
+  }
+
+  return STATUS_CODE_OK;
+}
+
+StatusCode can_hw_transmit(uint32_t id, bool extended, const uint8_t *data, size_t len) {
+  return can_hw_instance_transmit(s_default, id, extended, data, len);
+}
+
+bool can_hw_instance_receive(CanHwInstance *instance, uint32_t *id, bool *extended, uint64_t *data,
+                             size_t *len) {
+  CanHwFrame frame = { 0 };
+  if (instance == NULL || fifo_pop(&instance->rx_fifo, &frame) != STATUS_CODE_OK) {
+    return false;
+  }
+
+  *id = frame.id;
+  *extended = frame.extended;
+  *data = frame.data;
+  *len = frame.dlc;
+  instance->last_rx_timestamp_ns = frame.timestamp_ns;
+
+  return true;
+}
+
+// Must be called within the RX handler, returns whether a message was processed
+bool can_hw_receive(uint32_t *id, bool *extended, uint64_t *data, size_t *len) {
+  return can_hw_instance_receive(s_default, id, extended, data, len);
+}
+
+uint64_t can_hw_instance_get_rx_timestamp_ns(CanHwInstance *instance) {
+  return (instance == NULL) ? 0 : instance->last_rx_timestamp_ns;
+}
+
+uint64_t can_hw_get_rx_timestamp_ns(void) {
+  return can_hw_instance_get_rx_timestamp_ns(s_default);
+}
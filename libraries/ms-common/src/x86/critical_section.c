@@ -10,18 +10,25 @@
 #include "x86_interrupt.h"
 
 static bool s_interrupts_disabled = false;
+#ifndef X86_INTERRUPT_SCHED
 static pthread_mutex_t s_mutex = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+#endif
 
 // WARNING: due to skipping the pthread_mutex lock in a signal_handler it is possible that during a
 // signal handler's critical section a data race occurs due to another thread entering a critical
 // section successfully during the handler's execution. This is due to the signal handler not
 // locking the mutex however, this is to prevent deadlock. If this begins to be an issue we should
 // revisiting the mutex implementation here.
+//
+// With X86_INTERRUPT=sched, interrupts only run on the main thread and never preempt it, so the
+// mutex is skipped and a critical section is just the interrupt mask flag.
 
 bool critical_section_start(void) {
+#ifndef X86_INTERRUPT_SCHED
   if (!x86_interrupt_in_handler()) {
     pthread_mutex_lock(&s_mutex);
   }
+#endif
   if (!s_interrupts_disabled) {
     // Update the signal mask to prevent interrupts from being executed on the signal handler
     // thread. Note that they can still queue like on an embedded device.
@@ -35,9 +42,11 @@ bool critical_section_start(void) {
 }
 
 void critical_section_end(bool disabled_in_scope) {
+#ifndef X86_INTERRUPT_SCHED
   if (!x86_interrupt_in_handler()) {
     pthread_mutex_unlock(&s_mutex);
   }
+#endif
   if (s_interrupts_disabled && disabled_in_scope) {
     // Clear the block mask for this process to allow signals to be processed. (They will queue when
     // disabled).
@@ -1,8 +1,21 @@
 #include "hal_test_helpers.h"
 
 #include <stdint.h>
+#include <time.h>
+
+#include "misc.h"
 
 void _test_soft_timer_set_counter(uint32_t counter_value) {
   // Not possible on x86 ignore this.
   return;
 }
+
+uint64_t _test_benchmark_get_time(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
+uint32_t _test_benchmark_elapsed_us(uint64_t start_us) {
+  return (uint32_t)MIN(_test_benchmark_get_time() - start_us, UINT32_MAX);
+}
@@ -0,0 +1,44 @@
+// Uses a scheduled interrupt as the alarm, so time is real or virtual depending on the x86
+// interrupt backend (see x86_interrupt.h).
+#include "soft_timer_hw.h"
+
+#include <stddef.h>
+
+#include "interrupt_def.h"
+#include "x86_interrupt.h"
+
+static SoftTimerHwCallback s_callback = NULL;
+static uint8_t s_interrupt_id = 0;
+// Interrupt time at init, so soft timer time starts at 0
+static uint64_t s_start_time_us = 0;
+
+static void prv_alarm_handler(uint8_t interrupt_id) {
+  s_callback();
+}
+
+void soft_timer_hw_init(SoftTimerHwCallback callback) {
+  s_callback = callback;
+
+  // Register a handler and interrupt.
+  uint8_t handler_id;
+  x86_interrupt_register_handler(prv_alarm_handler, &handler_id);
+  InterruptSettings it_settings = {
+    .type = INTERRUPT_TYPE_INTERRUPT,       //
+    .priority = INTERRUPT_PRIORITY_NORMAL,  //
+  };
+  x86_interrupt_register_interrupt(handler_id, &it_settings, &s_interrupt_id);
+
+  s_start_time_us = x86_interrupt_get_time();
+}
+
+uint64_t soft_timer_hw_get_time(void) {
+  return x86_interrupt_get_time() - s_start_time_us;
+}
+
+void soft_timer_hw_set_alarm(uint64_t time_us) {
+  x86_interrupt_schedule(s_interrupt_id, s_start_time_us + time_us);
+}
+
+void soft_timer_hw_disable_alarm(void) {
+  x86_interrupt_cancel_schedule(s_interrupt_id);
+}
@@ -1,5 +1,8 @@
 #include "wait.h"
 
+#include "x86_interrupt.h"
+
 void wait(void) {
-  return;
+  // Interrupts preempt us with signals, but the scheduler needs us to give it a chance to run
+  x86_interrupt_wait();
 }
@@ -4,6 +4,7 @@
 #include "log.h"
 #include "test_helpers.h"
 #include "unity.h"
+#include "wait.h"
 
 #define TEST_CAN_UNKNOWN_MSG_ID 0xA
 #define TEST_CAN_DEVICE_ID 0x1
@@ -53,11 +54,7 @@ static void prv_clock_tx(void) {
   TEST_ASSERT_TRUE(processed);
 }
 
-void setup_test(void) {
-  event_queue_init();
-  interrupt_init();
-  soft_timer_init();
-
+static void prv_init_can(const CanMsgSchema *msg_schema) {
   CanSettings can_settings = {
     .device_id = TEST_CAN_DEVICE_ID,
     .bitrate = CAN_HW_BITRATE_125KBPS,
@@ -67,12 +64,21 @@ void setup_test(void) {
     .tx = { GPIO_PORT_A, 12 },
     .rx = { GPIO_PORT_A, 11 },
     .loopback = true,
+    .msg_schema = msg_schema,
   };
 
   StatusCode ret = can_init(&s_can_storage, &can_settings);
   TEST_ASSERT_OK(ret);
 }
 
+void setup_test(void) {
+  event_queue_init();
+  interrupt_init();
+  soft_timer_init();
+
+  prv_init_can(NULL);
+}
+
 void teardown_test(void) {}
 
 void test_can_basic(void) {
@@ -96,6 +102,7 @@ void test_can_basic(void) {
   Event e = { 0 };
   // Wait for RX
   while (event_process(&e) != STATUS_CODE_OK) {
+    wait();
   }
   TEST_ASSERT_EQUAL(TEST_CAN_EVENT_RX, e.id);
   bool processed = can_process_event(&e);
@@ -130,6 +137,7 @@ void test_can_filter(void) {
 
   Event e = { 0 };
   while (event_process(&e) != STATUS_CODE_OK) {
+    wait();
   }
   TEST_ASSERT_EQUAL(TEST_CAN_EVENT_RX, e.id);
   TEST_ASSERT_EQUAL(1, e.data);
@@ -141,6 +149,112 @@ void test_can_filter(void) {
   TEST_ASSERT_EQUAL(msg.data, rx_msg.data);
 }
 
+void test_can_filter_plan(void) {
+  CanFilterPlan plan = { 0 };
+  TEST_ASSERT_OK(can_get_filter_plan(&plan));
+  TEST_ASSERT_EQUAL(0, plan.num_filters);
+
+  TEST_ASSERT_OK(can_add_filter(0x2));
+  for (CanMessageId msg_id = 0x4; msg_id < 0x8; msg_id++) {
+    TEST_ASSERT_OK(can_add_filter(msg_id));
+  }
+  // Adding an ID twice is harmless
+  TEST_ASSERT_OK(can_add_filter(0x5));
+  TEST_ASSERT_EQUAL(STATUS_CODE_INVALID_ARGS, can_add_filter(CAN_MSG_MAX_IDS));
+
+  // 0x4 - 0x7 share a filter
+  TEST_ASSERT_OK(can_get_filter_plan(&plan));
+  TEST_ASSERT_EQUAL(2, plan.num_filters);
+  TEST_ASSERT_EQUAL(5, plan.num_subscribed);
+  TEST_ASSERT_EQUAL(5, plan.num_accepted);
+}
+
+void test_can_stats(void) {
+  volatile CanMessage rx_msg = { 0 };
+  CanMessage msg = {
+    .msg_id = 0x20,             //
+    .type = CAN_MSG_TYPE_DATA,  //
+    .dlc = 8,                   //
+  };
+
+  can_register_rx_handler(0x20, prv_rx_callback, &rx_msg);
+  TEST_ASSERT_OK(can_transmit(&msg, NULL));
+  prv_clock_tx();
+
+  Event e = { 0 };
+  while (event_process(&e) != STATUS_CODE_OK) {
+    wait();
+  }
+  TEST_ASSERT_EQUAL(TEST_CAN_EVENT_RX, e.id);
+  TEST_ASSERT_TRUE(can_process_event(&e));
+
+  CanStats stats = { 0 };
+  TEST_ASSERT_OK(can_get_stats(&stats));
+  TEST_ASSERT_EQUAL(1, stats.tx_frames[0x20]);
+  TEST_ASSERT_EQUAL(1, stats.rx_frames[0x20]);
+  TEST_ASSERT_EQUAL(1, stats.tx_latency.count);
+  TEST_ASSERT_EQUAL(1, stats.rx_latency.count);
+  TEST_ASSERT_EQUAL(0, stats.tx_dropped);
+  TEST_ASSERT_EQUAL(0, stats.rx_dropped);
+
+  TEST_ASSERT_EQUAL(STATUS_CODE_INVALID_ARGS, can_start_stats_broadcast(CAN_MSG_MAX_IDS, 100));
+
+  // The summary is sent like any other message
+  volatile CanMessage summary = { 0 };
+  can_register_rx_handler(0x30, prv_rx_callback, &summary);
+  TEST_ASSERT_OK(can_start_stats_broadcast(0x30, 10));
+  while (summary.msg_id != 0x30) {
+    while (event_process(&e) != STATUS_CODE_OK) {
+      wait();
+    }
+    TEST_ASSERT_TRUE(can_process_event(&e));
+  }
+  TEST_ASSERT_EQUAL(8, summary.dlc);
+}
+
+void test_can_msg_schema(void) {
+  CanMsgSchema msg_schema[CAN_MSG_MAX_IDS];
+  for (size_t i = 0; i < CAN_MSG_MAX_IDS; i++) {
+    msg_schema[i] = (CanMsgSchema){ .slot = CAN_MSG_SCHEMA_NO_SLOT };
+  }
+  msg_schema[0x20] = (CanMsgSchema){
+    .dlc = 2,                         //
+    .source_id = TEST_CAN_DEVICE_ID,  //
+    .slot = 0,                        //
+  };
+  prv_init_can(msg_schema);
+
+  volatile CanMessage rx_msg = { 0 };
+  can_register_rx_handler(0x20, prv_rx_callback, &rx_msg);
+  can_register_rx_handler(0x21, prv_rx_callback, &rx_msg);
+
+  // Wrong DLC, undefined message, then a valid message
+  const CanMessage msgs[] = {
+    { .msg_id = 0x20, .type = CAN_MSG_TYPE_DATA, .data = 0x1, .dlc = 3 },
+    { .msg_id = 0x21, .type = CAN_MSG_TYPE_DATA, .data = 0x2, .dlc = 2 },
+    { .msg_id = 0x20, .type = CAN_MSG_TYPE_DATA, .data = 0x3, .dlc = 2 },
+  };
+
+  for (size_t i = 0; i < SIZEOF_ARRAY(msgs); i++) {
+    TEST_ASSERT_OK(can_transmit(&msgs[i], NULL));
+    prv_clock_tx();
+
+    Event e = { 0 };
+    while (event_process(&e) != STATUS_CODE_OK) {
+      wait();
+    }
+    TEST_ASSERT_EQUAL(TEST_CAN_EVENT_RX, e.id);
+    TEST_ASSERT_TRUE(can_process_event(&e));
+
+    // Only the valid message reaches its handler
+    TEST_ASSERT_EQUAL((i == 2) ? 0x3 : 0, rx_msg.data);
+  }
+
+  CanStats stats = { 0 };
+  TEST_ASSERT_OK(can_get_stats(&stats));
+  TEST_ASSERT_EQUAL(2, stats.rx_invalid);
+}
+
 void test_can_ack(void) {
   volatile CanMessage rx_msg = { 0 };
   volatile uint16_t device_acked = CAN_MSG_INVALID_DEVICE;
@@ -168,6 +282,7 @@ void test_can_ack(void) {
   Event e = { 0 };
   // Handle RX of message and attempt transmit of ACK
   while (event_process(&e) != STATUS_CODE_OK) {
+    wait();
   }
   TEST_ASSERT_EQUAL(TEST_CAN_EVENT_RX, e.id);
   bool processed = can_process_event(&e);
@@ -176,6 +291,7 @@ void test_can_ack(void) {
 
   // Handle RX of ACK
   while (event_process(&e) != STATUS_CODE_OK) {
+    wait();
   }
   TEST_ASSERT_EQUAL(TEST_CAN_EVENT_RX, e.id);
   processed = can_process_event(&e);
@@ -203,6 +319,7 @@ void test_can_ack_expire(void) {
   TEST_ASSERT_OK(ret);
 
   while (ack_status == NUM_CAN_ACK_STATUSES) {
+    wait();
   }
 
   TEST_ASSERT_EQUAL(CAN_ACK_STATUS_TIMEOUT, ack_status);
@@ -233,6 +350,7 @@ void test_can_ack_status(void) {
   Event e = { 0 };
   // Handle RX of message and attempt transmit of ACK
   while (event_process(&e) != STATUS_CODE_OK) {
+    wait();
   }
   TEST_ASSERT_EQUAL(TEST_CAN_EVENT_RX, e.id);
   bool processed = can_process_event(&e);
@@ -241,6 +359,7 @@ void test_can_ack_status(void) {
 
   // Handle RX of ACK
   while (event_process(&e) != STATUS_CODE_OK) {
+    wait();
   }
   TEST_ASSERT_EQUAL(TEST_CAN_EVENT_RX, e.id);
   processed = can_process_event(&e);
@@ -267,6 +386,7 @@ void test_can_default(void) {
   Event e = { 0 };
   // Handle message RX
   while (event_process(&e) != STATUS_CODE_OK) {
+    wait();
   }
   TEST_ASSERT_EQUAL(TEST_CAN_EVENT_RX, e.id);
   bool processed = can_process_event(&e);
@@ -275,3 +395,50 @@ void test_can_default(void) {
   TEST_ASSERT_EQUAL(msg.msg_id, rx_msg.msg_id);
   TEST_ASSERT_EQUAL(msg.data, rx_msg.data);
 }
+
+void test_can_tx_batch(void) {
+  volatile CanMessage rx_msg = { 0 };
+  // Non-critical, so there are no ACKs
+  CanMessage msg = {
+    .msg_id = 0x20,             //
+    .type = CAN_MSG_TYPE_DATA,  //
+    .dlc = 1,                   //
+  };
+
+  can_register_rx_handler(0x20, prv_rx_callback, &rx_msg);
+
+  // A burst only raises a single TX event
+  for (uint8_t i = 0; i < 3; i++) {
+    msg.data = i;
+    TEST_ASSERT_OK(can_transmit(&msg, NULL));
+  }
+  prv_clock_tx();
+
+  CanStats stats = { 0 };
+  TEST_ASSERT_OK(can_get_stats(&stats));
+  TEST_ASSERT_EQUAL(3, stats.tx_queue_high_water);
+  TEST_ASSERT_EQUAL(1, stats.tx_service_passes);
+  TEST_ASSERT_EQUAL(3, stats.tx_latency.count + stats.tx_queue_depth);
+
+  // Anything that didn't fit in the mailboxes goes out once they free up
+  Event e = { 0 };
+  size_t num_rx = 0;
+  while (num_rx < 3) {
+    while (event_process(&e) != STATUS_CODE_OK) {
+      wait();
+    }
+    if (e.id == TEST_CAN_EVENT_RX) {
+      TEST_ASSERT_TRUE(can_process_event(&e));
+      TEST_ASSERT_EQUAL(num_rx, rx_msg.data);
+      num_rx++;
+    } else {
+      TEST_ASSERT_EQUAL(TEST_CAN_EVENT_TX, e.id);
+      TEST_ASSERT_TRUE(can_process_event(&e));
+    }
+  }
+
+  TEST_ASSERT_OK(can_get_stats(&stats));
+  TEST_ASSERT_EQUAL(3, stats.tx_latency.count);
+  TEST_ASSERT_EQUAL(0, stats.tx_queue_depth);
+  TEST_ASSERT_EQUAL(0, stats.tx_dropped);
+}
@@ -4,6 +4,7 @@
 #include "soft_timer.h"
 #include "test_helpers.h"
 #include "unity.h"
+#include "wait.h"
 
 typedef enum {
   TEST_CAN_ACK_DEVICE_A = 0,
@@ -137,6 +138,7 @@ void test_can_ack_expiry(void) {
   can_ack_add_request(&s_ack_requests, 0x2, &ack_request);
 
   while (data.msg_id == 0) {
+    wait();
   }
 
   TEST_ASSERT_EQUAL(0x2, data.msg_id);
@@ -168,9 +170,110 @@ void test_can_ack_expiry_moved(void) {
   TEST_ASSERT_EQUAL(1, s_ack_requests.num_requests);
 
   while (data.msg_id == can_msg.msg_id) {
+    wait();
   }
 
   TEST_ASSERT_EQUAL(0x2, data.msg_id);
   TEST_ASSERT_EQUAL(CAN_ACK_STATUS_TIMEOUT, data.status);
   TEST_ASSERT_EQUAL(0, s_ack_requests.num_requests);
 }
+
+void test_can_ack_same_id_fifo(void) {
+  TestResponse data[3] = { 0 };
+  CanMessage can_msg = {
+    .source_id = TEST_CAN_ACK_DEVICE_B,  //
+    .type = CAN_MSG_TYPE_ACK,            //
+    .msg_id = 0x3,                       //
+  };
+
+  for (size_t i = 0; i < SIZEOF_ARRAY(data); i++) {
+    CanAckRequest ack_request = {
+      .callback = prv_ack_callback,                                        //
+      .context = &data[i],                                                 //
+      .expected_bitset = CAN_ACK_EXPECTED_DEVICES(TEST_CAN_ACK_DEVICE_B),  //
+    };
+    TEST_ASSERT_OK(can_ack_add_request(&s_ack_requests, 0x3, &ack_request));
+  }
+
+  // Each ACK completes the oldest request that's still waiting
+  for (size_t i = 0; i < SIZEOF_ARRAY(data); i++) {
+    TEST_ASSERT_OK(can_ack_handle_msg(&s_ack_requests, &can_msg));
+    TEST_ASSERT_EQUAL(TEST_CAN_ACK_DEVICE_B, data[i].device);
+    TEST_ASSERT_EQUAL(SIZEOF_ARRAY(data) - i - 1, s_ack_requests.num_requests);
+  }
+  TEST_ASSERT_EQUAL(STATUS_CODE_UNKNOWN, can_ack_handle_msg(&s_ack_requests, &can_msg));
+
+  // Out of range IDs are rejected
+  CanAckRequest ack_request = { .expected_bitset = 0x1 };
+  TEST_ASSERT_NOT_OK(can_ack_add_request(&s_ack_requests, CAN_MSG_MAX_IDS, &ack_request));
+}
+
+void test_can_ack_expiry_out_of_order(void) {
+  // Remove a request from the middle of a FIFO, then make sure the others still time out
+  volatile TestResponse data[3] = { 0 };
+  CanMessage can_msg = {
+    .source_id = TEST_CAN_ACK_DEVICE_C,  //
+    .type = CAN_MSG_TYPE_ACK,            //
+    .msg_id = 0x5,                       //
+  };
+
+  for (size_t i = 0; i < SIZEOF_ARRAY(data); i++) {
+    CanAckRequest ack_request = {
+      .callback = prv_ack_callback,  //
+      .context = (void *)&data[i],   //
+      // Only the middle request is waiting on device C
+      .expected_bitset = (i == 1) ? CAN_ACK_EXPECTED_DEVICES(TEST_CAN_ACK_DEVICE_C)
+                                  : CAN_ACK_EXPECTED_DEVICES(TEST_CAN_ACK_DEVICE_A),
+    };
+    TEST_ASSERT_OK(can_ack_add_request(&s_ack_requests, 0x5, &ack_request));
+  }
+
+  TEST_ASSERT_OK(can_ack_handle_msg(&s_ack_requests, &can_msg));
+  TEST_ASSERT_EQUAL(CAN_ACK_STATUS_OK, data[1].status);
+  TEST_ASSERT_EQUAL(2, s_ack_requests.num_requests);
+
+  while (s_ack_requests.num_requests > 0) {
+    wait();
+  }
+
+  TEST_ASSERT_EQUAL(CAN_ACK_STATUS_TIMEOUT, data[0].status);
+  TEST_ASSERT_EQUAL(CAN_ACK_STATUS_OK, data[1].status);
+  TEST_ASSERT_EQUAL(CAN_ACK_STATUS_TIMEOUT, data[2].status);
+
+  CanAckRttHistogram histogram = { 0 };
+  TEST_ASSERT_OK(can_ack_get_rtt_histogram(&s_ack_requests, 0x5, &histogram));
+  TEST_ASSERT_EQUAL(2, histogram.timeouts);
+}
+
+void test_can_ack_rtt_histogram(void) {
+  TestResponse data = { 0 };
+  CanMessage can_msg = {
+    .source_id = TEST_CAN_ACK_DEVICE_A,  //
+    .type = CAN_MSG_TYPE_ACK,            //
+    .msg_id = 0x7,                       //
+  };
+  CanAckRequest ack_request = {
+    .callback = prv_ack_callback,                                        //
+    .context = &data,                                                    //
+    .expected_bitset = CAN_ACK_EXPECTED_DEVICES(TEST_CAN_ACK_DEVICE_A),  //
+  };
+
+  // Fast ACK, then one that takes a few ms
+  TEST_ASSERT_OK(can_ack_add_request(&s_ack_requests, 0x7, &ack_request));
+  TEST_ASSERT_OK(can_ack_handle_msg(&s_ack_requests, &can_msg));
+
+  TEST_ASSERT_OK(can_ack_add_request(&s_ack_requests, 0x7, &ack_request));
+  s_ack_requests.request_nodes[0].sent_us -= 3000;
+  TEST_ASSERT_OK(can_ack_handle_msg(&s_ack_requests, &can_msg));
+
+  CanAckRttHistogram histogram = { 0 };
+  TEST_ASSERT_OK(can_ack_get_rtt_histogram(&s_ack_requests, 0x7, &histogram));
+  TEST_ASSERT_EQUAL(1, histogram.buckets[0]);
+  // 3 ms is in [2 ms, 4 ms)
+  TEST_ASSERT_EQUAL(1, histogram.buckets[4]);
+  TEST_ASSERT_TRUE(histogram.max_us >= 3000);
+  TEST_ASSERT_EQUAL(0, histogram.timeouts);
+
+  TEST_ASSERT_NOT_OK(can_ack_get_rtt_histogram(&s_ack_requests, CAN_MSG_NUM_CRITICAL_IDS,
+                                               &histogram));
+}
@@ -0,0 +1,146 @@
+#include "can_filter.h"
+
+#include <stdbool.h>
+
+#include "test_helpers.h"
+#include "unity.h"
+
+#define TEST_CAN_FILTER_RANDOM_ROUNDS 200
+
+static CanFilterPlan s_plan;
+static uint32_t s_rand_state;
+
+static uint32_t prv_rand(void) {
+  s_rand_state = s_rand_state * 1103515245 + 12345;
+  return s_rand_state >> 8;
+}
+
+// Checks every message ID against the plan's filters, with a few different source IDs
+static uint64_t prv_accepted_ids(const CanFilterPlan *plan) {
+  uint64_t accepted = 0;
+
+  for (CanMessageId msg_id = 0; msg_id < CAN_MSG_MAX_IDS; msg_id++) {
+    for (uint16_t source_id = 0; source_id < CAN_MSG_MAX_DEVICES; source_id += 5) {
+      CanId can_id = { .source_id = source_id, .type = CAN_MSG_TYPE_DATA, .msg_id = msg_id };
+
+      for (size_t i = 0; i < plan->num_filters; i++) {
+        const CanHwFilter *filter = &plan->filters[i];
+        if ((can_id.raw & filter->mask) == (filter->filter & filter->mask)) {
+          // A filter either accepts every source ID or none of them
+          TEST_ASSERT_TRUE(source_id == 0 || (accepted & (1ull << msg_id)));
+          accepted |= 1ull << msg_id;
+          break;
+        }
+      }
+    }
+  }
+
+  return accepted;
+}
+
+static void prv_check_plan(const CanMessageId *msg_ids, size_t num_ids, size_t max_banks) {
+  uint64_t subscribed = 0;
+  for (size_t i = 0; i < num_ids; i++) {
+    subscribed |= 1ull << msg_ids[i];
+  }
+
+  uint64_t accepted = prv_accepted_ids(&s_plan);
+  TEST_ASSERT_EQUAL_HEX64(subscribed, accepted & subscribed);
+  TEST_ASSERT_EQUAL(__builtin_popcountll(subscribed), s_plan.num_subscribed);
+  TEST_ASSERT_EQUAL(__builtin_popcountll(accepted), s_plan.num_accepted);
+
+  TEST_ASSERT_TRUE(s_plan.num_banks <= max_banks);
+  TEST_ASSERT_TRUE(s_plan.num_filters <= s_plan.num_banks * CAN_FILTER_PER_BANK);
+  for (size_t i = 0; i < s_plan.num_filters; i++) {
+    TEST_ASSERT_FALSE(s_plan.filters[i].extended);
+  }
+}
+
+void setup_test(void) {}
+
+void teardown_test(void) {}
+
+void test_can_filter_exact(void) {
+  const CanMessageId msg_ids[] = { 3, 9, 3 };
+  TEST_ASSERT_OK(can_filter_plan(msg_ids, SIZEOF_ARRAY(msg_ids), CAN_HW_NUM_FILTER_BANKS, &s_plan));
+  prv_check_plan(msg_ids, SIZEOF_ARRAY(msg_ids), CAN_HW_NUM_FILTER_BANKS);
+
+  CanId msg_id_mask = { .msg_id = CAN_MSG_MAX_IDS - 1 };
+  TEST_ASSERT_EQUAL(2, s_plan.num_filters);
+  TEST_ASSERT_EQUAL(1, s_plan.num_banks);
+  TEST_ASSERT_EQUAL(msg_id_mask.raw, s_plan.filters[0].mask);
+  TEST_ASSERT_EQUAL(msg_id_mask.raw, s_plan.filters[1].mask);
+  TEST_ASSERT_EQUAL(2, s_plan.num_accepted);
+  TEST_ASSERT_EQUAL(0, can_filter_false_accept_rate(&s_plan));
+}
+
+void test_can_filter_lossless_merge(void) {
+  // 8 - 15 and 32 - 33 are aligned ranges, so they only need one filter each
+  const CanMessageId msg_ids[] = { 8, 9, 10, 11, 12, 13, 14, 15, 32, 33 };
+  TEST_ASSERT_OK(can_filter_plan(msg_ids, SIZEOF_ARRAY(msg_ids), CAN_HW_NUM_FILTER_BANKS, &s_plan));
+  prv_check_plan(msg_ids, SIZEOF_ARRAY(msg_ids), CAN_HW_NUM_FILTER_BANKS);
+
+  TEST_ASSERT_EQUAL(2, s_plan.num_filters);
+  TEST_ASSERT_EQUAL(SIZEOF_ARRAY(msg_ids), s_plan.num_accepted);
+  TEST_ASSERT_EQUAL(0, can_filter_false_accept_rate(&s_plan));
+}
+
+void test_can_filter_all(void) {
+  CanMessageId msg_ids[CAN_MSG_MAX_IDS];
+  for (CanMessageId i = 0; i < CAN_MSG_MAX_IDS; i++) {
+    msg_ids[i] = i;
+  }
+
+  TEST_ASSERT_OK(can_filter_plan(msg_ids, SIZEOF_ARRAY(msg_ids), 1, &s_plan));
+  prv_check_plan(msg_ids, SIZEOF_ARRAY(msg_ids), 1);
+
+  TEST_ASSERT_EQUAL(1, s_plan.num_filters);
+  TEST_ASSERT_EQUAL(0, s_plan.filters[0].mask);
+  TEST_ASSERT_EQUAL(0, can_filter_false_accept_rate(&s_plan));
+}
+
+void test_can_filter_over_budget(void) {
+  // No two of these can share a filter without letting other IDs through
+  const CanMessageId msg_ids[] = { 0, 7, 25, 42, 63 };
+  TEST_ASSERT_OK(can_filter_plan(msg_ids, SIZEOF_ARRAY(msg_ids), 1, &s_plan));
+  prv_check_plan(msg_ids, SIZEOF_ARRAY(msg_ids), 1);
+
+  TEST_ASSERT_EQUAL(2, s_plan.num_filters);
+  TEST_ASSERT_TRUE(s_plan.num_accepted > SIZEOF_ARRAY(msg_ids));
+  TEST_ASSERT_TRUE(s_plan.num_accepted < CAN_MSG_MAX_IDS);
+
+  size_t num_false_accepts = s_plan.num_accepted - SIZEOF_ARRAY(msg_ids);
+  TEST_ASSERT_EQUAL(num_false_accepts * 100 / (CAN_MSG_MAX_IDS - SIZEOF_ARRAY(msg_ids)),
+                    can_filter_false_accept_rate(&s_plan));
+}
+
+void test_can_filter_random(void) {
+  s_rand_state = 1;
+
+  for (size_t round = 0; round < TEST_CAN_FILTER_RANDOM_ROUNDS; round++) {
+    CanMessageId msg_ids[CAN_MSG_MAX_IDS];
+    size_t num_ids = (size_t)(prv_rand() % CAN_MSG_MAX_IDS) + 1;
+    size_t max_banks = (size_t)(prv_rand() % CAN_HW_NUM_FILTER_BANKS) + 1;
+    for (size_t i = 0; i < num_ids; i++) {
+      msg_ids[i] = (CanMessageId)(prv_rand() % CAN_MSG_MAX_IDS);
+    }
+
+    TEST_ASSERT_OK(can_filter_plan(msg_ids, num_ids, max_banks, &s_plan));
+    prv_check_plan(msg_ids, num_ids, max_banks);
+  }
+}
+
+void test_can_filter_invalid(void) {
+  const CanMessageId msg_ids[] = { 1, CAN_MSG_MAX_IDS };
+
+  TEST_ASSERT_EQUAL(STATUS_CODE_INVALID_ARGS, can_filter_plan(msg_ids, 2, 1, &s_plan));
+  TEST_ASSERT_EQUAL(STATUS_CODE_INVALID_ARGS, can_filter_plan(msg_ids, 1, 0, &s_plan));
+  TEST_ASSERT_EQUAL(STATUS_CODE_INVALID_ARGS,
+                    can_filter_plan(msg_ids, 1, CAN_HW_NUM_FILTER_BANKS + 1, &s_plan));
+  TEST_ASSERT_EQUAL(STATUS_CODE_INVALID_ARGS, can_filter_plan(NULL, 1, 1, &s_plan));
+  TEST_ASSERT_EQUAL(STATUS_CODE_INVALID_ARGS, can_filter_plan(msg_ids, 1, 1, NULL));
+
+  // Nothing subscribed means no filters
+  TEST_ASSERT_OK(can_filter_plan(NULL, 0, 1, &s_plan));
+  TEST_ASSERT_EQUAL(0, s_plan.num_filters);
+}
@@ -6,6 +6,7 @@
 #include "soft_timer.h"
 #include "test_helpers.h"
 #include "unity.h"
+#include "wait.h"
 
 static volatile size_t s_msg_rx;
 static volatile uint32_t s_rx_id;
@@ -24,6 +25,7 @@ static void prv_wait_rx(size_t wait_for) {
   size_t expected = s_msg_rx + wait_for;
 
   while (s_msg_rx != expected) {
+    wait();
   }
 }
 
@@ -0,0 +1,115 @@
+// x86 only - requires vcan0 and vcan1 unless built with X86_INTERRUPT=sched
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "can_hw.h"
+#include "can_hw_mcu.h"
+#include "delay.h"
+#include "interrupt.h"
+#include "soft_timer.h"
+#include "test_helpers.h"
+#include "unity.h"
+#include "wait.h"
+
+#define TEST_CAN_HW_INSTANCE_OTHER "vcan1"
+
+typedef struct TestCanHwInstanceRx {
+  CanHwInstance *instance;
+  volatile size_t num_rx;
+  volatile uint32_t id;
+  volatile uint64_t timestamp_ns;
+} TestCanHwInstanceRx;
+
+static TestCanHwInstanceRx s_default_rx;
+static TestCanHwInstanceRx s_other_rx;
+
+static void prv_handle_rx(void *context) {
+  TestCanHwInstanceRx *rx = context;
+  uint32_t id = 0;
+  bool extended = false;
+  uint64_t data = 0;
+  size_t len = 0;
+
+  while (can_hw_instance_receive(rx->instance, &id, &extended, &data, &len)) {
+    rx->id = id;
+    rx->timestamp_ns = can_hw_instance_get_rx_timestamp_ns(rx->instance);
+    rx->num_rx++;
+  }
+}
+
+static void prv_wait_rx(TestCanHwInstanceRx *rx, size_t num_rx) {
+  while (rx->num_rx < num_rx) {
+    wait();
+  }
+}
+
+void setup_test(void) {
+  interrupt_init();
+  soft_timer_init();
+
+  CanHwSettings can_settings = {
+    .bitrate = CAN_HW_BITRATE_500KBPS,
+    .loopback = true,
+    .tx = { GPIO_PORT_A, 12 },
+    .rx = { GPIO_PORT_A, 11 },
+  };
+
+  s_default_rx = (TestCanHwInstanceRx){ 0 };
+  s_other_rx = (TestCanHwInstanceRx){ 0 };
+
+  TEST_ASSERT_OK(can_hw_init(&can_settings));
+  TEST_ASSERT_OK(can_hw_open(&s_default_rx.instance, NULL, &can_settings));
+  TEST_ASSERT_OK(can_hw_open(&s_other_rx.instance, TEST_CAN_HW_INSTANCE_OTHER, &can_settings));
+  TEST_ASSERT_NOT_EQUAL(s_default_rx.instance, s_other_rx.instance);
+
+  TEST_ASSERT_OK(can_hw_register_callback(CAN_HW_EVENT_MSG_RX, prv_handle_rx, &s_default_rx));
+  TEST_ASSERT_OK(can_hw_instance_register_callback(s_other_rx.instance, CAN_HW_EVENT_MSG_RX,
+                                                   prv_handle_rx, &s_other_rx));
+}
+
+void teardown_test(void) {}
+
+void test_can_hw_instance_isolated(void) {
+  TEST_ASSERT_OK(can_hw_transmit(0x12, false, NULL, 0));
+  prv_wait_rx(&s_default_rx, 1);
+
+  TEST_ASSERT_OK(can_hw_instance_transmit(s_other_rx.instance, 0x34, false, NULL, 0));
+  prv_wait_rx(&s_other_rx, 1);
+
+  delay_ms(10);
+
+  // Each frame only shows up on its own bus
+  TEST_ASSERT_EQUAL(1, s_default_rx.num_rx);
+  TEST_ASSERT_EQUAL(0x12, s_default_rx.id);
+  TEST_ASSERT_EQUAL(1, s_other_rx.num_rx);
+  TEST_ASSERT_EQUAL(0x34, s_other_rx.id);
+  TEST_ASSERT_NOT_EQUAL(0, s_other_rx.timestamp_ns);
+}
+
+void test_can_hw_instance_filters(void) {
+  // Filters only apply to the instance they're added to
+  TEST_ASSERT_OK(can_hw_instance_add_filter(s_other_rx.instance, 0x7FF, 0x55, false));
+
+  TEST_ASSERT_OK(can_hw_instance_transmit(s_other_rx.instance, 0x12, false, NULL, 0));
+  TEST_ASSERT_OK(can_hw_instance_transmit(s_other_rx.instance, 0x55, false, NULL, 0));
+  TEST_ASSERT_OK(can_hw_transmit(0x12, false, NULL, 0));
+
+  prv_wait_rx(&s_other_rx, 1);
+  prv_wait_rx(&s_default_rx, 1);
+  delay_ms(10);
+
+  TEST_ASSERT_EQUAL(1, s_other_rx.num_rx);
+  TEST_ASSERT_EQUAL(0x55, s_other_rx.id);
+  TEST_ASSERT_EQUAL(1, s_default_rx.num_rx);
+}
+
+void test_can_hw_instance_invalid(void) {
+  CanHwSettings can_settings = { .bitrate = CAN_HW_BITRATE_500KBPS };
+  CanHwInstance *instance = NULL;
+
+  TEST_ASSERT_EQUAL(STATUS_CODE_INVALID_ARGS,
+                    can_hw_open(&instance, "an_interface_name_that_is_too_long", &can_settings));
+  TEST_ASSERT_EQUAL(STATUS_CODE_INVALID_ARGS,
+                    can_hw_instance_transmit(NULL, 0x12, false, NULL, 0));
+  TEST_ASSERT_FALSE(can_hw_instance_receive(NULL, NULL, NULL, NULL, NULL));
+}
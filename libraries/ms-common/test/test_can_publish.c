@@ -0,0 +1,167 @@
+#include "can_publish.h"
+
+#include "can.h"
+#include "delay.h"
+#include "interrupt.h"
+#include "soft_timer.h"
+#include "test_helpers.h"
+#include "unity.h"
+
+#define TEST_CAN_PUBLISH_MSG_ID 0x20
+#define TEST_CAN_PUBLISH_MAX_SILENCE_MS 20
+
+static CanPublishStorage s_publish;
+static uint32_t s_num_transmitted;
+static StatusCode s_transmit_status;
+
+StatusCode TEST_MOCK(can_transmit)(const CanMessage *msg, const CanAckRequest *ack_request) {
+  TEST_ASSERT_NULL(ack_request);
+  if (s_transmit_status == STATUS_CODE_OK) {
+    s_num_transmitted++;
+  }
+  return s_transmit_status;
+}
+
+static void prv_publish_u16(uint16_t a, uint16_t b) {
+  CanMessage msg = {
+    .msg_id = TEST_CAN_PUBLISH_MSG_ID,  //
+    .type = CAN_MSG_TYPE_DATA,          //
+    .data_u16 = { a, b },               //
+    .dlc = 4,                           //
+  };
+  TEST_ASSERT_OK(can_publish(&s_publish, &msg));
+}
+
+void setup_test(void) {
+  interrupt_init();
+  soft_timer_init();
+  s_num_transmitted = 0;
+  s_transmit_status = STATUS_CODE_OK;
+
+  CanPublishSettings publish_settings = {
+    .field_size = 2,
+    .deadband = 10,
+    .max_silence_ms = TEST_CAN_PUBLISH_MAX_SILENCE_MS,
+  };
+  TEST_ASSERT_OK(can_publish_init(&s_publish, &publish_settings));
+}
+
+void teardown_test(void) {}
+
+void test_can_publish_deadband(void) {
+  // The first message always goes out
+  prv_publish_u16(100, 200);
+  TEST_ASSERT_EQUAL(1, s_num_transmitted);
+
+  prv_publish_u16(100, 200);
+  prv_publish_u16(110, 190);
+  TEST_ASSERT_EQUAL(1, s_num_transmitted);
+  TEST_ASSERT_EQUAL(2, s_publish.num_suppressed);
+
+  // Either field moving past the deadband sends the message
+  prv_publish_u16(100, 211);
+  TEST_ASSERT_EQUAL(2, s_num_transmitted);
+  prv_publish_u16(89, 211);
+  TEST_ASSERT_EQUAL(3, s_num_transmitted);
+
+  // Slow drift is compared against the last value sent
+  prv_publish_u16(95, 211);
+  prv_publish_u16(99, 211);
+  TEST_ASSERT_EQUAL(3, s_num_transmitted);
+  prv_publish_u16(100, 211);
+  TEST_ASSERT_EQUAL(4, s_num_transmitted);
+  TEST_ASSERT_EQUAL(4, s_publish.num_sent);
+}
+
+void test_can_publish_max_silence(void) {
+  prv_publish_u16(100, 200);
+  prv_publish_u16(100, 200);
+  TEST_ASSERT_EQUAL(1, s_num_transmitted);
+
+  delay_ms(TEST_CAN_PUBLISH_MAX_SILENCE_MS + 1);
+  prv_publish_u16(100, 200);
+  TEST_ASSERT_EQUAL(2, s_num_transmitted);
+
+  // The heartbeat restarts from the last message sent
+  prv_publish_u16(100, 200);
+  TEST_ASSERT_EQUAL(2, s_num_transmitted);
+}
+
+void test_can_publish_layout_change(void) {
+  prv_publish_u16(100, 200);
+
+  CanMessage msg = {
+    .msg_id = TEST_CAN_PUBLISH_MSG_ID,  //
+    .type = CAN_MSG_TYPE_DATA,          //
+    .data_u16 = { 100, 200 },           //
+    .dlc = 2,                           //
+  };
+  TEST_ASSERT_OK(can_publish(&s_publish, &msg));
+  TEST_ASSERT_EQUAL(2, s_num_transmitted);
+
+  msg.msg_id++;
+  TEST_ASSERT_OK(can_publish(&s_publish, &msg));
+  TEST_ASSERT_EQUAL(3, s_num_transmitted);
+
+  can_publish_invalidate(&s_publish);
+  TEST_ASSERT_OK(can_publish(&s_publish, &msg));
+  TEST_ASSERT_EQUAL(4, s_num_transmitted);
+}
+
+void test_can_publish_long_silence(void) {
+  // Just over 2^32 us - truncated to 32 bits, the interval would be less than a millisecond
+  CanPublishSettings publish_settings = {
+    .field_size = 2,
+    .max_silence_ms = 4294968,
+  };
+  TEST_ASSERT_OK(can_publish_init(&s_publish, &publish_settings));
+
+  prv_publish_u16(100, 200);
+  delay_ms(TEST_CAN_PUBLISH_MAX_SILENCE_MS + 1);
+  prv_publish_u16(100, 200);
+  TEST_ASSERT_EQUAL(1, s_num_transmitted);
+}
+
+void test_can_publish_partial_field(void) {
+  CanMessage msg = {
+    .msg_id = TEST_CAN_PUBLISH_MSG_ID,  //
+    .type = CAN_MSG_TYPE_DATA,          //
+    .data_u16 = { 100, 200 },           //
+    .dlc = 3,                           //
+  };
+  TEST_ASSERT_OK(can_publish(&s_publish, &msg));
+
+  // Bytes past the DLC aren't sent, so they can't count as a change
+  msg.data_u8[3] = 0xFF;
+  TEST_ASSERT_OK(can_publish(&s_publish, &msg));
+  TEST_ASSERT_EQUAL(1, s_num_transmitted);
+
+  msg.data_u8[2] = 100;
+  TEST_ASSERT_OK(can_publish(&s_publish, &msg));
+  TEST_ASSERT_EQUAL(2, s_num_transmitted);
+}
+
+void test_can_publish_transmit_error(void) {
+  prv_publish_u16(100, 200);
+
+  // A failed transmit is retried on the next call
+  s_transmit_status = STATUS_CODE_RESOURCE_EXHAUSTED;
+  CanMessage msg = {
+    .msg_id = TEST_CAN_PUBLISH_MSG_ID,  //
+    .type = CAN_MSG_TYPE_DATA,          //
+    .data_u16 = { 150, 200 },           //
+    .dlc = 4,                           //
+  };
+  TEST_ASSERT_EQUAL(STATUS_CODE_RESOURCE_EXHAUSTED, can_publish(&s_publish, &msg));
+
+  s_transmit_status = STATUS_CODE_OK;
+  TEST_ASSERT_OK(can_publish(&s_publish, &msg));
+  TEST_ASSERT_EQUAL(2, s_num_transmitted);
+}
+
+void test_can_publish_invalid_args(void) {
+  CanPublishSettings publish_settings = { .field_size = 3 };
+  TEST_ASSERT_EQUAL(STATUS_CODE_INVALID_ARGS, can_publish_init(&s_publish, &publish_settings));
+  TEST_ASSERT_EQUAL(STATUS_CODE_INVALID_ARGS, can_publish_init(&s_publish, NULL));
+  TEST_ASSERT_EQUAL(STATUS_CODE_INVALID_ARGS, can_publish_init(NULL, &publish_settings));
+}
@@ -0,0 +1,169 @@
+#include "can_queue.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "log.h"
+#include "test_helpers.h"
+#include "unity.h"
+
+// 500 kbps, 8 data bytes
+#define TEST_CAN_QUEUE_FRAME_US 250
+#define TEST_CAN_QUEUE_SIM_FRAMES 1000
+// Heartbeat period in frame times, and telemetry messages queued per frame time
+#define TEST_CAN_QUEUE_HEARTBEAT_PERIOD 8
+#define TEST_CAN_QUEUE_TELEMETRY_PER_FRAME 2
+
+#define TEST_CAN_QUEUE_HEARTBEAT_ID 1
+#define TEST_CAN_QUEUE_TELEMETRY_ID 40
+
+typedef enum {
+  TEST_CAN_QUEUE_CLASS_CRITICAL = 0,
+  TEST_CAN_QUEUE_CLASS_TELEMETRY,
+  NUM_TEST_CAN_QUEUE_CLASSES,
+} TestCanQueueClass;
+
+typedef struct TestCanQueueDelay {
+  uint32_t sent;
+  uint32_t dropped;
+  uint32_t max_us;
+  uint64_t total_us;
+} TestCanQueueDelay;
+
+static CanQueue s_queue;
+
+static StatusCode prv_push(CanMessageId msg_id, uint64_t data, uint32_t queued_us) {
+  CanTxEntry entry = {
+    .msg = { .msg_id = msg_id, .type = CAN_MSG_TYPE_DATA, .data = data, .dlc = 8 },  //
+    .queued_us = queued_us,                                                         //
+  };
+  return can_queue_push(&s_queue, &entry);
+}
+
+void setup_test(void) {
+  TEST_ASSERT_OK(can_queue_init(&s_queue));
+}
+
+void teardown_test(void) {}
+
+void test_can_queue_id_order(void) {
+  CanMessageId ids[] = { 40, 3, 20, 1, 63, 13 };
+  for (size_t i = 0; i < SIZEOF_ARRAY(ids); i++) {
+    TEST_ASSERT_OK(prv_push(ids[i], i, 0));
+  }
+
+  CanTxEntry entry = { 0 };
+  CanMessageId last_id = 0;
+  for (size_t i = 0; i < SIZEOF_ARRAY(ids); i++) {
+    TEST_ASSERT_OK(can_queue_pop(&s_queue, &entry));
+    TEST_ASSERT_TRUE(last_id <= entry.msg.msg_id);
+    last_id = entry.msg.msg_id;
+  }
+  TEST_ASSERT_NOT_OK(can_queue_pop(&s_queue, &entry));
+}
+
+void test_can_queue_ack_order(void) {
+  CanTxEntry entry = {
+    .msg = { .msg_id = 5, .type = CAN_MSG_TYPE_ACK },  //
+  };
+  TEST_ASSERT_OK(can_queue_push(&s_queue, &entry));
+  TEST_ASSERT_OK(prv_push(6, 0, 0));
+  TEST_ASSERT_OK(prv_push(5, 0, 0));
+
+  // The ID wins first, then data frames win over ACKs, like on the bus
+  TEST_ASSERT_OK(can_queue_pop(&s_queue, &entry));
+  TEST_ASSERT_EQUAL(5, entry.msg.msg_id);
+  TEST_ASSERT_EQUAL(CAN_MSG_TYPE_DATA, entry.msg.type);
+  TEST_ASSERT_OK(can_queue_pop(&s_queue, &entry));
+  TEST_ASSERT_EQUAL(CAN_MSG_TYPE_ACK, entry.msg.type);
+  TEST_ASSERT_OK(can_queue_pop(&s_queue, &entry));
+  TEST_ASSERT_EQUAL(6, entry.msg.msg_id);
+}
+
+void test_can_queue_same_id_fifo(void) {
+  for (uint64_t i = 0; i < CAN_QUEUE_SIZE - CAN_QUEUE_CRITICAL_RESERVED; i++) {
+    TEST_ASSERT_OK(prv_push((i % 2 == 0) ? 30 : 20, i, 0));
+  }
+
+  CanTxEntry entry = { 0 };
+  for (uint64_t i = 1; i < CAN_QUEUE_SIZE - CAN_QUEUE_CRITICAL_RESERVED; i += 2) {
+    TEST_ASSERT_OK(can_queue_peek(&s_queue, &entry));
+    TEST_ASSERT_OK(can_queue_pop(&s_queue, &entry));
+    TEST_ASSERT_EQUAL(i, entry.msg.data);
+  }
+  for (uint64_t i = 0; i < CAN_QUEUE_SIZE - CAN_QUEUE_CRITICAL_RESERVED; i += 2) {
+    TEST_ASSERT_OK(can_queue_pop(&s_queue, &entry));
+    TEST_ASSERT_EQUAL(i, entry.msg.data);
+  }
+}
+
+void test_can_queue_critical_reserved(void) {
+  for (size_t i = 0; i < CAN_QUEUE_SIZE - CAN_QUEUE_CRITICAL_RESERVED; i++) {
+    TEST_ASSERT_OK(prv_push(TEST_CAN_QUEUE_TELEMETRY_ID, i, 0));
+  }
+  TEST_ASSERT_EQUAL(STATUS_CODE_RESOURCE_EXHAUSTED,
+                    prv_push(TEST_CAN_QUEUE_TELEMETRY_ID, 0, 0));
+
+  // Critical messages can still get in
+  for (size_t i = 0; i < CAN_QUEUE_CRITICAL_RESERVED; i++) {
+    TEST_ASSERT_OK(prv_push(TEST_CAN_QUEUE_HEARTBEAT_ID, i, 0));
+  }
+  TEST_ASSERT_NOT_OK(prv_push(TEST_CAN_QUEUE_HEARTBEAT_ID, 0, 0));
+  TEST_ASSERT_EQUAL(CAN_QUEUE_SIZE, can_queue_size(&s_queue));
+}
+
+// Simulates a bus that can send one frame per frame time while telemetry is queued faster than
+// that, and measures how long each class of message waits in the queue.
+void test_can_queue_delay_per_class(void) {
+  TestCanQueueDelay delays[NUM_TEST_CAN_QUEUE_CLASSES] = { 0 };
+
+  for (uint32_t frame = 0; frame < TEST_CAN_QUEUE_SIM_FRAMES; frame++) {
+    uint32_t now_us = frame * TEST_CAN_QUEUE_FRAME_US;
+
+    // The mailbox takes the highest priority message at the start of each frame
+    CanTxEntry entry = { 0 };
+    if (status_ok(can_queue_pop(&s_queue, &entry))) {
+      TestCanQueueDelay *delay = CAN_MSG_IS_CRITICAL(&entry.msg)
+                                     ? &delays[TEST_CAN_QUEUE_CLASS_CRITICAL]
+                                     : &delays[TEST_CAN_QUEUE_CLASS_TELEMETRY];
+      uint32_t delay_us = now_us - entry.queued_us;
+      delay->sent++;
+      delay->total_us += delay_us;
+      if (delay_us > delay->max_us) {
+        delay->max_us = delay_us;
+      }
+    }
+
+    // Then new messages show up partway through the frame
+    for (size_t i = 0; i < TEST_CAN_QUEUE_TELEMETRY_PER_FRAME; i++) {
+      if (!status_ok(prv_push(TEST_CAN_QUEUE_TELEMETRY_ID, frame, now_us + 1))) {
+        delays[TEST_CAN_QUEUE_CLASS_TELEMETRY].dropped++;
+      }
+    }
+    if (frame % TEST_CAN_QUEUE_HEARTBEAT_PERIOD == 0) {
+      if (!status_ok(prv_push(TEST_CAN_QUEUE_HEARTBEAT_ID, frame, now_us + 1))) {
+        delays[TEST_CAN_QUEUE_CLASS_CRITICAL].dropped++;
+      }
+    }
+  }
+
+  for (size_t i = 0; i < NUM_TEST_CAN_QUEUE_CLASSES; i++) {
+    LOG_DEBUG("Class %u: %u sent, %u dropped, avg %u us, max %u us\n", (unsigned int)i,
+              (unsigned int)delays[i].sent, (unsigned int)delays[i].dropped,
+              (unsigned int)(delays[i].total_us / (delays[i].sent ? delays[i].sent : 1)),
+              (unsigned int)delays[i].max_us);
+  }
+
+  // Critical messages only ever wait for the frame on the bus, no matter how much telemetry is
+  // backed up behind them
+  const TestCanQueueDelay *critical = &delays[TEST_CAN_QUEUE_CLASS_CRITICAL];
+  TEST_ASSERT_EQUAL(0, critical->dropped);
+  TEST_ASSERT_EQUAL(TEST_CAN_QUEUE_SIM_FRAMES / TEST_CAN_QUEUE_HEARTBEAT_PERIOD, critical->sent);
+  TEST_ASSERT_TRUE(critical->max_us <= TEST_CAN_QUEUE_FRAME_US);
+
+  // Telemetry is saturated, so it waits for most of a full queue
+  const TestCanQueueDelay *telemetry = &delays[TEST_CAN_QUEUE_CLASS_TELEMETRY];
+  TEST_ASSERT_TRUE(telemetry->dropped > 0);
+  TEST_ASSERT_TRUE(telemetry->max_us >
+                   (CAN_QUEUE_SIZE - CAN_QUEUE_CRITICAL_RESERVED) * TEST_CAN_QUEUE_FRAME_US);
+}
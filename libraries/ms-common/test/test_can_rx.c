@@ -1,8 +1,17 @@
 #include "can_rx.h"
+
+#include <stdlib.h>
+
+#include "hal_test_helpers.h"
+#include "interrupt.h"
+#include "log.h"
+#include "soft_timer.h"
 #include "test_helpers.h"
 #include "unity.h"
 
 #define TEST_CAN_RX_NUM_HANDLERS 10
+#define TEST_CAN_RX_BENCHMARK_HANDLERS 20
+#define TEST_CAN_RX_BENCHMARK_FRAMES 100000
 
 static CanRxHandlers s_rx_handlers;
 static CanRxHandler s_rx_handler_storage[TEST_CAN_RX_NUM_HANDLERS];
@@ -13,7 +22,17 @@ static StatusCode prv_rx_callback(const CanMessage *msg, void *context, CanAckSt
   return STATUS_CODE_OK;
 }
 
+// The sorted array + bsearch lookup that the ID-indexed table replaced, for comparison
+static int prv_handler_comp(const void *a, const void *b) {
+  const CanRxHandler *x = a;
+  const CanRxHandler *y = b;
+
+  return x->msg_id - y->msg_id;
+}
+
 void setup_test(void) {
+  interrupt_init();
+  soft_timer_init();
   can_rx_init(&s_rx_handlers, s_rx_handler_storage, TEST_CAN_RX_NUM_HANDLERS);
 }
 
@@ -77,3 +96,99 @@ void test_can_rx_default(void) {
   TEST_ASSERT_NOT_NULL(handler);
   TEST_ASSERT_EQUAL(0xA, handler->context);
 }
+
+void test_can_rx_default_then_register(void) {
+  TEST_ASSERT_OK(can_rx_register_default_handler(&s_rx_handlers, prv_rx_callback, (void *)0xA));
+
+  // The default handler doesn't count as a handler for the ID
+  TEST_ASSERT_OK(can_rx_register_handler(&s_rx_handlers, 0x05, prv_rx_callback, (void *)0x05));
+  TEST_ASSERT_NOT_OK(can_rx_register_default_handler(&s_rx_handlers, prv_rx_callback, NULL));
+
+  CanRxHandler *handler = can_rx_get_handler(&s_rx_handlers, 0x05);
+  TEST_ASSERT_NOT_NULL(handler);
+  TEST_ASSERT_EQUAL(0x05, handler->context);
+
+  handler = can_rx_get_handler(&s_rx_handlers, CAN_MSG_MAX_IDS - 1);
+  TEST_ASSERT_NOT_NULL(handler);
+  TEST_ASSERT_EQUAL(0xA, handler->context);
+}
+
+void test_can_rx_full(void) {
+  for (CanMessageId i = 0; i < TEST_CAN_RX_NUM_HANDLERS; i++) {
+    TEST_ASSERT_OK(can_rx_register_handler(&s_rx_handlers, i, prv_rx_callback, NULL));
+  }
+  TEST_ASSERT_EQUAL(STATUS_CODE_RESOURCE_EXHAUSTED,
+                    can_rx_register_handler(&s_rx_handlers, 0x20, prv_rx_callback, NULL));
+  TEST_ASSERT_NULL(can_rx_get_handler(&s_rx_handlers, 0x20));
+
+  CanRxHandler storage[UINT8_MAX + 1];
+  CanRxHandlers rx_handlers;
+  TEST_ASSERT_NOT_OK(can_rx_init(&rx_handlers, storage, SIZEOF_ARRAY(storage)));
+}
+
+void test_can_rx_hits(void) {
+  uint32_t hits[CAN_MSG_MAX_IDS] = { 0 };
+  hits[3] = 100;
+  TEST_ASSERT_OK(can_rx_register_handler(&s_rx_handlers, 0x01, prv_rx_callback, NULL));
+
+  // Not counted until enabled
+  can_rx_get_handler(&s_rx_handlers, 0x01);
+  TEST_ASSERT_OK(can_rx_set_hit_counts(&s_rx_handlers, hits));
+  TEST_ASSERT_EQUAL(0, hits[3]);
+
+  can_rx_get_handler(&s_rx_handlers, 0x01);
+  can_rx_get_handler(&s_rx_handlers, 0x01);
+  can_rx_get_handler(&s_rx_handlers, 0x03);
+  can_rx_get_handler(&s_rx_handlers, CAN_MSG_INVALID_ID);
+  TEST_ASSERT_EQUAL(2, hits[0x01]);
+  TEST_ASSERT_EQUAL(1, hits[0x03]);
+
+  TEST_ASSERT_OK(can_rx_set_hit_counts(&s_rx_handlers, NULL));
+  can_rx_get_handler(&s_rx_handlers, 0x01);
+  TEST_ASSERT_EQUAL(2, hits[0x01]);
+}
+
+// Looks up a stream of message IDs, like the CAN FSM does for every received frame.
+void test_can_rx_benchmark(void) {
+  static CanRxHandler s_sorted[TEST_CAN_RX_BENCHMARK_HANDLERS];
+  static CanRxHandler s_storage[TEST_CAN_RX_BENCHMARK_HANDLERS];
+  static CanMessageId s_frames[256];
+  CanRxHandlers rx_handlers;
+  can_rx_init(&rx_handlers, s_storage, SIZEOF_ARRAY(s_storage));
+
+  // Every third ID has a handler, and frames are a mix of handled and unhandled IDs
+  for (size_t i = 0; i < TEST_CAN_RX_BENCHMARK_HANDLERS; i++) {
+    CanMessageId msg_id = (CanMessageId)((i * 3) % CAN_MSG_MAX_IDS);
+    s_sorted[i] = (CanRxHandler){ .msg_id = msg_id, .callback = prv_rx_callback };
+    TEST_ASSERT_OK(can_rx_register_handler(&rx_handlers, msg_id, prv_rx_callback, NULL));
+  }
+  qsort(s_sorted, SIZEOF_ARRAY(s_sorted), sizeof(s_sorted[0]), prv_handler_comp);
+
+  for (size_t i = 0; i < SIZEOF_ARRAY(s_frames); i++) {
+    s_frames[i] = (CanMessageId)((i * 37 + 11) % CAN_MSG_MAX_IDS);
+  }
+
+  volatile size_t found_sorted = 0;
+  uint64_t start_us = _test_benchmark_get_time();
+  for (uint32_t i = 0; i < TEST_CAN_RX_BENCHMARK_FRAMES; i++) {
+    const CanRxHandler key = { .msg_id = s_frames[i % SIZEOF_ARRAY(s_frames)] };
+    if (bsearch(&key, s_sorted, SIZEOF_ARRAY(s_sorted), sizeof(s_sorted[0]), prv_handler_comp) !=
+        NULL) {
+      found_sorted++;
+    }
+  }
+  uint32_t sorted_us = _test_benchmark_elapsed_us(start_us);
+
+  volatile size_t found_table = 0;
+  start_us = _test_benchmark_get_time();
+  for (uint32_t i = 0; i < TEST_CAN_RX_BENCHMARK_FRAMES; i++) {
+    if (can_rx_get_handler(&rx_handlers, s_frames[i % SIZEOF_ARRAY(s_frames)]) != NULL) {
+      found_table++;
+    }
+  }
+  uint32_t table_us = _test_benchmark_elapsed_us(start_us);
+
+  TEST_ASSERT_EQUAL(found_sorted, found_table);
+  LOG_DEBUG("%u frames: bsearch %u us, table %u us\n", (unsigned int)TEST_CAN_RX_BENCHMARK_FRAMES,
+            (unsigned int)sorted_us, (unsigned int)table_us);
+}
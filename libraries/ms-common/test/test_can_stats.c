@@ -0,0 +1,104 @@
+#include "can_stats.h"
+
+#include "interrupt.h"
+#include "test_helpers.h"
+#include "unity.h"
+
+#define TEST_CAN_STATS_WINDOW_US (CAN_STATS_WINDOW_MS * 1000)
+// 8-byte frames at 500 kbps with worst-case stuffing are 135 bits, so this is ~50% of a window
+#define TEST_CAN_STATS_HALF_LOAD_FRAMES 185
+
+static CanStats s_stats;
+
+// Spreads |num_frames| transmits evenly across the window starting at |start_us|
+static void prv_fill_window(uint32_t start_us, size_t num_frames) {
+  CanMessage msg = { .msg_id = 20, .dlc = 8 };
+
+  for (size_t i = 0; i < num_frames; i++) {
+    uint32_t now_us = start_us + (uint32_t)(i * TEST_CAN_STATS_WINDOW_US / num_frames);
+    can_stats_record_tx(&s_stats, &msg, now_us, now_us);
+  }
+}
+
+void setup_test(void) {
+  interrupt_init();
+  can_stats_init(&s_stats, CAN_HW_BITRATE_500KBPS, 0);
+}
+
+void teardown_test(void) {}
+
+void test_can_stats_counters(void) {
+  CanMessage msg = { .msg_id = 5, .dlc = 2 };
+
+  can_stats_record_tx(&s_stats, &msg, 100, 150);
+  can_stats_record_tx(&s_stats, &msg, 200, 230);
+  msg.msg_id = 63;
+  can_stats_record_rx(&s_stats, &msg, 300, 400);
+
+  TEST_ASSERT_EQUAL(2, s_stats.tx_frames[5]);
+  TEST_ASSERT_EQUAL(0, s_stats.rx_frames[5]);
+  TEST_ASSERT_EQUAL(1, s_stats.rx_frames[63]);
+
+  TEST_ASSERT_EQUAL(2, s_stats.tx_latency.count);
+  TEST_ASSERT_EQUAL(80, s_stats.tx_latency.total_us);
+  TEST_ASSERT_EQUAL(50, s_stats.tx_latency.max_us);
+  TEST_ASSERT_EQUAL(1, s_stats.rx_latency.count);
+  TEST_ASSERT_EQUAL(100, s_stats.rx_latency.max_us);
+}
+
+void test_can_stats_bus_load(void) {
+  TEST_ASSERT_EQUAL(0, can_stats_bus_load(&s_stats, 0));
+
+  // The moving average should settle at the load of each window
+  uint32_t start_us = 0;
+  for (size_t i = 0; i < 20; i++) {
+    prv_fill_window(start_us, TEST_CAN_STATS_HALF_LOAD_FRAMES);
+    start_us += TEST_CAN_STATS_WINDOW_US;
+  }
+  TEST_ASSERT_UINT_WITHIN(2, 50, can_stats_bus_load(&s_stats, start_us));
+
+  // Quiet windows decay the load even without any frames
+  uint8_t load = can_stats_bus_load(&s_stats, start_us + TEST_CAN_STATS_WINDOW_US);
+  TEST_ASSERT_TRUE(load < 50);
+  TEST_ASSERT_TRUE(load > 0);
+  TEST_ASSERT_EQUAL(0, can_stats_bus_load(&s_stats, start_us + 100 * TEST_CAN_STATS_WINDOW_US));
+}
+
+void test_can_stats_bus_load_saturates(void) {
+  prv_fill_window(0, TEST_CAN_STATS_HALF_LOAD_FRAMES * 4);
+  // One window at 100% only moves the average a quarter of the way
+  TEST_ASSERT_EQUAL(25, can_stats_bus_load(&s_stats, TEST_CAN_STATS_WINDOW_US));
+}
+
+void test_can_stats_summary(void) {
+  CanMessage msg = { .msg_id = 5, .dlc = 1 };
+  can_stats_record_tx(&s_stats, &msg, 0, 70000);
+  can_stats_record_rx(&s_stats, &msg, 0, 300);
+  s_stats.tx_dropped = 3;
+  s_stats.rx_dropped = 300;
+  s_stats.bus_errors = 1;
+
+  CanMessage summary = { .msg_id = 40 };
+  can_stats_pack_summary(&s_stats, 70000, &summary);
+  TEST_ASSERT_EQUAL(40, summary.msg_id);
+  TEST_ASSERT_EQUAL(CAN_MSG_TYPE_DATA, summary.type);
+  TEST_ASSERT_EQUAL(8, summary.dlc);
+  TEST_ASSERT_EQUAL(3, summary.data_u8[1]);
+  TEST_ASSERT_EQUAL(UINT8_MAX, summary.data_u8[2]);
+  TEST_ASSERT_EQUAL(1, summary.data_u8[3]);
+  TEST_ASSERT_EQUAL(UINT16_MAX, summary.data_u16[2]);
+  TEST_ASSERT_EQUAL(300, summary.data_u16[3]);
+
+  // Everything but the bus load is since the last summary
+  s_stats.tx_dropped++;
+  can_stats_record_rx(&s_stats, &msg, 80000, 80010);
+  can_stats_pack_summary(&s_stats, 80010, &summary);
+  TEST_ASSERT_EQUAL(1, summary.data_u8[1]);
+  TEST_ASSERT_EQUAL(0, summary.data_u8[2]);
+  TEST_ASSERT_EQUAL(0, summary.data_u8[3]);
+  TEST_ASSERT_EQUAL(0, summary.data_u16[2]);
+  TEST_ASSERT_EQUAL(10, summary.data_u16[3]);
+
+  // Lifetime stats are kept
+  TEST_ASSERT_EQUAL(70000, s_stats.tx_latency.max_us);
+}
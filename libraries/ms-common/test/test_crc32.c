@@ -1,9 +1,40 @@
 #include <inttypes.h>
 #include "crc32.h"
+#include "hal_test_helpers.h"
+#include "interrupt.h"
 #include "log.h"
+#include "misc.h"
+#include "soft_timer.h"
 #include "unity.h"
 
+#define TEST_CRC32_RANDOM_BYTES 1000
+#define TEST_CRC32_BENCHMARK_BYTES 4096
+#define TEST_CRC32_BENCHMARK_ROUNDS 100
+
+static uint32_t s_rand_state;
+
+static uint32_t prv_rand(void) {
+  s_rand_state = s_rand_state * 1103515245 + 12345;
+  return s_rand_state >> 8;
+}
+
+// Reference implementation - one bit at a time with the reflected polynomial
+static uint32_t prv_crc32_bitwise(const uint8_t *buffer, size_t buffer_len) {
+  uint32_t crc = 0xFFFFFFFF;
+
+  for (size_t i = 0; i < buffer_len; i++) {
+    crc ^= buffer[i];
+    for (size_t bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320 : 0);
+    }
+  }
+
+  return ~crc;
+}
+
 void setup_test(void) {
+  interrupt_init();
+  soft_timer_init();
   crc32_init();
 }
 
@@ -29,3 +60,78 @@ void test_crc32_bytes(void) {
   LOG_DEBUG("0x%" PRIx32 "\n", crc);
   TEST_ASSERT_EQUAL_HEX(0xCBF43926, crc);
 }
+
+void test_crc32_stream(void) {
+  const uint8_t data[] = { 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39 };
+
+  // Every split of the data into two updates should match the one-shot CRC
+  for (size_t split = 0; split <= SIZEOF_ARRAY(data); split++) {
+    Crc32 crc;
+    crc32_start(&crc);
+    crc32_update(&crc, data, split);
+    crc32_update(&crc, data + split, SIZEOF_ARRAY(data) - split);
+    TEST_ASSERT_EQUAL_HEX(0xCBF43926, crc32_final(&crc));
+  }
+
+  // Nothing hashed
+  Crc32 crc;
+  crc32_start(&crc);
+  TEST_ASSERT_EQUAL_HEX(0x00000000, crc32_final(&crc));
+}
+
+void test_crc32_random(void) {
+  static uint8_t s_data[TEST_CRC32_RANDOM_BYTES];
+  s_rand_state = 1;
+  for (size_t i = 0; i < SIZEOF_ARRAY(s_data); i++) {
+    s_data[i] = (uint8_t)prv_rand();
+  }
+
+  // Covers every alignment and the byte-wise tail
+  for (size_t offset = 0; offset < 8; offset++) {
+    for (size_t len = 0; len < 64; len++) {
+      TEST_ASSERT_EQUAL_HEX(prv_crc32_bitwise(s_data + offset, len),
+                            crc32_arr(s_data + offset, len));
+    }
+  }
+
+  // Streams each half in random pieces, with the two streams interleaved
+  const size_t half = SIZEOF_ARRAY(s_data) / 2;
+  Crc32 crc_a;
+  Crc32 crc_b;
+  crc32_start(&crc_a);
+  crc32_start(&crc_b);
+  size_t pos = 0;
+  while (pos < half) {
+    size_t len = MIN(prv_rand() % 100, half - pos);
+    crc32_update(&crc_a, s_data + pos, len);
+    crc32_update(&crc_b, s_data + half + pos, len);
+    pos += len;
+  }
+  TEST_ASSERT_EQUAL_HEX(prv_crc32_bitwise(s_data, half), crc32_final(&crc_a));
+  TEST_ASSERT_EQUAL_HEX(prv_crc32_bitwise(s_data + half, half), crc32_final(&crc_b));
+}
+
+void test_crc32_benchmark(void) {
+  static uint8_t s_data[TEST_CRC32_BENCHMARK_BYTES];
+  for (size_t i = 0; i < SIZEOF_ARRAY(s_data); i++) {
+    s_data[i] = (uint8_t)i;
+  }
+
+  uint64_t start_us = _test_benchmark_get_time();
+  uint32_t bitwise_crc = prv_crc32_bitwise(s_data, SIZEOF_ARRAY(s_data));
+  uint32_t bitwise_us = _test_benchmark_elapsed_us(start_us);
+
+  uint32_t crc = 0;
+  start_us = _test_benchmark_get_time();
+  for (size_t i = 0; i < TEST_CRC32_BENCHMARK_ROUNDS; i++) {
+    crc = crc32_arr(s_data, SIZEOF_ARRAY(s_data));
+  }
+  uint32_t crc32_us = _test_benchmark_elapsed_us(start_us);
+  TEST_ASSERT_EQUAL_HEX(bitwise_crc, crc);
+
+  // Bytes per us is MB/s
+  LOG_DEBUG("CRC32 of %u bytes: bitwise %u MB/s, crc32_arr %u MB/s\n",
+            (unsigned int)SIZEOF_ARRAY(s_data),
+            (unsigned int)(SIZEOF_ARRAY(s_data) / MAX(bitwise_us, 1u)),
+            (unsigned int)(SIZEOF_ARRAY(s_data) * TEST_CRC32_BENCHMARK_ROUNDS / MAX(crc32_us, 1u)));
+}
@@ -1,4 +1,5 @@
 #include "event_queue.h"
+#include "misc.h"
 #include "status.h"
 #include "test_helpers.h"
 #include "unity.h"
@@ -70,3 +71,143 @@ void test_event_queue_raise_priority(void) {
 
   TEST_ASSERT_EQUAL(STATUS_CODE_EMPTY, event_process(&e));
 }
+
+void test_event_queue_process_batch(void) {
+  Event events[EVENT_QUEUE_SIZE] = { { 0 } };
+  TEST_ASSERT_EQUAL(0, event_process_batch(events, SIZEOF_ARRAY(events)));
+
+  for (uint16_t i = 0; i < 5; i++) {
+    TEST_ASSERT_OK(event_raise_priority(EVENT_PRIORITY_LOW, i, i * 100));
+  }
+  TEST_ASSERT_OK(event_raise_priority(EVENT_PRIORITY_HIGH, 10, 1000));
+  TEST_ASSERT_OK(event_raise_priority(EVENT_PRIORITY_HIGH, 11, 1100));
+
+  // Batches only come from the highest priority with events
+  TEST_ASSERT_EQUAL(2, event_process_batch(events, SIZEOF_ARRAY(events)));
+  TEST_ASSERT_EQUAL(10, events[0].id);
+  TEST_ASSERT_EQUAL(11, events[1].id);
+  TEST_ASSERT_EQUAL(1100, events[1].data);
+
+  // Limited by the batch size
+  TEST_ASSERT_EQUAL(3, event_process_batch(events, 3));
+  for (uint16_t i = 0; i < 3; i++) {
+    TEST_ASSERT_EQUAL(i, events[i].id);
+    TEST_ASSERT_EQUAL(i * 100, events[i].data);
+  }
+
+  // Events raised in between are picked up by priority
+  TEST_ASSERT_OK(event_raise_priority(EVENT_PRIORITY_HIGHEST, 20, 2000));
+  TEST_ASSERT_EQUAL(1, event_process_batch(events, SIZEOF_ARRAY(events)));
+  TEST_ASSERT_EQUAL(20, events[0].id);
+
+  TEST_ASSERT_EQUAL(2, event_process_batch(events, SIZEOF_ARRAY(events)));
+  TEST_ASSERT_EQUAL(3, events[0].id);
+  TEST_ASSERT_EQUAL(4, events[1].id);
+
+  TEST_ASSERT_EQUAL(0, event_process_batch(events, SIZEOF_ARRAY(events)));
+  TEST_ASSERT_EQUAL(STATUS_CODE_EMPTY, event_process(&events[0]));
+}
+
+void test_event_queue_wrap(void) {
+  // Keep a few events queued while cycling through the ring a few times
+  Event e = { 0 };
+  uint16_t next_raise = 0;
+  uint16_t next_process = 0;
+  for (; next_raise < 3; next_raise++) {
+    TEST_ASSERT_OK(event_raise(next_raise, next_raise));
+  }
+
+  for (int i = 0; i < 3 * EVENT_QUEUE_SIZE; i++) {
+    TEST_ASSERT_OK(event_raise(next_raise, next_raise));
+    next_raise++;
+    TEST_ASSERT_OK(event_process(&e));
+    TEST_ASSERT_EQUAL(next_process, e.id);
+    next_process++;
+  }
+}
+
+void test_event_queue_stats(void) {
+  EventQueueStats stats = { 0 };
+  TEST_ASSERT_OK(event_queue_get_stats(EVENT_PRIORITY_NORMAL, &stats));
+  TEST_ASSERT_EQUAL(0, stats.high_water_mark);
+  TEST_ASSERT_EQUAL(0, stats.dropped);
+  TEST_ASSERT_NOT_OK(event_queue_get_stats(NUM_EVENT_PRIORITIES, &stats));
+
+  for (int i = 0; i < EVENT_QUEUE_SIZE + 2; i++) {
+    event_raise(1, 0);
+  }
+  TEST_ASSERT_OK(event_raise_priority(EVENT_PRIORITY_LOW, 2, 0));
+
+  // Draining doesn't lower the high water mark
+  Event events[EVENT_QUEUE_SIZE] = { { 0 } };
+  TEST_ASSERT_EQUAL(EVENT_QUEUE_SIZE, event_process_batch(events, SIZEOF_ARRAY(events)));
+
+  TEST_ASSERT_OK(event_queue_get_stats(EVENT_PRIORITY_NORMAL, &stats));
+  TEST_ASSERT_EQUAL(EVENT_QUEUE_SIZE, stats.high_water_mark);
+  TEST_ASSERT_EQUAL(2, stats.dropped);
+
+  TEST_ASSERT_OK(event_queue_get_stats(EVENT_PRIORITY_LOW, &stats));
+  TEST_ASSERT_EQUAL(1, stats.high_water_mark);
+  TEST_ASSERT_EQUAL(0, stats.dropped);
+
+  // Cleared on init
+  event_queue_init();
+  TEST_ASSERT_OK(event_queue_get_stats(EVENT_PRIORITY_NORMAL, &stats));
+  TEST_ASSERT_EQUAL(0, stats.high_water_mark);
+  TEST_ASSERT_EQUAL(0, stats.dropped);
+}
+
+void test_event_queue_coalesce(void) {
+  const EventId speed[] = { 1 };
+  const EventId pedal[] = { 2, 3, 4 };
+  TEST_ASSERT_OK(event_queue_add_coalesce_group(speed, SIZEOF_ARRAY(speed)));
+  TEST_ASSERT_OK(event_queue_add_coalesce_group(pedal, SIZEOF_ARRAY(pedal)));
+  // IDs can only be in one group
+  TEST_ASSERT_NOT_OK(event_queue_add_coalesce_group(speed, SIZEOF_ARRAY(speed)));
+
+  // Far more updates than the queue can hold
+  for (uint16_t i = 0; i < 3 * EVENT_QUEUE_SIZE; i++) {
+    TEST_ASSERT_OK(event_raise(1, i));
+    TEST_ASSERT_OK(event_raise(pedal[i % SIZEOF_ARRAY(pedal)], i));
+    if (i == 0) {
+      TEST_ASSERT_OK(event_raise(5, 500));
+    }
+  }
+
+  // Only the latest of each group is left, in the position of the first
+  Event events[EVENT_QUEUE_SIZE] = { { 0 } };
+  TEST_ASSERT_EQUAL(3, event_process_batch(events, SIZEOF_ARRAY(events)));
+  TEST_ASSERT_EQUAL(1, events[0].id);
+  TEST_ASSERT_EQUAL(3 * EVENT_QUEUE_SIZE - 1, events[0].data);
+  TEST_ASSERT_EQUAL(pedal[(3 * EVENT_QUEUE_SIZE - 1) % SIZEOF_ARRAY(pedal)], events[1].id);
+  TEST_ASSERT_EQUAL(3 * EVENT_QUEUE_SIZE - 1, events[1].data);
+  TEST_ASSERT_EQUAL(5, events[2].id);
+
+  EventQueueStats stats = { 0 };
+  TEST_ASSERT_OK(event_queue_get_stats(EVENT_PRIORITY_NORMAL, &stats));
+  TEST_ASSERT_EQUAL(3, stats.high_water_mark);
+  TEST_ASSERT_EQUAL(2 * (3 * EVENT_QUEUE_SIZE - 1), stats.coalesced);
+  TEST_ASSERT_EQUAL(0, stats.dropped);
+
+  // Once processed, the next update is queued again behind other events
+  TEST_ASSERT_OK(event_raise(5, 501));
+  TEST_ASSERT_OK(event_raise(1, 10));
+  TEST_ASSERT_OK(event_raise(1, 11));
+  TEST_ASSERT_EQUAL(2, event_process_batch(events, SIZEOF_ARRAY(events)));
+  TEST_ASSERT_EQUAL(5, events[0].id);
+  TEST_ASSERT_EQUAL(1, events[1].id);
+  TEST_ASSERT_EQUAL(11, events[1].data);
+
+  // Only events at the same priority are coalesced
+  TEST_ASSERT_OK(event_raise_priority(EVENT_PRIORITY_LOW, 1, 20));
+  TEST_ASSERT_OK(event_raise_priority(EVENT_PRIORITY_HIGH, 1, 21));
+  TEST_ASSERT_OK(event_raise_priority(EVENT_PRIORITY_HIGH, 1, 22));
+  TEST_ASSERT_OK(event_raise_priority(EVENT_PRIORITY_LOW, 1, 23));
+  TEST_ASSERT_OK(event_process(&events[0]));
+  TEST_ASSERT_EQUAL(22, events[0].data);
+  TEST_ASSERT_OK(event_process(&events[0]));
+  TEST_ASSERT_EQUAL(20, events[0].data);
+  TEST_ASSERT_OK(event_process(&events[0]));
+  TEST_ASSERT_EQUAL(23, events[0].data);
+  TEST_ASSERT_EQUAL(STATUS_CODE_EMPTY, event_process(&events[0]));
+}
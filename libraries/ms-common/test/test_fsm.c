@@ -1,5 +1,6 @@
 #include "fsm.h"
 #include "log.h"
+#include "test_helpers.h"
 #include "unity.h"
 
 typedef enum {
@@ -16,9 +17,16 @@ static bool prv_guard(const Fsm *fsm, const Event *e, void *context) {
   return (bool)e->data;
 }
 
+static bool prv_guard_data_2(const Fsm *fsm, const Event *e, void *context) {
+  return e->data == 2;
+}
+
 FSM_DECLARE_STATE(test_a);
 FSM_DECLARE_STATE(test_b);
 FSM_DECLARE_STATE(test_c);
+FSM_DECLARE_STATE(test_d);
+FSM_DECLARE_STATE(test_ctx);
+FSM_DECLARE_STATE(test_large);
 
 FSM_STATE_TRANSITION(test_a) {
   FSM_ADD_TRANSITION(TEST_FSM_EVENT_A, test_a);
@@ -36,6 +44,33 @@ FSM_STATE_TRANSITION(test_c) {
   FSM_ADD_GUARDED_TRANSITION(TEST_FSM_EVENT_B, prv_guard, test_a);
 }
 
+// Transitions for the same event are checked in the order they were added
+FSM_STATE_TRANSITION(test_d) {
+  FSM_ADD_TRANSITION(TEST_FSM_EVENT_C, test_d);
+  FSM_ADD_GUARDED_TRANSITION(TEST_FSM_EVENT_B, prv_guard_data_2, test_b);
+  FSM_ADD_GUARDED_TRANSITION(TEST_FSM_EVENT_B, prv_guard, test_a);
+  FSM_ADD_TRANSITION(TEST_FSM_EVENT_B, test_c);
+  FSM_ADD_TRANSITION(TEST_FSM_EVENT_A, test_d);
+}
+
+// Takes its event ID from the FSM context
+FSM_STATE_TRANSITION(test_ctx) {
+  uint16_t *event_id = fsm->context;
+  FSM_ADD_TRANSITION(*event_id, test_a);
+}
+
+// More transitions than fit in the pool
+FSM_STATE_TRANSITION(test_large) {
+  for (uint16_t i = 0; i <= FSM_MAX_TRANSITIONS; i++) {
+    FSM_ADD_TRANSITION(i, test_a);
+  }
+}
+
+static void prv_count_transition(const FsmTransition *transition, void *context) {
+  uint16_t *num_transitions = context;
+  (*num_transitions)++;
+}
+
 static void prv_output(Fsm *fsm, const Event *e, void *context) {
   LOG_DEBUG("[%s:%s] State reached from %s (Event %d, data %d)\n", fsm->name,
             fsm->current_state->name, fsm->last_state->name, e->id, e->data);
@@ -100,3 +135,126 @@ void test_fsm_guard(void) {
   transitioned = fsm_process_event(&s_fsm, &e);
   TEST_ASSERT_TRUE(transitioned);
 }
+
+void test_fsm_table(void) {
+  uint16_t num_transitions = 0;
+  fsm_for_each_transition(&s_fsm, prv_count_transition, &num_transitions);
+  TEST_ASSERT_EQUAL(7, num_transitions);
+
+  if (test_a.transitions == NULL) {
+    TEST_IGNORE_MESSAGE("Built with FSM=func");
+  }
+
+  // Tables are built for every reachable state and sorted by event ID
+  TEST_ASSERT_EQUAL(2, test_b.num_transitions);
+  TEST_ASSERT_EQUAL(TEST_FSM_EVENT_A, test_b.transitions[0].event_id);
+  TEST_ASSERT_EQUAL_PTR(&test_a, test_b.transitions[0].state);
+  TEST_ASSERT_EQUAL(TEST_FSM_EVENT_C, test_b.transitions[1].event_id);
+
+  // test_d isn't reachable from test_a
+  TEST_ASSERT_NULL(test_d.transitions);
+}
+
+void test_fsm_guard_order(void) {
+  Fsm fsm = { 0 };
+  fsm_init(&fsm, "test_fsm_order", &test_d, &fsm);
+
+  Event e = {
+    .id = TEST_FSM_EVENT_B,  //
+    .data = 2,               //
+  };
+
+  // Both guarded transitions are true - the first one added wins
+  TEST_ASSERT_TRUE(fsm_process_event(&fsm, &e));
+  TEST_ASSERT_EQUAL_PTR(&test_b, fsm.current_state);
+
+  fsm.current_state = &test_d;
+  e.data = 1;
+  TEST_ASSERT_TRUE(fsm_process_event(&fsm, &e));
+  TEST_ASSERT_EQUAL_PTR(&test_a, fsm.current_state);
+
+  fsm.current_state = &test_d;
+  e.data = 0;
+  TEST_ASSERT_TRUE(fsm_process_event(&fsm, &e));
+  TEST_ASSERT_EQUAL_PTR(&test_c, fsm.current_state);
+}
+
+void test_fsm_shared_states(void) {
+  static uint16_t event_ids[2] = { TEST_FSM_EVENT_A, TEST_FSM_EVENT_B };
+  Fsm fsm_a = { 0 };
+  Fsm fsm_b = { 0 };
+  FsmPoolStats before = { 0 };
+  TEST_ASSERT_OK(fsm_get_pool_stats(&before));
+
+  // The second FSM's context changes the transitions, so the table can't be shared
+  fsm_init(&fsm_a, "test_fsm_ctx_a", &test_ctx, &event_ids[0]);
+  fsm_init(&fsm_b, "test_fsm_ctx_b", &test_ctx, &event_ids[1]);
+  TEST_ASSERT_NULL(test_ctx.transitions);
+
+  // The discarded table was the last one built, so it's returned to the pool
+  FsmPoolStats stats = { 0 };
+  TEST_ASSERT_OK(fsm_get_pool_stats(&stats));
+  TEST_ASSERT_EQUAL(before.in_use, stats.in_use);
+
+  Event e = { .id = TEST_FSM_EVENT_B };
+  TEST_ASSERT_FALSE(fsm_process_event(&fsm_a, &e));
+  TEST_ASSERT_TRUE(fsm_process_event(&fsm_b, &e));
+  TEST_ASSERT_EQUAL_PTR(&test_a, fsm_b.current_state);
+
+  e.id = TEST_FSM_EVENT_A;
+  TEST_ASSERT_TRUE(fsm_process_event(&fsm_a, &e));
+  TEST_ASSERT_EQUAL_PTR(&test_a, fsm_a.current_state);
+}
+
+void test_fsm_table_overflow(void) {
+  FsmPoolStats before = { 0 };
+  TEST_ASSERT_OK(fsm_get_pool_stats(&before));
+
+  Fsm fsm = { 0 };
+  TEST_ASSERT_OK(fsm_init(&fsm, "test_fsm_large", &test_large, NULL));
+
+  if (test_a.transitions == NULL) {
+    TEST_IGNORE_MESSAGE("Built with FSM=func");
+  }
+
+  // The FSM is still usable - the state just checks its transitions in order
+  FsmPoolStats stats = { 0 };
+  TEST_ASSERT_OK(fsm_get_pool_stats(&stats));
+  TEST_ASSERT_EQUAL(before.overflows + 1, stats.overflows);
+  TEST_ASSERT_EQUAL(before.in_use, stats.in_use);
+  TEST_ASSERT_NULL(test_large.transitions);
+
+  Event e = { .id = FSM_MAX_TRANSITIONS };
+  TEST_ASSERT_TRUE(fsm_process_event(&fsm, &e));
+  TEST_ASSERT_EQUAL_PTR(&test_a, fsm.current_state);
+}
+
+void test_fsm_reinit(void) {
+  FsmPoolStats before = { 0 };
+  TEST_ASSERT_OK(fsm_get_pool_stats(&before));
+
+  // Tables are only built once, so initializing again doesn't use more of the pool
+  for (uint16_t i = 0; i <= FSM_MAX_TRANSITIONS; i++) {
+    TEST_ASSERT_OK(fsm_init(&s_fsm, "test_fsm", &test_a, &s_fsm));
+  }
+
+  FsmPoolStats stats = { 0 };
+  TEST_ASSERT_OK(fsm_get_pool_stats(&stats));
+  TEST_ASSERT_EQUAL(before.in_use, stats.in_use);
+  TEST_ASSERT_EQUAL(before.overflows, stats.overflows);
+}
+
+void test_fsm_for_each_transition_default_state(void) {
+  Fsm fsm = { 0 };
+  fsm_init(&fsm, "test_fsm_default", &test_d, &fsm);
+
+  // test_d can't be reached again from test_a
+  Event e = { .id = TEST_FSM_EVENT_B, .data = 1 };
+  TEST_ASSERT_TRUE(fsm_process_event(&fsm, &e));
+  TEST_ASSERT_EQUAL_PTR(&test_a, fsm.current_state);
+
+  // Walks from the default state regardless of the current state
+  uint16_t num_transitions = 0;
+  fsm_for_each_transition(&fsm, prv_count_transition, &num_transitions);
+  TEST_ASSERT_EQUAL(12, num_transitions);
+}
@@ -100,3 +100,98 @@ void test_objpool_copy_free(void) {
   // We should still be able to free the node if this happens.
   TEST_ASSERT_OK(objpool_free_node(&gv_pool, node));
 }
+
+void test_objpool_double_free(void) {
+  TestObject *node = objpool_get_node(&gv_pool);
+  TEST_ASSERT_NOT_NULL(node);
+
+  TEST_ASSERT_OK(objpool_free_node(&gv_pool, node));
+  TEST_ASSERT_EQUAL(STATUS_CODE_INVALID_ARGS, objpool_free_node(&gv_pool, node));
+
+  // The pool should still hand out every node exactly once
+  for (int i = 0; i < TEST_OBJPOOL_SIZE; i++) {
+    TEST_ASSERT_NOT_NULL(objpool_get_node(&gv_pool));
+  }
+  TEST_ASSERT_NULL(objpool_get_node(&gv_pool));
+}
+
+void test_objpool_lazy_init(void) {
+  TestObject *node = objpool_get_node(&gv_pool);
+  TEST_ASSERT_NOT_NULL(node);
+  node->data = 0x1234;
+
+  // Nodes are left alone until they're handed out again
+  TEST_ASSERT_OK(objpool_free_node(&gv_pool, node));
+  TEST_ASSERT_EQUAL(0x1234, node->data);
+
+  TEST_ASSERT_EQUAL_PTR(node, objpool_get_node(&gv_pool));
+  TEST_ASSERT_EQUAL(TEST_OBJPOOL_DEFAULT, node->data);
+}
+
+void test_objpool_large(void) {
+  // Previously, only the first 32 nodes could be handed out
+  static ObjectPool pool;
+  static TestObject nodes[OBJPOOL_MAX_NODES];
+  TEST_ASSERT_OK(objpool_init(&pool, nodes, prv_node_init, NULL));
+
+  for (size_t i = 0; i < OBJPOOL_MAX_NODES; i++) {
+    TestObject *node = objpool_get_node(&pool);
+    // Nodes are handed out lowest first
+    TEST_ASSERT_EQUAL_PTR(&nodes[i], node);
+    TEST_ASSERT_EQUAL(TEST_OBJPOOL_DEFAULT, node->data);
+  }
+  TEST_ASSERT_NULL(objpool_get_node(&pool));
+
+  // Free a node near the end and one in the middle of a word
+  TEST_ASSERT_OK(objpool_free_node(&pool, &nodes[OBJPOOL_MAX_NODES - 1]));
+  TEST_ASSERT_OK(objpool_free_node(&pool, &nodes[OBJPOOL_WORD_BITS + 5]));
+  TEST_ASSERT_EQUAL_PTR(&nodes[OBJPOOL_WORD_BITS + 5], objpool_get_node(&pool));
+  TEST_ASSERT_EQUAL_PTR(&nodes[OBJPOOL_MAX_NODES - 1], objpool_get_node(&pool));
+  TEST_ASSERT_NULL(objpool_get_node(&pool));
+
+  ObjectPool too_big;
+  TEST_ASSERT_EQUAL(STATUS_CODE_OUT_OF_RANGE,
+                    objpool_init_verbose(&too_big, nodes, sizeof(nodes[0]), OBJPOOL_MAX_NODES + 1,
+                                         NULL, NULL));
+}
+
+void test_objpool_partial_word(void) {
+  // The bitmap shouldn't hand out nodes past the end of the last word
+  static ObjectPool pool;
+  static TestObject nodes[OBJPOOL_WORD_BITS + 3];
+  TEST_ASSERT_OK(objpool_init(&pool, nodes, NULL, NULL));
+
+  for (size_t i = 0; i < SIZEOF_ARRAY(nodes); i++) {
+    TEST_ASSERT_EQUAL_PTR(&nodes[i], objpool_get_node(&pool));
+  }
+  TEST_ASSERT_NULL(objpool_get_node(&pool));
+}
+
+void test_objpool_stats(void) {
+  TestObject *nodes[TEST_OBJPOOL_SIZE] = { 0 };
+  ObjpoolStats stats = { 0 };
+
+  TEST_ASSERT_EQUAL(STATUS_CODE_INVALID_ARGS, objpool_get_stats(&gv_pool, NULL));
+
+  for (int i = 0; i < TEST_OBJPOOL_SIZE; i++) {
+    nodes[i] = objpool_get_node(&gv_pool);
+  }
+  TEST_ASSERT_NULL(objpool_get_node(&gv_pool));
+  TEST_ASSERT_NULL(objpool_get_node(&gv_pool));
+
+  for (int i = 0; i < 5; i++) {
+    TEST_ASSERT_OK(objpool_free_node(&gv_pool, nodes[i]));
+  }
+  // Bad frees aren't counted
+  objpool_free_node(&gv_pool, nodes[0]);
+
+  TEST_ASSERT_OK(objpool_get_stats(&gv_pool, &stats));
+  TEST_ASSERT_EQUAL(TEST_OBJPOOL_SIZE - 5, stats.in_use);
+  TEST_ASSERT_EQUAL(TEST_OBJPOOL_SIZE, stats.peak_in_use);
+  TEST_ASSERT_EQUAL(2, stats.failures);
+
+  // Stats are reset with the pool
+  objpool_init(&gv_pool, gv_nodes, prv_node_init, NULL);
+  TEST_ASSERT_OK(objpool_get_stats(&gv_pool, &stats));
+  TEST_ASSERT_EQUAL(0, stats.peak_in_use);
+}
@@ -1,6 +1,7 @@
 #include "misc.h"
 #include "pqueue.h"
 #include "status.h"
+#include "test_helpers.h"
 #include "unity.h"
 
 #define TEST_PQUEUE_SIZE 15
@@ -45,3 +46,35 @@ void test_pqueue_out_of_space(void) {
     TEST_ASSERT_EQUAL(((i + 1) < TEST_PQUEUE_SIZE) ? (void *)i : NULL, pqueue_pop(&gv_queue));
   }
 }
+
+void test_pqueue_equal_prio_fifo(void) {
+  // Equal priorities come out in the order they were pushed, even once the sequence wraps
+  gv_queue.next_seq = UINT32_MAX - 5;
+
+  for (size_t round = 0; round < 3; round++) {
+    for (size_t i = 0; i < TEST_PQUEUE_SIZE - 1; i++) {
+      // Alternate between two priorities
+      TEST_ASSERT_OK(pqueue_push(&gv_queue, (void *)i, (uint16_t)(i % 2)));
+    }
+
+    for (size_t prio = 0; prio < 2; prio++) {
+      for (size_t i = prio; i < TEST_PQUEUE_SIZE - 1; i += 2) {
+        TEST_ASSERT_EQUAL_PTR((void *)i, pqueue_pop(&gv_queue));
+      }
+    }
+    TEST_ASSERT_NULL(pqueue_pop(&gv_queue));
+  }
+}
+
+void test_pqueue_equal_prio_fifo_long_wait(void) {
+  // A node waits behind more pushes than a 16-bit sequence can order
+  TEST_ASSERT_OK(pqueue_push(&gv_queue, (void *)1, 1));
+  for (size_t i = 0; i < 40000; i++) {
+    TEST_ASSERT_OK(pqueue_push(&gv_queue, NULL, 0));
+    TEST_ASSERT_NULL(pqueue_pop(&gv_queue));
+  }
+  TEST_ASSERT_OK(pqueue_push(&gv_queue, (void *)2, 1));
+
+  TEST_ASSERT_EQUAL_PTR((void *)1, pqueue_pop(&gv_queue));
+  TEST_ASSERT_EQUAL_PTR((void *)2, pqueue_pop(&gv_queue));
+}
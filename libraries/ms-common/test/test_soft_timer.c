@@ -8,6 +8,7 @@
 #include "log.h"
 #include "test_helpers.h"
 #include "unity.h"
+#include "wait.h"
 
 static void prv_timeout_cb(SoftTimerId timer_id, void *context) {
   SoftTimerId *cb_id = context;
@@ -38,6 +39,7 @@ void test_soft_timer_basic(void) {
   TEST_ASSERT_TRUE(soft_timer_inuse());
 
   while (cb_id == SOFT_TIMER_INVALID_TIMER) {
+    wait();
   }
 
   TEST_ASSERT_EQUAL(id, cb_id);
@@ -80,6 +82,7 @@ void test_soft_timer_preempt(void) {
   TEST_ASSERT_TRUE(soft_timer_inuse());
 
   while (cb_id_short == SOFT_TIMER_INVALID_TIMER) {
+    wait();
   }
 
   TEST_ASSERT_EQUAL(id_short, cb_id_short);
@@ -88,6 +91,7 @@ void test_soft_timer_preempt(void) {
   TEST_ASSERT_NOT_EQUAL(id_longer, cb_id_longer);
 
   while (cb_id_medium == SOFT_TIMER_INVALID_TIMER) {
+    wait();
   }
 
   TEST_ASSERT_EQUAL(id_medium, cb_id_medium);
@@ -95,12 +99,14 @@ void test_soft_timer_preempt(void) {
   TEST_ASSERT_NOT_EQUAL(id_longer, cb_id_longer);
 
   while (cb_id_long == SOFT_TIMER_INVALID_TIMER) {
+    wait();
   }
 
   TEST_ASSERT_EQUAL(id_long, cb_id_long);
   TEST_ASSERT_NOT_EQUAL(id_longer, cb_id_longer);
 
   while (cb_id_longer == SOFT_TIMER_INVALID_TIMER) {
+    wait();
   }
 
   TEST_ASSERT_EQUAL(id_longer, cb_id_longer);
@@ -129,6 +135,7 @@ void test_soft_timer_cancelled_timer(void) {
   soft_timer_cancel(id_short);
 
   while (cb_id_long == SOFT_TIMER_INVALID_TIMER) {
+    wait();
   }
 
   TEST_ASSERT_EQUAL(id_long, cb_id_long);
@@ -155,6 +162,7 @@ void test_soft_timer_remaining(void) {
     TEST_ASSERT_TRUE(time_remaining <= prev_time_remaining);
     critical_section_end(crit);
     prev_time_remaining = time_remaining;
+    wait();
   }
 
   TEST_ASSERT_EQUAL(0, soft_timer_remaining_time(id));
@@ -186,6 +194,7 @@ void test_soft_timer_exhausted(void) {
   TEST_ASSERT_OK(ret);
 
   while (cb_id_single == SOFT_TIMER_INVALID_TIMER) {
+    wait();
   }
 
   TEST_ASSERT_EQUAL(id_single, cb_id_single);
@@ -204,3 +213,74 @@ void test_soft_timer_too_short(void) {
   TEST_ASSERT_EQUAL(STATUS_CODE_INVALID_ARGS,
                     soft_timer_start(SOFT_TIMER_MIN_TIME_US - 1, prv_timeout_cb, NULL, NULL));
 }
+
+typedef struct TestSoftTimerPeriodic {
+  volatile uint32_t count;
+  uint64_t start_us;
+  uint32_t period_us;
+  uint32_t delay_us;
+  bool late;
+} TestSoftTimerPeriodic;
+
+static void prv_periodic_cb(SoftTimerId timer_id, void *context) {
+  TestSoftTimerPeriodic *periodic = context;
+  uint64_t now_us = soft_timer_get_time();
+
+  periodic->count++;
+  // We should never run before our deadline
+  if (now_us < periodic->start_us + (uint64_t)periodic->count * periodic->period_us) {
+    periodic->late = true;
+  }
+
+  if (periodic->count == 1 && periodic->delay_us != 0) {
+    // Simulate a slow callback
+    while (soft_timer_get_time() < now_us + periodic->delay_us) {
+      wait();
+    }
+  }
+}
+
+void test_soft_timer_periodic(void) {
+  TestSoftTimerPeriodic periodic = {
+    .period_us = 1000,  //
+  };
+  SoftTimerId id = SOFT_TIMER_INVALID_TIMER;
+
+  periodic.start_us = soft_timer_get_time();
+  TEST_ASSERT_OK(soft_timer_start_periodic(periodic.period_us, prv_periodic_cb, &periodic, &id));
+  TEST_ASSERT_NOT_EQUAL(SOFT_TIMER_INVALID_TIMER, id);
+
+  while (periodic.count < 5) {
+    wait();
+  }
+
+  // The timer keeps its id and stays active
+  TEST_ASSERT_TRUE(soft_timer_inuse());
+  TEST_ASSERT_FALSE(periodic.late);
+  TEST_ASSERT_TRUE(soft_timer_remaining_time(id) <= periodic.period_us);
+
+  TEST_ASSERT_TRUE(soft_timer_cancel(id));
+  TEST_ASSERT_FALSE(soft_timer_inuse());
+}
+
+void test_soft_timer_periodic_overrun(void) {
+  TestSoftTimerPeriodic periodic = {
+    .period_us = 1000,  //
+    .delay_us = 2500,   //
+  };
+  SoftTimerId id = SOFT_TIMER_INVALID_TIMER;
+
+  periodic.start_us = soft_timer_get_time();
+  TEST_ASSERT_OK(soft_timer_start_periodic(periodic.period_us, prv_periodic_cb, &periodic, &id));
+  TEST_ASSERT_EQUAL(0, soft_timer_get_overruns(id));
+
+  while (periodic.count < 3) {
+    wait();
+  }
+
+  // The first callback ran through the next 2 deadlines - one runs late and the other is skipped
+  TEST_ASSERT_TRUE(soft_timer_get_overruns(id) >= 1);
+
+  TEST_ASSERT_TRUE(soft_timer_cancel(id));
+  TEST_ASSERT_EQUAL(0, soft_timer_get_overruns(id));
+}
@@ -0,0 +1,283 @@
+#include "soft_timer_queue.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hal_test_helpers.h"
+#include "interrupt.h"
+#include "log.h"
+#include "misc.h"
+#include "soft_timer.h"
+#include "test_helpers.h"
+#include "unity.h"
+
+#define TEST_SOFT_TIMER_QUEUE_NUM_NODES 64
+#define TEST_SOFT_TIMER_QUEUE_BENCHMARK_MAX_NODES 256
+#define TEST_SOFT_TIMER_QUEUE_BENCHMARK_EXPIRIES 20000
+// Each benchmark is run several times and the fastest run is kept to filter out noise
+#define TEST_SOFT_TIMER_QUEUE_BENCHMARK_RUNS 3
+
+// Common interface so both queues can be driven by the same test code
+typedef struct TestSoftTimerQueueOps {
+  const char *name;
+  void (*init)(void *queue, SoftTimerNode *nodes, uint64_t now_us);
+  void (*insert)(void *queue, uint16_t node_id, uint64_t now_us);
+  void (*remove)(void *queue, uint16_t node_id);
+  bool (*next_event)(const void *queue, uint64_t *time_us);
+  uint16_t (*pop_expired)(void *queue, uint64_t now_us);
+} TestSoftTimerQueueOps;
+
+static SoftTimerList s_list;
+static SoftTimerWheel s_wheel;
+static SoftTimerNode s_list_nodes[TEST_SOFT_TIMER_QUEUE_NUM_NODES];
+static SoftTimerNode s_wheel_nodes[TEST_SOFT_TIMER_QUEUE_NUM_NODES];
+static SoftTimerNode s_benchmark_nodes[TEST_SOFT_TIMER_QUEUE_BENCHMARK_MAX_NODES];
+static uint32_t s_benchmark_periods[TEST_SOFT_TIMER_QUEUE_BENCHMARK_MAX_NODES];
+static uint32_t s_rand_state;
+
+static void prv_list_init(void *queue, SoftTimerNode *nodes, uint64_t now_us) {
+  soft_timer_list_init(queue, nodes, now_us);
+}
+
+static void prv_list_insert(void *queue, uint16_t node_id, uint64_t now_us) {
+  soft_timer_list_insert(queue, node_id, now_us);
+}
+
+static void prv_list_remove(void *queue, uint16_t node_id) {
+  soft_timer_list_remove(queue, node_id);
+}
+
+static bool prv_list_next_event(const void *queue, uint64_t *time_us) {
+  return soft_timer_list_next_event(queue, time_us);
+}
+
+static uint16_t prv_list_pop_expired(void *queue, uint64_t now_us) {
+  return soft_timer_list_pop_expired(queue, now_us);
+}
+
+static void prv_wheel_init(void *queue, SoftTimerNode *nodes, uint64_t now_us) {
+  soft_timer_wheel_init(queue, nodes, now_us);
+}
+
+static void prv_wheel_insert(void *queue, uint16_t node_id, uint64_t now_us) {
+  soft_timer_wheel_insert(queue, node_id, now_us);
+}
+
+static void prv_wheel_remove(void *queue, uint16_t node_id) {
+  soft_timer_wheel_remove(queue, node_id);
+}
+
+static bool prv_wheel_next_event(const void *queue, uint64_t *time_us) {
+  return soft_timer_wheel_next_event(queue, time_us);
+}
+
+static uint16_t prv_wheel_pop_expired(void *queue, uint64_t now_us) {
+  return soft_timer_wheel_pop_expired(queue, now_us);
+}
+
+static const TestSoftTimerQueueOps s_list_ops = {
+  .name = "list",                       //
+  .init = prv_list_init,                //
+  .insert = prv_list_insert,            //
+  .remove = prv_list_remove,            //
+  .next_event = prv_list_next_event,    //
+  .pop_expired = prv_list_pop_expired,  //
+};
+
+static const TestSoftTimerQueueOps s_wheel_ops = {
+  .name = "wheel",                       //
+  .init = prv_wheel_init,                //
+  .insert = prv_wheel_insert,            //
+  .remove = prv_wheel_remove,            //
+  .next_event = prv_wheel_next_event,    //
+  .pop_expired = prv_wheel_pop_expired,  //
+};
+
+// Simple LCG so runs are repeatable
+static uint32_t prv_rand(void) {
+  s_rand_state = s_rand_state * 1103515245 + 12345;
+  return s_rand_state >> 8;
+}
+
+static void prv_insert_both(uint16_t node_id, uint64_t expiry_us, uint64_t now_us) {
+  s_list_nodes[node_id].expiry_us = expiry_us;
+  s_wheel_nodes[node_id].expiry_us = expiry_us;
+  soft_timer_list_insert(&s_list, node_id, now_us);
+  soft_timer_wheel_insert(&s_wheel, node_id, now_us);
+}
+
+void setup_test(void) {
+  interrupt_init();
+  soft_timer_init();
+
+  s_rand_state = 1;
+}
+
+void teardown_test(void) {}
+
+void test_soft_timer_queue_wheel_basic(void) {
+  const uint64_t start_us = 123456;
+  uint64_t time_us = 0;
+  soft_timer_wheel_init(&s_wheel, s_wheel_nodes, start_us);
+
+  TEST_ASSERT_FALSE(soft_timer_wheel_next_event(&s_wheel, &time_us));
+  TEST_ASSERT_EQUAL(SOFT_TIMER_NODE_INVALID, soft_timer_wheel_pop_expired(&s_wheel, start_us));
+
+  s_wheel_nodes[0].expiry_us = start_us + 1000;
+  soft_timer_wheel_insert(&s_wheel, 0, start_us);
+
+  // The wheel should report the node's expiry as its next event
+  TEST_ASSERT_TRUE(soft_timer_wheel_next_event(&s_wheel, &time_us));
+  TEST_ASSERT_EQUAL(start_us + 1000, time_us);
+
+  TEST_ASSERT_EQUAL(SOFT_TIMER_NODE_INVALID,
+                    soft_timer_wheel_pop_expired(&s_wheel, start_us + 999));
+  TEST_ASSERT_EQUAL(0, soft_timer_wheel_pop_expired(&s_wheel, start_us + 1000));
+  TEST_ASSERT_FALSE(soft_timer_wheel_next_event(&s_wheel, &time_us));
+}
+
+void test_soft_timer_queue_wheel_overflow(void) {
+  // Start just before a top level boundary and schedule past it
+  const uint64_t start_us = ((uint64_t)1 << 35) - 10;
+  const uint64_t expiry_us = start_us + UINT32_MAX;
+  uint64_t time_us = 0;
+  soft_timer_wheel_init(&s_wheel, s_wheel_nodes, start_us);
+
+  s_wheel_nodes[0].expiry_us = expiry_us;
+  soft_timer_wheel_insert(&s_wheel, 0, start_us);
+
+  // The wheel should go straight to the expiry without stopping at the top level boundary
+  TEST_ASSERT_TRUE(soft_timer_wheel_next_event(&s_wheel, &time_us));
+  TEST_ASSERT_EQUAL(expiry_us, time_us);
+  TEST_ASSERT_EQUAL(SOFT_TIMER_NODE_INVALID, soft_timer_wheel_pop_expired(&s_wheel, time_us - 1));
+  TEST_ASSERT_EQUAL(0, soft_timer_wheel_pop_expired(&s_wheel, time_us));
+}
+
+void test_soft_timer_queue_wheel_remove(void) {
+  uint64_t time_us = 0;
+  soft_timer_wheel_init(&s_wheel, s_wheel_nodes, 0);
+
+  s_wheel_nodes[0].expiry_us = 100;
+  s_wheel_nodes[1].expiry_us = 100;
+  s_wheel_nodes[2].expiry_us = 5000;
+  soft_timer_wheel_insert(&s_wheel, 0, 0);
+  soft_timer_wheel_insert(&s_wheel, 1, 0);
+  soft_timer_wheel_insert(&s_wheel, 2, 0);
+
+  // Remove from a slot and from the expired list
+  soft_timer_wheel_remove(&s_wheel, 0);
+  TEST_ASSERT_EQUAL(1, soft_timer_wheel_pop_expired(&s_wheel, 200));
+  soft_timer_wheel_remove(&s_wheel, 2);
+
+  TEST_ASSERT_FALSE(soft_timer_wheel_next_event(&s_wheel, &time_us));
+  TEST_ASSERT_EQUAL(SOFT_TIMER_NODE_INVALID, soft_timer_wheel_pop_expired(&s_wheel, 10000));
+}
+
+void test_soft_timer_queue_matches_list(void) {
+  // Drive both queues with the same random operations - they should expire nodes at the same times
+  uint64_t now_us = 1000;
+  bool active[TEST_SOFT_TIMER_QUEUE_NUM_NODES] = { 0 };
+
+  soft_timer_list_init(&s_list, s_list_nodes, now_us);
+  soft_timer_wheel_init(&s_wheel, s_wheel_nodes, now_us);
+
+  for (size_t i = 0; i < 20000; i++) {
+    uint16_t node_id = (uint16_t)(prv_rand() % TEST_SOFT_TIMER_QUEUE_NUM_NODES);
+    uint32_t op = prv_rand() % 8;
+
+    if (!active[node_id]) {
+      // Mostly short timers with the occasional long one
+      uint32_t duration_us = (op == 0) ? prv_rand() : prv_rand() % 100000 + 1;
+      prv_insert_both(node_id, now_us + duration_us, now_us);
+      active[node_id] = true;
+    } else if (op == 1) {
+      soft_timer_list_remove(&s_list, node_id);
+      soft_timer_wheel_remove(&s_wheel, node_id);
+      active[node_id] = false;
+    }
+
+    // Jump to the next event or part of the way there
+    uint64_t list_next_us = 0;
+    uint64_t wheel_next_us = 0;
+    if (!soft_timer_list_next_event(&s_list, &list_next_us)) {
+      TEST_ASSERT_FALSE(soft_timer_wheel_next_event(&s_wheel, &wheel_next_us));
+      continue;
+    }
+    TEST_ASSERT_TRUE(soft_timer_wheel_next_event(&s_wheel, &wheel_next_us));
+    TEST_ASSERT_EQUAL(list_next_us, wheel_next_us);
+    now_us = (op < 4) ? list_next_us : now_us + (list_next_us - now_us) / 2;
+
+    uint16_t list_id = soft_timer_list_pop_expired(&s_list, now_us);
+    while (list_id != SOFT_TIMER_NODE_INVALID) {
+      uint16_t wheel_id = soft_timer_wheel_pop_expired(&s_wheel, now_us);
+      TEST_ASSERT_NOT_EQUAL(SOFT_TIMER_NODE_INVALID, wheel_id);
+      TEST_ASSERT_EQUAL(s_list_nodes[list_id].expiry_us, s_wheel_nodes[wheel_id].expiry_us);
+      TEST_ASSERT_TRUE(s_wheel_nodes[wheel_id].expiry_us <= now_us);
+      active[wheel_id] = false;
+      active[list_id] = false;
+      list_id = soft_timer_list_pop_expired(&s_list, now_us);
+    }
+    TEST_ASSERT_EQUAL(SOFT_TIMER_NODE_INVALID, soft_timer_wheel_pop_expired(&s_wheel, now_us));
+  }
+}
+
+// Models a system of periodic timers that are rearmed on expiry, with every 4th expiry also
+// cancelling and restarting another timer. Returns the time taken in microseconds.
+static uint32_t prv_benchmark_run(const TestSoftTimerQueueOps *ops, void *queue,
+                                  size_t num_nodes) {
+  uint64_t now_us = 0;
+  s_rand_state = 1;
+
+  ops->init(queue, s_benchmark_nodes, now_us);
+  for (uint16_t i = 0; i < num_nodes; i++) {
+    // Periods between 1ms and 1s
+    s_benchmark_periods[i] = prv_rand() % 1000000 + 1000;
+    s_benchmark_nodes[i].expiry_us = now_us + s_benchmark_periods[i];
+    ops->insert(queue, i, now_us);
+  }
+
+  uint64_t start_us = _test_benchmark_get_time();
+  size_t expiries = 0;
+  while (expiries < TEST_SOFT_TIMER_QUEUE_BENCHMARK_EXPIRIES) {
+    ops->next_event(queue, &now_us);
+
+    uint16_t node_id = ops->pop_expired(queue, now_us);
+    while (node_id != SOFT_TIMER_NODE_INVALID) {
+      s_benchmark_nodes[node_id].expiry_us = now_us + s_benchmark_periods[node_id];
+      ops->insert(queue, node_id, now_us);
+
+      if (++expiries % 4 == 0) {
+        uint16_t restart_id = (uint16_t)(prv_rand() % num_nodes);
+        ops->remove(queue, restart_id);
+        s_benchmark_nodes[restart_id].expiry_us = now_us + s_benchmark_periods[restart_id];
+        ops->insert(queue, restart_id, now_us);
+      }
+
+      node_id = ops->pop_expired(queue, now_us);
+    }
+  }
+
+  return _test_benchmark_elapsed_us(start_us);
+}
+
+static uint32_t prv_benchmark(const TestSoftTimerQueueOps *ops, void *queue, size_t num_nodes) {
+  uint32_t best_us = UINT32_MAX;
+  for (size_t i = 0; i < TEST_SOFT_TIMER_QUEUE_BENCHMARK_RUNS; i++) {
+    best_us = MIN(best_us, prv_benchmark_run(ops, queue, num_nodes));
+  }
+
+  return best_us;
+}
+
+void test_soft_timer_queue_benchmark(void) {
+  const size_t num_nodes[] = { 30, 64, 256 };
+
+  for (size_t i = 0; i < SIZEOF_ARRAY(num_nodes); i++) {
+    uint32_t list_us = prv_benchmark(&s_list_ops, &s_list, num_nodes[i]);
+    uint32_t wheel_us = prv_benchmark(&s_wheel_ops, &s_wheel, num_nodes[i]);
+
+    LOG_DEBUG("%u timers, %u expiries: %s %u us, %s %u us\n", (unsigned int)num_nodes[i],
+              TEST_SOFT_TIMER_QUEUE_BENCHMARK_EXPIRIES, s_list_ops.name, (unsigned int)list_us,
+              s_wheel_ops.name, (unsigned int)wheel_us);
+  }
+}
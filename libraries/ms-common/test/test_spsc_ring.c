@@ -0,0 +1,159 @@
+#include "spsc_ring.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "can_fifo.h"
+#include "fifo.h"
+#include "hal_test_helpers.h"
+#include "interrupt.h"
+#include "log.h"
+#include "soft_timer.h"
+#include "test_helpers.h"
+#include "unity.h"
+
+#define TEST_SPSC_RING_SIZE 8
+#define TEST_SPSC_RING_BENCHMARK_ROUNDS 10000
+
+SPSC_RING_DEFINE(TestRing, test_ring, uint16_t, TEST_SPSC_RING_SIZE)
+
+static TestRing s_ring;
+
+void setup_test(void) {
+  interrupt_init();
+  soft_timer_init();
+  test_ring_init(&s_ring);
+}
+
+void teardown_test(void) {}
+
+void test_spsc_ring_basic(void) {
+  uint16_t value = 0;
+  TEST_ASSERT_EQUAL(0, test_ring_size(&s_ring));
+  TEST_ASSERT_EQUAL(STATUS_CODE_RESOURCE_EXHAUSTED, test_ring_pop(&s_ring, &value));
+  TEST_ASSERT_EQUAL(STATUS_CODE_RESOURCE_EXHAUSTED, test_ring_peek(&s_ring, &value));
+
+  for (uint16_t i = 0; i < TEST_SPSC_RING_SIZE; i++) {
+    TEST_ASSERT_OK(test_ring_push(&s_ring, &i));
+  }
+  TEST_ASSERT_EQUAL(TEST_SPSC_RING_SIZE, test_ring_size(&s_ring));
+  value = 100;
+  TEST_ASSERT_EQUAL(STATUS_CODE_RESOURCE_EXHAUSTED, test_ring_push(&s_ring, &value));
+
+  TEST_ASSERT_OK(test_ring_peek(&s_ring, &value));
+  TEST_ASSERT_EQUAL(0, value);
+  TEST_ASSERT_OK(test_ring_pop(&s_ring, NULL));
+
+  for (uint16_t i = 1; i < TEST_SPSC_RING_SIZE; i++) {
+    TEST_ASSERT_OK(test_ring_pop(&s_ring, &value));
+    TEST_ASSERT_EQUAL(i, value);
+  }
+  TEST_ASSERT_EQUAL(0, test_ring_size(&s_ring));
+}
+
+void test_spsc_ring_index_wrap(void) {
+  // Indices are free-running, so make sure nothing breaks when they overflow
+  s_ring.head = UINT32_MAX - 2;
+  s_ring.tail = UINT32_MAX - 2;
+
+  for (uint16_t round = 0; round < 3; round++) {
+    for (uint16_t i = 0; i < TEST_SPSC_RING_SIZE; i++) {
+      uint16_t value = (uint16_t)(round * 100 + i);
+      TEST_ASSERT_OK(test_ring_push(&s_ring, &value));
+    }
+    TEST_ASSERT_EQUAL(TEST_SPSC_RING_SIZE, test_ring_size(&s_ring));
+    TEST_ASSERT_NOT_OK(test_ring_push(&s_ring, &round));
+
+    for (uint16_t i = 0; i < TEST_SPSC_RING_SIZE; i++) {
+      uint16_t value = 0;
+      TEST_ASSERT_OK(test_ring_pop(&s_ring, &value));
+      TEST_ASSERT_EQUAL(round * 100 + i, value);
+    }
+    TEST_ASSERT_EQUAL(0, test_ring_size(&s_ring));
+  }
+}
+
+void test_spsc_ring_pop_arr(void) {
+  uint16_t values[TEST_SPSC_RING_SIZE] = { 0 };
+
+  // Start partway through the buffer so the array wraps
+  s_ring.head = TEST_SPSC_RING_SIZE - 3;
+  s_ring.tail = TEST_SPSC_RING_SIZE - 3;
+  for (uint16_t i = 0; i < 6; i++) {
+    TEST_ASSERT_OK(test_ring_push(&s_ring, &i));
+  }
+
+  // Nothing is popped on failure
+  TEST_ASSERT_NOT_OK(test_ring_pop_arr(&s_ring, values, 7));
+  TEST_ASSERT_EQUAL(6, test_ring_size(&s_ring));
+
+  TEST_ASSERT_OK(test_ring_pop_arr(&s_ring, values, 5));
+  for (uint16_t i = 0; i < 5; i++) {
+    TEST_ASSERT_EQUAL(i, values[i]);
+  }
+
+  TEST_ASSERT_OK(test_ring_pop_arr(&s_ring, NULL, 1));
+  TEST_ASSERT_EQUAL(0, test_ring_size(&s_ring));
+}
+
+void test_spsc_ring_in_place(void) {
+  TEST_ASSERT_NULL(test_ring_peek_ptr(&s_ring));
+
+  for (uint16_t i = 0; i < TEST_SPSC_RING_SIZE; i++) {
+    uint16_t *slot = test_ring_claim(&s_ring);
+    TEST_ASSERT_NOT_NULL(slot);
+    *slot = i;
+
+    // Nothing is visible until it's committed
+    TEST_ASSERT_EQUAL(i, test_ring_size(&s_ring));
+    test_ring_commit(&s_ring);
+  }
+  TEST_ASSERT_NULL(test_ring_claim(&s_ring));
+
+  for (uint16_t i = 0; i < TEST_SPSC_RING_SIZE; i++) {
+    const uint16_t *elem = test_ring_peek_ptr(&s_ring);
+    TEST_ASSERT_NOT_NULL(elem);
+    TEST_ASSERT_EQUAL(i, *elem);
+
+    // The first slot can't be reused until it's popped
+    TEST_ASSERT_EQUAL_PTR(i == 0 ? NULL : &s_ring.elems[0], test_ring_claim(&s_ring));
+    TEST_ASSERT_OK(test_ring_pop(&s_ring, NULL));
+  }
+  TEST_ASSERT_NULL(test_ring_peek_ptr(&s_ring));
+}
+
+// Pushes and pops CAN messages in small bursts, like the CAN RX path.
+void test_spsc_ring_benchmark(void) {
+  static CanFifo can_fifo;
+  static CanRxRing can_ring;
+  CanMessage msg = { .msg_id = 1, .data = 0x1234, .dlc = 8 };
+  CanMessage rx_msg = { 0 };
+
+  can_fifo_init(&can_fifo);
+  uint64_t start_us = _test_benchmark_get_time();
+  for (uint32_t i = 0; i < TEST_SPSC_RING_BENCHMARK_ROUNDS; i++) {
+    msg.data = i;
+    fifo_push_impl(&can_fifo.fifo, &msg, sizeof(msg));
+    fifo_push_impl(&can_fifo.fifo, &msg, sizeof(msg));
+    fifo_pop_impl(&can_fifo.fifo, &rx_msg, sizeof(rx_msg));
+    fifo_pop_impl(&can_fifo.fifo, &rx_msg, sizeof(rx_msg));
+  }
+  uint32_t fifo_us = _test_benchmark_elapsed_us(start_us);
+  TEST_ASSERT_EQUAL(TEST_SPSC_RING_BENCHMARK_ROUNDS - 1, rx_msg.data);
+
+  can_rx_ring_init(&can_ring);
+  start_us = _test_benchmark_get_time();
+  for (uint32_t i = 0; i < TEST_SPSC_RING_BENCHMARK_ROUNDS; i++) {
+    msg.data = i;
+    can_rx_ring_push(&can_ring, &msg);
+    can_rx_ring_push(&can_ring, &msg);
+    can_rx_ring_pop(&can_ring, &rx_msg);
+    can_rx_ring_pop(&can_ring, &rx_msg);
+  }
+  uint32_t ring_us = _test_benchmark_elapsed_us(start_us);
+  TEST_ASSERT_EQUAL(TEST_SPSC_RING_BENCHMARK_ROUNDS - 1, rx_msg.data);
+
+  LOG_DEBUG("%u CAN messages: fifo %u us, spsc ring %u us\n",
+            (unsigned int)TEST_SPSC_RING_BENCHMARK_ROUNDS * 2, (unsigned int)fifo_us,
+            (unsigned int)ring_us);
+}
@@ -0,0 +1,120 @@
+// Only built with X86_INTERRUPT=sched - runs hours of soft timer and CAN traffic in virtual time
+#include <stdbool.h>
+#include <time.h>
+
+#include "can.h"
+#include "delay.h"
+#include "event_queue.h"
+#include "interrupt.h"
+#include "log.h"
+#include "soft_timer.h"
+#include "test_helpers.h"
+#include "unity.h"
+#include "wait.h"
+
+#define TEST_VIRTUAL_TIME_DEVICE_ID 0x1
+#define TEST_VIRTUAL_TIME_MSG_ID 0x5
+#define TEST_VIRTUAL_TIME_PERIOD_US 100000
+#define TEST_VIRTUAL_TIME_SOAK_US (60ull * 60 * 1000000)
+
+typedef enum {
+  TEST_VIRTUAL_TIME_EVENT_RX = 10,
+  TEST_VIRTUAL_TIME_EVENT_TX,
+  TEST_VIRTUAL_TIME_EVENT_FAULT,
+} TestVirtualTimeEvent;
+
+typedef struct TestVirtualTimeStats {
+  uint32_t tx;
+  uint32_t rx;
+  uint32_t tx_errors;
+} TestVirtualTimeStats;
+
+static CanStorage s_can_storage;
+
+static void prv_heartbeat_cb(SoftTimerId timer_id, void *context) {
+  TestVirtualTimeStats *stats = context;
+  CanMessage msg = {
+    .msg_id = TEST_VIRTUAL_TIME_MSG_ID,  //
+    .type = CAN_MSG_TYPE_DATA,           //
+    .data = stats->tx,                   //
+    .dlc = 4,                            //
+  };
+
+  if (status_ok(can_transmit(&msg, NULL))) {
+    stats->tx++;
+  } else {
+    stats->tx_errors++;
+  }
+}
+
+static StatusCode prv_rx_cb(const CanMessage *msg, void *context, CanAckStatus *ack_reply) {
+  TestVirtualTimeStats *stats = context;
+  // Messages should arrive in order
+  TEST_ASSERT_EQUAL(stats->rx, msg->data);
+  stats->rx++;
+
+  return STATUS_CODE_OK;
+}
+
+void setup_test(void) {
+  event_queue_init();
+  interrupt_init();
+  soft_timer_init();
+
+  CanSettings can_settings = {
+    .device_id = TEST_VIRTUAL_TIME_DEVICE_ID,
+    .bitrate = CAN_HW_BITRATE_500KBPS,
+    .rx_event = TEST_VIRTUAL_TIME_EVENT_RX,
+    .tx_event = TEST_VIRTUAL_TIME_EVENT_TX,
+    .fault_event = TEST_VIRTUAL_TIME_EVENT_FAULT,
+    .tx = { GPIO_PORT_A, 12 },
+    .rx = { GPIO_PORT_A, 11 },
+    .loopback = true,
+  };
+  TEST_ASSERT_OK(can_init(&s_can_storage, &can_settings));
+}
+
+void teardown_test(void) {}
+
+void test_virtual_time_delay(void) {
+  uint64_t start_us = soft_timer_get_time();
+  delay_s(60);
+
+  // Time jumps straight to the deadline
+  TEST_ASSERT_EQUAL(60000000, soft_timer_get_time() - start_us);
+}
+
+void test_virtual_time_soak(void) {
+  TestVirtualTimeStats stats = { 0 };
+  TEST_ASSERT_OK(can_register_rx_handler(TEST_VIRTUAL_TIME_MSG_ID, prv_rx_cb, &stats));
+
+  SoftTimerId timer_id = SOFT_TIMER_INVALID_TIMER;
+  TEST_ASSERT_OK(soft_timer_start_periodic(TEST_VIRTUAL_TIME_PERIOD_US, prv_heartbeat_cb, &stats,
+                                           &timer_id));
+
+  struct timespec real_start;
+  clock_gettime(CLOCK_MONOTONIC, &real_start);
+
+  uint64_t end_us = soft_timer_get_time() + TEST_VIRTUAL_TIME_SOAK_US;
+  Event e = { 0 };
+  while (soft_timer_get_time() < end_us) {
+    while (status_ok(event_process(&e))) {
+      can_process_event(&e);
+    }
+    wait();
+  }
+
+  struct timespec real_end;
+  clock_gettime(CLOCK_MONOTONIC, &real_end);
+  LOG_DEBUG("Ran %llu s of virtual time in %ld ms\n", TEST_VIRTUAL_TIME_SOAK_US / 1000000,
+            (real_end.tv_sec - real_start.tv_sec) * 1000 +
+                (real_end.tv_nsec - real_start.tv_nsec) / 1000000);
+
+  // Every period ran on time and every message made it back
+  TEST_ASSERT_EQUAL(TEST_VIRTUAL_TIME_SOAK_US / TEST_VIRTUAL_TIME_PERIOD_US, stats.tx);
+  TEST_ASSERT_EQUAL(0, stats.tx_errors);
+  TEST_ASSERT_EQUAL(0, soft_timer_get_overruns(timer_id));
+  TEST_ASSERT_UINT_WITHIN(1, stats.tx, stats.rx);
+
+  soft_timer_cancel(timer_id);
+}
@@ -0,0 +1,471 @@
+#pragma once
+// Typed pack functions for each message in can_msg_defs.h
+// These match the generated CAN_PACK_* macros, but the compiler checks each field's type and the
+// DLC comes from can_msg_schema.h.
+#include <stdint.h>
+
+#include "can_msg.h"
+#include "can_msg_schema.h"
+#include "status.h"
+
+static inline StatusCode can_pack_bps_heartbeat(CanMessage *msg, uint8_t status_u8) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_PLUTUS,
+    .msg_id = SYSTEM_CAN_MESSAGE_BPS_HEARTBEAT,
+    .data_u8 = { status_u8 },
+    .dlc = SYSTEM_CAN_MESSAGE_BPS_HEARTBEAT_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_power_distribution_fault(CanMessage *msg, uint8_t reason_u8) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_CHAOS,
+    .msg_id = SYSTEM_CAN_MESSAGE_POWER_DISTRIBUTION_FAULT,
+    .data_u8 = { reason_u8 },
+    .dlc = SYSTEM_CAN_MESSAGE_POWER_DISTRIBUTION_FAULT_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_battery_relay_main(CanMessage *msg, uint8_t relay_state_u8) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_CHAOS,
+    .msg_id = SYSTEM_CAN_MESSAGE_BATTERY_RELAY_MAIN,
+    .data_u8 = { relay_state_u8 },
+    .dlc = SYSTEM_CAN_MESSAGE_BATTERY_RELAY_MAIN_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_battery_relay_slave(CanMessage *msg, uint8_t relay_state_u8) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_CHAOS,
+    .msg_id = SYSTEM_CAN_MESSAGE_BATTERY_RELAY_SLAVE,
+    .data_u8 = { relay_state_u8 },
+    .dlc = SYSTEM_CAN_MESSAGE_BATTERY_RELAY_SLAVE_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_motor_relay(CanMessage *msg, uint8_t relay_state_u8) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_CHAOS,
+    .msg_id = SYSTEM_CAN_MESSAGE_MOTOR_RELAY,
+    .data_u8 = { relay_state_u8 },
+    .dlc = SYSTEM_CAN_MESSAGE_MOTOR_RELAY_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_solar_relay_rear(CanMessage *msg, uint8_t relay_state_u8) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_CHAOS,
+    .msg_id = SYSTEM_CAN_MESSAGE_SOLAR_RELAY_REAR,
+    .data_u8 = { relay_state_u8 },
+    .dlc = SYSTEM_CAN_MESSAGE_SOLAR_RELAY_REAR_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_solar_relay_front(CanMessage *msg, uint8_t relay_state_u8) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_CHAOS,
+    .msg_id = SYSTEM_CAN_MESSAGE_SOLAR_RELAY_FRONT,
+    .data_u8 = { relay_state_u8 },
+    .dlc = SYSTEM_CAN_MESSAGE_SOLAR_RELAY_FRONT_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_power_state(CanMessage *msg, uint8_t power_state_u8) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_DRIVER_CONTROLS_PEDAL,
+    .msg_id = SYSTEM_CAN_MESSAGE_POWER_STATE,
+    .data_u8 = { power_state_u8 },
+    .dlc = SYSTEM_CAN_MESSAGE_POWER_STATE_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_powertrain_heartbeat(CanMessage *msg) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_CHAOS,
+    .msg_id = SYSTEM_CAN_MESSAGE_POWERTRAIN_HEARTBEAT,
+    .dlc = SYSTEM_CAN_MESSAGE_POWERTRAIN_HEARTBEAT_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_ovuv_dcdc_aux(CanMessage *msg, uint8_t dcdc_ov_flag_u8,
+                                                uint8_t dcdc_uv_flag_u8, uint8_t aux_bat_ov_flag_u8,
+                                                uint8_t aux_bat_uv_flag_u8) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_CHAOS,
+    .msg_id = SYSTEM_CAN_MESSAGE_OVUV_DCDC_AUX,
+    .data_u8 = { dcdc_ov_flag_u8, dcdc_uv_flag_u8, aux_bat_ov_flag_u8, aux_bat_uv_flag_u8 },
+    .dlc = SYSTEM_CAN_MESSAGE_OVUV_DCDC_AUX_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_mc_error_limits(CanMessage *msg, uint16_t error_id_u16,
+                                                  uint16_t limits_u16) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_MOTOR_CONTROLLER,
+    .msg_id = SYSTEM_CAN_MESSAGE_MC_ERROR_LIMITS,
+    .data_u16 = { error_id_u16, limits_u16 },
+    .dlc = SYSTEM_CAN_MESSAGE_MC_ERROR_LIMITS_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_drive_output(CanMessage *msg, uint16_t throttle_u16,
+                                               uint16_t direction_u16, uint16_t cruise_control_u16,
+                                               uint16_t mechanical_brake_state_u16) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_DRIVER_CONTROLS_PEDAL,
+    .msg_id = SYSTEM_CAN_MESSAGE_DRIVE_OUTPUT,
+    .data_u16 = { throttle_u16, direction_u16, cruise_control_u16, mechanical_brake_state_u16 },
+    .dlc = SYSTEM_CAN_MESSAGE_DRIVE_OUTPUT_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_cruise_target(CanMessage *msg, uint8_t target_speed_u8) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_DRIVER_CONTROLS_PEDAL,
+    .msg_id = SYSTEM_CAN_MESSAGE_CRUISE_TARGET,
+    .data_u8 = { target_speed_u8 },
+    .dlc = SYSTEM_CAN_MESSAGE_CRUISE_TARGET_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_fan_control(CanMessage *msg, uint8_t state_u8) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_CHAOS,
+    .msg_id = SYSTEM_CAN_MESSAGE_FAN_CONTROL,
+    .data_u8 = { state_u8 },
+    .dlc = SYSTEM_CAN_MESSAGE_FAN_CONTROL_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_set_discharge_bitset(CanMessage *msg,
+                                                       uint64_t discharge_bitset_u64) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_TELEMETRY,
+    .msg_id = SYSTEM_CAN_MESSAGE_SET_DISCHARGE_BITSET,
+    .data = discharge_bitset_u64,
+    .dlc = SYSTEM_CAN_MESSAGE_SET_DISCHARGE_BITSET_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_discharge_state(CanMessage *msg, uint64_t discharge_bitset_u64) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_PLUTUS,
+    .msg_id = SYSTEM_CAN_MESSAGE_DISCHARGE_STATE,
+    .data = discharge_bitset_u64,
+    .dlc = SYSTEM_CAN_MESSAGE_DISCHARGE_STATE_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_lights_sync(CanMessage *msg) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_LIGHTS_REAR,
+    .msg_id = SYSTEM_CAN_MESSAGE_LIGHTS_SYNC,
+    .dlc = SYSTEM_CAN_MESSAGE_LIGHTS_SYNC_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_lights_state(CanMessage *msg, uint8_t light_id_u8,
+                                               uint8_t light_state_u8) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_DRIVER_CONTROLS_PEDAL,
+    .msg_id = SYSTEM_CAN_MESSAGE_LIGHTS_STATE,
+    .data_u8 = { light_id_u8, light_state_u8 },
+    .dlc = SYSTEM_CAN_MESSAGE_LIGHTS_STATE_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_horn(CanMessage *msg, uint8_t state_u8) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_DRIVER_CONTROLS_PEDAL,
+    .msg_id = SYSTEM_CAN_MESSAGE_HORN,
+    .data_u8 = { state_u8 },
+    .dlc = SYSTEM_CAN_MESSAGE_HORN_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_charger_conn_state(CanMessage *msg, uint8_t is_connected_u8) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_CHARGER,
+    .msg_id = SYSTEM_CAN_MESSAGE_CHARGER_CONN_STATE,
+    .data_u8 = { is_connected_u8 },
+    .dlc = SYSTEM_CAN_MESSAGE_CHARGER_CONN_STATE_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_charger_set_relay_state(CanMessage *msg, uint8_t state_u8) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_CHAOS,
+    .msg_id = SYSTEM_CAN_MESSAGE_CHARGER_SET_RELAY_STATE,
+    .data_u8 = { state_u8 },
+    .dlc = SYSTEM_CAN_MESSAGE_CHARGER_SET_RELAY_STATE_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_steering_event(CanMessage *msg, uint16_t event_id_u16,
+                                                 uint16_t data_u16) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_DRIVER_CONTROLS_STEERING,
+    .msg_id = SYSTEM_CAN_MESSAGE_STEERING_EVENT,
+    .data_u16 = { event_id_u16, data_u16 },
+    .dlc = SYSTEM_CAN_MESSAGE_STEERING_EVENT_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_center_console_event(CanMessage *msg, uint16_t event_id_u16,
+                                                       uint16_t data_u16) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_DRIVER_CONTROLS_CENTER_CONSOLE,
+    .msg_id = SYSTEM_CAN_MESSAGE_CENTER_CONSOLE_EVENT,
+    .data_u16 = { event_id_u16, data_u16 },
+    .dlc = SYSTEM_CAN_MESSAGE_CENTER_CONSOLE_EVENT_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_motor_controller_reset(CanMessage *msg,
+                                                         uint8_t motor_controller_index_u8) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_DRIVER_CONTROLS_PEDAL,
+    .msg_id = SYSTEM_CAN_MESSAGE_MOTOR_CONTROLLER_RESET,
+    .data_u8 = { motor_controller_index_u8 },
+    .dlc = SYSTEM_CAN_MESSAGE_MOTOR_CONTROLLER_RESET_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_battery_soc(CanMessage *msg) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_PLUTUS,
+    .msg_id = SYSTEM_CAN_MESSAGE_BATTERY_SOC,
+    .dlc = SYSTEM_CAN_MESSAGE_BATTERY_SOC_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_battery_vt(CanMessage *msg, uint16_t module_id_u16,
+                                             uint16_t voltage_u16, uint16_t temperature_u16) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_PLUTUS,
+    .msg_id = SYSTEM_CAN_MESSAGE_BATTERY_VT,
+    .data_u16 = { module_id_u16, voltage_u16, temperature_u16 },
+    .dlc = SYSTEM_CAN_MESSAGE_BATTERY_VT_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_battery_aggregate_vc(CanMessage *msg, uint32_t voltage_u32,
+                                                       uint32_t current_u32) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_PLUTUS,
+    .msg_id = SYSTEM_CAN_MESSAGE_BATTERY_AGGREGATE_VC,
+    .data_u32 = { voltage_u32, current_u32 },
+    .dlc = SYSTEM_CAN_MESSAGE_BATTERY_AGGREGATE_VC_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_motor_controller_vc(CanMessage *msg, uint16_t mc_voltage_1_u16,
+                                                      uint16_t mc_current_1_u16,
+                                                      uint16_t mc_voltage_2_u16,
+                                                      uint16_t mc_current_2_u16) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_MOTOR_CONTROLLER,
+    .msg_id = SYSTEM_CAN_MESSAGE_MOTOR_CONTROLLER_VC,
+    .data_u16 = { mc_voltage_1_u16, mc_current_1_u16, mc_voltage_2_u16, mc_current_2_u16 },
+    .dlc = SYSTEM_CAN_MESSAGE_MOTOR_CONTROLLER_VC_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_motor_velocity(CanMessage *msg,
+                                                 uint16_t vehicle_velocity_left_u16,
+                                                 uint16_t vehicle_velocity_right_u16) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_MOTOR_CONTROLLER,
+    .msg_id = SYSTEM_CAN_MESSAGE_MOTOR_VELOCITY,
+    .data_u16 = { vehicle_velocity_left_u16, vehicle_velocity_right_u16 },
+    .dlc = SYSTEM_CAN_MESSAGE_MOTOR_VELOCITY_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_motor_debug(CanMessage *msg, uint64_t data_u64) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_MOTOR_CONTROLLER,
+    .msg_id = SYSTEM_CAN_MESSAGE_MOTOR_DEBUG,
+    .data = data_u64,
+    .dlc = SYSTEM_CAN_MESSAGE_MOTOR_DEBUG_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_motor_temps(CanMessage *msg, uint32_t motor_temp_l_u32,
+                                              uint32_t motor_temp_r_u32) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_MOTOR_CONTROLLER,
+    .msg_id = SYSTEM_CAN_MESSAGE_MOTOR_TEMPS,
+    .data_u32 = { motor_temp_l_u32, motor_temp_r_u32 },
+    .dlc = SYSTEM_CAN_MESSAGE_MOTOR_TEMPS_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_motor_amp_hr(CanMessage *msg, uint32_t motor_amp_hr_l_u32,
+                                               uint32_t motor_amp_hr_r_u32) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_MOTOR_CONTROLLER,
+    .msg_id = SYSTEM_CAN_MESSAGE_MOTOR_AMP_HR,
+    .data_u32 = { motor_amp_hr_l_u32, motor_amp_hr_r_u32 },
+    .dlc = SYSTEM_CAN_MESSAGE_MOTOR_AMP_HR_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_odometer(CanMessage *msg, uint32_t odometer_val_u32) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_MOTOR_CONTROLLER,
+    .msg_id = SYSTEM_CAN_MESSAGE_ODOMETER,
+    .data_u32 = { odometer_val_u32 },
+    .dlc = SYSTEM_CAN_MESSAGE_ODOMETER_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_aux_dcdc_vc(CanMessage *msg, uint16_t aux_voltage_u16,
+                                              uint16_t aux_current_u16, uint16_t dcdc_voltage_u16,
+                                              uint16_t dcdc_current_u16) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_CHAOS,
+    .msg_id = SYSTEM_CAN_MESSAGE_AUX_DCDC_VC,
+    .data_u16 = { aux_voltage_u16, aux_current_u16, dcdc_voltage_u16, dcdc_current_u16 },
+    .dlc = SYSTEM_CAN_MESSAGE_AUX_DCDC_VC_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_dcdc_temps(CanMessage *msg, uint16_t temp_1_u16,
+                                             uint16_t temp_2_u16) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_CHAOS,
+    .msg_id = SYSTEM_CAN_MESSAGE_DCDC_TEMPS,
+    .data_u16 = { temp_1_u16, temp_2_u16 },
+    .dlc = SYSTEM_CAN_MESSAGE_DCDC_TEMPS_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_solar_data_front(CanMessage *msg, uint16_t module_id_u16,
+                                                   uint16_t voltage_u16, uint16_t current_u16,
+                                                   uint16_t temperature_u16) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_SOLAR_MASTER_FRONT,
+    .msg_id = SYSTEM_CAN_MESSAGE_SOLAR_DATA_FRONT,
+    .data_u16 = { module_id_u16, voltage_u16, current_u16, temperature_u16 },
+    .dlc = SYSTEM_CAN_MESSAGE_SOLAR_DATA_FRONT_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_solar_data_rear(CanMessage *msg, uint16_t module_id_u16,
+                                                  uint16_t voltage_u16, uint16_t current_u16,
+                                                  uint16_t temperature_u16) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_SOLAR_MASTER_REAR,
+    .msg_id = SYSTEM_CAN_MESSAGE_SOLAR_DATA_REAR,
+    .data_u16 = { module_id_u16, voltage_u16, current_u16, temperature_u16 },
+    .dlc = SYSTEM_CAN_MESSAGE_SOLAR_DATA_REAR_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_charger_info(CanMessage *msg, uint16_t current_u16,
+                                               uint16_t voltage_u16, uint16_t status_bitset_u16) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_CHARGER,
+    .msg_id = SYSTEM_CAN_MESSAGE_CHARGER_INFO,
+    .data_u16 = { current_u16, voltage_u16, status_bitset_u16 },
+    .dlc = SYSTEM_CAN_MESSAGE_CHARGER_INFO_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_linear_acceleration(CanMessage *msg) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_SENSOR_BOARD,
+    .msg_id = SYSTEM_CAN_MESSAGE_LINEAR_ACCELERATION,
+    .dlc = SYSTEM_CAN_MESSAGE_LINEAR_ACCELERATION_DLC,
+  };
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_pack_angular_rotation(CanMessage *msg) {
+  *msg = (CanMessage){
+    .type = CAN_MSG_TYPE_DATA,
+    .source_id = SYSTEM_CAN_DEVICE_SENSOR_BOARD,
+    .msg_id = SYSTEM_CAN_MESSAGE_ANGULAR_ROTATION,
+    .dlc = SYSTEM_CAN_MESSAGE_ANGULAR_ROTATION_DLC,
+  };
+  return STATUS_CODE_OK;
+}
@@ -0,0 +1,54 @@
+#pragma once
+// CAN message schema
+// Expected DLC, source device and slot of every message in can_msg_defs.h, so received messages
+// can be validated with a table lookup. Pass can_msg_schema_get() as CanSettings.msg_schema.
+//
+// This mirrors the generated message definitions - test_can_msg_pack checks it against the
+// generated CAN_PACK_* macros, so update both together when the codegen release changes.
+#include "can_msg.h"
+#include "can_msg_defs.h"
+
+// Expected DLC of each message
+#define SYSTEM_CAN_MESSAGE_BPS_HEARTBEAT_DLC 1
+#define SYSTEM_CAN_MESSAGE_POWER_DISTRIBUTION_FAULT_DLC 1
+#define SYSTEM_CAN_MESSAGE_BATTERY_RELAY_MAIN_DLC 1
+#define SYSTEM_CAN_MESSAGE_BATTERY_RELAY_SLAVE_DLC 1
+#define SYSTEM_CAN_MESSAGE_MOTOR_RELAY_DLC 1
+#define SYSTEM_CAN_MESSAGE_SOLAR_RELAY_REAR_DLC 1
+#define SYSTEM_CAN_MESSAGE_SOLAR_RELAY_FRONT_DLC 1
+#define SYSTEM_CAN_MESSAGE_POWER_STATE_DLC 1
+#define SYSTEM_CAN_MESSAGE_POWERTRAIN_HEARTBEAT_DLC 0
+#define SYSTEM_CAN_MESSAGE_OVUV_DCDC_AUX_DLC 4
+#define SYSTEM_CAN_MESSAGE_MC_ERROR_LIMITS_DLC 4
+#define SYSTEM_CAN_MESSAGE_DRIVE_OUTPUT_DLC 8
+#define SYSTEM_CAN_MESSAGE_CRUISE_TARGET_DLC 1
+#define SYSTEM_CAN_MESSAGE_FAN_CONTROL_DLC 1
+#define SYSTEM_CAN_MESSAGE_SET_DISCHARGE_BITSET_DLC 8
+#define SYSTEM_CAN_MESSAGE_DISCHARGE_STATE_DLC 8
+#define SYSTEM_CAN_MESSAGE_LIGHTS_SYNC_DLC 0
+#define SYSTEM_CAN_MESSAGE_LIGHTS_STATE_DLC 2
+#define SYSTEM_CAN_MESSAGE_HORN_DLC 1
+#define SYSTEM_CAN_MESSAGE_CHARGER_CONN_STATE_DLC 1
+#define SYSTEM_CAN_MESSAGE_CHARGER_SET_RELAY_STATE_DLC 1
+#define SYSTEM_CAN_MESSAGE_STEERING_EVENT_DLC 4
+#define SYSTEM_CAN_MESSAGE_CENTER_CONSOLE_EVENT_DLC 4
+#define SYSTEM_CAN_MESSAGE_MOTOR_CONTROLLER_RESET_DLC 1
+#define SYSTEM_CAN_MESSAGE_BATTERY_SOC_DLC 0
+#define SYSTEM_CAN_MESSAGE_BATTERY_VT_DLC 6
+#define SYSTEM_CAN_MESSAGE_BATTERY_AGGREGATE_VC_DLC 8
+#define SYSTEM_CAN_MESSAGE_MOTOR_CONTROLLER_VC_DLC 8
+#define SYSTEM_CAN_MESSAGE_MOTOR_VELOCITY_DLC 4
+#define SYSTEM_CAN_MESSAGE_MOTOR_DEBUG_DLC 8
+#define SYSTEM_CAN_MESSAGE_MOTOR_TEMPS_DLC 8
+#define SYSTEM_CAN_MESSAGE_MOTOR_AMP_HR_DLC 8
+#define SYSTEM_CAN_MESSAGE_ODOMETER_DLC 4
+#define SYSTEM_CAN_MESSAGE_AUX_DCDC_VC_DLC 8
+#define SYSTEM_CAN_MESSAGE_DCDC_TEMPS_DLC 4
+#define SYSTEM_CAN_MESSAGE_SOLAR_DATA_FRONT_DLC 8
+#define SYSTEM_CAN_MESSAGE_SOLAR_DATA_REAR_DLC 8
+#define SYSTEM_CAN_MESSAGE_CHARGER_INFO_DLC 6
+#define SYSTEM_CAN_MESSAGE_LINEAR_ACCELERATION_DLC 0
+#define SYSTEM_CAN_MESSAGE_ANGULAR_ROTATION_DLC 0
+
+// Returns a table of CAN_MSG_MAX_IDS entries, indexed by message ID
+const CanMsgSchema *can_msg_schema_get(void);
@@ -0,0 +1,282 @@
+#pragma once
+// Typed transmit functions for each message in can_msg_defs.h
+// Critical messages take an ACK request, as with the generated CAN_TRANSMIT_* macros.
+#include <stddef.h>
+#include <stdint.h>
+
+#include "can.h"
+#include "can_ack.h"
+#include "can_msg_pack.h"
+
+static inline StatusCode can_transmit_bps_heartbeat(const CanAckRequest *ack_request,
+                                                    uint8_t status_u8) {
+  CanMessage msg = { 0 };
+  can_pack_bps_heartbeat(&msg, status_u8);
+  return can_transmit(&msg, ack_request);
+}
+
+static inline StatusCode can_transmit_power_distribution_fault(const CanAckRequest *ack_request,
+                                                               uint8_t reason_u8) {
+  CanMessage msg = { 0 };
+  can_pack_power_distribution_fault(&msg, reason_u8);
+  return can_transmit(&msg, ack_request);
+}
+
+static inline StatusCode can_transmit_battery_relay_main(const CanAckRequest *ack_request,
+                                                         uint8_t relay_state_u8) {
+  CanMessage msg = { 0 };
+  can_pack_battery_relay_main(&msg, relay_state_u8);
+  return can_transmit(&msg, ack_request);
+}
+
+static inline StatusCode can_transmit_battery_relay_slave(const CanAckRequest *ack_request,
+                                                          uint8_t relay_state_u8) {
+  CanMessage msg = { 0 };
+  can_pack_battery_relay_slave(&msg, relay_state_u8);
+  return can_transmit(&msg, ack_request);
+}
+
+static inline StatusCode can_transmit_motor_relay(const CanAckRequest *ack_request,
+                                                  uint8_t relay_state_u8) {
+  CanMessage msg = { 0 };
+  can_pack_motor_relay(&msg, relay_state_u8);
+  return can_transmit(&msg, ack_request);
+}
+
+static inline StatusCode can_transmit_solar_relay_rear(const CanAckRequest *ack_request,
+                                                       uint8_t relay_state_u8) {
+  CanMessage msg = { 0 };
+  can_pack_solar_relay_rear(&msg, relay_state_u8);
+  return can_transmit(&msg, ack_request);
+}
+
+static inline StatusCode can_transmit_solar_relay_front(const CanAckRequest *ack_request,
+                                                        uint8_t relay_state_u8) {
+  CanMessage msg = { 0 };
+  can_pack_solar_relay_front(&msg, relay_state_u8);
+  return can_transmit(&msg, ack_request);
+}
+
+static inline StatusCode can_transmit_power_state(const CanAckRequest *ack_request,
+                                                  uint8_t power_state_u8) {
+  CanMessage msg = { 0 };
+  can_pack_power_state(&msg, power_state_u8);
+  return can_transmit(&msg, ack_request);
+}
+
+static inline StatusCode can_transmit_powertrain_heartbeat(const CanAckRequest *ack_request) {
+  CanMessage msg = { 0 };
+  can_pack_powertrain_heartbeat(&msg);
+  return can_transmit(&msg, ack_request);
+}
+
+static inline StatusCode can_transmit_ovuv_dcdc_aux(uint8_t dcdc_ov_flag_u8,
+                                                    uint8_t dcdc_uv_flag_u8,
+                                                    uint8_t aux_bat_ov_flag_u8,
+                                                    uint8_t aux_bat_uv_flag_u8) {
+  CanMessage msg = { 0 };
+  can_pack_ovuv_dcdc_aux(&msg, dcdc_ov_flag_u8, dcdc_uv_flag_u8, aux_bat_ov_flag_u8,
+                         aux_bat_uv_flag_u8);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_mc_error_limits(uint16_t error_id_u16, uint16_t limits_u16) {
+  CanMessage msg = { 0 };
+  can_pack_mc_error_limits(&msg, error_id_u16, limits_u16);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_drive_output(uint16_t throttle_u16, uint16_t direction_u16,
+                                                   uint16_t cruise_control_u16,
+                                                   uint16_t mechanical_brake_state_u16) {
+  CanMessage msg = { 0 };
+  can_pack_drive_output(&msg, throttle_u16, direction_u16, cruise_control_u16,
+                        mechanical_brake_state_u16);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_cruise_target(uint8_t target_speed_u8) {
+  CanMessage msg = { 0 };
+  can_pack_cruise_target(&msg, target_speed_u8);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_fan_control(uint8_t state_u8) {
+  CanMessage msg = { 0 };
+  can_pack_fan_control(&msg, state_u8);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_set_discharge_bitset(uint64_t discharge_bitset_u64) {
+  CanMessage msg = { 0 };
+  can_pack_set_discharge_bitset(&msg, discharge_bitset_u64);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_discharge_state(uint64_t discharge_bitset_u64) {
+  CanMessage msg = { 0 };
+  can_pack_discharge_state(&msg, discharge_bitset_u64);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_lights_sync(void) {
+  CanMessage msg = { 0 };
+  can_pack_lights_sync(&msg);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_lights_state(uint8_t light_id_u8, uint8_t light_state_u8) {
+  CanMessage msg = { 0 };
+  can_pack_lights_state(&msg, light_id_u8, light_state_u8);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_horn(uint8_t state_u8) {
+  CanMessage msg = { 0 };
+  can_pack_horn(&msg, state_u8);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_charger_conn_state(uint8_t is_connected_u8) {
+  CanMessage msg = { 0 };
+  can_pack_charger_conn_state(&msg, is_connected_u8);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_charger_set_relay_state(uint8_t state_u8) {
+  CanMessage msg = { 0 };
+  can_pack_charger_set_relay_state(&msg, state_u8);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_steering_event(uint16_t event_id_u16, uint16_t data_u16) {
+  CanMessage msg = { 0 };
+  can_pack_steering_event(&msg, event_id_u16, data_u16);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_center_console_event(uint16_t event_id_u16,
+                                                           uint16_t data_u16) {
+  CanMessage msg = { 0 };
+  can_pack_center_console_event(&msg, event_id_u16, data_u16);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_motor_controller_reset(uint8_t motor_controller_index_u8) {
+  CanMessage msg = { 0 };
+  can_pack_motor_controller_reset(&msg, motor_controller_index_u8);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_battery_soc(void) {
+  CanMessage msg = { 0 };
+  can_pack_battery_soc(&msg);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_battery_vt(uint16_t module_id_u16, uint16_t voltage_u16,
+                                                 uint16_t temperature_u16) {
+  CanMessage msg = { 0 };
+  can_pack_battery_vt(&msg, module_id_u16, voltage_u16, temperature_u16);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_battery_aggregate_vc(uint32_t voltage_u32,
+                                                           uint32_t current_u32) {
+  CanMessage msg = { 0 };
+  can_pack_battery_aggregate_vc(&msg, voltage_u32, current_u32);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_motor_controller_vc(uint16_t mc_voltage_1_u16,
+                                                          uint16_t mc_current_1_u16,
+                                                          uint16_t mc_voltage_2_u16,
+                                                          uint16_t mc_current_2_u16) {
+  CanMessage msg = { 0 };
+  can_pack_motor_controller_vc(&msg, mc_voltage_1_u16, mc_current_1_u16, mc_voltage_2_u16,
+                               mc_current_2_u16);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_motor_velocity(uint16_t vehicle_velocity_left_u16,
+                                                     uint16_t vehicle_velocity_right_u16) {
+  CanMessage msg = { 0 };
+  can_pack_motor_velocity(&msg, vehicle_velocity_left_u16, vehicle_velocity_right_u16);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_motor_debug(uint64_t data_u64) {
+  CanMessage msg = { 0 };
+  can_pack_motor_debug(&msg, data_u64);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_motor_temps(uint32_t motor_temp_l_u32,
+                                                  uint32_t motor_temp_r_u32) {
+  CanMessage msg = { 0 };
+  can_pack_motor_temps(&msg, motor_temp_l_u32, motor_temp_r_u32);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_motor_amp_hr(uint32_t motor_amp_hr_l_u32,
+                                                   uint32_t motor_amp_hr_r_u32) {
+  CanMessage msg = { 0 };
+  can_pack_motor_amp_hr(&msg, motor_amp_hr_l_u32, motor_amp_hr_r_u32);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_odometer(uint32_t odometer_val_u32) {
+  CanMessage msg = { 0 };
+  can_pack_odometer(&msg, odometer_val_u32);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_aux_dcdc_vc(uint16_t aux_voltage_u16,
+                                                  uint16_t aux_current_u16,
+                                                  uint16_t dcdc_voltage_u16,
+                                                  uint16_t dcdc_current_u16) {
+  CanMessage msg = { 0 };
+  can_pack_aux_dcdc_vc(&msg, aux_voltage_u16, aux_current_u16, dcdc_voltage_u16, dcdc_current_u16);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_dcdc_temps(uint16_t temp_1_u16, uint16_t temp_2_u16) {
+  CanMessage msg = { 0 };
+  can_pack_dcdc_temps(&msg, temp_1_u16, temp_2_u16);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_solar_data_front(uint16_t module_id_u16, uint16_t voltage_u16,
+                                                       uint16_t current_u16,
+                                                       uint16_t temperature_u16) {
+  CanMessage msg = { 0 };
+  can_pack_solar_data_front(&msg, module_id_u16, voltage_u16, current_u16, temperature_u16);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_solar_data_rear(uint16_t module_id_u16, uint16_t voltage_u16,
+                                                      uint16_t current_u16,
+                                                      uint16_t temperature_u16) {
+  CanMessage msg = { 0 };
+  can_pack_solar_data_rear(&msg, module_id_u16, voltage_u16, current_u16, temperature_u16);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_charger_info(uint16_t current_u16, uint16_t voltage_u16,
+                                                   uint16_t status_bitset_u16) {
+  CanMessage msg = { 0 };
+  can_pack_charger_info(&msg, current_u16, voltage_u16, status_bitset_u16);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_linear_acceleration(void) {
+  CanMessage msg = { 0 };
+  can_pack_linear_acceleration(&msg);
+  return can_transmit(&msg, NULL);
+}
+
+static inline StatusCode can_transmit_angular_rotation(void) {
+  CanMessage msg = { 0 };
+  can_pack_angular_rotation(&msg);
+  return can_transmit(&msg, NULL);
+}
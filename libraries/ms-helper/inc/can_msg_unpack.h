@@ -0,0 +1,544 @@
+#pragma once
+// Typed unpack functions for each message in can_msg_defs.h
+// As with the generated CAN_UNPACK_* macros, fields with NULL pointers are skipped.
+#include <stddef.h>
+#include <stdint.h>
+
+#include "can_msg.h"
+#include "can_msg_schema.h"
+#include "status.h"
+
+static inline StatusCode can_unpack_bps_heartbeat(const CanMessage *msg, uint8_t *status_u8_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_BPS_HEARTBEAT_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (status_u8_ptr != NULL) {
+    *status_u8_ptr = msg->data_u8[0];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_power_distribution_fault(const CanMessage *msg,
+                                                             uint8_t *reason_u8_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_POWER_DISTRIBUTION_FAULT_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (reason_u8_ptr != NULL) {
+    *reason_u8_ptr = msg->data_u8[0];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_battery_relay_main(const CanMessage *msg,
+                                                       uint8_t *relay_state_u8_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_BATTERY_RELAY_MAIN_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (relay_state_u8_ptr != NULL) {
+    *relay_state_u8_ptr = msg->data_u8[0];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_battery_relay_slave(const CanMessage *msg,
+                                                        uint8_t *relay_state_u8_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_BATTERY_RELAY_SLAVE_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (relay_state_u8_ptr != NULL) {
+    *relay_state_u8_ptr = msg->data_u8[0];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_motor_relay(const CanMessage *msg,
+                                                uint8_t *relay_state_u8_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_MOTOR_RELAY_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (relay_state_u8_ptr != NULL) {
+    *relay_state_u8_ptr = msg->data_u8[0];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_solar_relay_rear(const CanMessage *msg,
+                                                     uint8_t *relay_state_u8_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_SOLAR_RELAY_REAR_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (relay_state_u8_ptr != NULL) {
+    *relay_state_u8_ptr = msg->data_u8[0];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_solar_relay_front(const CanMessage *msg,
+                                                      uint8_t *relay_state_u8_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_SOLAR_RELAY_FRONT_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (relay_state_u8_ptr != NULL) {
+    *relay_state_u8_ptr = msg->data_u8[0];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_power_state(const CanMessage *msg,
+                                                uint8_t *power_state_u8_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_POWER_STATE_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (power_state_u8_ptr != NULL) {
+    *power_state_u8_ptr = msg->data_u8[0];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_powertrain_heartbeat(const CanMessage *msg) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_POWERTRAIN_HEARTBEAT_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_ovuv_dcdc_aux(const CanMessage *msg,
+                                                  uint8_t *dcdc_ov_flag_u8_ptr,
+                                                  uint8_t *dcdc_uv_flag_u8_ptr,
+                                                  uint8_t *aux_bat_ov_flag_u8_ptr,
+                                                  uint8_t *aux_bat_uv_flag_u8_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_OVUV_DCDC_AUX_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (dcdc_ov_flag_u8_ptr != NULL) {
+    *dcdc_ov_flag_u8_ptr = msg->data_u8[0];
+  }
+  if (dcdc_uv_flag_u8_ptr != NULL) {
+    *dcdc_uv_flag_u8_ptr = msg->data_u8[1];
+  }
+  if (aux_bat_ov_flag_u8_ptr != NULL) {
+    *aux_bat_ov_flag_u8_ptr = msg->data_u8[2];
+  }
+  if (aux_bat_uv_flag_u8_ptr != NULL) {
+    *aux_bat_uv_flag_u8_ptr = msg->data_u8[3];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_mc_error_limits(const CanMessage *msg,
+                                                    uint16_t *error_id_u16_ptr,
+                                                    uint16_t *limits_u16_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_MC_ERROR_LIMITS_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (error_id_u16_ptr != NULL) {
+    *error_id_u16_ptr = msg->data_u16[0];
+  }
+  if (limits_u16_ptr != NULL) {
+    *limits_u16_ptr = msg->data_u16[1];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_drive_output(const CanMessage *msg, uint16_t *throttle_u16_ptr,
+                                                 uint16_t *direction_u16_ptr,
+                                                 uint16_t *cruise_control_u16_ptr,
+                                                 uint16_t *mechanical_brake_state_u16_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_DRIVE_OUTPUT_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (throttle_u16_ptr != NULL) {
+    *throttle_u16_ptr = msg->data_u16[0];
+  }
+  if (direction_u16_ptr != NULL) {
+    *direction_u16_ptr = msg->data_u16[1];
+  }
+  if (cruise_control_u16_ptr != NULL) {
+    *cruise_control_u16_ptr = msg->data_u16[2];
+  }
+  if (mechanical_brake_state_u16_ptr != NULL) {
+    *mechanical_brake_state_u16_ptr = msg->data_u16[3];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_cruise_target(const CanMessage *msg,
+                                                  uint8_t *target_speed_u8_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_CRUISE_TARGET_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (target_speed_u8_ptr != NULL) {
+    *target_speed_u8_ptr = msg->data_u8[0];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_fan_control(const CanMessage *msg, uint8_t *state_u8_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_FAN_CONTROL_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (state_u8_ptr != NULL) {
+    *state_u8_ptr = msg->data_u8[0];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_set_discharge_bitset(const CanMessage *msg,
+                                                         uint64_t *discharge_bitset_u64_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_SET_DISCHARGE_BITSET_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (discharge_bitset_u64_ptr != NULL) {
+    *discharge_bitset_u64_ptr = msg->data;
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_discharge_state(const CanMessage *msg,
+                                                    uint64_t *discharge_bitset_u64_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_DISCHARGE_STATE_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (discharge_bitset_u64_ptr != NULL) {
+    *discharge_bitset_u64_ptr = msg->data;
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_lights_sync(const CanMessage *msg) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_LIGHTS_SYNC_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_lights_state(const CanMessage *msg, uint8_t *light_id_u8_ptr,
+                                                 uint8_t *light_state_u8_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_LIGHTS_STATE_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (light_id_u8_ptr != NULL) {
+    *light_id_u8_ptr = msg->data_u8[0];
+  }
+  if (light_state_u8_ptr != NULL) {
+    *light_state_u8_ptr = msg->data_u8[1];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_horn(const CanMessage *msg, uint8_t *state_u8_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_HORN_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (state_u8_ptr != NULL) {
+    *state_u8_ptr = msg->data_u8[0];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_charger_conn_state(const CanMessage *msg,
+                                                       uint8_t *is_connected_u8_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_CHARGER_CONN_STATE_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (is_connected_u8_ptr != NULL) {
+    *is_connected_u8_ptr = msg->data_u8[0];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_charger_set_relay_state(const CanMessage *msg,
+                                                            uint8_t *state_u8_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_CHARGER_SET_RELAY_STATE_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (state_u8_ptr != NULL) {
+    *state_u8_ptr = msg->data_u8[0];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_steering_event(const CanMessage *msg,
+                                                   uint16_t *event_id_u16_ptr,
+                                                   uint16_t *data_u16_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_STEERING_EVENT_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (event_id_u16_ptr != NULL) {
+    *event_id_u16_ptr = msg->data_u16[0];
+  }
+  if (data_u16_ptr != NULL) {
+    *data_u16_ptr = msg->data_u16[1];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_center_console_event(const CanMessage *msg,
+                                                         uint16_t *event_id_u16_ptr,
+                                                         uint16_t *data_u16_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_CENTER_CONSOLE_EVENT_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (event_id_u16_ptr != NULL) {
+    *event_id_u16_ptr = msg->data_u16[0];
+  }
+  if (data_u16_ptr != NULL) {
+    *data_u16_ptr = msg->data_u16[1];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_motor_controller_reset(const CanMessage *msg,
+                                                           uint8_t *motor_controller_index_u8_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_MOTOR_CONTROLLER_RESET_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (motor_controller_index_u8_ptr != NULL) {
+    *motor_controller_index_u8_ptr = msg->data_u8[0];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_battery_soc(const CanMessage *msg) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_BATTERY_SOC_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_battery_vt(const CanMessage *msg, uint16_t *module_id_u16_ptr,
+                                               uint16_t *voltage_u16_ptr,
+                                               uint16_t *temperature_u16_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_BATTERY_VT_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (module_id_u16_ptr != NULL) {
+    *module_id_u16_ptr = msg->data_u16[0];
+  }
+  if (voltage_u16_ptr != NULL) {
+    *voltage_u16_ptr = msg->data_u16[1];
+  }
+  if (temperature_u16_ptr != NULL) {
+    *temperature_u16_ptr = msg->data_u16[2];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_battery_aggregate_vc(const CanMessage *msg,
+                                                         uint32_t *voltage_u32_ptr,
+                                                         uint32_t *current_u32_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_BATTERY_AGGREGATE_VC_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (voltage_u32_ptr != NULL) {
+    *voltage_u32_ptr = msg->data_u32[0];
+  }
+  if (current_u32_ptr != NULL) {
+    *current_u32_ptr = msg->data_u32[1];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_motor_controller_vc(const CanMessage *msg,
+                                                        uint16_t *mc_voltage_1_u16_ptr,
+                                                        uint16_t *mc_current_1_u16_ptr,
+                                                        uint16_t *mc_voltage_2_u16_ptr,
+                                                        uint16_t *mc_current_2_u16_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_MOTOR_CONTROLLER_VC_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (mc_voltage_1_u16_ptr != NULL) {
+    *mc_voltage_1_u16_ptr = msg->data_u16[0];
+  }
+  if (mc_current_1_u16_ptr != NULL) {
+    *mc_current_1_u16_ptr = msg->data_u16[1];
+  }
+  if (mc_voltage_2_u16_ptr != NULL) {
+    *mc_voltage_2_u16_ptr = msg->data_u16[2];
+  }
+  if (mc_current_2_u16_ptr != NULL) {
+    *mc_current_2_u16_ptr = msg->data_u16[3];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_motor_velocity(const CanMessage *msg,
+                                                   uint16_t *vehicle_velocity_left_u16_ptr,
+                                                   uint16_t *vehicle_velocity_right_u16_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_MOTOR_VELOCITY_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (vehicle_velocity_left_u16_ptr != NULL) {
+    *vehicle_velocity_left_u16_ptr = msg->data_u16[0];
+  }
+  if (vehicle_velocity_right_u16_ptr != NULL) {
+    *vehicle_velocity_right_u16_ptr = msg->data_u16[1];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_motor_debug(const CanMessage *msg, uint64_t *data_u64_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_MOTOR_DEBUG_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (data_u64_ptr != NULL) {
+    *data_u64_ptr = msg->data;
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_motor_temps(const CanMessage *msg,
+                                                uint32_t *motor_temp_l_u32_ptr,
+                                                uint32_t *motor_temp_r_u32_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_MOTOR_TEMPS_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (motor_temp_l_u32_ptr != NULL) {
+    *motor_temp_l_u32_ptr = msg->data_u32[0];
+  }
+  if (motor_temp_r_u32_ptr != NULL) {
+    *motor_temp_r_u32_ptr = msg->data_u32[1];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_motor_amp_hr(const CanMessage *msg,
+                                                 uint32_t *motor_amp_hr_l_u32_ptr,
+                                                 uint32_t *motor_amp_hr_r_u32_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_MOTOR_AMP_HR_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (motor_amp_hr_l_u32_ptr != NULL) {
+    *motor_amp_hr_l_u32_ptr = msg->data_u32[0];
+  }
+  if (motor_amp_hr_r_u32_ptr != NULL) {
+    *motor_amp_hr_r_u32_ptr = msg->data_u32[1];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_odometer(const CanMessage *msg,
+                                             uint32_t *odometer_val_u32_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_ODOMETER_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (odometer_val_u32_ptr != NULL) {
+    *odometer_val_u32_ptr = msg->data_u32[0];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_aux_dcdc_vc(const CanMessage *msg,
+                                                uint16_t *aux_voltage_u16_ptr,
+                                                uint16_t *aux_current_u16_ptr,
+                                                uint16_t *dcdc_voltage_u16_ptr,
+                                                uint16_t *dcdc_current_u16_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_AUX_DCDC_VC_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (aux_voltage_u16_ptr != NULL) {
+    *aux_voltage_u16_ptr = msg->data_u16[0];
+  }
+  if (aux_current_u16_ptr != NULL) {
+    *aux_current_u16_ptr = msg->data_u16[1];
+  }
+  if (dcdc_voltage_u16_ptr != NULL) {
+    *dcdc_voltage_u16_ptr = msg->data_u16[2];
+  }
+  if (dcdc_current_u16_ptr != NULL) {
+    *dcdc_current_u16_ptr = msg->data_u16[3];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_dcdc_temps(const CanMessage *msg, uint16_t *temp_1_u16_ptr,
+                                               uint16_t *temp_2_u16_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_DCDC_TEMPS_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (temp_1_u16_ptr != NULL) {
+    *temp_1_u16_ptr = msg->data_u16[0];
+  }
+  if (temp_2_u16_ptr != NULL) {
+    *temp_2_u16_ptr = msg->data_u16[1];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_solar_data_front(const CanMessage *msg,
+                                                     uint16_t *module_id_u16_ptr,
+                                                     uint16_t *voltage_u16_ptr,
+                                                     uint16_t *current_u16_ptr,
+                                                     uint16_t *temperature_u16_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_SOLAR_DATA_FRONT_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (module_id_u16_ptr != NULL) {
+    *module_id_u16_ptr = msg->data_u16[0];
+  }
+  if (voltage_u16_ptr != NULL) {
+    *voltage_u16_ptr = msg->data_u16[1];
+  }
+  if (current_u16_ptr != NULL) {
+    *current_u16_ptr = msg->data_u16[2];
+  }
+  if (temperature_u16_ptr != NULL) {
+    *temperature_u16_ptr = msg->data_u16[3];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_solar_data_rear(const CanMessage *msg,
+                                                    uint16_t *module_id_u16_ptr,
+                                                    uint16_t *voltage_u16_ptr,
+                                                    uint16_t *current_u16_ptr,
+                                                    uint16_t *temperature_u16_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_SOLAR_DATA_REAR_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (module_id_u16_ptr != NULL) {
+    *module_id_u16_ptr = msg->data_u16[0];
+  }
+  if (voltage_u16_ptr != NULL) {
+    *voltage_u16_ptr = msg->data_u16[1];
+  }
+  if (current_u16_ptr != NULL) {
+    *current_u16_ptr = msg->data_u16[2];
+  }
+  if (temperature_u16_ptr != NULL) {
+    *temperature_u16_ptr = msg->data_u16[3];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_charger_info(const CanMessage *msg, uint16_t *current_u16_ptr,
+                                                 uint16_t *voltage_u16_ptr,
+                                                 uint16_t *status_bitset_u16_ptr) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_CHARGER_INFO_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  if (current_u16_ptr != NULL) {
+    *current_u16_ptr = msg->data_u16[0];
+  }
+  if (voltage_u16_ptr != NULL) {
+    *voltage_u16_ptr = msg->data_u16[1];
+  }
+  if (status_bitset_u16_ptr != NULL) {
+    *status_bitset_u16_ptr = msg->data_u16[2];
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_linear_acceleration(const CanMessage *msg) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_LINEAR_ACCELERATION_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  return STATUS_CODE_OK;
+}
+
+static inline StatusCode can_unpack_angular_rotation(const CanMessage *msg) {
+  if (msg->dlc != SYSTEM_CAN_MESSAGE_ANGULAR_ROTATION_DLC) {
+    return status_msg(STATUS_CODE_INTERNAL_ERROR, "DLC mismatch");
+  }
+  return STATUS_CODE_OK;
+}
@@ -0,0 +1,22 @@
+#pragma once
+// x86 only - Generic CAN over a named CAN HW instance (see can_hw_mcu.h).
+// This performs the initialization of the instance.
+//
+// Works like Generic CAN HW, but lets a simulated node talk on a second bus (i.e. a separate
+// vcan interface) alongside the default interface used by Network Layer CAN.
+
+#include "can_hw.h"
+#include "can_hw_mcu.h"
+#include "event_queue.h"
+#include "generic_can.h"
+#include "status.h"
+
+typedef struct GenericCanSocket {
+  GenericCan base;
+  CanHwInstance *instance;
+  EventId fault_event;
+} GenericCanSocket;
+
+// Initialize |can_socket| to use the CAN interface named |interface|.
+StatusCode generic_can_socket_init(GenericCanSocket *can_socket, const char *interface,
+                                   const CanHwSettings *settings, EventId fault_event);
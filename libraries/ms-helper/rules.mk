@@ -10,6 +10,8 @@ $(T)_DEPS := ms-common
 
 ifeq (x86,$(PLATFORM))
 $(T)_EXCLUDE_TESTS := mcp2515
+else
+$(T)_EXCLUDE_TESTS := generic_can_socket
 endif
 
 $(T)_test_thermistor_MOCKS := adc_read_converted adc_get_channel adc_set_channel
@@ -17,7 +17,6 @@ static void prv_can_interval_timer_cb(SoftTimerId id, void *context) {
   (void)id;
   CanInterval *interval = context;
   generic_can_tx(interval->can, &interval->msg);
-  soft_timer_start(interval->period, prv_can_interval_timer_cb, context, &interval->timer_id);
 }
 
 static void prv_init_can_interval(void *object, void *context) {
@@ -61,8 +60,8 @@ StatusCode can_interval_enable(CanInterval *interval) {
   if (interval->timer_id == SOFT_TIMER_INVALID_TIMER) {
     // Send now.
     status_ok_or_return(generic_can_tx(interval->can, &interval->msg));
-    status_ok_or_return(soft_timer_start(interval->period, prv_can_interval_timer_cb,
-                                         (void *)interval, &interval->timer_id));
+    status_ok_or_return(soft_timer_start_periodic(interval->period, prv_can_interval_timer_cb,
+                                                  (void *)interval, &interval->timer_id));
   }
 
   return STATUS_CODE_OK;
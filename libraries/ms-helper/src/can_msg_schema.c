@@ -0,0 +1,232 @@
+#include "can_msg_schema.h"
+
+static const CanMsgSchema s_schema[CAN_MSG_MAX_IDS] = {
+  [SYSTEM_CAN_MESSAGE_BPS_HEARTBEAT] = {
+    .dlc = SYSTEM_CAN_MESSAGE_BPS_HEARTBEAT_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_PLUTUS,
+    .slot = 0,
+  },
+  [SYSTEM_CAN_MESSAGE_POWER_DISTRIBUTION_FAULT] = {
+    .dlc = SYSTEM_CAN_MESSAGE_POWER_DISTRIBUTION_FAULT_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_CHAOS,
+    .slot = 1,
+  },
+  [SYSTEM_CAN_MESSAGE_BATTERY_RELAY_MAIN] = {
+    .dlc = SYSTEM_CAN_MESSAGE_BATTERY_RELAY_MAIN_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_CHAOS,
+    .slot = 2,
+  },
+  [SYSTEM_CAN_MESSAGE_BATTERY_RELAY_SLAVE] = {
+    .dlc = SYSTEM_CAN_MESSAGE_BATTERY_RELAY_SLAVE_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_CHAOS,
+    .slot = 3,
+  },
+  [SYSTEM_CAN_MESSAGE_MOTOR_RELAY] = {
+    .dlc = SYSTEM_CAN_MESSAGE_MOTOR_RELAY_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_CHAOS,
+    .slot = 4,
+  },
+  [SYSTEM_CAN_MESSAGE_SOLAR_RELAY_REAR] = {
+    .dlc = SYSTEM_CAN_MESSAGE_SOLAR_RELAY_REAR_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_CHAOS,
+    .slot = 5,
+  },
+  [SYSTEM_CAN_MESSAGE_SOLAR_RELAY_FRONT] = {
+    .dlc = SYSTEM_CAN_MESSAGE_SOLAR_RELAY_FRONT_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_CHAOS,
+    .slot = 6,
+  },
+  [SYSTEM_CAN_MESSAGE_POWER_STATE] = {
+    .dlc = SYSTEM_CAN_MESSAGE_POWER_STATE_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_DRIVER_CONTROLS_PEDAL,
+    .slot = 7,
+  },
+  [SYSTEM_CAN_MESSAGE_POWERTRAIN_HEARTBEAT] = {
+    .dlc = SYSTEM_CAN_MESSAGE_POWERTRAIN_HEARTBEAT_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_CHAOS,
+    .slot = 8,
+  },
+  [9] = { .slot = CAN_MSG_SCHEMA_NO_SLOT },
+  [10] = { .slot = CAN_MSG_SCHEMA_NO_SLOT },
+  [11] = { .slot = CAN_MSG_SCHEMA_NO_SLOT },
+  [12] = { .slot = CAN_MSG_SCHEMA_NO_SLOT },
+  [13] = { .slot = CAN_MSG_SCHEMA_NO_SLOT },
+  [14] = { .slot = CAN_MSG_SCHEMA_NO_SLOT },
+  [15] = { .slot = CAN_MSG_SCHEMA_NO_SLOT },
+  [SYSTEM_CAN_MESSAGE_OVUV_DCDC_AUX] = {
+    .dlc = SYSTEM_CAN_MESSAGE_OVUV_DCDC_AUX_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_CHAOS,
+    .slot = 9,
+  },
+  [SYSTEM_CAN_MESSAGE_MC_ERROR_LIMITS] = {
+    .dlc = SYSTEM_CAN_MESSAGE_MC_ERROR_LIMITS_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_MOTOR_CONTROLLER,
+    .slot = 10,
+  },
+  [SYSTEM_CAN_MESSAGE_DRIVE_OUTPUT] = {
+    .dlc = SYSTEM_CAN_MESSAGE_DRIVE_OUTPUT_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_DRIVER_CONTROLS_PEDAL,
+    .slot = 11,
+  },
+  [SYSTEM_CAN_MESSAGE_CRUISE_TARGET] = {
+    .dlc = SYSTEM_CAN_MESSAGE_CRUISE_TARGET_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_DRIVER_CONTROLS_PEDAL,
+    .slot = 12,
+  },
+  [SYSTEM_CAN_MESSAGE_FAN_CONTROL] = {
+    .dlc = SYSTEM_CAN_MESSAGE_FAN_CONTROL_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_CHAOS,
+    .slot = 13,
+  },
+  [SYSTEM_CAN_MESSAGE_SET_DISCHARGE_BITSET] = {
+    .dlc = SYSTEM_CAN_MESSAGE_SET_DISCHARGE_BITSET_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_TELEMETRY,
+    .slot = 14,
+  },
+  [SYSTEM_CAN_MESSAGE_DISCHARGE_STATE] = {
+    .dlc = SYSTEM_CAN_MESSAGE_DISCHARGE_STATE_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_PLUTUS,
+    .slot = 15,
+  },
+  [SYSTEM_CAN_MESSAGE_LIGHTS_SYNC] = {
+    .dlc = SYSTEM_CAN_MESSAGE_LIGHTS_SYNC_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_LIGHTS_REAR,
+    .slot = 16,
+  },
+  [SYSTEM_CAN_MESSAGE_LIGHTS_STATE] = {
+    .dlc = SYSTEM_CAN_MESSAGE_LIGHTS_STATE_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_DRIVER_CONTROLS_PEDAL,
+    .slot = 17,
+  },
+  [SYSTEM_CAN_MESSAGE_HORN] = {
+    .dlc = SYSTEM_CAN_MESSAGE_HORN_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_DRIVER_CONTROLS_PEDAL,
+    .slot = 18,
+  },
+  [SYSTEM_CAN_MESSAGE_CHARGER_CONN_STATE] = {
+    .dlc = SYSTEM_CAN_MESSAGE_CHARGER_CONN_STATE_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_CHARGER,
+    .slot = 19,
+  },
+  [SYSTEM_CAN_MESSAGE_CHARGER_SET_RELAY_STATE] = {
+    .dlc = SYSTEM_CAN_MESSAGE_CHARGER_SET_RELAY_STATE_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_CHAOS,
+    .slot = 20,
+  },
+  [SYSTEM_CAN_MESSAGE_STEERING_EVENT] = {
+    .dlc = SYSTEM_CAN_MESSAGE_STEERING_EVENT_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_DRIVER_CONTROLS_STEERING,
+    .slot = 21,
+  },
+  [SYSTEM_CAN_MESSAGE_CENTER_CONSOLE_EVENT] = {
+    .dlc = SYSTEM_CAN_MESSAGE_CENTER_CONSOLE_EVENT_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_DRIVER_CONTROLS_CENTER_CONSOLE,
+    .slot = 22,
+  },
+  [SYSTEM_CAN_MESSAGE_MOTOR_CONTROLLER_RESET] = {
+    .dlc = SYSTEM_CAN_MESSAGE_MOTOR_CONTROLLER_RESET_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_DRIVER_CONTROLS_PEDAL,
+    .slot = 23,
+  },
+  [SYSTEM_CAN_MESSAGE_BATTERY_SOC] = {
+    .dlc = SYSTEM_CAN_MESSAGE_BATTERY_SOC_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_PLUTUS,
+    .slot = 24,
+  },
+  [SYSTEM_CAN_MESSAGE_BATTERY_VT] = {
+    .dlc = SYSTEM_CAN_MESSAGE_BATTERY_VT_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_PLUTUS,
+    .slot = 25,
+  },
+  [SYSTEM_CAN_MESSAGE_BATTERY_AGGREGATE_VC] = {
+    .dlc = SYSTEM_CAN_MESSAGE_BATTERY_AGGREGATE_VC_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_PLUTUS,
+    .slot = 26,
+  },
+  [34] = { .slot = CAN_MSG_SCHEMA_NO_SLOT },
+  [SYSTEM_CAN_MESSAGE_MOTOR_CONTROLLER_VC] = {
+    .dlc = SYSTEM_CAN_MESSAGE_MOTOR_CONTROLLER_VC_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_MOTOR_CONTROLLER,
+    .slot = 27,
+  },
+  [SYSTEM_CAN_MESSAGE_MOTOR_VELOCITY] = {
+    .dlc = SYSTEM_CAN_MESSAGE_MOTOR_VELOCITY_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_MOTOR_CONTROLLER,
+    .slot = 28,
+  },
+  [SYSTEM_CAN_MESSAGE_MOTOR_DEBUG] = {
+    .dlc = SYSTEM_CAN_MESSAGE_MOTOR_DEBUG_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_MOTOR_CONTROLLER,
+    .slot = 29,
+  },
+  [SYSTEM_CAN_MESSAGE_MOTOR_TEMPS] = {
+    .dlc = SYSTEM_CAN_MESSAGE_MOTOR_TEMPS_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_MOTOR_CONTROLLER,
+    .slot = 30,
+  },
+  [SYSTEM_CAN_MESSAGE_MOTOR_AMP_HR] = {
+    .dlc = SYSTEM_CAN_MESSAGE_MOTOR_AMP_HR_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_MOTOR_CONTROLLER,
+    .slot = 31,
+  },
+  [SYSTEM_CAN_MESSAGE_ODOMETER] = {
+    .dlc = SYSTEM_CAN_MESSAGE_ODOMETER_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_MOTOR_CONTROLLER,
+    .slot = 32,
+  },
+  [41] = { .slot = CAN_MSG_SCHEMA_NO_SLOT },
+  [42] = { .slot = CAN_MSG_SCHEMA_NO_SLOT },
+  [SYSTEM_CAN_MESSAGE_AUX_DCDC_VC] = {
+    .dlc = SYSTEM_CAN_MESSAGE_AUX_DCDC_VC_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_CHAOS,
+    .slot = 33,
+  },
+  [SYSTEM_CAN_MESSAGE_DCDC_TEMPS] = {
+    .dlc = SYSTEM_CAN_MESSAGE_DCDC_TEMPS_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_CHAOS,
+    .slot = 34,
+  },
+  [SYSTEM_CAN_MESSAGE_SOLAR_DATA_FRONT] = {
+    .dlc = SYSTEM_CAN_MESSAGE_SOLAR_DATA_FRONT_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_SOLAR_MASTER_FRONT,
+    .slot = 35,
+  },
+  [SYSTEM_CAN_MESSAGE_SOLAR_DATA_REAR] = {
+    .dlc = SYSTEM_CAN_MESSAGE_SOLAR_DATA_REAR_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_SOLAR_MASTER_REAR,
+    .slot = 36,
+  },
+  [SYSTEM_CAN_MESSAGE_CHARGER_INFO] = {
+    .dlc = SYSTEM_CAN_MESSAGE_CHARGER_INFO_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_CHARGER,
+    .slot = 37,
+  },
+  [48] = { .slot = CAN_MSG_SCHEMA_NO_SLOT },
+  [49] = { .slot = CAN_MSG_SCHEMA_NO_SLOT },
+  [50] = { .slot = CAN_MSG_SCHEMA_NO_SLOT },
+  [SYSTEM_CAN_MESSAGE_LINEAR_ACCELERATION] = {
+    .dlc = SYSTEM_CAN_MESSAGE_LINEAR_ACCELERATION_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_SENSOR_BOARD,
+    .slot = 38,
+  },
+  [SYSTEM_CAN_MESSAGE_ANGULAR_ROTATION] = {
+    .dlc = SYSTEM_CAN_MESSAGE_ANGULAR_ROTATION_DLC,
+    .source_id = SYSTEM_CAN_DEVICE_SENSOR_BOARD,
+    .slot = 39,
+  },
+  [53] = { .slot = CAN_MSG_SCHEMA_NO_SLOT },
+  [54] = { .slot = CAN_MSG_SCHEMA_NO_SLOT },
+  [55] = { .slot = CAN_MSG_SCHEMA_NO_SLOT },
+  [56] = { .slot = CAN_MSG_SCHEMA_NO_SLOT },
+  [57] = { .slot = CAN_MSG_SCHEMA_NO_SLOT },
+  [58] = { .slot = CAN_MSG_SCHEMA_NO_SLOT },
+  [59] = { .slot = CAN_MSG_SCHEMA_NO_SLOT },
+  [60] = { .slot = CAN_MSG_SCHEMA_NO_SLOT },
+  [61] = { .slot = CAN_MSG_SCHEMA_NO_SLOT },
+  [62] = { .slot = CAN_MSG_SCHEMA_NO_SLOT },
+  [63] = { .slot = CAN_MSG_SCHEMA_NO_SLOT },
+};
+
+const CanMsgSchema *can_msg_schema_get(void) {
+  return s_schema;
+}
@@ -0,0 +1,93 @@
+#include "generic_can_socket.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "can_hw.h"
+#include "can_hw_mcu.h"
+#include "event_queue.h"
+#include "generic_can.h"
+#include "generic_can_helpers.h"
+#include "generic_can_msg.h"
+#include "soft_timer.h"
+#include "status.h"
+
+#define CAN_BUS_OFF_RECOVERY_TIME_MS 500
+
+static GenericCanInterface s_interface;
+
+// CanHwEventHandlerCb: Rx Occurred
+static void prv_rx_handler(void *context) {
+  GenericCanSocket *gcs = context;
+  GenericCanMsg rx_msg = { 0 };
+  while (can_hw_instance_receive(gcs->instance, &rx_msg.id, &rx_msg.extended, &rx_msg.data,
+                                 &rx_msg.dlc)) {
+    for (size_t i = 0; i < NUM_GENERIC_CAN_RX_HANDLERS; i++) {
+      if (gcs->base.rx_storage[i].rx_handler != NULL &&
+          (rx_msg.id & gcs->base.rx_storage[i].mask) == gcs->base.rx_storage[i].filter) {
+        gcs->base.rx_storage[i].rx_handler(&rx_msg, gcs->base.rx_storage[i].context);
+        break;
+      }
+    }
+  }
+}
+
+static void prv_bus_error_timeout_handler(SoftTimerId timer_id, void *context) {
+  GenericCanSocket *gcs = context;
+
+  if (can_hw_instance_bus_status(gcs->instance) == CAN_HW_BUS_STATUS_OFF) {
+    event_raise(gcs->fault_event, 0);
+  }
+}
+
+// CanHwEventHandlerCb: Fault Occurred
+static void prv_bus_error_handler(void *context) {
+  soft_timer_start_millis(CAN_BUS_OFF_RECOVERY_TIME_MS, prv_bus_error_timeout_handler, context,
+                          NULL);
+}
+
+// tx
+static StatusCode prv_tx(const GenericCan *can, const GenericCanMsg *msg) {
+  GenericCanSocket *gcs = (GenericCanSocket *)can;
+  if (can == NULL || msg == NULL) {
+    return status_code(STATUS_CODE_INVALID_ARGS);
+  } else if (gcs->base.interface != &s_interface) {
+    return status_msg(STATUS_CODE_INVALID_ARGS, "GenericCan not aligned to GenericCanSocket.");
+  }
+
+  return can_hw_instance_transmit(gcs->instance, msg->id, msg->extended, (uint8_t *)&msg->data,
+                                  msg->dlc);
+}
+
+// register_rx
+static StatusCode prv_register_rx(GenericCan *can, GenericCanRx rx_handler, uint32_t mask,
+                                  uint32_t filter, bool extended, void *context) {
+  GenericCanSocket *gcs = (GenericCanSocket *)can;
+  if (can == NULL) {
+    return status_code(STATUS_CODE_INVALID_ARGS);
+  } else if (gcs->base.interface != &s_interface) {
+    return status_msg(STATUS_CODE_INVALID_ARGS, "GenericCan not aligned to GenericCanSocket.");
+  }
+
+  status_ok_or_return(can_hw_instance_add_filter(gcs->instance, mask, filter, extended));
+  return generic_can_helpers_register_rx(can, rx_handler, mask, filter, context, NULL);
+}
+
+StatusCode generic_can_socket_init(GenericCanSocket *can_socket, const char *interface,
+                                   const CanHwSettings *settings, EventId fault_event) {
+  s_interface.tx = prv_tx;
+  s_interface.register_rx = prv_register_rx;
+
+  memset(can_socket->base.rx_storage, 0, sizeof(can_socket->base.rx_storage));
+
+  can_socket->base.interface = &s_interface;
+  can_socket->fault_event = fault_event;
+  status_ok_or_return(can_hw_open(&can_socket->instance, interface, settings));
+
+  can_hw_instance_register_callback(can_socket->instance, CAN_HW_EVENT_MSG_RX, prv_rx_handler,
+                                    can_socket);
+  can_hw_instance_register_callback(can_socket->instance, CAN_HW_EVENT_BUS_ERROR,
+                                    prv_bus_error_handler, can_socket);
+  return STATUS_CODE_OK;
+}
@@ -0,0 +1,263 @@
+#include "can_msg_pack.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "can_msg_schema.h"
+#include "can_msg_unpack.h"
+#include "can_pack.h"
+#include "status.h"
+#include "test_helpers.h"
+#include "unity.h"
+
+static void prv_assert_msg_equal(const CanMessage *expected, const CanMessage *actual) {
+  TEST_ASSERT_EQUAL(expected->type, actual->type);
+  TEST_ASSERT_EQUAL(expected->source_id, actual->source_id);
+  TEST_ASSERT_EQUAL(expected->msg_id, actual->msg_id);
+  TEST_ASSERT_EQUAL(expected->dlc, actual->dlc);
+  TEST_ASSERT_EQUAL_HEX64(expected->data, actual->data);
+
+  // The schema should describe the generated message too
+  const CanMsgSchema *schema = &can_msg_schema_get()[expected->msg_id];
+  TEST_ASSERT_EQUAL(expected->dlc, schema->dlc);
+  TEST_ASSERT_EQUAL(expected->source_id, schema->source_id);
+}
+
+void setup_test(void) {}
+
+void teardown_test(void) {}
+
+void test_can_msg_pack_matches_generated(void) {
+  CanMessage expected = { 0 };
+  CanMessage actual = { 0 };
+
+  CAN_PACK_BPS_HEARTBEAT(&expected, 0x11);
+  can_pack_bps_heartbeat(&actual, 0x11);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_POWER_DISTRIBUTION_FAULT(&expected, 0x11);
+  can_pack_power_distribution_fault(&actual, 0x11);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_BATTERY_RELAY_MAIN(&expected, 0x11);
+  can_pack_battery_relay_main(&actual, 0x11);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_BATTERY_RELAY_SLAVE(&expected, 0x11);
+  can_pack_battery_relay_slave(&actual, 0x11);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_MOTOR_RELAY(&expected, 0x11);
+  can_pack_motor_relay(&actual, 0x11);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_SOLAR_RELAY_REAR(&expected, 0x11);
+  can_pack_solar_relay_rear(&actual, 0x11);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_SOLAR_RELAY_FRONT(&expected, 0x11);
+  can_pack_solar_relay_front(&actual, 0x11);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_POWER_STATE(&expected, 0x11);
+  can_pack_power_state(&actual, 0x11);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_POWERTRAIN_HEARTBEAT(&expected);
+  can_pack_powertrain_heartbeat(&actual);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_OVUV_DCDC_AUX(&expected, 0x11, 0x22, 0x33, 0x44);
+  can_pack_ovuv_dcdc_aux(&actual, 0x11, 0x22, 0x33, 0x44);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_MC_ERROR_LIMITS(&expected, 0x1111, 0x2222);
+  can_pack_mc_error_limits(&actual, 0x1111, 0x2222);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_DRIVE_OUTPUT(&expected, 0x1111, 0x2222, 0x3333, 0x4444);
+  can_pack_drive_output(&actual, 0x1111, 0x2222, 0x3333, 0x4444);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_CRUISE_TARGET(&expected, 0x11);
+  can_pack_cruise_target(&actual, 0x11);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_FAN_CONTROL(&expected, 0x11);
+  can_pack_fan_control(&actual, 0x11);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_SET_DISCHARGE_BITSET(&expected, 0x0123456789ABCDEFULL);
+  can_pack_set_discharge_bitset(&actual, 0x0123456789ABCDEFULL);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_DISCHARGE_STATE(&expected, 0x0123456789ABCDEFULL);
+  can_pack_discharge_state(&actual, 0x0123456789ABCDEFULL);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_LIGHTS_SYNC(&expected);
+  can_pack_lights_sync(&actual);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_LIGHTS_STATE(&expected, 0x11, 0x22);
+  can_pack_lights_state(&actual, 0x11, 0x22);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_HORN(&expected, 0x11);
+  can_pack_horn(&actual, 0x11);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_CHARGER_CONN_STATE(&expected, 0x11);
+  can_pack_charger_conn_state(&actual, 0x11);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_CHARGER_SET_RELAY_STATE(&expected, 0x11);
+  can_pack_charger_set_relay_state(&actual, 0x11);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_STEERING_EVENT(&expected, 0x1111, 0x2222);
+  can_pack_steering_event(&actual, 0x1111, 0x2222);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_CENTER_CONSOLE_EVENT(&expected, 0x1111, 0x2222);
+  can_pack_center_console_event(&actual, 0x1111, 0x2222);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_MOTOR_CONTROLLER_RESET(&expected, 0x11);
+  can_pack_motor_controller_reset(&actual, 0x11);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_BATTERY_SOC(&expected);
+  can_pack_battery_soc(&actual);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_BATTERY_VT(&expected, 0x1111, 0x2222, 0x3333);
+  can_pack_battery_vt(&actual, 0x1111, 0x2222, 0x3333);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_BATTERY_AGGREGATE_VC(&expected, 0x11111111U, 0x22222222U);
+  can_pack_battery_aggregate_vc(&actual, 0x11111111U, 0x22222222U);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_MOTOR_CONTROLLER_VC(&expected, 0x1111, 0x2222, 0x3333, 0x4444);
+  can_pack_motor_controller_vc(&actual, 0x1111, 0x2222, 0x3333, 0x4444);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_MOTOR_VELOCITY(&expected, 0x1111, 0x2222);
+  can_pack_motor_velocity(&actual, 0x1111, 0x2222);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_MOTOR_DEBUG(&expected, 0x0123456789ABCDEFULL);
+  can_pack_motor_debug(&actual, 0x0123456789ABCDEFULL);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_MOTOR_TEMPS(&expected, 0x11111111U, 0x22222222U);
+  can_pack_motor_temps(&actual, 0x11111111U, 0x22222222U);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_MOTOR_AMP_HR(&expected, 0x11111111U, 0x22222222U);
+  can_pack_motor_amp_hr(&actual, 0x11111111U, 0x22222222U);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_ODOMETER(&expected, 0x11111111U);
+  can_pack_odometer(&actual, 0x11111111U);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_AUX_DCDC_VC(&expected, 0x1111, 0x2222, 0x3333, 0x4444);
+  can_pack_aux_dcdc_vc(&actual, 0x1111, 0x2222, 0x3333, 0x4444);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_DCDC_TEMPS(&expected, 0x1111, 0x2222);
+  can_pack_dcdc_temps(&actual, 0x1111, 0x2222);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_SOLAR_DATA_FRONT(&expected, 0x1111, 0x2222, 0x3333, 0x4444);
+  can_pack_solar_data_front(&actual, 0x1111, 0x2222, 0x3333, 0x4444);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_SOLAR_DATA_REAR(&expected, 0x1111, 0x2222, 0x3333, 0x4444);
+  can_pack_solar_data_rear(&actual, 0x1111, 0x2222, 0x3333, 0x4444);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_CHARGER_INFO(&expected, 0x1111, 0x2222, 0x3333);
+  can_pack_charger_info(&actual, 0x1111, 0x2222, 0x3333);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_LINEAR_ACCELERATION(&expected);
+  can_pack_linear_acceleration(&actual);
+  prv_assert_msg_equal(&expected, &actual);
+
+  CAN_PACK_ANGULAR_ROTATION(&expected);
+  can_pack_angular_rotation(&actual);
+  prv_assert_msg_equal(&expected, &actual);
+}
+
+void test_can_msg_unpack(void) {
+  CanMessage msg = { 0 };
+  TEST_ASSERT_OK(can_pack_ovuv_dcdc_aux(&msg, 1, 0, 1, 1));
+
+  uint8_t flags[4] = { 0 };
+  TEST_ASSERT_OK(can_unpack_ovuv_dcdc_aux(&msg, &flags[0], &flags[1], &flags[2], &flags[3]));
+  TEST_ASSERT_EQUAL(1, flags[0]);
+  TEST_ASSERT_EQUAL(0, flags[1]);
+  TEST_ASSERT_EQUAL(1, flags[2]);
+  TEST_ASSERT_EQUAL(1, flags[3]);
+
+  TEST_ASSERT_OK(can_pack_battery_aggregate_vc(&msg, 0x12345678, 0x9ABCDEF0));
+  uint32_t voltage = 0;
+  uint32_t current = 0;
+  TEST_ASSERT_OK(can_unpack_battery_aggregate_vc(&msg, &voltage, &current));
+  TEST_ASSERT_EQUAL_HEX32(0x12345678, voltage);
+  TEST_ASSERT_EQUAL_HEX32(0x9ABCDEF0, current);
+
+  TEST_ASSERT_OK(can_pack_discharge_state(&msg, 0x0123456789ABCDEFULL));
+  uint64_t bitset = 0;
+  TEST_ASSERT_OK(can_unpack_discharge_state(&msg, &bitset));
+  TEST_ASSERT_EQUAL_HEX64(0x0123456789ABCDEFULL, bitset);
+
+  TEST_ASSERT_OK(can_pack_powertrain_heartbeat(&msg));
+  TEST_ASSERT_OK(can_unpack_powertrain_heartbeat(&msg));
+}
+
+void test_can_msg_unpack_null_fields(void) {
+  CanMessage msg = { 0 };
+  TEST_ASSERT_OK(can_pack_drive_output(&msg, 100, 1, 0, 2));
+
+  // Fields we don't care about can be skipped
+  uint16_t throttle = 0;
+  uint16_t mech_brake = 0;
+  TEST_ASSERT_OK(can_unpack_drive_output(&msg, &throttle, NULL, NULL, &mech_brake));
+  TEST_ASSERT_EQUAL(100, throttle);
+  TEST_ASSERT_EQUAL(2, mech_brake);
+
+  TEST_ASSERT_OK(can_unpack_drive_output(&msg, NULL, NULL, NULL, NULL));
+}
+
+void test_can_msg_unpack_dlc_mismatch(void) {
+  CanMessage msg = { 0 };
+  TEST_ASSERT_OK(can_pack_drive_output(&msg, 100, 1, 0, 2));
+  msg.dlc = 4;
+
+  uint16_t throttle = 0;
+  TEST_ASSERT_NOT_OK(can_unpack_drive_output(&msg, &throttle, NULL, NULL, NULL));
+  TEST_ASSERT_EQUAL(0, throttle);
+}
+
+void test_can_msg_schema_slots(void) {
+  const CanMsgSchema *schema = can_msg_schema_get();
+  bool used[CAN_MSG_MAX_IDS] = { false };
+  size_t num_msgs = 0;
+
+  // Every defined message has its own slot, numbered from 0
+  for (size_t i = 0; i < CAN_MSG_MAX_IDS; i++) {
+    if (schema[i].slot == CAN_MSG_SCHEMA_NO_SLOT) {
+      continue;
+    }
+    TEST_ASSERT_TRUE(schema[i].slot < NUM_SYSTEM_CAN_MESSAGES);
+    TEST_ASSERT_FALSE(used[schema[i].slot]);
+    used[schema[i].slot] = true;
+    num_msgs++;
+  }
+
+  TEST_ASSERT_EQUAL(NUM_SYSTEM_CAN_MESSAGES, num_msgs);
+}
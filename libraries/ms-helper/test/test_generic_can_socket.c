@@ -0,0 +1,71 @@
+// x86 only - requires vcan1 unless built with X86_INTERRUPT=sched
+#include "generic_can_socket.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "can_hw.h"
+#include "delay.h"
+#include "event_queue.h"
+#include "generic_can.h"
+#include "gpio.h"
+#include "interrupt.h"
+#include "soft_timer.h"
+#include "status.h"
+#include "test_helpers.h"
+#include "unity.h"
+
+#define TEST_GENERIC_CAN_SOCKET_FAULT_EVENT 1
+#define TEST_GENERIC_CAN_SOCKET_INTERFACE "vcan1"
+
+static GenericCanSocket s_can;
+
+// GenericCanRxCb
+static void prv_can_rx_callback(const GenericCanMsg *msg, void *context) {
+  volatile uint8_t *counter = context;
+  (*counter)++;
+}
+
+void setup_test(void) {
+  event_queue_init();
+  interrupt_init();
+  soft_timer_init();
+  gpio_init();
+
+  const CanHwSettings can_hw_settings = {
+    .bitrate = CAN_HW_BITRATE_250KBPS,
+    .tx = { GPIO_PORT_A, 12 },
+    .rx = { GPIO_PORT_A, 11 },
+    .loopback = true,
+  };
+
+  TEST_ASSERT_OK(generic_can_socket_init(&s_can, TEST_GENERIC_CAN_SOCKET_INTERFACE,
+                                         &can_hw_settings, TEST_GENERIC_CAN_SOCKET_FAULT_EVENT));
+}
+
+void teardown_test(void) {}
+
+void test_generic_can_socket(void) {
+  GenericCan *can = (GenericCan *)&s_can;
+  volatile uint8_t counter = 0;
+
+  GenericCanMsg msg = {
+    .id = 0x0000FF,
+    .data = 255,
+    .dlc = 1,
+    .extended = true,
+  };
+
+  TEST_ASSERT_OK(generic_can_register_rx(can, prv_can_rx_callback, GENERIC_CAN_EMPTY_MASK, msg.id,
+                                         true, &counter));
+
+  TEST_ASSERT_OK(generic_can_tx(can, &msg));
+  delay_ms(300);
+  TEST_ASSERT_EQUAL(1, counter);
+
+  // Filtered out
+  msg.id--;
+  TEST_ASSERT_OK(generic_can_tx(can, &msg));
+  delay_ms(300);
+  TEST_ASSERT_EQUAL(1, counter);
+}
@@ -1,5 +1,14 @@
 #pragma once
-
+// Emulates interrupts on x86. One of two backends is selected at build time with the
+// X86_INTERRUPT make variable:
+// * signal (default): Interrupts are real-time signals delivered to the main thread. Signal
+//   priorities and masks emulate the NVIC, so interrupts can preempt the main thread at any point.
+// * sched: Interrupts are run by a single-threaded cooperative dispatcher in order of priority,
+//   then interrupt id. Pending interrupts run as soon as they are triggered from the main thread,
+//   when a critical section ends, or on x86_interrupt_wait(). Time is virtual and only advances in
+//   x86_interrupt_wait() when nothing else can run, so runs are much faster than real time and
+//   reproducible. Busy loops must call wait() to let interrupts run. Other threads may only
+//   interact with the firmware through x86_interrupt_trigger().
 #include <stdbool.h>
 #include <stdint.h>
 #include <sys/types.h>
@@ -24,6 +33,22 @@ StatusCode x86_interrupt_register_interrupt(uint8_t handler_id, const InterruptS
 // Triggers a software interrupt by interrupt_id.
 StatusCode x86_interrupt_trigger(uint8_t interrupt_id);
 
+// Triggers the interrupt once x86_interrupt_get_time() reaches time_us. Replaces any existing
+// schedule for the interrupt. Should only be called from the main thread.
+StatusCode x86_interrupt_schedule(uint8_t interrupt_id, uint64_t time_us);
+
+// Cancels any existing schedule for the interrupt.
+StatusCode x86_interrupt_cancel_schedule(uint8_t interrupt_id);
+
+// Returns the time in microseconds since interrupts were initialized.
+uint64_t x86_interrupt_get_time(void);
+
+// Waits for an interrupt. This is a no-op with the signal backend since signals preempt the main
+// thread. With the sched backend, this runs any pending interrupts that can run or fast-forwards to
+// the next scheduled interrupt. If there are neither, time moves forward by a millisecond - from
+// the main thread, this also waits up to a millisecond for other threads.
+void x86_interrupt_wait(void);
+
 // Configures the block mask on the signal handler for critical sections.
 void x86_interrupt_mask(void);
 void x86_interrupt_unmask(void);
@@ -11,5 +11,14 @@ $(T)_DEPS := libcore
 $(T)_CFLAGS += -ffreestanding
 
 ifneq (x86,$(PLATFORM))
-  $(T)_EXCLUDE_TESTS := x86_socket x86_cmd
+  $(T)_EXCLUDE_TESTS := x86_socket x86_cmd x86_interrupt_sched
+endif
+
+# Only one interrupt emulation backend is built - see x86_interrupt.h
+$(T)_SRC := $(wildcard $($(T)_SRC_ROOT)/*.c)
+ifeq (sched,$(X86_INTERRUPT))
+  $(T)_SRC := $(filter-out %/x86_interrupt.c,$($(T)_SRC))
+else
+  $(T)_SRC := $(filter-out %/x86_interrupt_sched.c,$($(T)_SRC))
+  $(T)_EXCLUDE_TESTS += x86_interrupt_sched
 endif
@@ -6,6 +6,7 @@
 #include <stdint.h>
 #include <string.h>
 #include <sys/types.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "interrupt_def.h"
@@ -38,6 +39,11 @@ static uint8_t s_x86_interrupt_next_handler_id = 0;
 static Interrupt s_x86_interrupt_interrupts_map[NUM_X86_INTERRUPT_INTERRUPTS];
 static x86InterruptHandler s_x86_interrupt_handlers[NUM_X86_INTERRUPT_HANDLERS];
 
+// Scheduled interrupts use a POSIX timer each, created on first use
+static timer_t s_x86_interrupt_timers[NUM_X86_INTERRUPT_INTERRUPTS];
+static bool s_x86_interrupt_timer_created[NUM_X86_INTERRUPT_INTERRUPTS];
+static struct timespec s_start_time;
+
 // Signal handler for all interrupts. Prioritization is handled by the implementation of signals and
 // the init function. Signals of higher priority interrupt the running of this function. All other
 // signals are stored in a pqueue and are executed in order of priority then arrival. Runs the
@@ -119,6 +125,15 @@ void x86_interrupt_init(void) {
   act.sa_sigaction = prv_sig_state_handler;
   sigaction(SIGRTMIN + NUM_INTERRUPT_PRIORITIES, &act, NULL);
 
+  // Delete timers from any previous initialization.
+  for (size_t i = 0; i < NUM_X86_INTERRUPT_INTERRUPTS; i++) {
+    if (s_x86_interrupt_timer_created[i]) {
+      timer_delete(s_x86_interrupt_timers[i]);
+      s_x86_interrupt_timer_created[i] = false;
+    }
+  }
+  clock_gettime(CLOCK_MONOTONIC, &s_start_time);
+
   // Clear statics.
   s_interrupt_state_update = X86_INTERRUPT_STATE_NONE;
   s_in_handler_flag = false;
@@ -174,6 +189,61 @@ StatusCode x86_interrupt_trigger(uint8_t interrupt_id) {
   return STATUS_CODE_OK;
 }
 
+StatusCode x86_interrupt_schedule(uint8_t interrupt_id, uint64_t time_us) {
+  if (interrupt_id >= s_x86_interrupt_next_interrupt_id) {
+    return status_code(STATUS_CODE_INVALID_ARGS);
+  }
+
+  if (!s_x86_interrupt_timer_created[interrupt_id]) {
+    // Deliver the signal the same way as a triggered interrupt
+    struct sigevent event = { 0 };
+    event.sigev_value.sival_int = interrupt_id;
+    event.sigev_notify = SIGEV_SIGNAL;
+    event.sigev_signo = SIGRTMIN + (int)s_x86_interrupt_interrupts_map[interrupt_id].priority;
+    if (timer_create(CLOCK_MONOTONIC, &event, &s_x86_interrupt_timers[interrupt_id]) != 0) {
+      return status_msg(STATUS_CODE_INTERNAL_ERROR, "Failed to create timer");
+    }
+    s_x86_interrupt_timer_created[interrupt_id] = true;
+  }
+
+  // Convert to an absolute time on the monotonic clock - this is never 0, which would disarm the
+  // timer. Times in the past expire immediately.
+  uint64_t time_ns = (uint64_t)s_start_time.tv_nsec + time_us % 1000000 * 1000;
+  struct itimerspec spec = { { 0, 0 }, { 0, 0 } };
+  spec.it_value.tv_sec = s_start_time.tv_sec + (time_t)(time_us / 1000000 + time_ns / 1000000000);
+  spec.it_value.tv_nsec = (int64_t)(time_ns % 1000000000);
+  timer_settime(s_x86_interrupt_timers[interrupt_id], TIMER_ABSTIME, &spec, NULL);
+
+  return STATUS_CODE_OK;
+}
+
+StatusCode x86_interrupt_cancel_schedule(uint8_t interrupt_id) {
+  if (interrupt_id >= s_x86_interrupt_next_interrupt_id) {
+    return status_code(STATUS_CODE_INVALID_ARGS);
+  }
+
+  if (s_x86_interrupt_timer_created[interrupt_id]) {
+    struct itimerspec spec = { { 0, 0 }, { 0, 0 } };
+    timer_settime(s_x86_interrupt_timers[interrupt_id], 0, &spec, NULL);
+  }
+
+  return STATUS_CODE_OK;
+}
+
+uint64_t x86_interrupt_get_time(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  int64_t elapsed_ns = (int64_t)(now.tv_sec - s_start_time.tv_sec) * 1000000000 +
+                       (now.tv_nsec - s_start_time.tv_nsec);
+  return (uint64_t)elapsed_ns / 1000;
+}
+
+void x86_interrupt_wait(void) {
+  // Signals preempt the main thread, so there's nothing to do
+  return;
+}
+
 void x86_interrupt_pthread_init(void) {
   sigset_t block_mask;
   sigemptyset(&block_mask);
@@ -0,0 +1,287 @@
+// Cooperative interrupt dispatcher - see x86_interrupt.h
+// Only built with X86_INTERRUPT=sched.
+//
+// Pending interrupts are tracked as a bitset per priority. Interrupts are run on the main thread
+// only, in order of priority and then interrupt id, and an interrupt can only be preempted by a
+// higher priority one. Since nothing preempts the main thread, masking interrupts is just a flag.
+// Other threads may set pending bits, which the main thread picks up on its next dispatch.
+#include "x86_interrupt.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "interrupt_def.h"
+#include "log.h"
+#include "misc.h"
+#include "status.h"
+
+#define NUM_X86_INTERRUPT_HANDLERS 64
+#define NUM_X86_INTERRUPT_INTERRUPTS 128
+#define X86_INTERRUPT_PENDING_WORDS (NUM_X86_INTERRUPT_INTERRUPTS / 64)
+#define X86_INTERRUPT_NOT_SCHEDULED UINT64_MAX
+// How far time moves if there is nothing else to do. With nothing scheduled, we also block this
+// long waiting for other threads.
+#define X86_INTERRUPT_IDLE_US 1000
+
+typedef struct Interrupt {
+  InterruptPriority priority;
+  uint8_t handler_id;
+  bool is_event;
+} Interrupt;
+
+static uint8_t s_x86_interrupt_next_interrupt_id = 0;
+static uint8_t s_x86_interrupt_next_handler_id = 0;
+
+static Interrupt s_x86_interrupt_interrupts_map[NUM_X86_INTERRUPT_INTERRUPTS];
+static x86InterruptHandler s_x86_interrupt_handlers[NUM_X86_INTERRUPT_HANDLERS];
+static uint64_t s_deadlines[NUM_X86_INTERRUPT_INTERRUPTS];
+
+// Modified atomically since other threads can trigger interrupts
+static uint64_t s_pending[NUM_INTERRUPT_PRIORITIES][X86_INTERRUPT_PENDING_WORDS];
+
+static uint64_t s_time_us = 0;
+static bool s_masked = false;
+// Priority of the interrupt being run or NUM_INTERRUPT_PRIORITIES if none
+static InterruptPriority s_active_priority = NUM_INTERRUPT_PRIORITIES;
+
+static pthread_t s_main_thread;
+static pthread_mutex_t s_wake_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_wake_cond = PTHREAD_COND_INITIALIZER;
+
+static void prv_set_pending(uint8_t interrupt_id) {
+  InterruptPriority priority = s_x86_interrupt_interrupts_map[interrupt_id].priority;
+  __atomic_fetch_or(&s_pending[priority][interrupt_id / 64], (uint64_t)1 << (interrupt_id % 64),
+                    __ATOMIC_SEQ_CST);
+}
+
+// Clears and returns the highest priority pending interrupt that is more urgent than
+// |max_priority|.
+static bool prv_take_pending(InterruptPriority max_priority, uint8_t *interrupt_id) {
+  for (size_t priority = 0; priority < max_priority; priority++) {
+    for (size_t word = 0; word < X86_INTERRUPT_PENDING_WORDS; word++) {
+      uint64_t pending = __atomic_load_n(&s_pending[priority][word], __ATOMIC_SEQ_CST);
+      if (pending != 0) {
+        uint64_t bit = pending & (~pending + 1);
+        __atomic_fetch_and(&s_pending[priority][word], ~bit, __ATOMIC_SEQ_CST);
+        *interrupt_id = (uint8_t)(word * 64 + (size_t)__builtin_ctzll(pending));
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+// Returns whether there are pending interrupts that could run right now
+static bool prv_runnable_pending(void) {
+  if (s_masked) {
+    return false;
+  }
+
+  for (size_t priority = 0; priority < s_active_priority; priority++) {
+    for (size_t word = 0; word < X86_INTERRUPT_PENDING_WORDS; word++) {
+      if (__atomic_load_n(&s_pending[priority][word], __ATOMIC_SEQ_CST) != 0) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+// Marks every scheduled interrupt that is due as pending
+static void prv_trigger_due(void) {
+  for (uint8_t i = 0; i < s_x86_interrupt_next_interrupt_id; i++) {
+    if (s_deadlines[i] <= s_time_us) {
+      s_deadlines[i] = X86_INTERRUPT_NOT_SCHEDULED;
+      prv_set_pending(i);
+    }
+  }
+}
+
+// Runs pending interrupts that can preempt whatever is currently running
+static void prv_dispatch(void) {
+  if (!pthread_equal(pthread_self(), s_main_thread)) {
+    return;
+  }
+
+  uint8_t interrupt_id = 0;
+  while (!s_masked && prv_take_pending(s_active_priority, &interrupt_id)) {
+    const Interrupt *interrupt = &s_x86_interrupt_interrupts_map[interrupt_id];
+    InterruptPriority prev_priority = s_active_priority;
+
+    s_active_priority = interrupt->priority;
+    // If the interrupt is an event don't run the handler as it is just a wake event.
+    if (!interrupt->is_event) {
+      s_x86_interrupt_handlers[interrupt->handler_id](interrupt_id);
+    }
+    s_active_priority = prev_priority;
+  }
+}
+
+void x86_interrupt_init(void) {
+  s_main_thread = pthread_self();
+
+  // Log the main thread ID for debugging.
+  LOG_DEBUG("Main Thread (id:%ld)\n", s_main_thread);
+
+  // Clear statics.
+  s_x86_interrupt_next_interrupt_id = 0;
+  s_x86_interrupt_next_handler_id = 0;
+  memset(&s_x86_interrupt_interrupts_map, 0, sizeof(s_x86_interrupt_interrupts_map));
+  memset(&s_x86_interrupt_handlers, 0, sizeof(s_x86_interrupt_handlers));
+  for (size_t i = 0; i < NUM_X86_INTERRUPT_INTERRUPTS; i++) {
+    s_deadlines[i] = X86_INTERRUPT_NOT_SCHEDULED;
+  }
+  for (size_t priority = 0; priority < NUM_INTERRUPT_PRIORITIES; priority++) {
+    for (size_t word = 0; word < X86_INTERRUPT_PENDING_WORDS; word++) {
+      __atomic_store_n(&s_pending[priority][word], 0, __ATOMIC_SEQ_CST);
+    }
+  }
+
+  s_time_us = 0;
+  s_masked = false;
+  s_active_priority = NUM_INTERRUPT_PRIORITIES;
+}
+
+StatusCode x86_interrupt_register_handler(x86InterruptHandler handler, uint8_t *handler_id) {
+  if (s_x86_interrupt_next_handler_id >= NUM_X86_INTERRUPT_HANDLERS) {
+    return status_code(STATUS_CODE_RESOURCE_EXHAUSTED);
+  }
+
+  *handler_id = s_x86_interrupt_next_handler_id;
+  s_x86_interrupt_next_handler_id++;
+  s_x86_interrupt_handlers[*handler_id] = handler;
+
+  return STATUS_CODE_OK;
+}
+
+StatusCode x86_interrupt_register_interrupt(uint8_t handler_id, const InterruptSettings *settings,
+                                            uint8_t *interrupt_id) {
+  if (handler_id >= s_x86_interrupt_next_handler_id ||
+      settings->priority >= NUM_INTERRUPT_PRIORITIES || settings->type >= NUM_INTERRUPT_TYPES) {
+    return status_code(STATUS_CODE_INVALID_ARGS);
+  } else if (s_x86_interrupt_next_interrupt_id >= NUM_X86_INTERRUPT_INTERRUPTS) {
+    return status_code(STATUS_CODE_RESOURCE_EXHAUSTED);
+  }
+
+  *interrupt_id = s_x86_interrupt_next_interrupt_id;
+  s_x86_interrupt_next_interrupt_id++;
+  Interrupt interrupt = {
+    .priority = settings->priority, .handler_id = handler_id, .is_event = (bool)settings->type
+  };
+  s_x86_interrupt_interrupts_map[*interrupt_id] = interrupt;
+
+  return STATUS_CODE_OK;
+}
+
+StatusCode x86_interrupt_trigger(uint8_t interrupt_id) {
+  if (interrupt_id >= s_x86_interrupt_next_interrupt_id) {
+    return status_code(STATUS_CODE_INVALID_ARGS);
+  }
+
+  prv_set_pending(interrupt_id);
+
+  if (pthread_equal(pthread_self(), s_main_thread)) {
+    prv_dispatch();
+  } else {
+    // Wake the main thread if it's waiting
+    pthread_mutex_lock(&s_wake_mutex);
+    pthread_cond_signal(&s_wake_cond);
+    pthread_mutex_unlock(&s_wake_mutex);
+  }
+
+  return STATUS_CODE_OK;
+}
+
+StatusCode x86_interrupt_schedule(uint8_t interrupt_id, uint64_t time_us) {
+  if (interrupt_id >= s_x86_interrupt_next_interrupt_id) {
+    return status_code(STATUS_CODE_INVALID_ARGS);
+  }
+
+  s_deadlines[interrupt_id] = time_us;
+  if (time_us <= s_time_us) {
+    prv_trigger_due();
+    prv_dispatch();
+  }
+
+  return STATUS_CODE_OK;
+}
+
+StatusCode x86_interrupt_cancel_schedule(uint8_t interrupt_id) {
+  if (interrupt_id >= s_x86_interrupt_next_interrupt_id) {
+    return status_code(STATUS_CODE_INVALID_ARGS);
+  }
+
+  s_deadlines[interrupt_id] = X86_INTERRUPT_NOT_SCHEDULED;
+
+  return STATUS_CODE_OK;
+}
+
+uint64_t x86_interrupt_get_time(void) {
+  return s_time_us;
+}
+
+void x86_interrupt_wait(void) {
+  if (prv_runnable_pending()) {
+    prv_dispatch();
+    return;
+  }
+
+  // Nothing can run until the next scheduled interrupt, so skip straight to it
+  uint64_t next_deadline_us = X86_INTERRUPT_NOT_SCHEDULED;
+  for (uint8_t i = 0; i < s_x86_interrupt_next_interrupt_id; i++) {
+    next_deadline_us = MIN(next_deadline_us, s_deadlines[i]);
+  }
+
+  if (next_deadline_us != X86_INTERRUPT_NOT_SCHEDULED) {
+    s_time_us = MAX(s_time_us, next_deadline_us);
+    prv_trigger_due();
+    prv_dispatch();
+    return;
+  }
+
+  if (!s_masked && !x86_interrupt_in_handler()) {
+    // Only another thread can wake us now
+    struct timespec timeout = { 0 };
+    clock_gettime(CLOCK_REALTIME, &timeout);
+    timeout.tv_nsec += X86_INTERRUPT_IDLE_US * 1000;
+    if (timeout.tv_nsec >= 1000000000) {
+      timeout.tv_sec++;
+      timeout.tv_nsec -= 1000000000;
+    }
+
+    pthread_mutex_lock(&s_wake_mutex);
+    if (!prv_runnable_pending()) {
+      pthread_cond_timedwait(&s_wake_cond, &s_wake_mutex, &timeout);
+    }
+    pthread_mutex_unlock(&s_wake_mutex);
+  }
+
+  // Busy loops still take time, even if nothing else can run.
+  if (!prv_runnable_pending()) {
+    s_time_us += X86_INTERRUPT_IDLE_US;
+  }
+  prv_dispatch();
+}
+
+void x86_interrupt_mask(void) {
+  s_masked = true;
+}
+
+void x86_interrupt_unmask(void) {
+  s_masked = false;
+  prv_dispatch();
+}
+
+void x86_interrupt_pthread_init(void) {
+  // Nothing to do - interrupts are never run on other threads
+  return;
+}
+
+bool x86_interrupt_in_handler(void) {
+  return s_active_priority != NUM_INTERRUPT_PRIORITIES;
+}
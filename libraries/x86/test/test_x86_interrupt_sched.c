@@ -0,0 +1,156 @@
+// Only built with X86_INTERRUPT=sched
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "interrupt_def.h"
+#include "test_helpers.h"
+#include "unity.h"
+#include "x86_interrupt.h"
+
+#define TEST_X86_INTERRUPT_MAX_RUNS 10
+
+static uint8_t s_handler_id;
+static uint8_t s_runs[TEST_X86_INTERRUPT_MAX_RUNS];
+static uint64_t s_run_times[TEST_X86_INTERRUPT_MAX_RUNS];
+static size_t s_num_runs;
+
+// Interrupt to trigger from inside the handler, if any
+static uint8_t s_nested_id;
+static bool s_nested;
+
+static void prv_handler(uint8_t interrupt_id) {
+  if (s_num_runs < TEST_X86_INTERRUPT_MAX_RUNS) {
+    s_runs[s_num_runs] = interrupt_id;
+    s_run_times[s_num_runs] = x86_interrupt_get_time();
+    s_num_runs++;
+  }
+
+  if (s_nested) {
+    s_nested = false;
+    x86_interrupt_trigger(s_nested_id);
+  }
+}
+
+static uint8_t prv_register(InterruptPriority priority) {
+  InterruptSettings settings = {
+    .type = INTERRUPT_TYPE_INTERRUPT,  //
+    .priority = priority,              //
+  };
+  uint8_t interrupt_id = 0;
+  TEST_ASSERT_OK(x86_interrupt_register_interrupt(s_handler_id, &settings, &interrupt_id));
+  return interrupt_id;
+}
+
+void setup_test(void) {
+  x86_interrupt_init();
+  TEST_ASSERT_OK(x86_interrupt_register_handler(prv_handler, &s_handler_id));
+
+  memset(s_runs, 0, sizeof(s_runs));
+  memset(s_run_times, 0, sizeof(s_run_times));
+  s_num_runs = 0;
+  s_nested = false;
+}
+
+void teardown_test(void) {}
+
+void test_x86_interrupt_sched_trigger(void) {
+  uint8_t id = prv_register(INTERRUPT_PRIORITY_NORMAL);
+
+  // Triggering from the main thread runs the interrupt immediately
+  TEST_ASSERT_OK(x86_interrupt_trigger(id));
+  TEST_ASSERT_EQUAL(1, s_num_runs);
+  TEST_ASSERT_EQUAL(id, s_runs[0]);
+  TEST_ASSERT_FALSE(x86_interrupt_in_handler());
+
+  TEST_ASSERT_NOT_OK(x86_interrupt_trigger(id + 1));
+}
+
+void test_x86_interrupt_sched_masked_order(void) {
+  uint8_t low = prv_register(INTERRUPT_PRIORITY_LOW);
+  uint8_t normal_a = prv_register(INTERRUPT_PRIORITY_NORMAL);
+  uint8_t normal_b = prv_register(INTERRUPT_PRIORITY_NORMAL);
+  uint8_t high = prv_register(INTERRUPT_PRIORITY_HIGH);
+
+  x86_interrupt_mask();
+  x86_interrupt_trigger(low);
+  x86_interrupt_trigger(normal_b);
+  x86_interrupt_trigger(high);
+  x86_interrupt_trigger(normal_a);
+
+  // Pending interrupts can't run while masked, even when waiting
+  x86_interrupt_wait();
+  TEST_ASSERT_EQUAL(0, s_num_runs);
+
+  // Priority first, then interrupt id
+  x86_interrupt_unmask();
+  TEST_ASSERT_EQUAL(4, s_num_runs);
+  TEST_ASSERT_EQUAL(high, s_runs[0]);
+  TEST_ASSERT_EQUAL(normal_a, s_runs[1]);
+  TEST_ASSERT_EQUAL(normal_b, s_runs[2]);
+  TEST_ASSERT_EQUAL(low, s_runs[3]);
+}
+
+void test_x86_interrupt_sched_nested(void) {
+  uint8_t normal = prv_register(INTERRUPT_PRIORITY_NORMAL);
+  uint8_t high = prv_register(INTERRUPT_PRIORITY_HIGH);
+  uint8_t low = prv_register(INTERRUPT_PRIORITY_LOW);
+
+  // A higher priority interrupt preempts the handler
+  s_nested = true;
+  s_nested_id = high;
+  x86_interrupt_trigger(normal);
+  TEST_ASSERT_EQUAL(2, s_num_runs);
+  TEST_ASSERT_EQUAL(normal, s_runs[0]);
+  TEST_ASSERT_EQUAL(high, s_runs[1]);
+
+  // A lower priority interrupt runs once the handler is done
+  s_nested = true;
+  s_nested_id = low;
+  x86_interrupt_trigger(normal);
+  TEST_ASSERT_EQUAL(4, s_num_runs);
+  TEST_ASSERT_EQUAL(normal, s_runs[2]);
+  TEST_ASSERT_EQUAL(low, s_runs[3]);
+}
+
+void test_x86_interrupt_sched_schedule(void) {
+  uint8_t first = prv_register(INTERRUPT_PRIORITY_LOW);
+  uint8_t second = prv_register(INTERRUPT_PRIORITY_HIGH);
+  uint8_t cancelled = prv_register(INTERRUPT_PRIORITY_NORMAL);
+
+  TEST_ASSERT_EQUAL(0, x86_interrupt_get_time());
+  TEST_ASSERT_OK(x86_interrupt_schedule(second, 5000000));
+  TEST_ASSERT_OK(x86_interrupt_schedule(first, 1000));
+  TEST_ASSERT_OK(x86_interrupt_schedule(cancelled, 2000));
+  TEST_ASSERT_OK(x86_interrupt_cancel_schedule(cancelled));
+
+  // Time only moves when waiting, and skips straight to the next deadline
+  TEST_ASSERT_EQUAL(0, s_num_runs);
+  x86_interrupt_wait();
+  TEST_ASSERT_EQUAL(1, s_num_runs);
+  TEST_ASSERT_EQUAL(first, s_runs[0]);
+  TEST_ASSERT_EQUAL(1000, s_run_times[0]);
+
+  x86_interrupt_wait();
+  TEST_ASSERT_EQUAL(2, s_num_runs);
+  TEST_ASSERT_EQUAL(second, s_runs[1]);
+  TEST_ASSERT_EQUAL(5000000, x86_interrupt_get_time());
+
+  // Schedules in the past run immediately
+  TEST_ASSERT_OK(x86_interrupt_schedule(first, 0));
+  TEST_ASSERT_EQUAL(3, s_num_runs);
+  TEST_ASSERT_EQUAL(5000000, s_run_times[2]);
+}
+
+void test_x86_interrupt_sched_same_deadline(void) {
+  uint8_t low = prv_register(INTERRUPT_PRIORITY_LOW);
+  uint8_t high = prv_register(INTERRUPT_PRIORITY_HIGH);
+
+  x86_interrupt_schedule(low, 100);
+  x86_interrupt_schedule(high, 100);
+  x86_interrupt_wait();
+
+  TEST_ASSERT_EQUAL(2, s_num_runs);
+  TEST_ASSERT_EQUAL(high, s_runs[0]);
+  TEST_ASSERT_EQUAL(low, s_runs[1]);
+}
@@ -9,7 +9,7 @@ VALID_LIBRARIES := $(patsubst $(LIB_DIR)/%/rules.mk,%,$(wildcard $(LIB_DIR)/*/ru
 # - For test, gdb, and program, check to see if PLATFORM and {PROJECT or {LIBRARY and TEST}} are valid
 # - For build, check if PLATFORM and {PROJECT or LIBRARY} are valid
 
-ifneq (,$(filter clean lint pylint format build_all test_all test_format socketcan update_codegen,$(MAKECMDGOALS)))
+ifneq (,$(filter clean lint pylint format build_all test_all test_format socketcan sim update_codegen,$(MAKECMDGOALS)))
   # Universal operation: do nothing - args are not used or only PLATFORM is checked
 else ifneq (,$(filter new,$(MAKECMDGOALS)))
   # New project: just make sure PROJECT or LIBRARY is defined
@@ -31,7 +31,7 @@ else
   endif
 endif
 
-ifneq (,$(filter build_all test_all test gdb program build,$(MAKECMDGOALS)))
+ifneq (,$(filter build_all test_all test gdb program build sim,$(MAKECMDGOALS)))
   # Check for valid PLATFORM
   override PLATFORM := $(filter $(VALID_PLATFORMS),$(PLATFORM))
 
@@ -39,3 +39,9 @@ ifneq (,$(filter build_all test_all test gdb program build,$(MAKECMDGOALS)))
     $(error Invalid platform. Expected PLATFORM=[$(VALID_PLATFORMS)])
   endif
 endif
+
+ifneq (,$(filter sim,$(MAKECMDGOALS)))
+  ifneq (x86,$(PLATFORM))
+    $(error Simulations only run on x86. Expected PLATFORM=x86)
+  endif
+endif
@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+"""x86 simulation launcher.
+
+Runs several x86 project binaries at once, each as its own process. Nodes are given as
+project[@interface], where the interface is the CAN interface used by the node's CAN HW default
+instance (vcan0 if omitted). The same project may be listed more than once. Each node gets its own
+flash file and its output is prefixed with its name. Stops every node on Ctrl-C or once any node
+exits.
+
+Usage: python3 x86_sim.py --bin-dir build/bin/x86 chaos plutus@vcan0 mc_interface
+"""
+import argparse
+import os
+import signal
+import subprocess
+import sys
+import threading
+
+DEFAULT_INTERFACE = 'vcan0'
+
+
+def parse_node(spec):
+    """Splits a project[@interface] node spec into (project, interface)."""
+    project, _, interface = spec.partition('@')
+    return project, interface or DEFAULT_INTERFACE
+
+
+def forward_output(name, stream):
+    """Copies a node's output to stdout, prefixing each line with the node's name."""
+    for line in iter(stream.readline, b''):
+        sys.stdout.write('[{}] {}'.format(name, line.decode(errors='replace')))
+        sys.stdout.flush()
+
+
+def launch(bin_dir, flash_dir, specs):
+    """Starts every node and waits until one exits or the user interrupts.
+
+    Args:
+        bin_dir: Folder containing the x86 project binaries.
+        flash_dir: Folder to hold each node's flash file.
+        specs: List of project[@interface] node specs.
+
+    Returns:
+        The exit code of the first node to exit, or 0 if interrupted.
+    """
+    os.makedirs(flash_dir, exist_ok=True)
+
+    nodes = []
+    for index, spec in enumerate(specs):
+        project, interface = parse_node(spec)
+        name = '{}@{}'.format(project, interface)
+        env = dict(os.environ)
+        env['MIDSUN_X86_CAN_INTERFACE'] = interface
+        env['MIDSUN_X86_FLASH_FILE'] = os.path.join(flash_dir,
+                                                    '{}_{}.flash'.format(project, index))
+
+        proc = subprocess.Popen([os.path.join(bin_dir, project)], env=env,
+                                stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+        thread = threading.Thread(target=forward_output, args=(name, proc.stdout), daemon=True)
+        thread.start()
+        nodes.append((name, proc, thread))
+        print('Started {} (pid {})'.format(name, proc.pid))
+
+    exit_code = 0
+    try:
+        # Nodes aren't expected to exit, so stop the whole simulation once one does
+        pid, status = os.wait()
+        exit_code = os.WEXITSTATUS(status) if os.WIFEXITED(status) else 1
+        name = next(name for name, proc, _ in nodes if proc.pid == pid)
+        print('{} exited with status {}, stopping simulation'.format(name, exit_code))
+    except KeyboardInterrupt:
+        print('Stopping simulation')
+
+    for name, proc, thread in nodes:
+        if proc.poll() is None:
+            proc.send_signal(signal.SIGTERM)
+        try:
+            proc.wait(timeout=1)
+        except subprocess.TimeoutExpired:
+            proc.kill()
+            proc.wait()
+        thread.join(timeout=1)
+
+    return exit_code
+
+
+def main():
+    """Main entry point of program"""
+    parser = argparse.ArgumentParser(description='Runs several x86 projects at once')
+    parser.add_argument('--bin-dir', default='build/bin/x86')
+    parser.add_argument('--flash-dir', default='build/sim')
+    parser.add_argument('nodes', nargs='+', help='project[@interface]')
+    args = parser.parse_args()
+
+    sys.exit(launch(args.bin_dir, args.flash_dir, args.nodes))
+
+
+if __name__ == '__main__':
+    main()
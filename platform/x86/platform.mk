@@ -27,6 +27,17 @@ LDSCRIPT := $(PLATFORM_DIR)/ldscripts
 # Build flags for the device
 CDEFINES := _GNU_SOURCE
 
+# Interrupt emulation - see x86_interrupt.h
+X86_INTERRUPT ?= signal
+VALID_X86_INTERRUPTS := signal sched
+ifeq (,$(filter $(VALID_X86_INTERRUPTS),$(X86_INTERRUPT)))
+  $(error Invalid x86 interrupt emulation. Expected: $(VALID_X86_INTERRUPTS))
+endif
+
+ifeq (sched,$(X86_INTERRUPT))
+  CDEFINES += X86_INTERRUPT_SCHED
+endif
+
 ifeq (gcc,$(COMPILER))
   CSFLAGS := -g -Os
 else ifeq (asan, $(COPTIONS))
@@ -6,11 +6,16 @@
 #include <stdint.h>
 
 #include "adc.h"
+#include "can_publish.h"
 #include "event_queue.h"
 #include "gpio.h"
 #include "soft_timer.h"
 #include "status.h"
 
+// Voltage (mV) or current (mA) change needed to send the readings before the next heartbeat
+#define POWER_PATH_PUBLISH_DEADBAND 10
+#define POWER_PATH_PUBLISH_MAX_SILENCE_MS 1000
+
 // Conversion function signature for ADCs.
 typedef uint16_t (*PowerPathConversionFn)(uint16_t value);
 
@@ -47,12 +52,14 @@ typedef struct PowerPathCfg {
   PowerPathSource aux_bat;
   PowerPathSource dcdc;
   uint32_t period_millis;
+  CanPublishStorage publish;
 } PowerPathCfg;
 
 // Configures the GPIO pins for the power path.
 StatusCode power_path_init(PowerPathCfg *pp);
 
-// Starts sending data periodically over CAN.
+// Starts sending data periodically over CAN. Readings are only sent when they change by more than
+// POWER_PATH_PUBLISH_DEADBAND, or every POWER_PATH_PUBLISH_MAX_SILENCE_MS if they're steady.
 StatusCode power_path_send_data_daemon(PowerPathCfg *pp, uint32_t period_millis);
 
 // Starts monitoring the specified power source periodically.
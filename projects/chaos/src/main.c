@@ -5,6 +5,7 @@
 #include "bps_heartbeat.h"
 #include "can.h"
 #include "can_ack.h"
+#include "can_msg_schema.h"
 #include "chaos_config.h"
 #include "chaos_events.h"
 #include "chaos_flags.h"
@@ -31,6 +32,8 @@
 #include "wait.h"
 
 #define CHAOS_DEBUG_LED_PERIOD_MS 500
+// Max events handled per pass of the main loop, i.e. a burst of CAN RX events
+#define CHAOS_EVENT_BATCH_SIZE 8
 
 static CanStorage s_can_storage;
 static EmergencyFaultStorage s_emergency_storage;
@@ -64,6 +67,7 @@ int main(void) {
     .tx = { GPIO_PORT_A, 12 },
     .rx = { GPIO_PORT_A, 11 },
     .loopback = false,
+    .msg_schema = can_msg_schema_get(),
   };
   can_init(&s_can_storage, &can_settings);
 
@@ -111,36 +115,37 @@ int main(void) {
   LOG_DEBUG("Started\n");
 
   // Main loop
-  Event e = { 0 };
-  StatusCode status = NUM_STATUS_CODES;
+  Event events[CHAOS_EVENT_BATCH_SIZE] = { 0 };
   while (true) {
     // Tight event loop
-    do {
-      status = event_process(&e);
-      // TODO(ELEC-105): Validate nothing gets stuck here.
-      if (status == STATUS_CODE_EMPTY) {
-        wait();
-      }
-    } while (status != STATUS_CODE_OK);
+    // TODO(ELEC-105): Validate nothing gets stuck here.
+    size_t num_events = event_process_batch(events, SIZEOF_ARRAY(events));
+    if (num_events == 0) {
+      wait();
+      continue;
+    }
 
     // Event Processing:
 
     // TODO(ELEC-105): At least one of the following should respond with either a boolean true or
     // a STATUS_CODE_OK for each emitted message. Consider adding a requirement that this is the
     // case with a failure resulting in faulting into Emergency.
-    can_process_event(&e);
-    delay_service_process_event(&e);
-    fan_control_process_event(&e);
-    emergency_fault_process_event(&s_emergency_storage, &e);
-    gpio_fsm_process_event(&e);
+    for (size_t i = 0; i < num_events; i++) {
+      const Event *e = &events[i];
+      can_process_event(e);
+      delay_service_process_event(e);
+      fan_control_process_event(e);
+      emergency_fault_process_event(&s_emergency_storage, e);
+      gpio_fsm_process_event(e);
 #ifdef CHAOS_FLAG_ENABLE_POWERTRAIN_HB
-    powertrain_heartbeat_process_event(&e);
+      powertrain_heartbeat_process_event(e);
 #endif  // CHAOS_FLAG_ENABLE_POWERTRAIN_HB
-    power_path_process_event(&cfg->power_path, &e);
-    charger_process_event(&e);
-    relay_process_event(&e);
-    relay_retry_service_update(&e);
-    sequencer_fsm_publish_next_event(&e);
+      power_path_process_event(&cfg->power_path, e);
+      charger_process_event(e);
+      relay_process_event(e);
+      relay_retry_service_update(e);
+      sequencer_fsm_publish_next_event(e);
+    }
   }
 
   // Not reached.
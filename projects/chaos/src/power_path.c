@@ -5,6 +5,8 @@
 
 #include "adc.h"
 #include "can_msg_defs.h"
+#include "can_pack.h"
+#include "can_publish.h"
 #include "can_transmit.h"
 #include "chaos_events.h"
 #include "event_queue.h"
@@ -32,8 +34,9 @@ static void prv_send(SoftTimerId timer_id, void *context) {
   power_path_read_source(&cfg->aux_bat, &aux);
   PowerPathVCReadings dcdc = { 0 };
   power_path_read_source(&cfg->dcdc, &dcdc);
-  CAN_TRANSMIT_AUX_DCDC_VC(aux.voltage, aux.current, dcdc.voltage, dcdc.current);
-  soft_timer_start_millis(cfg->period_millis, prv_send, context, NULL);
+  CanMessage msg = { 0 };
+  CAN_PACK_AUX_DCDC_VC(&msg, aux.voltage, aux.current, dcdc.voltage, dcdc.current);
+  can_publish(&cfg->publish, &msg);
 }
 
 // Interrupt handler for over and under voltage warnings.
@@ -125,7 +128,15 @@ StatusCode power_path_init(PowerPathCfg *pp) {
 
 StatusCode power_path_send_data_daemon(PowerPathCfg *pp, uint32_t period_millis) {
   pp->period_millis = period_millis;
-  return soft_timer_start_millis(pp->period_millis, prv_send, pp, NULL);
+
+  const CanPublishSettings publish_settings = {
+    .field_size = sizeof(uint16_t),
+    .deadband = POWER_PATH_PUBLISH_DEADBAND,
+    .max_silence_ms = POWER_PATH_PUBLISH_MAX_SILENCE_MS,
+  };
+  status_ok_or_return(can_publish_init(&pp->publish, &publish_settings));
+
+  return soft_timer_start_periodic_millis(pp->period_millis, prv_send, pp, NULL);
 }
 
 StatusCode power_path_source_monitor_enable(PowerPathSource *source, uint32_t period_millis) {
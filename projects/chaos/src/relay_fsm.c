@@ -151,8 +151,7 @@ StatusCode relay_fsm_create(Fsm *fsm, RelayId relay_id, const char *fsm_name,
   s_fsm_ctxs[relay_id].request.context = &s_fsm_ctxs[relay_id].ack_ctx;
   s_fsm_ctxs[relay_id].power_pin.port = addr->port;
   s_fsm_ctxs[relay_id].power_pin.pin = addr->pin;
-  fsm_init(fsm, fsm_name, &relay_opened, &s_fsm_ctxs[relay_id]);
-  return STATUS_CODE_OK;
+  return fsm_init(fsm, fsm_name, &relay_opened, &s_fsm_ctxs[relay_id]);
 }
 
 StatusCode relay_fsm_open_event(RelayId relay_id, Event *e) {
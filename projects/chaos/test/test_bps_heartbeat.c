@@ -16,6 +16,7 @@
 #include "gpio.h"
 #include "interrupt.h"
 #include "misc.h"
+#include "ms_test_helpers.h"
 #include "soft_timer.h"
 #include "status.h"
 #include "test_helpers.h"
@@ -63,36 +64,27 @@ void test_bps_heartbeat_watchdog_kick(void) {
   };
 
   Event e = { 0 };
-  StatusCode status = NUM_STATUS_CODES;
 
   // Auto Start
   CAN_TRANSMIT_BPS_HEARTBEAT(&ack_req, EE_BPS_HEARTBEAT_STATE_OK);
   // Send HB
   // TX
-  do {
-    status = event_process(&e);
-  } while (status == STATUS_CODE_EMPTY);
+  MS_TEST_HELPER_AWAIT_EVENT(e);
   TEST_ASSERT_TRUE(can_process_event(&e));
 
   // In theory these latter three events are in indeterminate order but it doesn't matter
   // RX
-  do {
-    status = event_process(&e);
-  } while (status == STATUS_CODE_EMPTY);
+  MS_TEST_HELPER_AWAIT_EVENT(e);
   TEST_ASSERT_TRUE(can_process_event(&e));
 
   // HB Timer is started
 
   // Ack HB
   // TX
-  do {
-    status = event_process(&e);
-  } while (status == STATUS_CODE_EMPTY);
+  MS_TEST_HELPER_AWAIT_EVENT(e);
   TEST_ASSERT_TRUE(can_process_event(&e));
   // RX
-  do {
-    status = event_process(&e);
-  } while (status == STATUS_CODE_EMPTY);
+  MS_TEST_HELPER_AWAIT_EVENT(e);
   TEST_ASSERT_TRUE(can_process_event(&e));
 
   delay_ms(BPS_HEARTBEAT_EXPECTED_PERIOD_MS / 2);
@@ -101,30 +93,22 @@ void test_bps_heartbeat_watchdog_kick(void) {
   CAN_TRANSMIT_BPS_HEARTBEAT(&ack_req, EE_BPS_HEARTBEAT_STATE_OK);
   // Send HB
   // TX
-  do {
-    status = event_process(&e);
-  } while (status == STATUS_CODE_EMPTY);
+  MS_TEST_HELPER_AWAIT_EVENT(e);
   TEST_ASSERT_TRUE(can_process_event(&e));
 
   // In theory these latter three events are in indeterminate order but it doesn't matter
   // RX
-  do {
-    status = event_process(&e);
-  } while (status == STATUS_CODE_EMPTY);
+  MS_TEST_HELPER_AWAIT_EVENT(e);
   TEST_ASSERT_TRUE(can_process_event(&e));
 
   // HB Timer is started
 
   // Ack HB
   // TX
-  do {
-    status = event_process(&e);
-  } while (status == STATUS_CODE_EMPTY);
+  MS_TEST_HELPER_AWAIT_EVENT(e);
   TEST_ASSERT_TRUE(can_process_event(&e));
   // RX
-  do {
-    status = event_process(&e);
-  } while (status == STATUS_CODE_EMPTY);
+  MS_TEST_HELPER_AWAIT_EVENT(e);
   TEST_ASSERT_TRUE(can_process_event(&e));
 
   // Delay long enough the first watchdog would expire but not the second.
@@ -141,30 +125,22 @@ void test_bps_heartbeat_watchdog_kick(void) {
   CAN_TRANSMIT_BPS_HEARTBEAT(&ack_req, EE_BPS_HEARTBEAT_STATE_OK);
   // Send HB
   // TX
-  do {
-    status = event_process(&e);
-  } while (status == STATUS_CODE_EMPTY);
+  MS_TEST_HELPER_AWAIT_EVENT(e);
   TEST_ASSERT_TRUE(can_process_event(&e));
 
   // In theory these latter three events are in indeterminate order but it doesn't matter
   // RX
-  do {
-    status = event_process(&e);
-  } while (status == STATUS_CODE_EMPTY);
+  MS_TEST_HELPER_AWAIT_EVENT(e);
   TEST_ASSERT_TRUE(can_process_event(&e));
 
   // HB Timer is started
 
   // Ack HB
   // TX
-  do {
-    status = event_process(&e);
-  } while (status == STATUS_CODE_EMPTY);
+  MS_TEST_HELPER_AWAIT_EVENT(e);
   TEST_ASSERT_TRUE(can_process_event(&e));
   // RX
-  do {
-    status = event_process(&e);
-  } while (status == STATUS_CODE_EMPTY);
+  MS_TEST_HELPER_AWAIT_EVENT(e);
   TEST_ASSERT_TRUE(can_process_event(&e));
 
   // Verify that the watchdog actually expires.
@@ -138,17 +138,12 @@ void test_power_path_uv_ov(void) {
   gpio_it_trigger_interrupt(&s_ppc.aux_bat.uv_ov_pin);
 
   volatile Event e = { 0 };
-  volatile StatusCode status = NUM_STATUS_CODES;
 
   // TX
-  do {
-    status = event_process(&e);
-  } while (status != STATUS_CODE_OK);
+  MS_TEST_HELPER_AWAIT_EVENT(e);
   TEST_ASSERT_TRUE(can_process_event(&e));
   // RX
-  do {
-    status = event_process(&e);
-  } while (status != STATUS_CODE_OK);
+  MS_TEST_HELPER_AWAIT_EVENT(e);
   TEST_ASSERT_TRUE(can_process_event(&e));
 
   TEST_ASSERT_EQUAL(false, s_dcdc_uv);
@@ -159,14 +154,10 @@ void test_power_path_uv_ov(void) {
   gpio_it_trigger_interrupt(&s_ppc.dcdc.uv_ov_pin);
 
   // TX
-  do {
-    status = event_process(&e);
-  } while (status != STATUS_CODE_OK);
+  MS_TEST_HELPER_AWAIT_EVENT(e);
   TEST_ASSERT_TRUE(can_process_event(&e));
   // RX
-  do {
-    status = event_process(&e);
-  } while (status != STATUS_CODE_OK);
+  MS_TEST_HELPER_AWAIT_EVENT(e);
   TEST_ASSERT_TRUE(can_process_event(&e));
 
   TEST_ASSERT_EQUAL(true, s_dcdc_uv);
@@ -52,7 +52,6 @@ void teardown_test(void) {}
 
 void test_powertrain_heartbeat_watchdog(void) {
   Event e = { 0 };
-  volatile StatusCode status = NUM_STATUS_CODES;
   e.id = CHAOS_EVENT_SEQUENCE_DRIVE_DONE;
   TEST_ASSERT_TRUE(powertrain_heartbeat_process_event(&e));
 
@@ -64,9 +63,7 @@ void test_powertrain_heartbeat_watchdog(void) {
   MS_TEST_HELPER_CAN_TX_RX(CHAOS_EVENT_CAN_TX, CHAOS_EVENT_CAN_RX);
 
   // Watchdog should activate.
-  do {
-    status = event_process(&e);
-  } while (status == STATUS_CODE_EMPTY);
+  MS_TEST_HELPER_AWAIT_EVENT(e);
   TEST_ASSERT_EQUAL(CHAOS_EVENT_SEQUENCE_EMERGENCY, e.id);
 
   // No more should activate.
@@ -76,7 +73,6 @@ void test_powertrain_heartbeat_watchdog(void) {
 
 void test_powertrain_heartbeat_stop_heartbeat(void) {
   Event e = { 0 };
-  StatusCode status = NUM_STATUS_CODES;
   e.id = CHAOS_EVENT_SEQUENCE_DRIVE_DONE;
   TEST_ASSERT_TRUE(powertrain_heartbeat_process_event(&e));
 
@@ -98,7 +94,6 @@ void test_powertrain_heartbeat_kick_watchdog(void) {
   };
 
   Event e = { 0 };
-  volatile StatusCode status = NUM_STATUS_CODES;
   e.id = CHAOS_EVENT_SEQUENCE_DRIVE_DONE;
   TEST_ASSERT_TRUE(powertrain_heartbeat_process_event(&e));
 
@@ -119,8 +114,6 @@ void test_powertrain_heartbeat_kick_watchdog(void) {
   MS_TEST_HELPER_CAN_TX_RX(CHAOS_EVENT_CAN_TX, CHAOS_EVENT_CAN_RX);
 
   // Watchdog should trigger.
-  do {
-    status = event_process(&e);
-  } while (status == STATUS_CODE_EMPTY);
+  MS_TEST_HELPER_AWAIT_EVENT(e);
   TEST_ASSERT_EQUAL(CHAOS_EVENT_SEQUENCE_EMERGENCY, e.id);
 }
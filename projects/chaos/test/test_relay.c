@@ -13,6 +13,7 @@
 #include "gpio.h"
 #include "interrupt.h"
 #include "log.h"
+#include "ms_test_helpers.h"
 #include "relay_fsm.h"
 #include "relay_id.h"
 #include "relay_retry_service.h"
@@ -110,7 +111,6 @@ void test_relay_cycle(void) {
   };
 
   Event e = { 0 };
-  StatusCode status = NUM_STATUS_CODES;
 
   // For each RelayID.
   for (uint16_t i = 0; i < SIZEOF_ARRAY(params); i++) {
@@ -139,9 +139,7 @@ void test_relay_cycle(void) {
       // non-deterministic due to threading.
       for (uint16_t k = 0; k < expected_can_cnt + expected_event_cnt + expected_retry_cnt; k++) {
         // Get an event to handle.
-        do {
-          status = event_process(&e);
-        } while (status != STATUS_CODE_OK);
+        MS_TEST_HELPER_AWAIT_EVENT(e);
 
         // If it is a CAN event let the CAN_FSM handle it.
         if (e.id == CHAOS_EVENT_CAN_RX || e.id == CHAOS_EVENT_CAN_TX ||
@@ -185,14 +183,11 @@ void test_relay_retry_limit(void) {
 
   // Track the number of retries.
   uint16_t retries = 0;
-  StatusCode status = NUM_STATUS_CODES;
 
   // While the retry cap event isn't reached keep retrying.
   while (e.id != CHAOS_EVENT_RELAY_ERROR) {
     // Grab a valid event.
-    do {
-      status = event_process(&e);
-    } while (status != STATUS_CODE_OK);
+    MS_TEST_HELPER_AWAIT_EVENT(e);
 
     // Handle CAN message
     if (e.id == CHAOS_EVENT_CAN_RX || e.id == CHAOS_EVENT_CAN_TX || e.id == CHAOS_EVENT_CAN_FAULT) {
@@ -223,12 +218,9 @@ void test_relay_concurrent(void) {
   TEST_ASSERT_OK(relay_fsm_close_event(RELAY_ID_BATTERY_SLAVE, &e));
   TEST_ASSERT_TRUE(relay_process_event(&e));
 
-  StatusCode status = NUM_STATUS_CODES;
 
   while (!(e.id == CHAOS_EVENT_RELAY_CLOSED && e.data == RELAY_ID_BATTERY_SLAVE)) {
-    do {
-      status = event_process(&e);
-    } while (status != STATUS_CODE_OK);
+    MS_TEST_HELPER_AWAIT_EVENT(e);
     if (e.id == CHAOS_EVENT_CAN_RX || e.id == CHAOS_EVENT_CAN_TX || e.id == CHAOS_EVENT_CAN_FAULT) {
       TEST_ASSERT_TRUE(can_process_event(&e));
     } else {
@@ -239,9 +231,7 @@ void test_relay_concurrent(void) {
   TEST_ASSERT_TRUE(relay_process_event(&e));
 
   while (!(e.id == CHAOS_EVENT_RELAY_CLOSED && e.data == RELAY_ID_BATTERY_MAIN)) {
-    do {
-      status = event_process(&e);
-    } while (status != STATUS_CODE_OK);
+    MS_TEST_HELPER_AWAIT_EVENT(e);
     if (e.id == CHAOS_EVENT_CAN_RX || e.id == CHAOS_EVENT_CAN_TX || e.id == CHAOS_EVENT_CAN_FAULT) {
       TEST_ASSERT_TRUE(can_process_event(&e));
     } else {
@@ -254,9 +244,7 @@ void test_relay_concurrent(void) {
   TEST_ASSERT_TRUE(relay_process_event(&e));
 
   while (!(e.id == CHAOS_EVENT_RELAY_CLOSED && e.data == RELAY_ID_MOTORS)) {
-    do {
-      status = event_process(&e);
-    } while (status != STATUS_CODE_OK);
+    MS_TEST_HELPER_AWAIT_EVENT(e);
     if (e.id == CHAOS_EVENT_CAN_RX || e.id == CHAOS_EVENT_CAN_TX || e.id == CHAOS_EVENT_CAN_FAULT) {
       TEST_ASSERT_TRUE(can_process_event(&e));
     } else {
@@ -269,9 +257,7 @@ void test_relay_concurrent(void) {
   TEST_ASSERT_TRUE(relay_process_event(&e));
 
   while (!(e.id == CHAOS_EVENT_RELAY_OPENED && e.data == RELAY_ID_MOTORS)) {
-    do {
-      status = event_process(&e);
-    } while (status != STATUS_CODE_OK);
+    MS_TEST_HELPER_AWAIT_EVENT(e);
     if (e.id == CHAOS_EVENT_CAN_RX || e.id == CHAOS_EVENT_CAN_TX || e.id == CHAOS_EVENT_CAN_FAULT) {
       TEST_ASSERT_TRUE(can_process_event(&e));
     } else {
@@ -284,9 +270,7 @@ void test_relay_concurrent(void) {
   TEST_ASSERT_TRUE(relay_process_event(&e));
 
   while (!(e.id == CHAOS_EVENT_RELAY_OPENED && e.data == RELAY_ID_BATTERY_MAIN)) {
-    do {
-      status = event_process(&e);
-    } while (status != STATUS_CODE_OK);
+    MS_TEST_HELPER_AWAIT_EVENT(e);
     if (e.id == CHAOS_EVENT_CAN_RX || e.id == CHAOS_EVENT_CAN_TX || e.id == CHAOS_EVENT_CAN_FAULT) {
       TEST_ASSERT_TRUE(can_process_event(&e));
     } else {
@@ -297,9 +281,7 @@ void test_relay_concurrent(void) {
   TEST_ASSERT_TRUE(relay_process_event(&e));
 
   while (!(e.id == CHAOS_EVENT_RELAY_OPENED && e.data == RELAY_ID_BATTERY_SLAVE)) {
-    do {
-      status = event_process(&e);
-    } while (status != STATUS_CODE_OK);
+    MS_TEST_HELPER_AWAIT_EVENT(e);
     if (e.id == CHAOS_EVENT_CAN_RX || e.id == CHAOS_EVENT_CAN_TX || e.id == CHAOS_EVENT_CAN_FAULT) {
       TEST_ASSERT_TRUE(can_process_event(&e));
     } else {
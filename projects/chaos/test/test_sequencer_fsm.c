@@ -8,6 +8,7 @@
 #include "log.h"
 #include "soft_timer.h"
 #include "test_helpers.h"
+#include "wait.h"
 
 static void prv_handle_awaiting(const Event *prev_event, Event *present_event) {
   if (prev_event->id == CHAOS_EVENT_CLOSE_RELAY) {
@@ -223,6 +224,8 @@ void test_sequencer_fsm_interrupted_awaiting(void) {
   StatusCode event_status = STATUS_CODE_OK;
   while (seq_status != STATUS_CODE_RESOURCE_EXHAUSTED) {
     TEST_ASSERT_OK(seq_status);
+    // Give the delayed event's timer a chance to run
+    wait();
     event_status = event_process(&present_event);
     if (event_status != STATUS_CODE_OK) {
       prv_handle_awaiting(&prev_event, &present_event);
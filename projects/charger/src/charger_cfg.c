@@ -4,6 +4,7 @@
 
 #include "can.h"
 #include "can_msg_defs.h"
+#include "can_msg_schema.h"
 #include "charger_controller.h"
 #include "charger_events.h"
 #include "generic_can_network.h"
@@ -24,6 +25,7 @@ static CanSettings s_can_settings = {
 };
 
 CanSettings *charger_cfg_load_can_settings(void) {
+  s_can_settings.msg_schema = can_msg_schema_get();
   return &s_can_settings;
 }
 
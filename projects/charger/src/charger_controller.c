@@ -6,7 +6,8 @@
 #include <string.h>
 
 #include "can_interval.h"
-#include "can_transmit.h"
+#include "can_pack.h"
+#include "can_publish.h"
 #include "charger_can.h"
 #include "charger_events.h"
 #include "event_queue.h"
@@ -20,9 +21,13 @@
 #define CHARGER_EXPECTED_RX_DLC 8
 #define CHARGER_EXPECTED_TX_DLC 8
 
+// The charger broadcasts every second, so only forward changes and a heartbeat to the car
+#define CHARGER_INFO_MAX_SILENCE_MS 5000
+
 static ChargerStorage *s_storage;
 static CanInterval *s_interval;
 static ChargerCanStatus *s_charger_status;
+static CanPublishStorage s_info_publish;
 
 // Explicit for readability.
 static const ChargerCanJ1939Id s_rx_id = {
@@ -51,8 +56,10 @@ static void prv_rx_handler(const GenericCanMsg *msg, void *context) {
     .raw_data = msg->data,
   };
   *s_charger_status = data.data_impl.status_flags;
-  CAN_TRANSMIT_CHARGER_INFO(SWAP_UINT16(data.data_impl.current),
-                            SWAP_UINT16(data.data_impl.voltage), data.data_impl.status_flags.raw);
+  CanMessage info = { 0 };
+  CAN_PACK_CHARGER_INFO(&info, SWAP_UINT16(data.data_impl.current),
+                        SWAP_UINT16(data.data_impl.voltage), data.data_impl.status_flags.raw);
+  can_publish(&s_info_publish, &info);
 
   // Check for statuses
   if (!charger_controller_is_safe()) {
@@ -79,6 +86,14 @@ StatusCode charger_controller_init(ChargerStorage *storage, const ChargerSetting
   };
   status_ok_or_return(gpio_init_pin(&settings->relay_control_pin, &gpio_settings));
 
+  // Status flags are bits, so any change is sent
+  const CanPublishSettings publish_settings = {
+    .field_size = sizeof(uint16_t),
+    .deadband = 0,
+    .max_silence_ms = CHARGER_INFO_MAX_SILENCE_MS,
+  };
+  status_ok_or_return(can_publish_init(&s_info_publish, &publish_settings));
+
   const ChargerCanTxData tx_data = { .data_impl = {
                                          .max_voltage = settings->max_voltage,
                                          .max_current = settings->max_current,
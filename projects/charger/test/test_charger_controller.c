@@ -14,6 +14,7 @@
 #include "soft_timer.h"
 #include "test_helpers.h"
 #include "unity.h"
+#include "wait.h"
 
 #define TEST_CHARGER_CAN_DELAY_MS 250
 
@@ -117,6 +118,7 @@ void test_charger_controller(void) {
   TEST_ASSERT_OK(charger_controller_set_state(CHARGER_STATE_START));
   // Let the callback trigger
   while (!s_received) {
+    wait();
   }
 
   // Send a bad status (auto stop)
@@ -141,9 +143,11 @@ void test_charger_controller(void) {
   TEST_ASSERT_OK(charger_controller_set_state(CHARGER_STATE_START));
   // Let the callback trigger twice
   while (!s_received) {
+    wait();
   }
   s_received = false;
   while (!s_received) {
+    wait();
   }
 
   TEST_ASSERT_EQUAL(3, s_counter);
@@ -207,6 +211,7 @@ void test_charger_controller_off(void) {
   TEST_ASSERT_OK(charger_controller_set_state(CHARGER_STATE_STOP));
   // Let the callback trigger
   while (!s_received) {
+    wait();
   }
 
   // Start the charger
@@ -215,6 +220,7 @@ void test_charger_controller_off(void) {
   TEST_ASSERT_OK(charger_controller_set_state(CHARGER_STATE_START));
   // Let the callback trigger
   while (!s_received) {
+    wait();
   }
 
   // Turn off the charger
@@ -223,6 +229,7 @@ void test_charger_controller_off(void) {
   TEST_ASSERT_OK(charger_controller_set_state(CHARGER_STATE_OFF));
   // Let the callback trigger
   while (!s_received) {
+    wait();
   }
 
   // Delay until sending is validated to stop (sends every second).
@@ -66,7 +66,6 @@ void test_notify(void) {
                              TEST_NOTIFY_WATCHDOG_PERIOD_S));
 
   Event e = { 0, 0 };
-  StatusCode status = NUM_STATUS_CODES;
 
   // Charge
   s_response = EE_CHARGER_SET_RELAY_STATE_CLOSE;
@@ -90,9 +89,7 @@ void test_notify(void) {
   s_response = NUM_EE_CHARGER_SET_RELAY_STATES;
   e.id = UINT16_MAX;
   while (e.id != CHARGER_EVENT_STOP_CHARGING) {
-    do {
-      status = event_process(&e);
-    } while (status != STATUS_CODE_OK);
+    MS_TEST_HELPER_AWAIT_EVENT(e);
     if (e.id == CHARGER_EVENT_CAN_RX || e.id == CHARGER_EVENT_CAN_TX) {
       TEST_ASSERT_TRUE(can_process_event(&e));
     }
@@ -6,7 +6,7 @@
 # $(T)_SRC: $(T)_DIR/src{/$(PLATFORM)}/*.{c,s}
 
 # Specify the libraries you want to include
-$(T)_DEPS := ms-common codegen-tooling
+$(T)_DEPS := ms-common ms-helper codegen-tooling
 
 ifeq (x86,$(PLATFORM))
 $(T)_EXCLUDE_TESTS := \
@@ -74,7 +74,5 @@ StatusCode button_led_fsm_create(Fsm *fsm, GpioExpanderStorage *expander_storage
   status_ok_or_return(gpio_expander_init_pin(expander_storage, pin, &output_settings));
 
   // Start in the off state
-  fsm_init(fsm, fsm_name, &button_led_off, &s_fsm_ctxs[button_id]);
-
-  return STATUS_CODE_OK;
+  return fsm_init(fsm, fsm_name, &button_led_off, &s_fsm_ctxs[button_id]);
 }
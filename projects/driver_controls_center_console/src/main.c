@@ -19,6 +19,7 @@
 
 #include "can.h"
 #include "can_msg_defs.h"
+#include "can_msg_schema.h"
 #include "can_transmit.h"
 #include "can_unpack.h"
 
@@ -62,6 +63,7 @@ int main() {
     .fault_event = CENTER_CONSOLE_EVENT_CAN_FAULT,
     .tx = CENTER_CONSOLE_CONFIG_PIN_CAN_TX,
     .rx = CENTER_CONSOLE_CONFIG_PIN_CAN_RX,
+    .msg_schema = can_msg_schema_get(),
   };
   can_init(&s_can_storage, &can_settings);
 
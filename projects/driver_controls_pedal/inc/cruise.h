@@ -12,10 +12,14 @@
 //   * INPUT_EVENT_CONTROL_STALK_ANALOG_CC_SPEED_MINUS:
 //      offsets the target speed by -CRUISE_OFFSET_CMS
 //
+// The target is only sent over CAN when it changes, or at least every CRUISE_PUBLISH_MAX_SILENCE_MS
+// while it's being updated.
+//
 // Requires CAN to be initialized
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "can_publish.h"
 #include "event_queue.h"
 #include "soft_timer.h"
 #include "status.h"
@@ -26,12 +30,15 @@
 // Arbitrary maximum of ~113 km/h for safety
 #define CRUISE_MAX_TARGET_CMS 3150
 
+#define CRUISE_PUBLISH_MAX_SILENCE_MS 1000
+
 typedef struct CruiseStorage {
   volatile int16_t target_speed_cms;   // m/s * 100
   volatile int16_t current_speed_cms;  // From motor controllers
   int16_t offset_cms;
   SoftTimerId repeat_timer;  // Repeats offset while increment/decrement is held
   size_t repeat_counter;
+  CanPublishStorage publish;
 } CruiseStorage;
 
 // Registers a CAN handler for motor controller speed
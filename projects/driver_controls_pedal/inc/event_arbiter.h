@@ -6,6 +6,10 @@
 // the current states of all active FSMs to determine whether it will be processed or
 // discarded. This is to prevent situations like processing a gear shift while the brake is
 // not pressed, which would be dangerous for the driver.
+//
+// Events are then only passed to the FSMs that have a transition for that event ID in a state
+// reachable from their default state. The subscribers of each event ID are found the first time
+// an event is processed after an FSM is added, so all FSMs must be initialized by then.
 
 #include "fsm.h"
 #include "objpool.h"
@@ -13,6 +17,8 @@
 
 // Arbitrary FSM cap
 #define EVENT_ARBITER_MAX_FSMS 10
+// Distinct event IDs with subscribers - any past this are sent to every FSM
+#define EVENT_ARBITER_MAX_EVENTS 64
 
 // Returns whether the given event should be processed by any FSMs
 typedef bool (*EventArbiterGuardFn)(const Event *e);
@@ -22,9 +28,22 @@ typedef struct EventArbiterGuard {
   EventArbiterGuardFn guard_fn;
 } EventArbiterGuard;
 
+// Bit n is set if the nth FSM has a transition for the event
+typedef struct EventArbiterSubscription {
+  EventId event_id;
+  uint16_t fsms;
+} EventArbiterSubscription;
+
 typedef struct EventArbiterStorage {
   size_t num_registered_arbiters;
   EventArbiterGuard arbiters[EVENT_ARBITER_MAX_FSMS];
+
+  // Sorted by event ID
+  EventArbiterSubscription subscriptions[EVENT_ARBITER_MAX_EVENTS];
+  size_t num_subscriptions;
+  // FSMs that didn't fit in the subscriptions receive every event
+  uint16_t catch_all_fsms;
+  bool subscriptions_valid;
 } EventArbiterStorage;
 
 // Initializes the event arbiter to the default state with a given output function
@@ -38,4 +57,4 @@ EventArbiterGuard *event_arbiter_add_fsm(EventArbiterStorage *storage, Fsm *fsm,
 StatusCode event_arbiter_set_guard_fn(EventArbiterGuard *guard, EventArbiterGuardFn guard_fn);
 
 // Process an event if allowed by the registered arbiters
-bool event_arbiter_process_event(const EventArbiterStorage *storage, const Event *e);
+bool event_arbiter_process_event(EventArbiterStorage *storage, const Event *e);
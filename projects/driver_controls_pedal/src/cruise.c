@@ -2,7 +2,7 @@
 
 #include "can.h"
 #include "can_msg_defs.h"
-#include "can_transmit.h"
+#include "can_pack.h"
 #include "can_unpack.h"
 #include "log.h"
 #include "misc.h"
@@ -52,6 +52,13 @@ StatusCode cruise_init(CruiseStorage *cruise) {
   cruise->repeat_counter = 0;
   cruise->repeat_timer = SOFT_TIMER_INVALID_TIMER;
 
+  const CanPublishSettings publish_settings = {
+    .field_size = sizeof(uint8_t),
+    .deadband = 0,
+    .max_silence_ms = CRUISE_PUBLISH_MAX_SILENCE_MS,
+  };
+  status_ok_or_return(can_publish_init(&cruise->publish, &publish_settings));
+
   can_register_rx_handler(SYSTEM_CAN_MESSAGE_MOTOR_VELOCITY, prv_handle_motor_velocity, cruise);
 
   return STATUS_CODE_OK;
@@ -66,7 +73,9 @@ StatusCode cruise_set_target_cms(CruiseStorage *cruise, int16_t target) {
   cruise->target_speed_cms = MAX(0, cruise->target_speed_cms);
   cruise->target_speed_cms = MIN(CRUISE_MAX_TARGET_CMS, cruise->target_speed_cms);
 
-  return CAN_TRANSMIT_CRUISE_TARGET(cruise->target_speed_cms);
+  CanMessage msg = { 0 };
+  CAN_PACK_CRUISE_TARGET(&msg, cruise->target_speed_cms);
+  return can_publish(&cruise->publish, &msg);
 }
 
 int16_t cruise_get_target_cms(CruiseStorage *cruise) {
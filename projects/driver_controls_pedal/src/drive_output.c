@@ -47,9 +47,6 @@ static void prv_watchdog_cb(SoftTimerId timer_id, void *context) {
 
   // Reset watchdog
   storage->watchdog = 0;
-
-  soft_timer_start_millis(DRIVE_OUTPUT_WATCHDOG_MS, prv_watchdog_cb, context,
-                          &storage->watchdog_timer);
 }
 
 static void prv_broadcast_cb(SoftTimerId timer_id, void *context) {
@@ -71,9 +68,6 @@ static void prv_broadcast_cb(SoftTimerId timer_id, void *context) {
                             (uint16_t)storage->data[DRIVE_OUTPUT_SOURCE_MECH_BRAKE]);
 
   debug_led_toggle_state(DEBUG_LED_BLUE_A);
-
-  soft_timer_start_millis(DRIVE_OUTPUT_BROADCAST_MS, prv_broadcast_cb, context,
-                          &storage->output_timer);
 }
 
 StatusCode drive_output_init(DriveOutputStorage *storage, EventId fault_event,
@@ -98,12 +92,12 @@ StatusCode drive_output_set_enabled(DriveOutputStorage *storage, bool enabled) {
     // Reset watchdog
     storage->watchdog = 0;
 
-    StatusCode ret = soft_timer_start_millis(DRIVE_OUTPUT_WATCHDOG_MS, prv_watchdog_cb, storage,
-                                             &storage->watchdog_timer);
+    StatusCode ret = soft_timer_start_periodic_millis(DRIVE_OUTPUT_WATCHDOG_MS, prv_watchdog_cb,
+                                                      storage, &storage->watchdog_timer);
     status_ok_or_return(ret);
 
-    return soft_timer_start_millis(DRIVE_OUTPUT_BROADCAST_MS, prv_broadcast_cb, storage,
-                                   &storage->output_timer);
+    return soft_timer_start_periodic_millis(DRIVE_OUTPUT_BROADCAST_MS, prv_broadcast_cb, storage,
+                                            &storage->output_timer);
   } else {
     storage->watchdog_timer = SOFT_TIMER_INVALID_TIMER;
     storage->output_timer = SOFT_TIMER_INVALID_TIMER;
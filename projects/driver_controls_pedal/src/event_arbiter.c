@@ -4,8 +4,86 @@
 
 #include "log.h"
 
+_Static_assert(EVENT_ARBITER_MAX_FSMS <= 16, "FSM subscriber masks must fit in a uint16_t");
+
+typedef struct EventArbiterSubscribeCtx {
+  EventArbiterStorage *storage;
+  uint16_t fsm_bit;
+} EventArbiterSubscribeCtx;
+
+// Returns the index of the first subscription with an event ID >= |event_id|
+static size_t prv_find_subscription(const EventArbiterStorage *storage, EventId event_id) {
+  size_t low = 0;
+  size_t high = storage->num_subscriptions;
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    if (storage->subscriptions[mid].event_id < event_id) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+
+  return low;
+}
+
+static void prv_subscribe(const FsmTransition *transition, void *context) {
+  EventArbiterSubscribeCtx *ctx = context;
+  EventArbiterStorage *storage = ctx->storage;
+
+  size_t index = prv_find_subscription(storage, transition->event_id);
+  if (index < storage->num_subscriptions &&
+      storage->subscriptions[index].event_id == transition->event_id) {
+    storage->subscriptions[index].fsms |= ctx->fsm_bit;
+    return;
+  }
+
+  if (storage->num_subscriptions >= EVENT_ARBITER_MAX_EVENTS) {
+    storage->catch_all_fsms |= ctx->fsm_bit;
+    return;
+  }
+
+  for (size_t i = storage->num_subscriptions; i > index; i--) {
+    storage->subscriptions[i] = storage->subscriptions[i - 1];
+  }
+  storage->subscriptions[index] = (EventArbiterSubscription){
+    .event_id = transition->event_id,  //
+    .fsms = ctx->fsm_bit,              //
+  };
+  storage->num_subscriptions++;
+}
+
+static void prv_build_subscriptions(EventArbiterStorage *storage) {
+  storage->num_subscriptions = 0;
+  storage->catch_all_fsms = 0;
+
+  for (size_t i = 0; i < storage->num_registered_arbiters; i++) {
+    EventArbiterSubscribeCtx ctx = {
+      .storage = storage,              //
+      .fsm_bit = (uint16_t)(1u << i),  //
+    };
+
+    Fsm *fsm = storage->arbiters[i].fsm;
+    if (fsm->current_state == NULL) {
+      LOG_WARN("Event arbiter: FSM %u is not initialized\n", (unsigned int)i);
+      storage->catch_all_fsms |= ctx.fsm_bit;
+      continue;
+    }
+    fsm_for_each_transition(fsm, prv_subscribe, &ctx);
+  }
+
+  if (storage->catch_all_fsms != 0) {
+    LOG_WARN("Event arbiter: Ran out of subscriptions\n");
+  }
+
+  storage->subscriptions_valid = true;
+}
+
 StatusCode event_arbiter_init(EventArbiterStorage *storage) {
   storage->num_registered_arbiters = 0;
+  storage->num_subscriptions = 0;
+  storage->catch_all_fsms = 0;
+  storage->subscriptions_valid = false;
 
   return STATUS_CODE_OK;
 }
@@ -20,6 +98,7 @@ EventArbiterGuard *event_arbiter_add_fsm(EventArbiterStorage *storage, Fsm *fsm,
 
   arbiter->fsm = fsm;
   arbiter->guard_fn = guard_fn;
+  storage->subscriptions_valid = false;
 
   return arbiter;
 }
@@ -30,7 +109,7 @@ StatusCode event_arbiter_set_guard_fn(EventArbiterGuard *arbiter, EventArbiterGu
   return STATUS_CODE_OK;
 }
 
-bool event_arbiter_process_event(const EventArbiterStorage *storage, const Event *e) {
+bool event_arbiter_process_event(EventArbiterStorage *storage, const Event *e) {
   // Check if any of the arbiters block this event
   for (size_t i = 0; i < storage->num_registered_arbiters; i++) {
     if (storage->arbiters[i].guard_fn != NULL && !storage->arbiters[i].guard_fn(e)) {
@@ -38,10 +117,22 @@ bool event_arbiter_process_event(const EventArbiterStorage *storage, const Event
     }
   }
 
+  if (!storage->subscriptions_valid) {
+    prv_build_subscriptions(storage);
+  }
+
+  uint16_t fsms = storage->catch_all_fsms;
+  size_t index = prv_find_subscription(storage, e->id);
+  if (index < storage->num_subscriptions && storage->subscriptions[index].event_id == e->id) {
+    fsms |= storage->subscriptions[index].fsms;
+  }
+
   bool transitioned = false;
   // We didn't get blocked by any of the arbiters - process the event
-  for (size_t i = 0; i < storage->num_registered_arbiters; i++) {
-    transitioned |= fsm_process_event(storage->arbiters[i].fsm, e);
+  for (size_t i = 0; fsms != 0; i++, fsms >>= 1) {
+    if (fsms & 1) {
+      transitioned |= fsm_process_event(storage->arbiters[i].fsm, e);
+    }
   }
 
   return transitioned;
@@ -86,7 +86,5 @@ StatusCode cruise_fsm_init(Fsm *fsm, EventArbiterStorage *storage) {
     return status_code(STATUS_CODE_RESOURCE_EXHAUSTED);
   }
 
-  fsm_init(fsm, "Cruise FSM", &cruise_off, guard);
-
-  return STATUS_CODE_OK;
+  return fsm_init(fsm, "Cruise FSM", &cruise_off, guard);
 }
@@ -101,7 +101,5 @@ StatusCode direction_fsm_init(Fsm *fsm, EventArbiterStorage *storage) {
     return status_code(STATUS_CODE_RESOURCE_EXHAUSTED);
   }
 
-  fsm_init(fsm, "Direction FSM", &state_neutral, guard);
-
-  return STATUS_CODE_OK;
+  return fsm_init(fsm, "Direction FSM", &state_neutral, guard);
 }
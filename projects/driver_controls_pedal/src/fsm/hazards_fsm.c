@@ -40,7 +40,5 @@ StatusCode hazards_fsm_init(Fsm *fsm, EventArbiterStorage *storage) {
     return status_code(STATUS_CODE_RESOURCE_EXHAUSTED);
   }
 
-  fsm_init(fsm, "Hazard Light FSM", &state_hazard_off, guard);
-
-  return STATUS_CODE_OK;
+  return fsm_init(fsm, "Hazard Light FSM", &state_hazard_off, guard);
 }
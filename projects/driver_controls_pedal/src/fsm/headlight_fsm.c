@@ -108,7 +108,5 @@ StatusCode headlight_fsm_init(Fsm *fsm, EventArbiterStorage *storage) {
     return status_code(STATUS_CODE_RESOURCE_EXHAUSTED);
   }
 
-  fsm_init(fsm, "Headlight FSM", &headlight_off, guard);
-
-  return STATUS_CODE_OK;
+  return fsm_init(fsm, "Headlight FSM", &headlight_off, guard);
 }
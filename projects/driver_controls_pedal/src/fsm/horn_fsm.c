@@ -42,7 +42,5 @@ StatusCode horn_fsm_init(Fsm *fsm, EventArbiterStorage *storage) {
     return status_code(STATUS_CODE_RESOURCE_EXHAUSTED);
   }
 
-  fsm_init(fsm, "Horn FSM", &state_horn_off, guard);
-
-  return STATUS_CODE_OK;
+  return fsm_init(fsm, "Horn FSM", &state_horn_off, guard);
 }
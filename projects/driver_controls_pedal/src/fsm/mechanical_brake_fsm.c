@@ -86,7 +86,5 @@ StatusCode mechanical_brake_fsm_init(Fsm *fsm, EventArbiterStorage *storage) {
     return status_code(STATUS_CODE_RESOURCE_EXHAUSTED);
   }
 
-  fsm_init(fsm, "Mechanical Brake FSM", &state_disengaged, guard);
-
-  return STATUS_CODE_OK;
+  return fsm_init(fsm, "Mechanical Brake FSM", &state_disengaged, guard);
 }
@@ -103,7 +103,5 @@ StatusCode pedal_fsm_init(Fsm *fsm, EventArbiterStorage *storage) {
     return status_code(STATUS_CODE_RESOURCE_EXHAUSTED);
   }
 
-  fsm_init(fsm, "Pedal FSM", &state_brake, guard);
-
-  return STATUS_CODE_OK;
+  return fsm_init(fsm, "Pedal FSM", &state_brake, guard);
 }
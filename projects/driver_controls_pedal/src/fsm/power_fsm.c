@@ -157,7 +157,5 @@ StatusCode power_fsm_init(Fsm *fsm, EventArbiterStorage *storage) {
     return status_code(STATUS_CODE_RESOURCE_EXHAUSTED);
   }
 
-  fsm_init(fsm, "Power FSM", &state_off, guard);
-
-  return STATUS_CODE_OK;
+  return fsm_init(fsm, "Power FSM", &state_off, guard);
 }
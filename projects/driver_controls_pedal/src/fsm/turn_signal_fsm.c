@@ -59,7 +59,5 @@ StatusCode turn_signal_fsm_init(Fsm *fsm, EventArbiterStorage *storage) {
     return status_code(STATUS_CODE_RESOURCE_EXHAUSTED);
   }
 
-  fsm_init(fsm, "Turn Signal FSM", &state_no_signal, guard);
-
-  return STATUS_CODE_OK;
+  return fsm_init(fsm, "Turn Signal FSM", &state_no_signal, guard);
 }
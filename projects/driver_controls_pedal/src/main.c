@@ -12,6 +12,7 @@
 
 #include "can.h"
 #include "can_msg_defs.h"
+#include "can_msg_schema.h"
 #include "can_unpack.h"
 
 #include "ads1015.h"
@@ -36,6 +37,9 @@
 #include "fsm/power_fsm.h"
 #include "fsm/turn_signal_fsm.h"
 
+// Max events handled per pass of the main loop, i.e. a burst of CAN RX events
+#define DRIVER_CONTROLS_EVENT_BATCH_SIZE 8
+
 typedef StatusCode (*DriverControlsFsmInitFn)(Fsm *fsm, EventArbiterStorage *storage);
 
 typedef enum {
@@ -152,6 +156,16 @@ int main() {
   soft_timer_init();
   event_queue_init();
 
+  // Throttle zones and speed updates are raised periodically and only the latest one matters
+  const EventId pedal_events[] = {
+    PEDAL_EVENT_INPUT_PEDAL_BRAKE,  //
+    PEDAL_EVENT_INPUT_PEDAL_COAST,  //
+    PEDAL_EVENT_INPUT_PEDAL_ACCEL,  //
+  };
+  const EventId speed_events[] = { PEDAL_EVENT_INPUT_SPEED_UPDATE };
+  status_ok_or_return(event_queue_add_coalesce_group(pedal_events, SIZEOF_ARRAY(pedal_events)));
+  status_ok_or_return(event_queue_add_coalesce_group(speed_events, SIZEOF_ARRAY(speed_events)));
+
   // CAN initialization
   const CanSettings can_settings = {
     .device_id = SYSTEM_CAN_DEVICE_DRIVER_CONTROLS_PEDAL,
@@ -161,6 +175,7 @@ int main() {
     .fault_event = PEDAL_EVENT_CAN_FAULT,
     .tx = { GPIO_PORT_A, 12 },
     .rx = { GPIO_PORT_A, 11 },
+    .msg_schema = can_msg_schema_get(),
   };
   status_ok_or_return(can_init(&s_can_storage, &can_settings));
 
@@ -223,16 +238,17 @@ int main() {
   // TODO(ELEC-617): Allocate a CAN message or provide a way to disable regen
   // braking behaviour, instead of relying on the #define in Pedal Flags.
 
-  StatusCode status = NUM_STATUS_CODES;
-  Event e = { 0 };
+  Event events[DRIVER_CONTROLS_EVENT_BATCH_SIZE] = { 0 };
   while (true) {
-    if (status_ok(event_process(&e))) {
-      can_process_event(&e);
+    size_t num_events = event_process_batch(events, SIZEOF_ARRAY(events));
+    for (size_t i = 0; i < num_events; i++) {
+      const Event *e = &events[i];
+      can_process_event(e);
 
-      event_arbiter_process_event(&s_event_arbiter, &e);
+      event_arbiter_process_event(&s_event_arbiter, e);
 
-      brake_signal_process_event(&e);
-      cruise_handle_event(cruise_global(), &e);
+      brake_signal_process_event(e);
+      cruise_handle_event(cruise_global(), e);
     }
   }
 
@@ -133,8 +133,6 @@ static void prv_raise_event_timer_callback(SoftTimerId timer_id, void *context)
     storage->position.zone = NUM_THROTTLE_ZONES;
     event_raise(PEDAL_EVENT_INPUT_PEDAL_FAULT, 0);
   }
-
-  soft_timer_start_millis(THROTTLE_UPDATE_PERIOD_MS, prv_raise_event_timer_callback, context, NULL);
 }
 
 // Initializes the throttle by configuring the ADS1015 channels and
@@ -163,8 +161,8 @@ StatusCode throttle_init(ThrottleStorage *storage, ThrottleCalibrationData *cali
 
   storage->pedal_ads1015_storage = pedal_ads1015_storage;
 
-  return soft_timer_start_millis(THROTTLE_UPDATE_PERIOD_MS, prv_raise_event_timer_callback, storage,
-                                 NULL);
+  return soft_timer_start_periodic_millis(THROTTLE_UPDATE_PERIOD_MS, prv_raise_event_timer_callback,
+                                          storage, NULL);
 }
 
 // Gets the current position of the pedal (writes to position).
@@ -0,0 +1,130 @@
+#include "event_arbiter.h"
+
+#include <stdbool.h>
+
+#include "fsm.h"
+#include "test_helpers.h"
+#include "unity.h"
+
+typedef enum {
+  TEST_EVENT_ARBITER_EVENT_A = 0,
+  TEST_EVENT_ARBITER_EVENT_B,
+  TEST_EVENT_ARBITER_EVENT_C,
+  TEST_EVENT_ARBITER_EVENT_D,
+} TestEventArbiterEvent;
+
+static EventArbiterStorage s_arbiter;
+static Fsm s_fsm_x;
+static Fsm s_fsm_y;
+static Fsm s_fsm_z;
+
+// X: off <-> on with A, C is only handled once on
+FSM_DECLARE_STATE(state_x_off);
+FSM_DECLARE_STATE(state_x_on);
+// Y: idle <-> busy with B and C
+FSM_DECLARE_STATE(state_y_idle);
+FSM_DECLARE_STATE(state_y_busy);
+
+FSM_STATE_TRANSITION(state_x_off) {
+  FSM_ADD_TRANSITION(TEST_EVENT_ARBITER_EVENT_A, state_x_on);
+}
+
+FSM_STATE_TRANSITION(state_x_on) {
+  FSM_ADD_TRANSITION(TEST_EVENT_ARBITER_EVENT_A, state_x_off);
+  FSM_ADD_TRANSITION(TEST_EVENT_ARBITER_EVENT_C, state_x_on);
+}
+
+FSM_STATE_TRANSITION(state_y_idle) {
+  FSM_ADD_TRANSITION(TEST_EVENT_ARBITER_EVENT_B, state_y_busy);
+}
+
+FSM_STATE_TRANSITION(state_y_busy) {
+  FSM_ADD_TRANSITION(TEST_EVENT_ARBITER_EVENT_C, state_y_idle);
+}
+
+// Blocks B
+static bool prv_guard_block_b(const Event *e) {
+  return e->id != TEST_EVENT_ARBITER_EVENT_B;
+}
+
+static uint16_t prv_subscribers(EventId event_id) {
+  for (size_t i = 0; i < s_arbiter.num_subscriptions; i++) {
+    if (s_arbiter.subscriptions[i].event_id == event_id) {
+      return s_arbiter.subscriptions[i].fsms;
+    }
+  }
+
+  return 0;
+}
+
+void setup_test(void) {
+  event_arbiter_init(&s_arbiter);
+  TEST_ASSERT_NOT_NULL(event_arbiter_add_fsm(&s_arbiter, &s_fsm_x, NULL));
+  TEST_ASSERT_NOT_NULL(event_arbiter_add_fsm(&s_arbiter, &s_fsm_y, NULL));
+
+  // FSMs are added to the arbiter before they're initialized
+  fsm_init(&s_fsm_x, "X", &state_x_off, NULL);
+  fsm_init(&s_fsm_y, "Y", &state_y_idle, NULL);
+}
+
+void teardown_test(void) {}
+
+void test_event_arbiter_subscriptions(void) {
+  Event e = { .id = TEST_EVENT_ARBITER_EVENT_D };
+  TEST_ASSERT_FALSE(event_arbiter_process_event(&s_arbiter, &e));
+
+  // Subscriptions cover every reachable state, not just the current one
+  TEST_ASSERT_TRUE(s_arbiter.subscriptions_valid);
+  TEST_ASSERT_EQUAL(3, s_arbiter.num_subscriptions);
+  TEST_ASSERT_EQUAL(0x1, prv_subscribers(TEST_EVENT_ARBITER_EVENT_A));
+  TEST_ASSERT_EQUAL(0x2, prv_subscribers(TEST_EVENT_ARBITER_EVENT_B));
+  TEST_ASSERT_EQUAL(0x3, prv_subscribers(TEST_EVENT_ARBITER_EVENT_C));
+  TEST_ASSERT_EQUAL(0, s_arbiter.catch_all_fsms);
+
+  // Sorted for the binary search
+  for (size_t i = 1; i < s_arbiter.num_subscriptions; i++) {
+    TEST_ASSERT_TRUE(s_arbiter.subscriptions[i - 1].event_id <
+                     s_arbiter.subscriptions[i].event_id);
+  }
+}
+
+void test_event_arbiter_process(void) {
+  Event e = { .id = TEST_EVENT_ARBITER_EVENT_A };
+  TEST_ASSERT_TRUE(event_arbiter_process_event(&s_arbiter, &e));
+  TEST_ASSERT_EQUAL_PTR(&state_x_on, s_fsm_x.current_state);
+  TEST_ASSERT_EQUAL_PTR(&state_y_idle, s_fsm_y.current_state);
+
+  e.id = TEST_EVENT_ARBITER_EVENT_B;
+  TEST_ASSERT_TRUE(event_arbiter_process_event(&s_arbiter, &e));
+  TEST_ASSERT_EQUAL_PTR(&state_y_busy, s_fsm_y.current_state);
+
+  // Both FSMs handle C
+  e.id = TEST_EVENT_ARBITER_EVENT_C;
+  TEST_ASSERT_TRUE(event_arbiter_process_event(&s_arbiter, &e));
+  TEST_ASSERT_EQUAL_PTR(&state_x_on, s_fsm_x.current_state);
+  TEST_ASSERT_EQUAL_PTR(&state_x_on, s_fsm_x.last_state);
+  TEST_ASSERT_EQUAL_PTR(&state_y_idle, s_fsm_y.current_state);
+
+  e.id = TEST_EVENT_ARBITER_EVENT_D;
+  TEST_ASSERT_FALSE(event_arbiter_process_event(&s_arbiter, &e));
+}
+
+void test_event_arbiter_guard(void) {
+  EventArbiterGuard *guard = event_arbiter_add_fsm(&s_arbiter, &s_fsm_z, prv_guard_block_b);
+  TEST_ASSERT_NOT_NULL(guard);
+  fsm_init(&s_fsm_z, "Z", &state_x_off, NULL);
+
+  // Adding an FSM rebuilds the subscriptions
+  Event e = { .id = TEST_EVENT_ARBITER_EVENT_A };
+  TEST_ASSERT_TRUE(event_arbiter_process_event(&s_arbiter, &e));
+  TEST_ASSERT_EQUAL(0x5, prv_subscribers(TEST_EVENT_ARBITER_EVENT_A));
+  TEST_ASSERT_EQUAL_PTR(&state_x_on, s_fsm_z.current_state);
+
+  e.id = TEST_EVENT_ARBITER_EVENT_B;
+  TEST_ASSERT_FALSE(event_arbiter_process_event(&s_arbiter, &e));
+  TEST_ASSERT_EQUAL_PTR(&state_y_idle, s_fsm_y.current_state);
+
+  TEST_ASSERT_OK(event_arbiter_set_guard_fn(guard, NULL));
+  TEST_ASSERT_TRUE(event_arbiter_process_event(&s_arbiter, &e));
+  TEST_ASSERT_EQUAL_PTR(&state_y_busy, s_fsm_y.current_state);
+}
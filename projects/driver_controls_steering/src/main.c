@@ -8,6 +8,7 @@
 
 #include "can.h"
 #include "can_msg_defs.h"
+#include "can_msg_schema.h"
 #include "can_transmit.h"
 
 #include "config.h"
@@ -40,6 +41,7 @@ int main() {
     .fault_event = STEERING_EVENT_CAN_FAULT,
     .tx = STEERING_CONFIG_PIN_CAN_TX,
     .rx = STEERING_CONFIG_PIN_CAN_RX,
+    .msg_schema = can_msg_schema_get(),
   };
   can_init(&s_can_storage, &can_settings);
 
@@ -101,8 +101,7 @@ StatusCode lights_signal_fsm_init(LightsSignalFsm *lights_signal_fsm,
   fsm_state_init(state_hazard_right_signal, prv_state_hazard_signal_output);
 
   status_ok_or_return(lights_blinker_init(&lights_signal_fsm->blinker, blinker_duration, count));
-  fsm_init(&lights_signal_fsm->fsm, "Lights Signal FSM", &state_none, lights_signal_fsm);
-  return STATUS_CODE_OK;
+  return fsm_init(&lights_signal_fsm->fsm, "Lights Signal FSM", &state_none, lights_signal_fsm);
 }
 
 StatusCode lights_signal_fsm_process_event(LightsSignalFsm *lights_signal_fsm, const Event *event) {
@@ -1,6 +1,7 @@
 #include <stdint.h>
 
 #include "can.h"
+#include "can_msg_schema.h"
 #include "gpio.h"
 #include "interrupt.h"
 #include "log.h"
@@ -38,6 +39,7 @@ int main(void) {
     .tx_event = LIGHTS_EVENT_CAN_TX,
     .fault_event = LIGHTS_EVENT_CAN_FAULT,
     .loopback = false,
+    .msg_schema = can_msg_schema_get(),
   };
 
   uint16_t device_id_lookup[NUM_LIGHTS_BOARD_TYPES] = {
@@ -1,6 +1,7 @@
 #include <stdlib.h>
 
 #include "interrupt.h"
+#include "ms_test_helpers.h"
 #include "soft_timer.h"
 #include "status.h"
 #include "test_helpers.h"
@@ -59,14 +60,12 @@ void test_lights_blinker_activate(void) {
   TEST_ASSERT_EQUAL(LIGHTS_EVENT_GPIO_PERIPHERAL_SIGNAL_LEFT, e.data);
 
   // Now we make sure blinker 1 timer goes off before blinker 2
-  while (event_process(&e) != STATUS_CODE_OK) {
-  }
+  MS_TEST_HELPER_AWAIT_EVENT(e);
   TEST_ASSERT_EQUAL(LIGHTS_EVENT_GPIO_OFF, e.id);
   TEST_ASSERT_EQUAL(LIGHTS_EVENT_GPIO_PERIPHERAL_SIGNAL_HAZARD, e.data);
 
   // Wait for the second blinker
-  while (event_process(&e) != STATUS_CODE_OK) {
-  }
+  MS_TEST_HELPER_AWAIT_EVENT(e);
   TEST_ASSERT_EQUAL(LIGHTS_EVENT_GPIO_OFF, e.id);
   TEST_ASSERT_EQUAL(LIGHTS_EVENT_GPIO_PERIPHERAL_SIGNAL_LEFT, e.data);
 }
@@ -198,8 +197,7 @@ void test_lights_blinker_force_on_while_deactivated(void) {
   TEST_ASSERT_EQUAL(LIGHTS_EVENT_GPIO_PERIPHERAL_SIGNAL_LEFT, e.data);
   TEST_ASSERT_EQUAL(LIGHTS_EVENT_GPIO_ON, e.id);
   // Wait for a full blink cycle.
-  while (event_process(&e) != STATUS_CODE_OK) {
-  }
+  MS_TEST_HELPER_AWAIT_EVENT(e);
   TEST_ASSERT_EQUAL(LIGHTS_EVENT_GPIO_PERIPHERAL_SIGNAL_LEFT, e.data);
   TEST_ASSERT_EQUAL(LIGHTS_EVENT_GPIO_OFF, e.id);
 
@@ -218,15 +216,12 @@ void test_lights_blinker_with_sync(void) {
   TEST_ASSERT_OK(event_process(&e));
   TEST_ASSERT_EQUAL(LIGHTS_EVENT_GPIO_ON, e.id);
   for (uint8_t i = 0; i < count; i++) {
-    while (event_process(&e) != STATUS_CODE_OK) {
-    }
+    MS_TEST_HELPER_AWAIT_EVENT(e);
     TEST_ASSERT_EQUAL(LIGHTS_EVENT_GPIO_OFF, e.id);
-    while (event_process(&e) != STATUS_CODE_OK) {
-    }
+    MS_TEST_HELPER_AWAIT_EVENT(e);
     TEST_ASSERT_EQUAL(LIGHTS_EVENT_GPIO_ON, e.id);
   }
-  while (event_process(&e) != STATUS_CODE_OK) {
-  }
+  MS_TEST_HELPER_AWAIT_EVENT(e);
   // Expect the sync event to have been raised.
   TEST_ASSERT_EQUAL(LIGHTS_EVENT_SYNC_TX, e.id);
 }
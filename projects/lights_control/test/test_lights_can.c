@@ -46,24 +46,21 @@ void test_lights_rx_handler(void) {
   TEST_ASSERT_OK(CAN_TRANSMIT_LIGHTS_STATE(EE_LIGHT_TYPE_HIGH_BEAMS, EE_LIGHT_STATE_ON));
   Event e = { 0 };
   MS_TEST_HELPER_CAN_TX_RX(LIGHTS_EVENT_CAN_TX, LIGHTS_EVENT_CAN_RX);
-  while (!status_ok(event_process(&e))) {
-  }
+  MS_TEST_HELPER_AWAIT_EVENT(e);
   TEST_ASSERT_EQUAL(LIGHTS_EVENT_GPIO_ON, e.id);
   TEST_ASSERT_EQUAL(LIGHTS_EVENT_GPIO_PERIPHERAL_HIGH_BEAMS, e.data);
 
   // Transmit an lights state OFF message.
   TEST_ASSERT_OK(CAN_TRANSMIT_LIGHTS_STATE(EE_LIGHT_TYPE_LOW_BEAMS, EE_LIGHT_STATE_OFF));
   MS_TEST_HELPER_CAN_TX_RX(LIGHTS_EVENT_CAN_TX, LIGHTS_EVENT_CAN_RX);
-  while (!status_ok(event_process(&e))) {
-  }
+  MS_TEST_HELPER_AWAIT_EVENT(e);
   TEST_ASSERT_EQUAL(LIGHTS_EVENT_GPIO_OFF, e.id);
   TEST_ASSERT_EQUAL(LIGHTS_EVENT_GPIO_PERIPHERAL_LOW_BEAMS, e.data);
 
   // Transmit a signal light ON message.
   TEST_ASSERT_OK(CAN_TRANSMIT_LIGHTS_STATE(EE_LIGHT_TYPE_SIGNAL_RIGHT, EE_LIGHT_STATE_ON));
   MS_TEST_HELPER_CAN_TX_RX(LIGHTS_EVENT_CAN_TX, LIGHTS_EVENT_CAN_RX);
-  while (!status_ok(event_process(&e))) {
-  }
+  MS_TEST_HELPER_AWAIT_EVENT(e);
   TEST_ASSERT_EQUAL(LIGHTS_EVENT_SIGNAL_ON, e.id);
   TEST_ASSERT_EQUAL(LIGHTS_EVENT_SIGNAL_MODE_RIGHT, e.data);
 }
@@ -73,8 +70,7 @@ void test_lights_rx_horn_handler(void) {
   TEST_ASSERT_OK(CAN_TRANSMIT_HORN(EE_HORN_STATE_ON));
   Event e = { 0 };
   MS_TEST_HELPER_CAN_TX_RX(LIGHTS_EVENT_CAN_TX, LIGHTS_EVENT_CAN_RX);
-  while (!status_ok(event_process(&e))) {
-  }
+  MS_TEST_HELPER_AWAIT_EVENT(e);
   TEST_ASSERT_EQUAL(LIGHTS_EVENT_GPIO_ON, e.id);
   TEST_ASSERT_EQUAL(LIGHTS_EVENT_GPIO_PERIPHERAL_HORN, e.data);
 }
@@ -84,8 +80,7 @@ void test_lights_sync_handler(void) {
   TEST_ASSERT_OK(CAN_TRANSMIT_LIGHTS_SYNC());
   Event e = { 0 };
   MS_TEST_HELPER_CAN_TX_RX(LIGHTS_EVENT_CAN_TX, LIGHTS_EVENT_CAN_RX);
-  while (!status_ok(event_process(&e))) {
-  }
+  MS_TEST_HELPER_AWAIT_EVENT(e);
   TEST_ASSERT_EQUAL(LIGHTS_EVENT_SYNC_RX, e.id);
 }
 
@@ -94,7 +89,6 @@ void test_lights_process_event(void) {
   const Event e = { .id = LIGHTS_EVENT_SYNC_TX, .data = 0 };
   TEST_ASSERT_OK(lights_can_process_event(&e));
   MS_TEST_HELPER_CAN_TX_RX(LIGHTS_EVENT_CAN_TX, LIGHTS_EVENT_CAN_RX);
-  while (!status_ok(event_process(&e))) {
-  }
+  MS_TEST_HELPER_AWAIT_EVENT(e);
   TEST_ASSERT_EQUAL(LIGHTS_EVENT_SYNC_RX, e.id);
 }
@@ -1,3 +1,4 @@
+#include "ms_test_helpers.h"
 #include "status.h"
 #include "test_helpers.h"
 #include "unity.h"
@@ -34,8 +35,7 @@ void test_lights_strobe_turn_on_off() {
   TEST_ASSERT_EQUAL(event.data, LIGHTS_EVENT_GPIO_PERIPHERAL_STROBE);
 
   // Waiting for one blink.
-  while (event_process(&event) != STATUS_CODE_OK) {
-  }
+  MS_TEST_HELPER_AWAIT_EVENT(event);
   // Asserting correct event raised by blinker.
   TEST_ASSERT_EQUAL(event.id, LIGHTS_EVENT_GPIO_OFF);
   TEST_ASSERT_EQUAL(event.data, LIGHTS_EVENT_GPIO_PERIPHERAL_STROBE);
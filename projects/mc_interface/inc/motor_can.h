@@ -0,0 +1,12 @@
+#pragma once
+// Sets up the CAN bus to the motor controllers
+//
+// On STM32F0xx, the motor controllers are on a separate bus reached through CAN UART and a CAN
+// slave board. x86 has no UART, so the bus is a second CAN interface instead - vcan1 by default,
+// or the interface named by MIDSUN_X86_MOTOR_CAN_INTERFACE.
+#include "event_queue.h"
+#include "generic_can.h"
+#include "status.h"
+
+// |fault_event| is raised if the bus goes off, where supported
+StatusCode motor_can_init(EventId fault_event, GenericCan **can);
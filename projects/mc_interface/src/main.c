@@ -1,28 +1,28 @@
 #include "can.h"
 #include "can_msg_defs.h"
+#include "can_msg_schema.h"
 #include "drive_can.h"
-#include "generic_can_uart.h"
 #include "gpio.h"
 #include "heartbeat_rx.h"
 #include "interrupt.h"
+#include "log.h"
 #include "mc_cfg.h"
+#include "motor_can.h"
 #include "motor_controller.h"
 #include "sequenced_relay.h"
-#include "uart.h"
 #include "wait.h"
 
 typedef enum {
   MOTOR_EVENT_SYSTEM_CAN_RX = 0,
   MOTOR_EVENT_SYSTEM_CAN_TX,
   MOTOR_EVENT_SYSTEM_CAN_FAULT,
+  MOTOR_EVENT_MOTOR_CAN_FAULT,
 } MotorEvent;
 
 static MotorControllerStorage s_controller_storage;
-static GenericCanUart s_can_uart;
 static CanStorage s_can_storage;
 static SequencedRelayStorage s_relay_storage;
 static HeartbeatRxHandlerStorage s_powertrain_heartbeat;
-static UartStorage s_uart_storage;
 
 static void prv_setup_system_can(void) {
   CanSettings can_settings = {
@@ -34,34 +34,30 @@ static void prv_setup_system_can(void) {
     .tx = { GPIO_PORT_A, 12 },
     .rx = { GPIO_PORT_A, 11 },
     .loopback = false,
+    .msg_schema = can_msg_schema_get(),
   };
 
   can_init(&s_can_storage, &can_settings);
 }
 
-static void prv_setup_motor_can(void) {
-  UartSettings uart_settings = {
-    .baudrate = MC_CFG_CAN_UART_BAUDRATE,
-    .tx = MC_CFG_CAN_UART_TX,
-    .rx = MC_CFG_CAN_UART_RX,
-    .alt_fn = MC_CFG_CAN_UART_ALTFN,
-  };
-  uart_init(MC_CFG_CAN_UART_PORT, &uart_settings, &s_uart_storage);
-
-  generic_can_uart_init(&s_can_uart, MC_CFG_CAN_UART_PORT);
-}
-
 int main(void) {
   interrupt_init();
   gpio_init();
   soft_timer_init();
   event_queue_init();
   prv_setup_system_can();
-  prv_setup_motor_can();
+
+  GenericCan *motor_can = NULL;
+  StatusCode status = motor_can_init(MOTOR_EVENT_MOTOR_CAN_FAULT, &motor_can);
+  if (!status_ok(status)) {
+    // The motor controllers are unreachable, so there's nothing to drive
+    LOG_CRITICAL("Failed to initialize motor CAN: %d\n", status);
+    return 1;
+  }
 
   // clang-format off
   MotorControllerSettings mc_settings = {
-    .motor_can = (GenericCan *)&s_can_uart,
+    .motor_can = motor_can,
     .ids = {
       [MOTOR_CONTROLLER_LEFT] = {
           .motor_controller = MC_CFG_MOTOR_CAN_ID_MC_LEFT,
@@ -94,6 +90,10 @@ int main(void) {
   while (true) {
     Event e = { 0 };
     while (status_ok(event_process(&e))) {
+      if (e.id == MOTOR_EVENT_MOTOR_CAN_FAULT) {
+        LOG_WARN("Motor CAN bus fault\n");
+      }
+
       can_process_event(&e);
     }
 
@@ -99,8 +99,6 @@ static void prv_periodic_tx(SoftTimerId timer_id, void *context) {
     generic_can_tx(storage->settings.motor_can, &msg);
   }
   storage->timeout_counter++;
-
-  soft_timer_start_millis(MOTOR_CONTROLLER_DRIVE_TX_PERIOD_MS, prv_periodic_tx, storage, NULL);
 }
 
 StatusCode motor_controller_init(MotorControllerStorage *controller,
@@ -123,8 +121,8 @@ StatusCode motor_controller_init(MotorControllerStorage *controller,
                                                 can_id.raw, false, controller));
   }
 
-  return soft_timer_start_millis(MOTOR_CONTROLLER_DRIVE_TX_PERIOD_MS, prv_periodic_tx, controller,
-                                 NULL);
+  return soft_timer_start_periodic_millis(MOTOR_CONTROLLER_DRIVE_TX_PERIOD_MS, prv_periodic_tx,
+                                          controller, NULL);
 }
 
 // Override the callbacks that are called when information is received from the motor controllers
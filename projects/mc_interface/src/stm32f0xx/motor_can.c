@@ -0,0 +1,22 @@
+#include "motor_can.h"
+
+#include "generic_can_uart.h"
+#include "mc_cfg.h"
+#include "uart.h"
+
+static GenericCanUart s_can_uart;
+static UartStorage s_uart_storage;
+
+StatusCode motor_can_init(EventId fault_event, GenericCan **can) {
+  UartSettings uart_settings = {
+    .baudrate = MC_CFG_CAN_UART_BAUDRATE,
+    .tx = MC_CFG_CAN_UART_TX,
+    .rx = MC_CFG_CAN_UART_RX,
+    .alt_fn = MC_CFG_CAN_UART_ALTFN,
+  };
+  status_ok_or_return(uart_init(MC_CFG_CAN_UART_PORT, &uart_settings, &s_uart_storage));
+  status_ok_or_return(generic_can_uart_init(&s_can_uart, MC_CFG_CAN_UART_PORT));
+
+  *can = (GenericCan *)&s_can_uart;
+  return STATUS_CODE_OK;
+}
@@ -0,0 +1,31 @@
+#include "motor_can.h"
+
+#include <stdlib.h>
+
+#include "can_hw.h"
+#include "generic_can_socket.h"
+#include "mc_cfg.h"
+
+#define MOTOR_CAN_DEFAULT_INTERFACE "vcan1"
+#define MOTOR_CAN_INTERFACE_ENV "MIDSUN_X86_MOTOR_CAN_INTERFACE"
+
+static GenericCanSocket s_can_socket;
+
+StatusCode motor_can_init(EventId fault_event, GenericCan **can) {
+  const char *interface = getenv(MOTOR_CAN_INTERFACE_ENV);
+  if (interface == NULL) {
+    interface = MOTOR_CAN_DEFAULT_INTERFACE;
+  }
+
+  CanHwSettings can_hw_settings = {
+    .bitrate = MC_CFG_CAN_BITRATE,
+    .tx = { GPIO_PORT_B, 10 },
+    .rx = { GPIO_PORT_B, 11 },
+    .loopback = false,
+  };
+  status_ok_or_return(
+      generic_can_socket_init(&s_can_socket, interface, &can_hw_settings, fault_event));
+
+  *can = (GenericCan *)&s_can_socket;
+  return STATUS_CODE_OK;
+}
@@ -127,10 +127,10 @@ void setup_test(void) {
     TEST_MOTOR_CONTROLLER_CAN_ID_DC_RIGHT,
   };
   for (size_t i = 0; i < NUM_MOTOR_CONTROLLERS; i++) {
-    WaveSculptorCanId can_id = {
-      .device_id = dc_ids[i],
-      .msg_id = WAVESCULPTOR_CMD_ID_DRIVE,
-    };
+    // Clear the whole ID first - the bits above the bitfields are used in the exact match
+    WaveSculptorCanId can_id = { 0 };
+    can_id.device_id = dc_ids[i];
+    can_id.msg_id = WAVESCULPTOR_CMD_ID_DRIVE;
     TEST_ASSERT_OK(generic_can_register_rx((GenericCan *)&s_can, prv_copy_drive_cmd,
                                            GENERIC_CAN_EMPTY_MASK, can_id.raw, false,
                                            &s_drive_cmds[i]));
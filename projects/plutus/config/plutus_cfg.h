@@ -21,6 +21,21 @@
 #define PLUTUS_CFG_OVERCURRENT_DISCHARGE 122400
 #define PLUTUS_CFG_OVERCURRENT_CHARGE 130000
 #define PLUTUS_CFG_LTC_AFE_FSM_MAX_FAULTS 5
+// Cell rolling averages move 1/2^n of the way to each new scan
+#define PLUTUS_CFG_PACK_STATS_AVG_SHIFT 3
+
+// Cell balancing
+// in 100 uV units above the pack minimum
+#define PLUTUS_CFG_BALANCING_THRESHOLD 100
+#define PLUTUS_CFG_BALANCING_HYSTERESIS 50
+// in 100 uV units
+#define PLUTUS_CFG_BALANCING_MIN_VOLTAGE 30000
+// in 0.1 C units
+#define PLUTUS_CFG_BALANCING_OVERTEMP 500
+// Scans with discharge enabled, then scans discarded while the cells settle
+#define PLUTUS_CFG_BALANCING_SCANS 8
+#define PLUTUS_CFG_BALANCING_SETTLE_SCANS 1
+#define PLUTUS_CFG_BALANCING_PUBLISH_MAX_SILENCE_MS 1000
 
 // Heartbeat settings
 #define PLUTUS_CFG_HEARTBEAT_PERIOD_MS 1000
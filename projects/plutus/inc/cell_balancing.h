@@ -0,0 +1,73 @@
+#pragma once
+// Passive cell balancing controller
+// Requires the LTC AFE, CAN and soft timers to be initialized
+//
+// Cells that are more than |threshold| above the pack minimum are discharged through the AFE's
+// discharge switches until they are within |threshold - hysteresis|. Cells whose thermistor is past
+// |temp_node_limit| are never discharged.
+//
+// The bleed current skews the cell voltage readings, so balancing is duty-cycled around the
+// measurement windows. Discharge is enabled for |balance_scans| cell scans, then turned off. The
+// next |settle_scans| scans are discarded while the cells recover, and the scan after that is used
+// to choose the cells for the next round. Discharge bits only take effect when the AFE config is
+// rewritten before each aux conversion, so cell_balancing_update() should be called from the cell
+// result callback.
+//
+// The selected cells are published as DISCHARGE_STATE whenever they change.
+#include <stdbool.h>
+#include <stdint.h>
+#include "can_publish.h"
+#include "ltc_afe.h"
+#include "pack_stats.h"
+#include "status.h"
+
+typedef enum {
+  // Discharge is off and readings can be used once the cells have settled
+  CELL_BALANCING_PHASE_MEASURE = 0,
+  CELL_BALANCING_PHASE_BALANCE,
+  NUM_CELL_BALANCING_PHASES,
+} CellBalancingPhase;
+
+typedef struct CellBalancingSettings {
+  LtcAfeStorage *ltc_afe;
+
+  // In 100uV (0.1mV) above the pack minimum
+  uint16_t threshold;
+  uint16_t hysteresis;
+  // Balancing is disabled while the pack minimum is below this - in 100uV
+  uint16_t min_voltage;
+  // Thermistor node voltage at the maximum balancing temperature - in 100uV
+  uint16_t temp_node_limit;
+
+  uint16_t balance_scans;
+  uint16_t settle_scans;
+  // Resend DISCHARGE_STATE at least this often
+  uint32_t publish_max_silence_ms;
+} CellBalancingSettings;
+
+typedef struct CellBalancingStorage {
+  CellBalancingSettings settings;
+  CellBalancingPhase phase;
+  // Scans seen in the current phase
+  uint16_t phase_scans;
+
+  // Cells chosen at the last clean measurement, by result index
+  uint64_t selected_bitset;
+  // Cells with discharge enabled in the AFE
+  uint64_t discharge_bitset;
+
+  CanPublishStorage publish;
+} CellBalancingStorage;
+
+// |storage| should persist.
+StatusCode cell_balancing_init(CellBalancingStorage *storage,
+                               const CellBalancingSettings *settings);
+
+// Runs the controller for a new scan. |temp_voltages| is the latest thermistor node voltage for
+// each cell in |stats|.
+StatusCode cell_balancing_update(CellBalancingStorage *storage, const PackStats *stats,
+                                 const uint16_t *temp_voltages);
+
+// Turns off all discharge and deselects every cell, i.e. on a pack fault. Balancing resumes with
+// the next clean measurement.
+StatusCode cell_balancing_stop(CellBalancingStorage *storage);
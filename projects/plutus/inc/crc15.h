@@ -1,8 +1,19 @@
 #pragma once
 // crc15 implementation for the LTC6804-1
+//
+// Table-driven using constant tables, so no initialization is required. crc15_calculate()
+// consumes two bytes per table step, and crc15_calculate_u8() is the byte-at-a-time equivalent.
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
-void crc15_init_table(void);
+// Size of the PEC in bytes
+#define CRC15_PEC_SIZE 2
 
-uint16_t crc15_calculate(uint8_t *data, size_t len);
+// Returns the PEC of |data| as it should be sent - MSB first
+uint16_t crc15_calculate(const uint8_t *data, size_t len);
+
+uint16_t crc15_calculate_u8(const uint8_t *data, size_t len);
+
+// Returns whether the big endian PEC in the last 2 bytes of |data| matches the rest of the data
+bool crc15_verify(const uint8_t *data, size_t len);
@@ -1,9 +1,12 @@
 #pragma once
 // Monitor voltage/current/temperature for faults
-// Requires LTC AFE, current sense, BPS heartbeat to be initialized
+// Also runs cell balancing from each scan - balancing stops while there's a cell voltage fault.
+// Requires LTC AFE, current sense, BPS heartbeat, CAN to be initialized
 #include "bps_heartbeat.h"
+#include "cell_balancing.h"
 #include "current_sense.h"
 #include "ltc_afe.h"
+#include "pack_stats.h"
 
 typedef struct FaultMonitorSettings {
   LtcAfeStorage *ltc_afe;
@@ -26,9 +29,7 @@ typedef struct FaultMonitorSettings {
 } FaultMonitorSettings;
 
 typedef struct FaultMonitorResult {
-  uint16_t cell_voltages[PLUTUS_CFG_AFE_TOTAL_CELLS];
   uint16_t temp_voltages[PLUTUS_CFG_AFE_TOTAL_CELLS];
-  uint32_t total_voltage;
   int32_t current;
   bool charging;
 } FaultMonitorResult;
@@ -36,6 +37,9 @@ typedef struct FaultMonitorResult {
 typedef struct FaultMonitorStorage {
   FaultMonitorSettings settings;
   FaultMonitorResult result;
+  // Cell voltages and pack statistics - use pack_stats_get()
+  PackStatsStorage pack_stats;
+  CellBalancingStorage cell_balancing;
   size_t num_afe_faults;
 
   // in uA
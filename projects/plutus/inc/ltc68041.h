@@ -7,6 +7,9 @@
 #define LTC6804_CELLS_IN_REG 3
 #define LTC6804_GPIOS_IN_REG 3
 
+// Command code and its PEC
+#define LTC6804_CMD_SIZE 4
+
 typedef enum {
   LTC_AFE_REGISTER_CONFIG = 0,
   LTC_AFE_REGISTER_CELL_VOLTAGE_A,
@@ -74,7 +77,7 @@ typedef struct {
 
 // WRCFG + all slave registers
 typedef struct {
-  uint8_t wrcfg[4];
+  uint8_t wrcfg[LTC6804_CMD_SIZE];
 
   // devices are ordered with the last slave first
   LtcAfeWriteDeviceConfigPacket devices[PLUTUS_CFG_AFE_DEVICES_IN_CHAIN];
@@ -30,6 +30,16 @@
 #define _PACKED
 #endif
 
+// Uses _PACKED
+#include "ltc68041.h"
+
+// The isoSPI ports go idle if there's no activity for tIDLE (4.3ms min), and need a wakeup first
+#define LTC_AFE_IDLE_TIMEOUT_US 4000
+
+// Number of times a register group is re-read if any device's PEC doesn't match before the read
+// is failed
+#define LTC_AFE_PEC_RETRIES 1
+
 // Function to run when a conversion is complete
 typedef void (*LtcAfeResultCallback)(uint16_t *result_arr, size_t len, void *context);
 
@@ -67,6 +77,22 @@ typedef struct LtcAfeSettings {
   void *result_context;
 } LtcAfeSettings;
 
+typedef struct LtcAfeScanStats {
+  uint32_t num_scans;
+  // Wakeup pulses sent to the chain - SPI transfers within the idle timeout don't need one
+  uint32_t num_wakeups;
+  // Cell conversion trigger to the last voltage group being read
+  uint32_t last_cycle_us;
+  uint32_t max_cycle_us;
+  // Time spent reading back the cell voltage groups
+  uint32_t last_readout_us;
+  uint32_t max_readout_us;
+  // Register groups with a PEC mismatch, by device in chain order - includes aux reads
+  uint32_t pec_errors[PLUTUS_CFG_AFE_DEVICES_IN_CHAIN];
+  // Register groups that were re-read after a PEC mismatch
+  uint32_t num_group_retries;
+} LtcAfeScanStats;
+
 typedef struct LtcAfeStorage {
   Fsm fsm;
   SpiPort spi_port;
@@ -96,6 +122,18 @@ typedef struct LtcAfeStorage {
   // TODO(ELEC-447): Handle unused cell inputs during balancing
   uint16_t discharge_cell_lookup[LTC_AFE_MAX_TOTAL_CELLS];
 
+  // Commands with their PEC, built once at init
+  uint8_t read_reg_cmd[NUM_LTC_AFE_REGISTERS][LTC6804_CMD_SIZE];
+  uint8_t adcv_cmd[LTC6804_CMD_SIZE];
+  uint8_t adax_cmd[LTC6804_CMD_SIZE];
+  uint8_t wrcfg_cmd[LTC6804_CMD_SIZE];
+
+  // End of the last SPI transfer, to tell whether the chain has gone idle
+  uint32_t last_access_us;
+  bool accessed;
+  uint32_t scan_start_us;
+  LtcAfeScanStats scan_stats;
+
   LtcAfeResultCallback cell_result_cb;
   LtcAfeResultCallback aux_result_cb;
   void *result_context;
@@ -118,6 +156,9 @@ StatusCode ltc_afe_request_aux_conversion(LtcAfeStorage *afe);
 // Process PLUTUS_EVENT_AFE_* events
 bool ltc_afe_process_event(LtcAfeStorage *afe, const Event *e);
 
+// Returns timing and PEC errors for the scans since init
+StatusCode ltc_afe_get_scan_stats(const LtcAfeStorage *afe, LtcAfeScanStats *stats);
+
 // Mark cell for discharging (takes effect after config is re-written)
 // |cell| should be [0, PLUTUS_CFG_AFE_TOTAL_CELLS)
 StatusCode ltc_afe_toggle_cell_discharge(LtcAfeStorage *afe, uint16_t cell, bool discharge);
@@ -13,6 +13,11 @@
 // Note that all units are in 100uV.
 //
 // This module supports AFEs with fewer than 12 cells using the |input_bitset|.
+//
+// Commands and their PECs are built once at init. The chain is only woken up if it may have gone
+// idle since the last transfer, so the cell voltage groups are read back-to-back after one wakeup.
+// Every register group's PEC is verified before its data is used. A group with a mismatch is
+// re-read on its own up to LTC_AFE_PEC_RETRIES times before the read fails.
 #include "ltc_afe.h"
 
 // Initialize the LTC6804.
@@ -26,6 +31,7 @@ StatusCode ltc_afe_impl_trigger_cell_conv(LtcAfeStorage *afe);
 StatusCode ltc_afe_impl_trigger_aux_conv(LtcAfeStorage *afe, uint8_t device_cell);
 
 // Reads converted voltages from the AFE into the storage result arrays.
+// Reading cells completes a scan and updates the scan timing stats.
 StatusCode ltc_afe_impl_read_cells(LtcAfeStorage *afe);
 StatusCode ltc_afe_impl_read_aux(LtcAfeStorage *afe, uint8_t device_cell);
 
@@ -0,0 +1,64 @@
+#pragma once
+// Pack statistics computed from each cell voltage scan
+//
+// Every update computes the total, min/max/mean, the cells at the extremes, the spread between
+// them, and a rolling average for each cell in a single pass over the scan.
+//
+// Results are double-buffered: updates write the inactive buffer and then publish it, so
+// pack_stats_get() always returns a complete scan without a critical section. This is safe as long
+// as readers either run in the same context as the writer or in an interrupt that finishes before
+// the writer resumes (i.e. soft timer callbacks) - a reader can never be preempted by an update.
+//
+// All voltages are in 100uV.
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "plutus_cfg.h"
+#include "status.h"
+
+// Rolling averages are exponential moving averages with a weight of 1 / 2^|avg_shift|
+#define PACK_STATS_MAX_AVG_SHIFT 8
+
+typedef struct PackStatsSettings {
+  // Each scan moves the rolling average 1 / 2^|avg_shift| of the way to the new reading
+  uint8_t avg_shift;
+} PackStatsSettings;
+
+typedef struct PackStats {
+  uint16_t cell_voltages[PLUTUS_CFG_AFE_TOTAL_CELLS];
+  uint16_t avg_voltages[PLUTUS_CFG_AFE_TOTAL_CELLS];
+  size_t num_cells;
+
+  uint32_t total_voltage;
+  uint16_t min_voltage;
+  uint16_t max_voltage;
+  uint16_t mean_voltage;
+  // Max - min
+  uint16_t spread;
+  uint16_t min_cell;
+  uint16_t max_cell;
+
+  // Scans since init - 0 if no scan has completed yet
+  uint32_t num_scans;
+} PackStats;
+
+typedef struct PackStatsStorage {
+  PackStatsSettings settings;
+  PackStats buffers[2];
+  // Index of the buffer readers should use
+  volatile uint8_t active;
+
+  // Rolling averages scaled by 2^|avg_shift| to keep the fractional part
+  uint32_t avg_accum[PLUTUS_CFG_AFE_TOTAL_CELLS];
+} PackStatsStorage;
+
+StatusCode pack_stats_init(PackStatsStorage *storage, const PackStatsSettings *settings);
+
+// Computes the stats for a new scan and publishes them.
+// |num_cells| should be (0, PLUTUS_CFG_AFE_TOTAL_CELLS].
+StatusCode pack_stats_update(PackStatsStorage *storage, const uint16_t *cell_voltages,
+                             size_t num_cells);
+
+// Returns the stats from the latest complete scan. The pointer is only valid until the next
+// update, so readers in the writer's context should not hold on to it.
+const PackStats *pack_stats_get(const PackStatsStorage *storage);
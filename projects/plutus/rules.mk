@@ -15,3 +15,4 @@ $(T)_EXCLUDE_TESTS := ltc_afe ltc_adc
 endif
 
 $(T)_test_bps_heartbeat_MOCKS := sequenced_relay_set_state
+$(T)_test_cell_balancing_MOCKS := ltc_afe_toggle_cell_discharge can_transmit
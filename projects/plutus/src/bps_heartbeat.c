@@ -50,8 +50,15 @@ static void prv_periodic_heartbeat(SoftTimerId timer_id, void *context) {
   BpsHeartbeatStorage *storage = context;
 
   prv_handle_state(storage);
+}
+
+// Sends the first heartbeat once the startup delay has passed, then every period after that
+static void prv_start_heartbeat(SoftTimerId timer_id, void *context) {
+  BpsHeartbeatStorage *storage = context;
+
+  prv_handle_state(storage);
 
-  soft_timer_start_millis(storage->period_ms, prv_periodic_heartbeat, storage, NULL);
+  soft_timer_start_periodic_millis(storage->period_ms, prv_periodic_heartbeat, storage, NULL);
 }
 
 StatusCode bps_heartbeat_init(BpsHeartbeatStorage *storage, SequencedRelayStorage *relay,
@@ -70,7 +77,7 @@ StatusCode bps_heartbeat_init(BpsHeartbeatStorage *storage, SequencedRelayStorag
   debug_led_init(DEBUG_LED_GREEN);
 
   return soft_timer_start_millis(storage->period_ms * BPS_HEARTBEAT_STARTUP_DELAY_MULTIPLIER,
-                                 prv_periodic_heartbeat, storage, NULL);
+                                 prv_start_heartbeat, storage, NULL);
 }
 
 StatusCode bps_heartbeat_raise_fault(BpsHeartbeatStorage *storage,
@@ -0,0 +1,127 @@
+#include "cell_balancing.h"
+#include <string.h>
+#include "can_pack.h"
+
+static_assert(PLUTUS_CFG_AFE_TOTAL_CELLS <= 64, "Cell bitsets must fit in a u64");
+
+static StatusCode prv_publish(CellBalancingStorage *storage) {
+  CanMessage msg = { 0 };
+  CAN_PACK_DISCHARGE_STATE(&msg, storage->selected_bitset);
+
+  return can_publish(&storage->publish, &msg);
+}
+
+// Updates the AFE's discharge bits to match |bitset|
+static StatusCode prv_apply(CellBalancingStorage *storage, uint64_t bitset) {
+  uint64_t changed = storage->discharge_bitset ^ bitset;
+  for (uint16_t cell = 0; changed != 0; cell++, changed >>= 1) {
+    if (changed & 0x1) {
+      bool discharge = (bitset >> cell) & 0x1;
+      status_ok_or_return(
+          ltc_afe_toggle_cell_discharge(storage->settings.ltc_afe, cell, discharge));
+    }
+  }
+
+  storage->discharge_bitset = bitset;
+  return STATUS_CODE_OK;
+}
+
+static void prv_set_phase(CellBalancingStorage *storage, CellBalancingPhase phase) {
+  storage->phase = phase;
+  storage->phase_scans = 0;
+}
+
+// Drops any cell that has hit the thermal limit
+static uint64_t prv_filter_hot_cells(const CellBalancingStorage *storage, uint64_t bitset,
+                                     const uint16_t *temp_voltages, size_t num_cells) {
+  for (size_t cell = 0; cell < num_cells; cell++) {
+    if (temp_voltages[cell] > storage->settings.temp_node_limit) {
+      bitset &= ~((uint64_t)1 << cell);
+    }
+  }
+
+  return bitset;
+}
+
+static uint64_t prv_select_cells(const CellBalancingStorage *storage, const PackStats *stats) {
+  if (stats->min_voltage < storage->settings.min_voltage) {
+    return 0;
+  }
+
+  uint16_t start = storage->settings.threshold;
+  uint16_t stop = (uint16_t)(storage->settings.threshold - storage->settings.hysteresis);
+  uint64_t bitset = 0;
+  for (size_t cell = 0; cell < stats->num_cells; cell++) {
+    uint16_t delta = (uint16_t)(stats->cell_voltages[cell] - stats->min_voltage);
+    // Cells already being balanced keep going until they're within the lower threshold
+    bool selected = (storage->selected_bitset >> cell) & 0x1;
+    if (delta > (selected ? stop : start)) {
+      bitset |= (uint64_t)1 << cell;
+    }
+  }
+
+  return bitset;
+}
+
+StatusCode cell_balancing_init(CellBalancingStorage *storage,
+                               const CellBalancingSettings *settings) {
+  if (storage == NULL || settings == NULL || settings->ltc_afe == NULL ||
+      settings->hysteresis > settings->threshold || settings->balance_scans == 0) {
+    return status_code(STATUS_CODE_INVALID_ARGS);
+  }
+
+  memset(storage, 0, sizeof(*storage));
+  storage->settings = *settings;
+
+  const CanPublishSettings publish_settings = {
+    .field_size = sizeof(uint64_t),
+    .deadband = 0,
+    .max_silence_ms = settings->publish_max_silence_ms,
+  };
+  return can_publish_init(&storage->publish, &publish_settings);
+}
+
+StatusCode cell_balancing_update(CellBalancingStorage *storage, const PackStats *stats,
+                                 const uint16_t *temp_voltages) {
+  if (stats->num_cells > PLUTUS_CFG_AFE_TOTAL_CELLS) {
+    return status_code(STATUS_CODE_INVALID_ARGS);
+  }
+
+  storage->phase_scans++;
+
+  if (storage->phase == CELL_BALANCING_PHASE_MEASURE) {
+    if (storage->phase_scans > storage->settings.settle_scans) {
+      // Discharge has been off long enough for this reading to be accurate
+      uint64_t selected = prv_select_cells(storage, stats);
+      storage->selected_bitset = prv_filter_hot_cells(storage, selected, temp_voltages,
+                                                      stats->num_cells);
+
+      if (storage->selected_bitset != 0) {
+        status_ok_or_return(prv_apply(storage, storage->selected_bitset));
+        prv_set_phase(storage, CELL_BALANCING_PHASE_BALANCE);
+      }
+    }
+  } else {
+    // Readings are skewed by the bleed current, but the thermal limit still applies
+    storage->selected_bitset = prv_filter_hot_cells(storage, storage->selected_bitset,
+                                                    temp_voltages, stats->num_cells);
+
+    if (storage->phase_scans >= storage->settings.balance_scans ||
+        storage->selected_bitset == 0) {
+      status_ok_or_return(prv_apply(storage, 0));
+      prv_set_phase(storage, CELL_BALANCING_PHASE_MEASURE);
+    } else {
+      status_ok_or_return(prv_apply(storage, storage->selected_bitset));
+    }
+  }
+
+  return prv_publish(storage);
+}
+
+StatusCode cell_balancing_stop(CellBalancingStorage *storage) {
+  storage->selected_bitset = 0;
+  prv_set_phase(storage, CELL_BALANCING_PHASE_MEASURE);
+  status_ok_or_return(prv_apply(storage, 0));
+
+  return prv_publish(storage);
+}
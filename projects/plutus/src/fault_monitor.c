@@ -2,7 +2,6 @@
 
 #include <string.h>
 
-#include "critical_section.h"
 #include "exported_enums.h"
 #include "log.h"
 #include "plutus_event.h"
@@ -13,24 +12,17 @@ static void prv_extract_cell_result(uint16_t *result_arr, size_t len, void *cont
 
   ltc_afe_request_aux_conversion(storage->settings.ltc_afe);
 
-  bool disabled = critical_section_start();
-  memcpy(storage->result.cell_voltages, result_arr, sizeof(storage->result.cell_voltages));
+  StatusCode ret = pack_stats_update(&storage->pack_stats, result_arr, len);
+  const PackStats *stats = pack_stats_get(&storage->pack_stats);
 
-  storage->result.total_voltage = 0;
-  bool fault = false;
-  for (size_t i = 0; i < len; i++) {
-    storage->result.total_voltage += result_arr[i];
-    if (result_arr[i] < storage->settings.undervoltage ||
-        result_arr[i] > storage->settings.overvoltage) {
-      fault = true;
-    }
-  }
-  critical_section_end(disabled);
-
-  if (fault) {
+  if (!status_ok(ret) || stats->min_voltage < storage->settings.undervoltage ||
+      stats->max_voltage > storage->settings.overvoltage) {
+    cell_balancing_stop(&storage->cell_balancing);
     bps_heartbeat_raise_fault(storage->settings.bps_heartbeat,
                               EE_BPS_HEARTBEAT_FAULT_SOURCE_LTC_AFE_CELL);
   } else {
+    // Must run before the aux conversion rewrites the AFE config
+    cell_balancing_update(&storage->cell_balancing, stats, storage->result.temp_voltages);
     bps_heartbeat_clear_fault(storage->settings.bps_heartbeat,
                               EE_BPS_HEARTBEAT_FAULT_SOURCE_LTC_AFE_CELL);
   }
@@ -110,6 +102,24 @@ StatusCode fault_monitor_init(FaultMonitorStorage *storage, const FaultMonitorSe
   prv_convert_temp_node_voltage(settings->overtemp_discharge, &storage->discharge_temp_node_limit);
   prv_convert_temp_node_voltage(settings->overtemp_charge, &storage->charge_temp_node_limit);
 
+  const PackStatsSettings pack_stats_settings = {
+    .avg_shift = PLUTUS_CFG_PACK_STATS_AVG_SHIFT,
+  };
+  status_ok_or_return(pack_stats_init(&storage->pack_stats, &pack_stats_settings));
+
+  CellBalancingSettings balancing_settings = {
+    .ltc_afe = settings->ltc_afe,
+    .threshold = PLUTUS_CFG_BALANCING_THRESHOLD,
+    .hysteresis = PLUTUS_CFG_BALANCING_HYSTERESIS,
+    .min_voltage = PLUTUS_CFG_BALANCING_MIN_VOLTAGE,
+    .balance_scans = PLUTUS_CFG_BALANCING_SCANS,
+    .settle_scans = PLUTUS_CFG_BALANCING_SETTLE_SCANS,
+    .publish_max_silence_ms = PLUTUS_CFG_BALANCING_PUBLISH_MAX_SILENCE_MS,
+  };
+  prv_convert_temp_node_voltage(PLUTUS_CFG_BALANCING_OVERTEMP,
+                                &balancing_settings.temp_node_limit);
+  status_ok_or_return(cell_balancing_init(&storage->cell_balancing, &balancing_settings));
+
   current_sense_register_callback(storage->settings.current_sense, prv_extract_current,
                                   prv_handle_adc_timeout, storage);
 
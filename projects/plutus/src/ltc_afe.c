@@ -32,6 +32,12 @@ bool ltc_afe_process_event(LtcAfeStorage *afe, const Event *e) {
   return fsm_process_event(&afe->fsm, e);
 }
 
+StatusCode ltc_afe_get_scan_stats(const LtcAfeStorage *afe, LtcAfeScanStats *stats) {
+  *stats = afe->scan_stats;
+
+  return STATUS_CODE_OK;
+}
+
 StatusCode ltc_afe_toggle_cell_discharge(LtcAfeStorage *afe, uint16_t cell, bool discharge) {
   return ltc_afe_impl_toggle_cell_discharge(afe, cell, discharge);
 }
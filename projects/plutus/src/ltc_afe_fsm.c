@@ -141,7 +141,5 @@ StatusCode ltc_afe_fsm_init(Fsm *fsm, LtcAfeStorage *afe) {
   fsm_state_init(afe_read_aux, prv_afe_read_aux_output);
   fsm_state_init(afe_aux_complete, prv_afe_aux_complete_output);
 
-  fsm_init(fsm, "LTC AFE FSM", &afe_idle, afe);
-
-  return STATUS_CODE_OK;
+  return fsm_init(fsm, "LTC AFE FSM", &afe_idle, afe);
 }
@@ -4,18 +4,19 @@
 #include "crc15.h"
 #include "delay.h"
 #include "ltc68041.h"
+#include "soft_timer.h"
 
 // - 12-bit, 16-bit and 24-bit values are little endian
 // - commands and PEC are big endian
 
-static uint16_t s_read_reg_cmd[NUM_LTC_AFE_REGISTERS] = {
+static const uint16_t s_read_reg_cmd[NUM_LTC_AFE_REGISTERS] = {
   LTC6804_RDCFG_RESERVED,  LTC6804_RDCVA_RESERVED,   LTC6804_RDCVB_RESERVED,
   LTC6804_RDCVC_RESERVED,  LTC6804_RDCVD_RESERVED,   LTC6804_RDAUXA_RESERVED,
-  LTC6804_RDAUXA_RESERVED, LTC6804_RDSTATA_RESERVED, LTC6804_RDSTATB_RESERVED,
+  LTC6804_RDAUXB_RESERVED, LTC6804_RDSTATA_RESERVED, LTC6804_RDSTATB_RESERVED,
   LTC6804_RDCOMM_RESERVED
 };
 
-static uint8_t s_voltage_reg[NUM_LTC_AFE_VOLTAGE_REGISTERS] = {
+static const uint8_t s_voltage_reg[NUM_LTC_AFE_VOLTAGE_REGISTERS] = {
   LTC_AFE_REGISTER_CELL_VOLTAGE_A,
   LTC_AFE_REGISTER_CELL_VOLTAGE_B,
   LTC_AFE_REGISTER_CELL_VOLTAGE_C,
@@ -23,6 +24,13 @@ static uint8_t s_voltage_reg[NUM_LTC_AFE_VOLTAGE_REGISTERS] = {
 };
 
 static void prv_wakeup_idle(LtcAfeStorage *afe) {
+  // The chain stays awake for tIDLE after the last transfer, so back-to-back transfers only need
+  // to wake it once
+  uint32_t now_us = (uint32_t)soft_timer_get_time();
+  if (afe->accessed && now_us - afe->last_access_us < LTC_AFE_IDLE_TIMEOUT_US) {
+    return;
+  }
+
   // Wakeup method 2 - pair of long -1, +1 for each device
   for (size_t i = 0; i < PLUTUS_CFG_AFE_DEVICES_IN_CHAIN; i++) {
     gpio_set_state(&afe->cs, GPIO_STATE_LOW);
@@ -30,73 +38,95 @@ static void prv_wakeup_idle(LtcAfeStorage *afe) {
     // Wait for 300us - greater than tWAKE, less than tIDLE
     delay_us(300);
   }
+  afe->scan_stats.num_wakeups++;
 }
 
-static StatusCode prv_build_cmd(uint16_t command, uint8_t *cmd, size_t len) {
-  if (len != 4) {
-    return status_code(STATUS_CODE_INVALID_ARGS);
-  }
+// Wakes up the chain if it might be idle and runs one transfer
+static StatusCode prv_exchange(LtcAfeStorage *afe, uint8_t *tx_data, size_t tx_len,
+                               uint8_t *rx_data, size_t rx_len) {
+  prv_wakeup_idle(afe);
+  StatusCode ret = spi_exchange(afe->spi_port, tx_data, tx_len, rx_data, rx_len);
+
+  afe->last_access_us = (uint32_t)soft_timer_get_time();
+  afe->accessed = true;
+
+  return ret;
+}
 
+static void prv_build_cmd(uint16_t command, uint8_t *cmd) {
   cmd[0] = (uint8_t)(command >> 8);
   cmd[1] = (uint8_t)(command & 0xFF);
 
-  uint16_t cmd_pec = crc15_calculate(cmd, 2);
+  uint16_t cmd_pec = crc15_calculate(cmd, LTC6804_CMD_SIZE - CRC15_PEC_SIZE);
   cmd[2] = (uint8_t)(cmd_pec >> 8);
   cmd[3] = (uint8_t)(cmd_pec);
+}
 
-  return STATUS_CODE_OK;
+// Commands only depend on the ADC mode, so their PECs are calculated once
+static void prv_build_cmds(LtcAfeStorage *afe) {
+  for (size_t reg = 0; reg < NUM_LTC_AFE_REGISTERS; reg++) {
+    prv_build_cmd(s_read_reg_cmd[reg], afe->read_reg_cmd[reg]);
+  }
+
+  uint8_t mode = (uint8_t)((afe->adc_mode + 1) % 3);
+  // ADCV command
+  uint16_t adcv = LTC6804_ADCV_RESERVED | LTC6804_ADCV_DISCHARGE_NOT_PERMITTED |
+                  LTC6804_CNVT_CELL_ALL | (mode << 7);
+  prv_build_cmd(adcv, afe->adcv_cmd);
+
+  // ADAX
+  uint16_t adax = LTC6804_ADAX_RESERVED | LTC6804_ADAX_GPIO1 | (mode << 7);
+  prv_build_cmd(adax, afe->adax_cmd);
+
+  prv_build_cmd(LTC6804_WRCFG_RESERVED, afe->wrcfg_cmd);
 }
 
 static StatusCode prv_read_register(LtcAfeStorage *afe, LtcAfeRegister reg, uint8_t *data,
                                     size_t len) {
-  if (reg > NUM_LTC_AFE_REGISTERS) {
+  if (reg >= NUM_LTC_AFE_REGISTERS) {
     return status_code(STATUS_CODE_INVALID_ARGS);
   }
 
-  uint16_t reg_cmd = s_read_reg_cmd[reg];
+  return prv_exchange(afe, afe->read_reg_cmd[reg], LTC6804_CMD_SIZE, data, len);
+}
 
-  uint8_t cmd[4] = { 0 };
-  prv_build_cmd(reg_cmd, cmd, SIZEOF_ARRAY(cmd));
+// Checks the PEC of each device's register group, counting mismatches against the device
+static bool prv_verify_group(LtcAfeStorage *afe, const uint8_t *data, size_t group_size) {
+  bool valid = true;
+  for (size_t device = 0; device < PLUTUS_CFG_AFE_DEVICES_IN_CHAIN; device++) {
+    if (!crc15_verify(data + device * group_size, group_size)) {
+      afe->scan_stats.pec_errors[device]++;
+      valid = false;
+    }
+  }
 
-  prv_wakeup_idle(afe);
-  return spi_exchange(afe->spi_port, cmd, 4, data, len);
+  return valid;
 }
 
-// read from a voltage register
-static StatusCode prv_read_voltage(LtcAfeStorage *afe, LtcAfeVoltageRegister reg,
-                                   LtcAfeVoltageRegisterGroup *data) {
-  if (reg > NUM_LTC_AFE_VOLTAGE_REGISTERS) {
-    return status_code(STATUS_CODE_INVALID_ARGS);
+// Verifies a register group that has already been read from every device, re-reading only that
+// group on a PEC mismatch instead of restarting the whole scan
+static StatusCode prv_check_group(LtcAfeStorage *afe, LtcAfeRegister reg, uint8_t *data,
+                                  size_t group_size) {
+  size_t len = group_size * PLUTUS_CFG_AFE_DEVICES_IN_CHAIN;
+  for (size_t retry = 0; !prv_verify_group(afe, data, group_size); retry++) {
+    if (retry >= LTC_AFE_PEC_RETRIES) {
+      return status_code(STATUS_CODE_INTERNAL_ERROR);
+    }
+
+    afe->scan_stats.num_group_retries++;
+    status_ok_or_return(prv_read_register(afe, reg, data, len));
   }
 
-  size_t len = sizeof(LtcAfeVoltageRegisterGroup) * PLUTUS_CFG_AFE_DEVICES_IN_CHAIN;
-  return prv_read_register(afe, s_voltage_reg[reg], (uint8_t *)data, len);
+  return STATUS_CODE_OK;
 }
 
 // start cell voltage conversion
 static StatusCode prv_trigger_adc_conversion(LtcAfeStorage *afe) {
-  uint8_t mode = (uint8_t)((afe->adc_mode + 1) % 3);
-  // ADCV command
-  uint16_t adcv = LTC6804_ADCV_RESERVED | LTC6804_ADCV_DISCHARGE_NOT_PERMITTED |
-                  LTC6804_CNVT_CELL_ALL | (mode << 7);
-
-  uint8_t cmd[4] = { 0 };
-  prv_build_cmd(adcv, cmd, SIZEOF_ARRAY(cmd));
-
-  prv_wakeup_idle(afe);
-  return spi_exchange(afe->spi_port, cmd, 4, NULL, 0);
+  return prv_exchange(afe, afe->adcv_cmd, LTC6804_CMD_SIZE, NULL, 0);
 }
 
 static StatusCode prv_trigger_aux_adc_conversion(LtcAfeStorage *afe) {
-  uint8_t mode = (uint8_t)((afe->adc_mode + 1) % 3);
-  // ADAX
-  uint16_t adax = LTC6804_ADAX_RESERVED | LTC6804_ADAX_GPIO1 | (mode << 7);
-
-  uint8_t cmd[4] = { 0 };
-  prv_build_cmd(adax, cmd, SIZEOF_ARRAY(cmd));
-
-  prv_wakeup_idle(afe);
-  return spi_exchange(afe->spi_port, cmd, 4, NULL, 0);
+  return prv_exchange(afe, afe->adax_cmd, LTC6804_CMD_SIZE, NULL, 0);
 }
 
 // write config to all devices
@@ -104,7 +134,7 @@ static StatusCode prv_write_config(LtcAfeStorage *afe, uint8_t gpio_enable_pins)
   // see p.54 in datasheet
   LtcAfeWriteConfigPacket config_packet = { 0 };
 
-  prv_build_cmd(LTC6804_WRCFG_RESERVED, config_packet.wrcfg, SIZEOF_ARRAY(config_packet.wrcfg));
+  memcpy(config_packet.wrcfg, afe->wrcfg_cmd, sizeof(config_packet.wrcfg));
 
   // essentially, each set of CFGR registers are clocked through each device,
   // until the first set reaches the last device (like a giant shift register)
@@ -128,13 +158,12 @@ static StatusCode prv_write_config(LtcAfeStorage *afe, uint8_t gpio_enable_pins)
     // GPIO5, ..., GPIO2 are used to MUX data
     config_packet.devices[curr_device].reg.gpio = (enable >> 3);
 
-    uint16_t cfgr_pec = crc15_calculate((uint8_t *)&config_packet.devices[curr_device].reg, 6);
+    uint16_t cfgr_pec = crc15_calculate((uint8_t *)&config_packet.devices[curr_device].reg,
+                                        sizeof(config_packet.devices[curr_device].reg));
     config_packet.devices[curr_device].pec = SWAP_UINT16(cfgr_pec);
   }
 
-  prv_wakeup_idle(afe);
-  return spi_exchange(afe->spi_port, (uint8_t *)&config_packet, sizeof(LtcAfeWriteConfigPacket),
-                      NULL, 0);
+  return prv_exchange(afe, (uint8_t *)&config_packet, sizeof(LtcAfeWriteConfigPacket), NULL, 0);
 }
 
 static void prv_calc_offsets(LtcAfeStorage *afe) {
@@ -182,7 +211,7 @@ StatusCode ltc_afe_impl_init(LtcAfeStorage *afe, const LtcAfeSettings *settings)
 
   prv_calc_offsets(afe);
 
-  crc15_init_table();
+  prv_build_cmds(afe);
 
   SpiSettings spi_config = {
     .baudrate = settings->spi_baudrate,  //
@@ -201,6 +230,7 @@ StatusCode ltc_afe_impl_init(LtcAfeStorage *afe, const LtcAfeSettings *settings)
 }
 
 StatusCode ltc_afe_impl_trigger_cell_conv(LtcAfeStorage *afe) {
+  afe->scan_start_us = (uint32_t)soft_timer_get_time();
   return prv_trigger_adc_conversion(afe);
 }
 
@@ -214,16 +244,32 @@ StatusCode ltc_afe_impl_trigger_aux_conv(LtcAfeStorage *afe, uint8_t device_cell
 }
 
 StatusCode ltc_afe_impl_read_cells(LtcAfeStorage *afe) {
-  // Read all voltage A, then B, ...
+  LtcAfeVoltageRegisterGroup voltage_register[NUM_LTC_AFE_VOLTAGE_REGISTERS]
+                                            [PLUTUS_CFG_AFE_DEVICES_IN_CHAIN] = { 0 };
+
+  // Read all voltage A, then B, ... back-to-back so the chain only needs to be woken up once
+  uint32_t readout_start_us = (uint32_t)soft_timer_get_time();
   for (uint8_t cell_reg = 0; cell_reg < NUM_LTC_AFE_VOLTAGE_REGISTERS; ++cell_reg) {
-    LtcAfeVoltageRegisterGroup voltage_register[PLUTUS_CFG_AFE_DEVICES_IN_CHAIN] = { 0 };
+    status_ok_or_return(prv_read_register(afe, s_voltage_reg[cell_reg],
+                                          (uint8_t *)voltage_register[cell_reg],
+                                          sizeof(voltage_register[cell_reg])));
+  }
 
-    prv_read_voltage(afe, cell_reg, voltage_register);
+  // Corrupted groups are re-read individually so bad readings never reach the result array
+  for (uint8_t cell_reg = 0; cell_reg < NUM_LTC_AFE_VOLTAGE_REGISTERS; ++cell_reg) {
+    status_ok_or_return(prv_check_group(afe, s_voltage_reg[cell_reg],
+                                        (uint8_t *)voltage_register[cell_reg],
+                                        sizeof(LtcAfeVoltageRegisterGroup)));
+  }
+  uint32_t readout_end_us = (uint32_t)soft_timer_get_time();
 
+  for (uint8_t cell_reg = 0; cell_reg < NUM_LTC_AFE_VOLTAGE_REGISTERS; ++cell_reg) {
     for (uint8_t device = 0; device < PLUTUS_CFG_AFE_DEVICES_IN_CHAIN; ++device) {
+      LtcAfeVoltageRegisterGroup *group = &voltage_register[cell_reg][device];
+
       for (uint16_t cell = 0; cell < LTC6804_CELLS_IN_REG; ++cell) {
         // LSB of the reading is 100 uV
-        uint16_t voltage = voltage_register[device].reg.voltages[cell];
+        uint16_t voltage = group->reg.voltages[cell];
         uint16_t device_cell = cell + (cell_reg * LTC6804_CELLS_IN_REG);
         uint16_t index = device * LTC_AFE_MAX_CELLS_PER_DEVICE + device_cell;
 
@@ -232,17 +278,16 @@ StatusCode ltc_afe_impl_read_cells(LtcAfeStorage *afe) {
           afe->cell_voltages[afe->cell_result_index[index]] = voltage;
         }
       }
-
-      // the Packet Error Code is transmitted after the cell data (see p.45)
-      uint16_t received_pec = SWAP_UINT16(voltage_register[device].pec);
-      uint16_t data_pec = crc15_calculate((uint8_t *)&voltage_register[device], 6);
-      if (received_pec != data_pec) {
-        // return early on failure
-        return status_code(STATUS_CODE_INTERNAL_ERROR);
-      }
     }
   }
 
+  LtcAfeScanStats *stats = &afe->scan_stats;
+  stats->num_scans++;
+  stats->last_readout_us = readout_end_us - readout_start_us;
+  stats->last_cycle_us = readout_end_us - afe->scan_start_us;
+  stats->max_readout_us = MAX(stats->max_readout_us, stats->last_readout_us);
+  stats->max_cycle_us = MAX(stats->max_cycle_us, stats->last_cycle_us);
+
   return STATUS_CODE_OK;
 }
 
@@ -250,7 +295,10 @@ StatusCode ltc_afe_impl_read_aux(LtcAfeStorage *afe, uint8_t device_cell) {
   LTCAFEAuxRegisterGroupPacket register_data[PLUTUS_CFG_AFE_DEVICES_IN_CHAIN] = { 0 };
 
   size_t len = sizeof(register_data);
-  prv_read_register(afe, LTC_AFE_REGISTER_AUX_A, (uint8_t *)register_data, len);
+  status_ok_or_return(
+      prv_read_register(afe, LTC_AFE_REGISTER_AUX_A, (uint8_t *)register_data, len));
+  status_ok_or_return(prv_check_group(afe, LTC_AFE_REGISTER_AUX_A, (uint8_t *)register_data,
+                                      sizeof(LTCAFEAuxRegisterGroupPacket)));
 
   for (uint16_t device = 0; device < PLUTUS_CFG_AFE_DEVICES_IN_CHAIN; ++device) {
     // data comes in in the form { 1, 1, 2, 2, 3, 3, PEC, PEC }
@@ -262,12 +310,6 @@ StatusCode ltc_afe_impl_read_aux(LtcAfeStorage *afe, uint8_t device_cell) {
       uint16_t index = device * LTC_AFE_MAX_CELLS_PER_DEVICE + device_cell;
       afe->aux_voltages[afe->aux_result_index[index]] = voltage;
     }
-
-    uint16_t received_pec = SWAP_UINT16(register_data[device].pec);
-    uint16_t data_pec = crc15_calculate((uint8_t *)&register_data[device], 6);
-    if (received_pec != data_pec) {
-      return status_code(STATUS_CODE_INTERNAL_ERROR);
-    }
   }
 
   return STATUS_CODE_OK;
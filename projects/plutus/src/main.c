@@ -17,13 +17,14 @@ static size_t s_telemetry_counter = 0;
 
 static void prv_periodic_tx_debug(SoftTimerId timer_id, void *context) {
   FaultMonitorResult *result = &s_fault_monitor.result;
+  const PackStats *stats = pack_stats_get(&s_fault_monitor.pack_stats);
 
   if (s_telemetry_counter < PLUTUS_CFG_AFE_TOTAL_CELLS) {
-    CAN_TRANSMIT_BATTERY_VT(s_telemetry_counter, result->cell_voltages[s_telemetry_counter],
+    CAN_TRANSMIT_BATTERY_VT(s_telemetry_counter, stats->cell_voltages[s_telemetry_counter],
                             result->temp_voltages[s_telemetry_counter]);
     s_telemetry_counter++;
   } else if (s_telemetry_counter == PLUTUS_CFG_AFE_TOTAL_CELLS) {
-    CAN_TRANSMIT_BATTERY_AGGREGATE_VC(result->total_voltage, (uint32_t)result->current);
+    CAN_TRANSMIT_BATTERY_AGGREGATE_VC(stats->total_voltage, (uint32_t)result->current);
     s_telemetry_counter = 0;
   }
 
@@ -0,0 +1,78 @@
+#include "pack_stats.h"
+#include <stdatomic.h>
+#include <string.h>
+
+StatusCode pack_stats_init(PackStatsStorage *storage, const PackStatsSettings *settings) {
+  if (storage == NULL || settings == NULL || settings->avg_shift > PACK_STATS_MAX_AVG_SHIFT) {
+    return status_code(STATUS_CODE_INVALID_ARGS);
+  }
+
+  memset(storage, 0, sizeof(*storage));
+  storage->settings = *settings;
+
+  return STATUS_CODE_OK;
+}
+
+StatusCode pack_stats_update(PackStatsStorage *storage, const uint16_t *cell_voltages,
+                             size_t num_cells) {
+  if (num_cells == 0 || num_cells > PLUTUS_CFG_AFE_TOTAL_CELLS) {
+    return status_code(STATUS_CODE_INVALID_ARGS);
+  }
+
+  uint8_t active = storage->active;
+  const PackStats *prev = &storage->buffers[active];
+  PackStats *stats = &storage->buffers[active ^ 1];
+  uint8_t shift = storage->settings.avg_shift;
+  uint32_t *avg_accum = storage->avg_accum;
+
+  if (prev->num_scans == 0 || prev->num_cells != num_cells) {
+    // Seed the averages so they don't ramp up from 0
+    for (size_t i = 0; i < num_cells; i++) {
+      avg_accum[i] = (uint32_t)cell_voltages[i] << shift;
+    }
+  }
+
+  // Keep the loop body free of calls and cross-iteration dependencies other than the reductions
+  uint32_t total = 0;
+  uint16_t min_voltage = UINT16_MAX;
+  uint16_t max_voltage = 0;
+  size_t min_cell = 0;
+  size_t max_cell = 0;
+  for (size_t i = 0; i < num_cells; i++) {
+    uint16_t voltage = cell_voltages[i];
+
+    stats->cell_voltages[i] = voltage;
+    total += voltage;
+    if (voltage < min_voltage) {
+      min_voltage = voltage;
+      min_cell = i;
+    }
+    if (voltage > max_voltage) {
+      max_voltage = voltage;
+      max_cell = i;
+    }
+
+    avg_accum[i] = avg_accum[i] - (avg_accum[i] >> shift) + voltage;
+    stats->avg_voltages[i] = (uint16_t)(avg_accum[i] >> shift);
+  }
+
+  stats->num_cells = num_cells;
+  stats->total_voltage = total;
+  stats->min_voltage = min_voltage;
+  stats->max_voltage = max_voltage;
+  stats->mean_voltage = (uint16_t)(total / num_cells);
+  stats->spread = max_voltage - min_voltage;
+  stats->min_cell = (uint16_t)min_cell;
+  stats->max_cell = (uint16_t)max_cell;
+  stats->num_scans = prev->num_scans + 1;
+
+  // Publish only once the buffer is complete - keep the compiler from sinking the writes below
+  atomic_signal_fence(memory_order_release);
+  storage->active = active ^ 1;
+
+  return STATUS_CODE_OK;
+}
+
+const PackStats *pack_stats_get(const PackStatsStorage *storage) {
+  return &storage->buffers[storage->active];
+}
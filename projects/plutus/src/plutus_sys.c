@@ -1,5 +1,6 @@
 #include "plutus_sys.h"
 #include <string.h>
+#include "can_msg_schema.h"
 #include "crc32.h"
 #include "event_queue.h"
 #include "flash.h"
@@ -48,6 +49,7 @@ static StatusCode prv_init_common(PlutusSysStorage *storage, PlutusSysType type)
     .fault_event = PLUTUS_EVENT_CAN_FAULT,
     .tx = { GPIO_PORT_A, 12 },
     .rx = { GPIO_PORT_A, 11 },
+    .msg_schema = can_msg_schema_get(),
   };
   status_ok_or_return(can_init(&storage->can, &can_settings));
 
@@ -0,0 +1,198 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "can.h"
+#include "cell_balancing.h"
+#include "interrupt.h"
+#include "soft_timer.h"
+#include "test_helpers.h"
+#include "unity.h"
+
+#define TEST_CELL_BALANCING_THRESHOLD 100
+#define TEST_CELL_BALANCING_HYSTERESIS 50
+#define TEST_CELL_BALANCING_MIN_VOLTAGE 30000
+#define TEST_CELL_BALANCING_TEMP_LIMIT 20000
+#define TEST_CELL_BALANCING_SCANS 3
+#define TEST_CELL_BALANCING_SETTLE_SCANS 1
+#define TEST_CELL_BALANCING_NUM_CELLS 8
+
+static LtcAfeStorage s_afe;
+static CellBalancingStorage s_balancing;
+static PackStatsStorage s_pack_stats;
+static uint16_t s_cells[TEST_CELL_BALANCING_NUM_CELLS];
+static uint16_t s_temps[TEST_CELL_BALANCING_NUM_CELLS];
+
+// Discharge state in the AFE and the last published state
+static uint64_t s_discharge;
+static uint64_t s_published;
+static uint32_t s_num_published;
+
+StatusCode TEST_MOCK(ltc_afe_toggle_cell_discharge)(LtcAfeStorage *afe, uint16_t cell,
+                                                    bool discharge) {
+  TEST_ASSERT_EQUAL_PTR(&s_afe, afe);
+  if (discharge) {
+    s_discharge |= (uint64_t)1 << cell;
+  } else {
+    s_discharge &= ~((uint64_t)1 << cell);
+  }
+
+  return STATUS_CODE_OK;
+}
+
+StatusCode TEST_MOCK(can_transmit)(const CanMessage *msg, const CanAckRequest *ack_request) {
+  TEST_ASSERT_EQUAL(SYSTEM_CAN_MESSAGE_DISCHARGE_STATE, msg->msg_id);
+  s_published = msg->data;
+  s_num_published++;
+
+  return STATUS_CODE_OK;
+}
+
+static void prv_scan(void) {
+  TEST_ASSERT_OK(pack_stats_update(&s_pack_stats, s_cells, TEST_CELL_BALANCING_NUM_CELLS));
+  TEST_ASSERT_OK(cell_balancing_update(&s_balancing, pack_stats_get(&s_pack_stats), s_temps));
+}
+
+void setup_test(void) {
+  interrupt_init();
+  soft_timer_init();
+
+  s_discharge = 0;
+  s_published = 0;
+  s_num_published = 0;
+  for (size_t i = 0; i < TEST_CELL_BALANCING_NUM_CELLS; i++) {
+    s_cells[i] = 36000;
+    s_temps[i] = 10000;
+  }
+
+  const PackStatsSettings pack_stats_settings = { .avg_shift = 0 };
+  TEST_ASSERT_OK(pack_stats_init(&s_pack_stats, &pack_stats_settings));
+
+  const CellBalancingSettings settings = {
+    .ltc_afe = &s_afe,
+    .threshold = TEST_CELL_BALANCING_THRESHOLD,
+    .hysteresis = TEST_CELL_BALANCING_HYSTERESIS,
+    .min_voltage = TEST_CELL_BALANCING_MIN_VOLTAGE,
+    .temp_node_limit = TEST_CELL_BALANCING_TEMP_LIMIT,
+    .balance_scans = TEST_CELL_BALANCING_SCANS,
+    .settle_scans = TEST_CELL_BALANCING_SETTLE_SCANS,
+    .publish_max_silence_ms = 1000,
+  };
+  TEST_ASSERT_OK(cell_balancing_init(&s_balancing, &settings));
+}
+
+void teardown_test(void) {}
+
+void test_cell_balancing_duty_cycle(void) {
+  s_cells[2] = 36000 + TEST_CELL_BALANCING_THRESHOLD + 1;
+  s_cells[5] = 36000 + TEST_CELL_BALANCING_THRESHOLD;
+
+  // The first scans after discharge is turned off are discarded
+  prv_scan();
+  TEST_ASSERT_EQUAL(0, s_discharge);
+
+  for (int round = 0; round < 2; round++) {
+    // Only cells past the threshold are chosen
+    prv_scan();
+    TEST_ASSERT_EQUAL(CELL_BALANCING_PHASE_BALANCE, s_balancing.phase);
+    TEST_ASSERT_EQUAL(1 << 2, s_discharge);
+    TEST_ASSERT_EQUAL(1 << 2, s_published);
+
+    for (int i = 0; i < TEST_CELL_BALANCING_SCANS - 1; i++) {
+      prv_scan();
+      TEST_ASSERT_EQUAL(1 << 2, s_discharge);
+    }
+
+    // Discharge is turned off for the measurement window, but the cell is still published
+    prv_scan();
+    TEST_ASSERT_EQUAL(CELL_BALANCING_PHASE_MEASURE, s_balancing.phase);
+    TEST_ASSERT_EQUAL(0, s_discharge);
+    TEST_ASSERT_EQUAL(1 << 2, s_published);
+
+    prv_scan();
+    TEST_ASSERT_EQUAL(0, s_discharge);
+  }
+}
+
+void test_cell_balancing_hysteresis(void) {
+  s_cells[0] = 36000 + TEST_CELL_BALANCING_THRESHOLD + 1;
+  prv_scan();
+  prv_scan();
+  TEST_ASSERT_EQUAL(1 << 0, s_discharge);
+
+  // Run through the balance and settle scans
+  for (int i = 0; i < TEST_CELL_BALANCING_SCANS + TEST_CELL_BALANCING_SETTLE_SCANS; i++) {
+    prv_scan();
+  }
+
+  // Below the start threshold, but still above the stop threshold
+  s_cells[0] = 36000 + TEST_CELL_BALANCING_THRESHOLD - TEST_CELL_BALANCING_HYSTERESIS + 1;
+  prv_scan();
+  TEST_ASSERT_EQUAL(1 << 0, s_discharge);
+
+  for (int i = 0; i < TEST_CELL_BALANCING_SCANS + TEST_CELL_BALANCING_SETTLE_SCANS; i++) {
+    prv_scan();
+  }
+
+  s_cells[0] = 36000 + TEST_CELL_BALANCING_THRESHOLD - TEST_CELL_BALANCING_HYSTERESIS;
+  prv_scan();
+  TEST_ASSERT_EQUAL(0, s_discharge);
+  TEST_ASSERT_EQUAL(0, s_published);
+  TEST_ASSERT_EQUAL(CELL_BALANCING_PHASE_MEASURE, s_balancing.phase);
+}
+
+void test_cell_balancing_thermal_limit(void) {
+  s_cells[1] = 37000;
+  s_cells[3] = 37000;
+  s_temps[3] = TEST_CELL_BALANCING_TEMP_LIMIT + 1;
+  prv_scan();
+  prv_scan();
+  TEST_ASSERT_EQUAL(1 << 1, s_discharge);
+
+  // Cells that heat up while balancing are dropped right away
+  s_temps[1] = TEST_CELL_BALANCING_TEMP_LIMIT + 1;
+  prv_scan();
+  TEST_ASSERT_EQUAL(0, s_discharge);
+  TEST_ASSERT_EQUAL(0, s_published);
+  TEST_ASSERT_EQUAL(CELL_BALANCING_PHASE_MEASURE, s_balancing.phase);
+}
+
+void test_cell_balancing_min_voltage(void) {
+  for (size_t i = 0; i < TEST_CELL_BALANCING_NUM_CELLS; i++) {
+    s_cells[i] = TEST_CELL_BALANCING_MIN_VOLTAGE + 1000;
+  }
+  s_cells[4] = TEST_CELL_BALANCING_MIN_VOLTAGE - 1;
+  prv_scan();
+  prv_scan();
+  TEST_ASSERT_EQUAL(0, s_discharge);
+}
+
+void test_cell_balancing_stop(void) {
+  s_cells[6] = 37000;
+  prv_scan();
+  prv_scan();
+  TEST_ASSERT_EQUAL(1 << 6, s_discharge);
+
+  TEST_ASSERT_OK(cell_balancing_stop(&s_balancing));
+  TEST_ASSERT_EQUAL(0, s_discharge);
+  TEST_ASSERT_EQUAL(0, s_published);
+
+  // Readings right after stopping are still settling
+  prv_scan();
+  TEST_ASSERT_EQUAL(0, s_discharge);
+  prv_scan();
+  TEST_ASSERT_EQUAL(1 << 6, s_discharge);
+}
+
+void test_cell_balancing_invalid_args(void) {
+  CellBalancingSettings settings = {
+    .ltc_afe = &s_afe,
+    .threshold = 10,
+    .hysteresis = 20,
+    .balance_scans = 1,
+  };
+  TEST_ASSERT_EQUAL(STATUS_CODE_INVALID_ARGS, cell_balancing_init(&s_balancing, &settings));
+
+  settings.hysteresis = 0;
+  settings.balance_scans = 0;
+  TEST_ASSERT_EQUAL(STATUS_CODE_INVALID_ARGS, cell_balancing_init(&s_balancing, &settings));
+}
@@ -1,13 +1,40 @@
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include "crc15.h"
 #include "test_helpers.h"
 #include "unity.h"
 
-void setup_test(void) {
-  crc15_init_table();
+#define TEST_CRC15_MAX_LEN 64
+#define TEST_CRC15_POLYNOMIAL 0x4599
+
+static uint32_t s_seed = 1;
+
+// Simple LCG so the tests are reproducible
+static uint8_t prv_rand(void) {
+  s_seed = s_seed * 1103515245 + 12345;
+  return (uint8_t)(s_seed >> 16);
+}
+
+// Bit-by-bit reference implementation from the datasheet (p.44)
+static uint16_t prv_crc15_bitwise(const uint8_t *data, size_t len) {
+  uint16_t remainder = 16;
+
+  for (size_t i = 0; i < len; i++) {
+    for (int bit = 7; bit >= 0; bit--) {
+      bool in0 = ((data[i] >> bit) & 0x1) ^ ((remainder >> 14) & 0x1);
+      remainder = (uint16_t)((remainder << 1) & 0x7FFF);
+      if (in0) {
+        remainder ^= TEST_CRC15_POLYNOMIAL;
+      }
+    }
+  }
+
+  return (uint16_t)(remainder << 1);
 }
 
+void setup_test(void) {}
+
 void teardown_test(void) {}
 
 void test_crc15_calculate_example(void) {
@@ -119,3 +146,35 @@ void test_crc15_calculate_wrcfg(void) {
 
   TEST_ASSERT_EQUAL(pec, crc15_calculate(data, SIZEOF_ARRAY(data)));
 }
+
+void test_crc15_calculate_matches_reference(void) {
+  uint8_t data[TEST_CRC15_MAX_LEN] = { 0 };
+
+  // Cover both odd and even lengths so the trailing byte is exercised
+  for (size_t len = 0; len <= TEST_CRC15_MAX_LEN; len++) {
+    for (size_t i = 0; i < len; i++) {
+      data[i] = prv_rand();
+    }
+
+    uint16_t expected = prv_crc15_bitwise(data, len);
+    TEST_ASSERT_EQUAL_HEX16(expected, crc15_calculate(data, len));
+    TEST_ASSERT_EQUAL_HEX16(expected, crc15_calculate_u8(data, len));
+  }
+}
+
+void test_crc15_verify(void) {
+  // RDCOMM slave result with its PEC (datasheet p.57)
+  uint8_t data[] = { 0x75, 0x5F, 0x7A, 0xAF, 0x7C, 0xCF, 0xF2, 0xBA };
+  TEST_ASSERT_TRUE(crc15_verify(data, SIZEOF_ARRAY(data)));
+
+  // Any single bit error in the data or PEC should be caught
+  for (size_t i = 0; i < SIZEOF_ARRAY(data); i++) {
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      data[i] ^= (uint8_t)(1 << bit);
+      TEST_ASSERT_FALSE(crc15_verify(data, SIZEOF_ARRAY(data)));
+      data[i] ^= (uint8_t)(1 << bit);
+    }
+  }
+
+  TEST_ASSERT_FALSE(crc15_verify(data, 1));
+}
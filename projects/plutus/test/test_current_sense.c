@@ -11,6 +11,7 @@
 #include "soft_timer.h"
 #include "test_helpers.h"
 #include "unity.h"
+#include "wait.h"
 
 // Arbitrary number of testing samples
 #define TEST_CURRENT_SENSE_NUM_SAMPLES 10
@@ -76,6 +77,7 @@ void test_current_sense(void) {
   // Collect samples and tests that the readings fit the linear relationship defined by the
   // calibration data
   while (s_callback_runs < TEST_CURRENT_SENSE_NUM_SAMPLES) {
+    wait();
   }
 
   TEST_ASSERT_EQUAL(TEST_CURRENT_SENSE_NUM_SAMPLES, s_callback_runs);
@@ -1,3 +1,4 @@
+#include <inttypes.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <string.h>
@@ -102,6 +103,26 @@ void test_ltc_afe_read_all_voltage_repeated_within_tolerances(void) {
   }
 }
 
+void test_ltc_afe_scan_stats(void) {
+  for (int sample = 0; sample < TEST_LTC_AFE_NUM_SAMPLES; ++sample) {
+    TEST_ASSERT_OK(ltc_afe_request_cell_conversion(&s_afe));
+    prv_wait_conv();
+  }
+
+  LtcAfeScanStats stats = { 0 };
+  TEST_ASSERT_OK(ltc_afe_get_scan_stats(&s_afe, &stats));
+  TEST_ASSERT_EQUAL(TEST_LTC_AFE_NUM_SAMPLES, stats.num_scans);
+  // The conversion delay lets the chain go idle, but the voltage groups share a single wakeup
+  TEST_ASSERT_TRUE(stats.num_wakeups <= 2 * TEST_LTC_AFE_NUM_SAMPLES + 1);
+  TEST_ASSERT_TRUE(stats.last_readout_us <= stats.last_cycle_us);
+  TEST_ASSERT_TRUE(stats.max_readout_us <= stats.max_cycle_us);
+
+  LOG_DEBUG("Scan: cycle %" PRIu32 " us (max %" PRIu32 "), readout %" PRIu32 " us (max %" PRIu32
+            "), %" PRIu32 " wakeups\n",
+            stats.last_cycle_us, stats.max_cycle_us, stats.last_readout_us, stats.max_readout_us,
+            stats.num_wakeups);
+}
+
 void test_ltc_afe_read_all_aux_repeated_within_tolerances(void) {
   // the idea here is that we repeatedly take samples and verify that the values being read
   // are within an acceptable tolerance
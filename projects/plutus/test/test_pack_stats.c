@@ -0,0 +1,93 @@
+#include <stddef.h>
+#include <stdint.h>
+#include "pack_stats.h"
+#include "test_helpers.h"
+#include "unity.h"
+
+#define TEST_PACK_STATS_AVG_SHIFT 2
+
+static PackStatsStorage s_pack_stats;
+static uint16_t s_cells[PLUTUS_CFG_AFE_TOTAL_CELLS];
+
+void setup_test(void) {
+  const PackStatsSettings settings = {
+    .avg_shift = TEST_PACK_STATS_AVG_SHIFT,
+  };
+  TEST_ASSERT_OK(pack_stats_init(&s_pack_stats, &settings));
+
+  for (size_t i = 0; i < PLUTUS_CFG_AFE_TOTAL_CELLS; i++) {
+    s_cells[i] = 36000;
+  }
+}
+
+void teardown_test(void) {}
+
+void test_pack_stats_extremes(void) {
+  TEST_ASSERT_EQUAL(0, pack_stats_get(&s_pack_stats)->num_scans);
+
+  s_cells[5] = 30000;
+  s_cells[PLUTUS_CFG_AFE_TOTAL_CELLS - 1] = 41000;
+  // Ties keep the first cell
+  s_cells[7] = 30000;
+  TEST_ASSERT_OK(pack_stats_update(&s_pack_stats, s_cells, PLUTUS_CFG_AFE_TOTAL_CELLS));
+
+  const PackStats *stats = pack_stats_get(&s_pack_stats);
+  uint32_t total = 36000 * (PLUTUS_CFG_AFE_TOTAL_CELLS - 3) + 30000 * 2 + 41000;
+  TEST_ASSERT_EQUAL(1, stats->num_scans);
+  TEST_ASSERT_EQUAL(PLUTUS_CFG_AFE_TOTAL_CELLS, stats->num_cells);
+  TEST_ASSERT_EQUAL(total, stats->total_voltage);
+  TEST_ASSERT_EQUAL(total / PLUTUS_CFG_AFE_TOTAL_CELLS, stats->mean_voltage);
+  TEST_ASSERT_EQUAL(30000, stats->min_voltage);
+  TEST_ASSERT_EQUAL(5, stats->min_cell);
+  TEST_ASSERT_EQUAL(41000, stats->max_voltage);
+  TEST_ASSERT_EQUAL(PLUTUS_CFG_AFE_TOTAL_CELLS - 1, stats->max_cell);
+  TEST_ASSERT_EQUAL(11000, stats->spread);
+  TEST_ASSERT_EQUAL_UINT16_ARRAY(s_cells, stats->cell_voltages, PLUTUS_CFG_AFE_TOTAL_CELLS);
+}
+
+void test_pack_stats_rolling_average(void) {
+  // The first scan seeds the average
+  TEST_ASSERT_OK(pack_stats_update(&s_pack_stats, s_cells, PLUTUS_CFG_AFE_TOTAL_CELLS));
+  TEST_ASSERT_EQUAL(36000, pack_stats_get(&s_pack_stats)->avg_voltages[0]);
+
+  // Each scan moves the average 1/4 of the way to the reading
+  s_cells[0] = 40000;
+  TEST_ASSERT_OK(pack_stats_update(&s_pack_stats, s_cells, PLUTUS_CFG_AFE_TOTAL_CELLS));
+  const PackStats *stats = pack_stats_get(&s_pack_stats);
+  TEST_ASSERT_EQUAL(37000, stats->avg_voltages[0]);
+  TEST_ASSERT_EQUAL(36000, stats->avg_voltages[1]);
+  TEST_ASSERT_EQUAL(40000, stats->cell_voltages[0]);
+
+  for (size_t i = 0; i < 100; i++) {
+    TEST_ASSERT_OK(pack_stats_update(&s_pack_stats, s_cells, PLUTUS_CFG_AFE_TOTAL_CELLS));
+  }
+  TEST_ASSERT_EQUAL(40000, pack_stats_get(&s_pack_stats)->avg_voltages[0]);
+}
+
+void test_pack_stats_double_buffered(void) {
+  TEST_ASSERT_OK(pack_stats_update(&s_pack_stats, s_cells, PLUTUS_CFG_AFE_TOTAL_CELLS));
+  const PackStats *first = pack_stats_get(&s_pack_stats);
+
+  // Updates never touch the buffer that readers currently see
+  s_cells[0] = 20000;
+  TEST_ASSERT_OK(pack_stats_update(&s_pack_stats, s_cells, PLUTUS_CFG_AFE_TOTAL_CELLS));
+  const PackStats *second = pack_stats_get(&s_pack_stats);
+
+  TEST_ASSERT_NOT_EQUAL(first, second);
+  TEST_ASSERT_EQUAL(36000, first->min_voltage);
+  TEST_ASSERT_EQUAL(1, first->num_scans);
+  TEST_ASSERT_EQUAL(20000, second->min_voltage);
+  TEST_ASSERT_EQUAL(2, second->num_scans);
+}
+
+void test_pack_stats_invalid_args(void) {
+  TEST_ASSERT_EQUAL(STATUS_CODE_INVALID_ARGS, pack_stats_update(&s_pack_stats, s_cells, 0));
+  TEST_ASSERT_EQUAL(STATUS_CODE_INVALID_ARGS,
+                    pack_stats_update(&s_pack_stats, s_cells, PLUTUS_CFG_AFE_TOTAL_CELLS + 1));
+  TEST_ASSERT_EQUAL(0, pack_stats_get(&s_pack_stats)->num_scans);
+
+  const PackStatsSettings settings = {
+    .avg_shift = PACK_STATS_MAX_AVG_SHIFT + 1,
+  };
+  TEST_ASSERT_EQUAL(STATUS_CODE_INVALID_ARGS, pack_stats_init(&s_pack_stats, &settings));
+}
@@ -134,8 +134,7 @@ StatusCode mcp3427_register_callback(Mcp3427Storage *storage, Mcp3427Callback ca
   storage->callback = callback;
   storage->context = context;
   // Starting the state machine.
-  fsm_init(&storage->fsm, MCP3427_FSM_NAME, &channel_1_trigger, storage);
-  return STATUS_CODE_OK;
+  return fsm_init(&storage->fsm, MCP3427_FSM_NAME, &channel_1_trigger, storage);
 }
 
 StatusCode mcp3427_register_fault_callback(Mcp3427Storage *storage, Mcp3427FaultCallback callback,
@@ -1,5 +1,7 @@
 #include "solar_master_config.h"
 
+#include "can_msg_schema.h"
+
 // TODO(ELEC-502): Add I2C high speed support to the driver.
 const I2CSettings slave_i2c_settings = {
   .speed = I2C_SPEED_STANDARD,      //
@@ -62,6 +64,7 @@ StatusCode solar_master_config_init(void) {
       (state == GPIO_STATE_HIGH) ? SOLAR_MASTER_CONFIG_BOARD_FRONT : SOLAR_MASTER_CONFIG_BOARD_REAR;
 
   s_config.can_settings->device_id = device_id_lookup[s_config.board];
+  s_config.can_settings->msg_schema = can_msg_schema_get();
   return STATUS_CODE_OK;
 }
 
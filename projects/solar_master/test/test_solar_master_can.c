@@ -62,8 +62,7 @@ void test_solar_master_can_rx_handler(void) {
   // TX Relay Message.
   MS_TEST_HELPER_CAN_TX_RX(SOLAR_MASTER_EVENT_CAN_TX, SOLAR_MASTER_EVENT_CAN_RX);
   Event e = { 0 };
-  while (!status_ok(event_process(&e))) {
-  }
+  MS_TEST_HELPER_AWAIT_EVENT(e);
   TEST_ASSERT_EQUAL(SOLAR_MASTER_EVENT_RELAY_STATE, e.id);
   TEST_ASSERT_EQUAL(EE_CHARGER_SET_RELAY_STATE_OPEN, e.data);
   // ACK Relay Message.